@@ -0,0 +1,426 @@
+/**
+ * @file address_checker.c
+ * @brief This file contains the implementation of the address checker functions.
+ *
+ * The address checker collects the address ranges written by the data records during the single-pass
+ * validation of the Intel Hex file analyzer. Records that follow each other in memory extend the last range,
+ * so a file written in address order gives few ranges. The ranges are sorted by address and swept once:
+ * a range that starts before the highest end of the previous ranges overlaps them.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "address_checker.h"   /* Include header file of this function file */
+#include <stdlib.h>            /* For realloc(), free(), qsort() functions */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ADDRESS_CHECKER_MIN_RANGES  64      /* The number of ranges of the first allocation */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold an address range written by data records that follow each other in memory.
+ */
+typedef struct
+{
+    uint64_t begin;                 /* The first absolute memory address of the range */
+    uint64_t end;                   /* The address after the last byte of the range */
+    uint32_t line;                  /* The line of the first data record of the range */
+} AddressRange_t;
+
+/**
+ * @brief Structure to hold the state of the address check.
+ */
+typedef struct
+{
+    AddressReport_t *addresses;     /* The address report */
+    AddressRange_t *ranges;         /* The address ranges written by the data records */
+    uint32_t count;                 /* The number of ranges */
+    uint32_t capacity;              /* The number of ranges that fit in the allocated array */
+    int8_t sorted;                  /* 1 while the ranges are sorted by address and don't overlap */
+    int8_t out_of_memory;           /* 1 if an allocation failed */
+} AddressChecker_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function starts the address check.
+ *
+ * @param checker The state of the address check.
+ * @param addresses The address report.
+ */
+static void startAddressCheck(AddressChecker_t *checker, AddressReport_t *addresses);
+
+/**
+ * @brief This function adds the address range of a valid data record, it is the visitor of the validation.
+ *
+ * @param context The state of the address check.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void addRange(void *context, const IntelHexRecord_t *record, uint32_t absolute_address, uint32_t line_number);
+
+/**
+ * @brief This function compares two address ranges by address, then by line.
+ *
+ * @param first The first range.
+ * @param second The second range.
+ * @return A negative value, 0 or a positive value if the first range is before, same as or after the second one.
+ */
+static int compareRanges(const void *first, const void *second);
+
+/**
+ * @brief This function stores an overlap or a gap in an array of the address report.
+ *
+ * @param entries The array of the address report.
+ * @param capacity The number of entries of the array.
+ * @param count The number of entries stored in the array.
+ * @param total The number of overlaps or gaps found.
+ * @param address The first absolute memory address of the overlap or of the gap.
+ * @param size The number of bytes of the overlap or of the gap.
+ * @param line The line of the record that overlaps or that follows the gap.
+ * @param other_line The line of the records that are overlapped or that precede the gap.
+ */
+static void addConflict(AddressConflict_t entries[], uint32_t capacity, uint32_t *count, uint32_t *total,
+                        uint64_t address, uint64_t size, uint32_t line, uint32_t other_line);
+
+/**
+ * @brief This function finishes the address check.
+ *
+ * The ranges are sorted if needed and swept once to find the overlaps and the gaps.
+ *
+ * @param checker The state of the address check.
+ * @param addresses The address report.
+ * @param result The result of the validation of the file.
+ * @return The result of the check (same values as checkIntelHexAddresses).
+ */
+static int32_t finishAddressCheck(AddressChecker_t *checker, AddressReport_t *addresses, int32_t result);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function validates the Intel Hex file and checks the addresses written by its data records.
+ *
+ * The file is validated in a single pass, the address range of each data record is resolved with the extended
+ * segment (02) and extended linear (04) address records. Records that follow each other in memory are kept
+ * as one range, the ranges are then sorted by address and swept once to find the overlaps and the gaps.
+ * The counts of the address report are set by the function, the arrays and capacities are given by the caller.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param addresses The address report, its arrays, capacities and gap threshold are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid without overlap, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the check, 5 if data records overlap, 6 if a data record crosses the end
+ *         of the 4 GiB address space.
+ */
+int32_t checkIntelHexAddresses(HexContext_t *context, FILE *fptr, AddressReport_t *addresses, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    AddressChecker_t checker;       /* Declaring the state of the address check */
+
+    startAddressCheck(&checker, addresses);
+    /* Validate the file and add the address range of each valid data record */
+    result = visitIntelHexFile(context, fptr, addRange, &checker, report);
+    /* Return the result of the check */
+    return finishAddressCheck(&checker, addresses, result);
+}
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and checks the addresses written by its data records.
+ *
+ * The function does the same as checkIntelHexAddresses on a file stored in memory (a buffer or a memory-mapped file).
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param addresses The address report, its arrays, capacities and gap threshold are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid without overlap, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the check, 5 if data records overlap, 6 if a data record crosses the end
+ *         of the 4 GiB address space.
+ */
+int32_t checkIntelHexBufferAddresses(HexContext_t *context, const int8_t buffer[], uint64_t size,
+                                     AddressReport_t *addresses, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    AddressChecker_t checker;       /* Declaring the state of the address check */
+
+    startAddressCheck(&checker, addresses);
+    /* Validate the file and add the address range of each valid data record */
+    result = visitIntelHexBuffer(context, buffer, size, addRange, &checker, report);
+    /* Return the result of the check */
+    return finishAddressCheck(&checker, addresses, result);
+}
+
+/**
+ * @brief This function starts the address check.
+ *
+ * @param checker The state of the address check.
+ * @param addresses The address report.
+ */
+static void startAddressCheck(AddressChecker_t *checker, AddressReport_t *addresses)
+{
+    checker->addresses = addresses;
+    checker->ranges = NULL;
+    checker->count = 0;
+    checker->capacity = 0;
+    checker->sorted = 1;
+    checker->out_of_memory = 0;
+    addresses->overlap_count = 0;
+    addresses->overlap_total = 0;
+    addresses->gap_count = 0;
+    addresses->gap_total = 0;
+    addresses->overflow_line = 0;
+}
+
+/**
+ * @brief This function adds the address range of a valid data record, it is the visitor of the validation.
+ *
+ * A data record that starts at the end of the last range extends it, any other data record starts a new range.
+ * The array of ranges only grows geometrically, so no memory is allocated for each record.
+ * The range of a data record that crosses the end of the 4 GiB address space ends after it, the line of the first
+ * such record is kept in the address report.
+ *
+ * @param context The state of the address check.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void addRange(void *context, const IntelHexRecord_t *record, uint32_t absolute_address, uint32_t line_number)
+{
+    AddressChecker_t *checker = (AddressChecker_t *)context;   /* The state of the address check */
+    AddressRange_t *last = NULL;                                /* The last range */
+    AddressRange_t *ranges = NULL;                              /* The new array of ranges */
+    uint64_t capacity = 0;                                      /* The new capacity of the array of ranges */
+
+    /* Only data records with data bytes write to the memory */
+    if ((record->record_type == 0x00) && (record->byte_count > 0) && !checker->out_of_memory)
+    {
+        if ((checker->addresses->overflow_line == 0) &&
+            ((uint64_t)absolute_address + record->byte_count > HEX_ADDRESS_SPACE_SIZE))
+        {
+            checker->addresses->overflow_line = line_number;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        last = (checker->count > 0) ? &(checker->ranges[checker->count - 1]) : NULL;
+        /* Check if the record extends the last range */
+        if ((last != NULL) && (last->end == absolute_address))
+        {
+            last->end += record->byte_count;
+        }
+        else
+        {
+            /* Make sure the array can hold one more range */
+            if (checker->count == checker->capacity)
+            {
+                capacity = (checker->capacity < ADDRESS_CHECKER_MIN_RANGES) ? ADDRESS_CHECKER_MIN_RANGES :
+                           (uint64_t)checker->capacity * 2;
+                ranges = (capacity <= 0xFFFFFFFFU) ?
+                         (AddressRange_t *)realloc(checker->ranges, (size_t)capacity * sizeof(AddressRange_t)) : NULL;
+                if (ranges == NULL)
+                {
+                    checker->out_of_memory = 1;
+                }
+                else
+                {
+                    checker->ranges = ranges;
+                    checker->capacity = (uint32_t)capacity;
+                }
+            }
+            else
+            {
+                /* Do nothing */
+            }
+
+            /* Start a new range */
+            if (!checker->out_of_memory)
+            {
+                /* If the record is before the end of the last range, the ranges must be sorted at the end */
+                if ((last != NULL) && (absolute_address < checker->ranges[checker->count - 1].end))
+                {
+                    checker->sorted = 0;
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+                checker->ranges[checker->count].begin = absolute_address;
+                checker->ranges[checker->count].end = (uint64_t)absolute_address + record->byte_count;
+                checker->ranges[checker->count].line = line_number;
+                checker->count += 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function compares two address ranges by address, then by line.
+ *
+ * @param first The first range.
+ * @param second The second range.
+ * @return A negative value, 0 or a positive value if the first range is before, same as or after the second one.
+ */
+static int compareRanges(const void *first, const void *second)
+{
+    const AddressRange_t *a = (const AddressRange_t *)first;        /* The first range */
+    const AddressRange_t *b = (const AddressRange_t *)second;       /* The second range */
+    int result = 0;                                                 /* Initialize the result of the comparison */
+
+    if (a->begin != b->begin)
+    {
+        result = (a->begin < b->begin) ? -1 : 1;
+    }
+    else if (a->line != b->line)
+    {
+        result = (a->line < b->line) ? -1 : 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function stores an overlap or a gap in an array of the address report.
+ *
+ * @param entries The array of the address report.
+ * @param capacity The number of entries of the array.
+ * @param count The number of entries stored in the array.
+ * @param total The number of overlaps or gaps found.
+ * @param address The first absolute memory address of the overlap or of the gap.
+ * @param size The number of bytes of the overlap or of the gap.
+ * @param line The line of the record that overlaps or that follows the gap.
+ * @param other_line The line of the records that are overlapped or that precede the gap.
+ */
+static void addConflict(AddressConflict_t entries[], uint32_t capacity, uint32_t *count, uint32_t *total,
+                        uint64_t address, uint64_t size, uint32_t line, uint32_t other_line)
+{
+    if (*count < capacity)
+    {
+        entries[*count].address = (uint32_t)address;
+        entries[*count].size = (size > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)size;
+        entries[*count].line = line;
+        entries[*count].other_line = other_line;
+        *count += 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    *total += 1;
+}
+
+/**
+ * @brief This function finishes the address check.
+ *
+ * The ranges are sorted by address if the records aren't in address order, then swept once. The highest end
+ * of the ranges before the current range is kept with the line of its range: a range that starts before it
+ * overlaps the data of that line, a range that starts far after it follows a gap.
+ *
+ * @param checker The state of the address check.
+ * @param addresses The address report.
+ * @param result The result of the validation of the file.
+ * @return The result of the check (same values as checkIntelHexAddresses).
+ */
+static int32_t finishAddressCheck(AddressChecker_t *checker, AddressReport_t *addresses, int32_t result)
+{
+    uint32_t i = 0;                 /* Loop counter */
+    uint64_t highest_end = 0;       /* The highest end of the ranges before the current range */
+    uint32_t highest_line = 0;      /* The line of the range with the highest end */
+    const AddressRange_t *range = NULL;     /* The current range */
+
+    if (checker->out_of_memory)
+    {
+        result = 4;
+    }
+    /* The addresses are only checked in a valid file */
+    else if (result == 0)
+    {
+        if (!checker->sorted)
+        {
+            qsort(checker->ranges, checker->count, sizeof(AddressRange_t), compareRanges);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        for (i = 0; i < checker->count; i++)
+        {
+            range = &(checker->ranges[i]);
+            /* Check if the range overlaps the data of the previous ranges */
+            if ((i > 0) && (range->begin < highest_end))
+            {
+                addConflict(addresses->overlaps, addresses->overlap_capacity, &(addresses->overlap_count),
+                            &(addresses->overlap_total), range->begin,
+                            ((range->end < highest_end) ? range->end : highest_end) - range->begin,
+                            range->line, highest_line);
+            }
+            /* Check if there is a gap larger than the threshold before the range */
+            else if ((i > 0) && (addresses->gap_threshold > 0) &&
+                     (range->begin - highest_end >= addresses->gap_threshold))
+            {
+                addConflict(addresses->gaps, addresses->gap_capacity, &(addresses->gap_count),
+                            &(addresses->gap_total), highest_end, range->begin - highest_end,
+                            range->line, highest_line);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            /* Keep the highest end */
+            if (range->end > highest_end)
+            {
+                highest_end = range->end;
+                highest_line = range->line;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        /* Overlapping data records or a data record past the end of the address space make the check fail */
+        if (addresses->overlap_total > 0)
+        {
+            result = 5;
+        }
+        else if (addresses->overflow_line != 0)
+        {
+            result = 6;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    free(checker->ranges);
+    return result;
+} /* EOF */
+
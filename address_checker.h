@@ -0,0 +1,107 @@
+/**
+ * @file address_checker.h
+ * @brief This file contains the prototypes of the address checker functions.
+ *
+ * The address checker resolves the absolute memory address of all data records of an Intel Hex file
+ * and detects the data records that overwrite data of another record, this is an opt-in check
+ * alongside the error codes of checkRecord.
+ * It can also report the gaps between the written addresses that are larger than a threshold.
+ * A data record whose bytes go past the end of the 4 GiB address space is reported as well, its addresses
+ * aren't wrapped to 0, like in the memory image and the converter.
+ * The written address ranges are sorted once, so the check takes O(n log n) time for n records.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef ADDRESS_CHECKER_H
+#define ADDRESS_CHECKER_H
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold one overlap or one gap found by the address checker.
+ *
+ * For an overlap, line is the line of the data record that writes again the addresses written by the records
+ * starting at other_line. For a gap, line is the line of the record after the gap and other_line is the line
+ * of the records before the gap.
+ */
+typedef struct
+{
+    uint32_t address;               /* The first absolute memory address of the overlap or of the gap */
+    uint32_t size;                  /* The number of bytes of the overlap or of the gap */
+    uint32_t line;                  /* The line of the record that overlaps or that follows the gap */
+    uint32_t other_line;            /* The line of the records that are overlapped or that precede the gap */
+} AddressConflict_t;
+
+/**
+ * @brief Structure to hold the result of the address check.
+ *
+ * The arrays of overlaps and gaps are allocated by the caller, overlaps and gaps behind the capacity
+ * are only counted. Gaps are only reported if gap_threshold isn't 0.
+ */
+typedef struct
+{
+    AddressConflict_t *overlaps;    /* The array of overlaps, given by the caller */
+    uint32_t overlap_capacity;      /* The number of entries of the array of overlaps */
+    uint32_t overlap_count;         /* The number of overlaps stored in the array */
+    uint32_t overlap_total;         /* The number of overlaps found */
+    AddressConflict_t *gaps;        /* The array of gaps, given by the caller */
+    uint32_t gap_capacity;          /* The number of entries of the array of gaps */
+    uint32_t gap_count;             /* The number of gaps stored in the array */
+    uint32_t gap_total;             /* The number of gaps found */
+    uint32_t gap_threshold;         /* The minimum number of bytes of a reported gap, 0 to report no gap */
+    uint32_t overflow_line;         /* The line of the first data record that crosses the end of the 4 GiB address space,
+                                       0 if there is none */
+} AddressReport_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function validates the Intel Hex file and checks the addresses written by its data records.
+ *
+ * The file is validated in a single pass, the address range of each data record is resolved with the extended
+ * segment (02) and extended linear (04) address records. Records that follow each other in memory are kept
+ * as one range, the ranges are then sorted by address and swept once to find the overlaps and the gaps.
+ * The counts of the address report are set by the function, the arrays and capacities are given by the caller.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param addresses The address report, its arrays, capacities and gap threshold are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid without overlap, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the check, 5 if data records overlap, 6 if a data record crosses the end
+ *         of the 4 GiB address space.
+ */
+int32_t checkIntelHexAddresses(HexContext_t *context, FILE *fptr, AddressReport_t *addresses, FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and checks the addresses written by its data records.
+ *
+ * The function does the same as checkIntelHexAddresses on a file stored in memory (a buffer or a memory-mapped file).
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param addresses The address report, its arrays, capacities and gap threshold are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid without overlap, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the check, 5 if data records overlap, 6 if a data record crosses the end
+ *         of the 4 GiB address space.
+ */
+int32_t checkIntelHexBufferAddresses(HexContext_t *context, const int8_t buffer[], uint64_t size,
+                                     AddressReport_t *addresses, FileReport_t *report);
+
+#endif /* ADDRESS_CHECKER_H */
+
@@ -0,0 +1,414 @@
+/**
+ * @file address_index.c
+ * @brief This file contains the implementation of the address index functions.
+ *
+ * The index file has a header with the size and the modification time of the Intel Hex file, then the entries.
+ * The entries are collected by a visitor of the single-pass validation, which gives the absolute address
+ * resolved with the extended segment (02) and extended linear (04) address records, and the byte offset
+ * of the line is taken from the context. The index file is used in place through a memory mapping.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "address_index.h"     /* Include header file of this function file */
+#include "record_handler.h"    /* Include header file of the record handler of lower layer */
+#include <stdlib.h>            /* For malloc(), realloc(), free(), qsort() functions */
+#include <string.h>            /* For memset() function */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ADDRESS_INDEX_MAGIC         0x49584849U     /* "IHXI" in little-endian order, the first bytes of an index */
+#define ADDRESS_INDEX_VERSION       2               /* The version of the format of the index file (2: time in ns) */
+#define ADDRESS_INDEX_MIN_ENTRIES   1024            /* The number of entries of the first allocation */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the header of an index file.
+ */
+typedef struct
+{
+    uint32_t magic;                 /* ADDRESS_INDEX_MAGIC */
+    uint32_t header_size;           /* The size of this structure */
+    uint32_t version;               /* ADDRESS_INDEX_VERSION */
+    uint32_t entry_count;           /* The number of entries behind the header */
+    uint64_t source_size;           /* The number of bytes of the Intel Hex file */
+    uint64_t source_time;           /* The modification time of the Intel Hex file, with its fraction of a second */
+} AddressIndexHeader_t;
+
+/**
+ * @brief Structure to hold the state of the building of an index.
+ */
+typedef struct
+{
+    HexContext_t *context;          /* The context of the file, it gives the byte offset of the line */
+    AddressIndexEntry_t *entries;   /* The entries, in the order of the file */
+    uint32_t count;                 /* The number of entries */
+    uint32_t capacity;              /* The number of allocated entries */
+    int8_t out_of_memory;           /* 1 if an allocation failed */
+} IndexBuilder_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void addIndexEntry(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                          uint32_t line_number);
+static int compareIndexEntries(const void *first, const void *second);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function validates an Intel Hex file and writes its address index.
+ *
+ * The file is mapped into memory and validated with visitIntelHexBuffer, each data record gives one entry.
+ * The entries are sorted by address at the end. The index is only written if the file is valid.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param index_path The path of the index file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the index is written, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if a file can't be opened or written, 4 if there isn't enough memory.
+ */
+int32_t buildAddressIndex(HexContext_t *context, const char *path, const char *index_path, FileReport_t *report)
+{
+    int32_t result = 0;                     /* Initialize the result of the function */
+    FILE *fptr = NULL;                      /* The index file */
+    MappedFile_t file;                      /* Declaring the mapping of the Intel Hex file */
+    RandomReader_t source;                  /* Declaring the Intel Hex file, to get its size and modification time */
+    IndexBuilder_t builder;                 /* Declaring the state of the building of the index */
+    AddressIndexHeader_t header;            /* Declaring the header of the index file */
+
+    memset(report, 0, sizeof(FileReport_t));
+    builder.context = context;
+    builder.entries = NULL;
+    builder.count = 0;
+    builder.capacity = 0;
+    builder.out_of_memory = 0;
+    if (openRandomReader(&source, path) != 0)
+    {
+        result = 3;
+    }
+    else
+    {
+        if (mapFile(path, &file) != 0)
+        {
+            result = 3;
+        }
+        else
+        {
+            result = visitIntelHexBuffer(context, file.data, file.size, addIndexEntry, &builder, report);
+            unmapFile(&file);
+        }
+        closeRandomReader(&source);
+    }
+    if ((result == 0) && builder.out_of_memory)
+    {
+        result = 4;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* Sort the entries and write the index */
+    if (result == 0)
+    {
+        if (builder.count > 1)
+        {
+            qsort(builder.entries, builder.count, sizeof(AddressIndexEntry_t), compareIndexEntries);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        memset(&header, 0, sizeof(AddressIndexHeader_t));
+        header.magic = ADDRESS_INDEX_MAGIC;
+        header.header_size = sizeof(AddressIndexHeader_t);
+        header.version = ADDRESS_INDEX_VERSION;
+        header.entry_count = builder.count;
+        header.source_size = source.size;
+        header.source_time = source.time;
+        fptr = fopen(index_path, "wb");
+        if ((fptr == NULL) || (fwrite(&header, sizeof(AddressIndexHeader_t), 1, fptr) != 1) ||
+            (fwrite(builder.entries, sizeof(AddressIndexEntry_t), builder.count, fptr) != builder.count))
+        {
+            result = 3;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if ((fptr != NULL) && (fclose(fptr) != 0))
+        {
+            result = 3;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    free(builder.entries);
+    return result;
+}
+
+/**
+ * @brief This function opens the address index of an Intel Hex file.
+ *
+ * The index can only be used if it is built from the Intel Hex file as it is now: the size and
+ * the modification time of the file, with its fraction of a second, must be the ones stored in the index.
+ *
+ * @param index The structure to store the open index.
+ * @param path The path of the Intel Hex file.
+ * @param index_path The path of the index file.
+ * @return 0 if the index is open, 1 if the index is missing, damaged or out of date,
+ *         3 if the Intel Hex file can't be opened.
+ */
+int32_t openAddressIndex(AddressIndex_t *index, const char *path, const char *index_path)
+{
+    int32_t result = 0;                     /* Initialize the result of the function */
+    const AddressIndexHeader_t *header = NULL;  /* The header of the index file */
+
+    index->entries = NULL;
+    index->entry_count = 0;
+    index->file.data = NULL;
+    index->file.size = 0;
+    index->file.handle = NULL;
+    if (openRandomReader(&(index->source), path) != 0)
+    {
+        result = 3;
+    }
+    else if ((mapFile(index_path, &(index->file)) != 0) || (index->file.size < sizeof(AddressIndexHeader_t)))
+    {
+        result = 1;
+    }
+    else
+    {
+        /* Use the index only if it is complete and built from the Intel Hex file as it is now */
+        header = (const AddressIndexHeader_t *)index->file.data;
+        if ((header->magic != ADDRESS_INDEX_MAGIC) || (header->header_size != sizeof(AddressIndexHeader_t)) ||
+            (header->version != ADDRESS_INDEX_VERSION) ||
+            (index->file.size != sizeof(AddressIndexHeader_t) +
+                                 ((uint64_t)header->entry_count * sizeof(AddressIndexEntry_t))) ||
+            (header->source_size != index->source.size) || (header->source_time != index->source.time))
+        {
+            result = 1;
+        }
+        else
+        {
+            index->entries = (const AddressIndexEntry_t *)(index->file.data + sizeof(AddressIndexHeader_t));
+            index->entry_count = header->entry_count;
+        }
+    }
+
+    /* Release what is open if the index can't be used */
+    if (result != 0)
+    {
+        unmapFile(&(index->file));
+        if (result != 3)
+        {
+            closeRandomReader(&(index->source));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function finds the data byte written at an absolute memory address.
+ *
+ * The last entry that starts at or below the address is found with a binary search, then the entries
+ * in front of it are checked while they can still reach the address, because a record has at most
+ * RECORD_MAX_DATA_BYTES data bytes. If several records write the address, the last record of the file is used,
+ * like a programmer would do. Only the line of this record is read from the Intel Hex file and decoded.
+ *
+ * @param context The context of the file, its base address is the base address of the record after the call.
+ * @param index The open index.
+ * @param address The absolute memory address.
+ * @param lookup The structure to store the data byte and its record.
+ * @return 0 if the address is found, 1 if no record writes the address, 2 if the record can't be read.
+ */
+int32_t lookupAddress(HexContext_t *context, AddressIndex_t *index, uint32_t address, AddressLookup_t *lookup)
+{
+    int32_t result = 1;                     /* Initialize the result of the function */
+    uint32_t low = 0;                       /* The first entry of the binary search */
+    uint32_t high = index->entry_count;     /* The entry behind the last entry of the binary search */
+    uint32_t middle = 0;                    /* The entry in the middle of the binary search */
+    const AddressIndexEntry_t *entry = NULL;    /* The current entry */
+    const AddressIndexEntry_t *found = NULL;    /* The last record of the file that writes the address */
+
+    /* Find the first entry that starts above the address */
+    while (low < high)
+    {
+        middle = low + ((high - low) / 2);
+        if (index->entries[middle].address <= address)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    /* Check the entries that can reach the address */
+    while ((low > 0) && (address - index->entries[low - 1].address < RECORD_MAX_DATA_BYTES))
+    {
+        entry = &(index->entries[low - 1]);
+        if ((address - entry->address < entry->byte_count) &&
+            ((found == NULL) || (entry->line_number > found->line_number)))
+        {
+            found = entry;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        low -= 1;
+    }
+
+    /* Read and decode the line of the record */
+    if (found != NULL)
+    {
+        result = 2;
+        lookup->entry = *found;
+        lookup->length = 11 + (found->byte_count * 2);
+        context->line_number = found->line_number;
+        if ((readFileAt(&(index->source), found->offset, lookup->line, lookup->length) == lookup->length) &&
+            (parseRecord(context, lookup->line, lookup->length, &(lookup->record)) == 0) &&
+            (lookup->record.record_type == 0x00) && (lookup->record.byte_count == found->byte_count))
+        {
+            context->base_address = found->address - lookup->record.address;
+            lookup->value = lookup->record.data[address - found->address];
+            result = 0;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function closes an address index.
+ *
+ * @param index The index to close.
+ */
+void closeAddressIndex(AddressIndex_t *index)
+{
+    unmapFile(&(index->file));
+    closeRandomReader(&(index->source));
+    index->entries = NULL;
+    index->entry_count = 0;
+}
+
+/**
+ * @brief This function adds the entry of a data record to the index being built.
+ *
+ * It is the visitor of the validation, the records without data bytes write nothing and are skipped.
+ * The array of the entries grows geometrically.
+ *
+ * @param visitor_context The state of the building of the index.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void addIndexEntry(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                          uint32_t line_number)
+{
+    IndexBuilder_t *builder = (IndexBuilder_t *)visitor_context;    /* The state of the building of the index */
+    uint32_t capacity = 0;                  /* The new number of allocated entries */
+    AddressIndexEntry_t *entries = NULL;    /* Pointer to the new entries */
+    AddressIndexEntry_t *entry = NULL;      /* Pointer to the new entry */
+
+    if ((record->record_type == 0x00) && (record->byte_count > 0) && !builder->out_of_memory)
+    {
+        if (builder->count == builder->capacity)
+        {
+            capacity = (builder->capacity == 0) ? ADDRESS_INDEX_MIN_ENTRIES : builder->capacity * 2;
+            entries = (AddressIndexEntry_t *)realloc(builder->entries, (size_t)capacity * sizeof(AddressIndexEntry_t));
+            if (entries != NULL)
+            {
+                builder->entries = entries;
+                builder->capacity = capacity;
+            }
+            else
+            {
+                builder->out_of_memory = 1;
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        if (!builder->out_of_memory)
+        {
+            entry = &(builder->entries[builder->count]);
+            entry->address = absolute_address;
+            entry->byte_count = record->byte_count;
+            entry->offset = builder->context->line_offset;
+            entry->line_number = line_number;
+            entry->reserved = 0;
+            builder->count += 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function compares two entries by address, then by line number, for qsort.
+ *
+ * @param first The first entry.
+ * @param second The second entry.
+ * @return -1 if the first entry comes first, 1 if it comes after, 0 otherwise.
+ */
+static int compareIndexEntries(const void *first, const void *second)
+{
+    const AddressIndexEntry_t *first_entry = (const AddressIndexEntry_t *)first;    /* The first entry */
+    const AddressIndexEntry_t *second_entry = (const AddressIndexEntry_t *)second;  /* The second entry */
+    int result = 0;                         /* The result of the comparison */
+
+    if (first_entry->address != second_entry->address)
+    {
+        result = (first_entry->address < second_entry->address) ? -1 : 1;
+    }
+    else if (first_entry->line_number != second_entry->line_number)
+    {
+        result = (first_entry->line_number < second_entry->line_number) ? -1 : 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+} /* EOF */
@@ -0,0 +1,125 @@
+/**
+ * @file address_index.h
+ * @brief This file contains the prototypes of the address index functions.
+ *
+ * The address index is a small binary file next to an Intel Hex file. It has one entry for each data record,
+ * sorted by absolute memory address, with the byte offset and the line number of the record in the Intel Hex file.
+ * Function buildAddressIndex validates the Intel Hex file and writes its index in a single pass.
+ * Function openAddressIndex maps the index into memory, then lookupAddress finds the record that writes
+ * a memory address with a binary search and reads only this record from the Intel Hex file.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "file_mapper.h"               /* Include header file of the file mapper */
+#include "random_reader.h"             /* Include header file of the random reader */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef ADDRESS_INDEX_H
+#define ADDRESS_INDEX_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ADDRESS_INDEX_EXTENSION ".hidx"                         /* The extension added to the path of the Intel Hex file */
+#define ADDRESS_INDEX_MAX_LINE  (11 + (RECORD_MAX_DATA_BYTES * 2))  /* The characters of the longest data record */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold one entry of an address index, the entries are stored as they are in the index file.
+ */
+typedef struct
+{
+    uint32_t address;               /* The absolute memory address of the first data byte of the record */
+    uint32_t byte_count;            /* The number of data bytes of the record */
+    uint64_t offset;                /* The byte offset of the line of the record in the Intel Hex file */
+    uint32_t line_number;           /* The line number of the record */
+    uint32_t reserved;              /* 0, it keeps the size of the entries a multiple of 8 bytes */
+} AddressIndexEntry_t;
+
+/**
+ * @brief Structure to hold an open address index.
+ */
+typedef struct
+{
+    MappedFile_t file;                  /* The mapping of the index file */
+    const AddressIndexEntry_t *entries; /* The entries, sorted by address then by line number */
+    uint32_t entry_count;               /* The number of entries */
+    RandomReader_t source;              /* The Intel Hex file, open for random reads */
+} AddressIndex_t;
+
+/**
+ * @brief Structure to hold the result of the lookup of an address.
+ */
+typedef struct
+{
+    uint8_t value;                      /* The data byte written at the address */
+    AddressIndexEntry_t entry;          /* The entry of the record */
+    IntelHexRecord_t record;            /* The record */
+    int8_t line[ADDRESS_INDEX_MAX_LINE];    /* The characters of the line of the record */
+    uint32_t length;                    /* The number of characters of the line */
+} AddressLookup_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function validates an Intel Hex file and writes its address index.
+ *
+ * The index is only written if the file is valid.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param index_path The path of the index file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the index is written, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if a file can't be opened or written, 4 if there isn't enough memory.
+ */
+int32_t buildAddressIndex(HexContext_t *context, const char *path, const char *index_path, FileReport_t *report);
+
+/**
+ * @brief This function opens the address index of an Intel Hex file.
+ *
+ * The index can only be used if it is built from the Intel Hex file as it is now: the size and
+ * the modification time of the file, with its fraction of a second, must be the ones stored in the index.
+ *
+ * @param index The structure to store the open index.
+ * @param path The path of the Intel Hex file.
+ * @param index_path The path of the index file.
+ * @return 0 if the index is open, 1 if the index is missing, damaged or out of date,
+ *         3 if the Intel Hex file can't be opened.
+ */
+int32_t openAddressIndex(AddressIndex_t *index, const char *path, const char *index_path);
+
+/**
+ * @brief This function finds the data byte written at an absolute memory address.
+ *
+ * If several records write the address, the last record of the file is used, like a programmer would do.
+ * Only the line of this record is read from the Intel Hex file and decoded.
+ *
+ * @param context The context of the file, its base address is the base address of the record after the call.
+ * @param index The open index.
+ * @param address The absolute memory address.
+ * @param lookup The structure to store the data byte and its record.
+ * @return 0 if the address is found, 1 if no record writes the address, 2 if the record can't be read.
+ */
+int32_t lookupAddress(HexContext_t *context, AddressIndex_t *index, uint32_t address, AddressLookup_t *lookup);
+
+/**
+ * @brief This function closes an address index.
+ *
+ * @param index The index to close.
+ */
+void closeAddressIndex(AddressIndex_t *index);
+
+#endif /* ADDRESS_INDEX_H */
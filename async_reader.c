@@ -0,0 +1,1023 @@
+/**
+ * @file async_reader.c
+ * @brief This file contains the implementation of the asynchronous reader functions.
+ *
+ * All blocks are asked at once when the file is opened, then each block given to the caller is asked again
+ * with the next offset when the caller wants the following block, so ASYNC_READER_DEPTH - 1 reads stay
+ * in flight while a block is parsed. The reads can complete in any order, the blocks are always given
+ * in the order of the file. A short read is continued from where it stopped, a read of 0 bytes before
+ * the end of a block means that the file was truncated and ends the file.
+ * The blocks are never given to the caller before the reads in flight are done, and the reads in flight
+ * are waited for before the buffers are freed, because the operating system writes into them.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "async_reader.h"       /* Include header file of this function file */
+#include "hex_statistics.h"     /* For readStatisticsClock() function */
+#include <stddef.h>             /* For NULL */
+#include <stdlib.h>             /* For malloc(), free() functions */
+#include <string.h>             /* For memset() function */
+
+#if defined(_WIN32)
+#include <windows.h>            /* For CreateFile(), ReadFile(), GetOverlappedResult() functions */
+#else
+#include <errno.h>              /* For errno, EINTR, EAGAIN */
+#include <fcntl.h>              /* For open() function */
+#include <pthread.h>            /* For pthread_create(), pthread_cond_wait() functions */
+#include <sys/stat.h>           /* For fstat() function */
+#include <sys/types.h>          /* For off_t, ssize_t */
+#include <unistd.h>             /* For pread(), close(), syscall() functions */
+#if ASYNC_READER_IO_URING
+#include <linux/io_uring.h>     /* For the structures and constants of io_uring */
+#include <sys/mman.h>           /* For mmap(), munmap() functions */
+#include <sys/syscall.h>        /* For __NR_io_uring_setup, __NR_io_uring_enter */
+#include <sys/uio.h>            /* For struct iovec */
+#endif
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+#if defined(_WIN32)
+/**
+ * @brief Structure to hold the overlapped reads of the blocks.
+ */
+typedef struct
+{
+    OVERLAPPED reads[ASYNC_READER_DEPTH];   /* The offset and the completion event of the read of each block */
+} OverlappedState_t;
+#else
+/**
+ * @brief Structure to hold the read-ahead thread and what it shares with the caller.
+ *
+ * The thread reads the pending blocks in the order of the ring, the order in which they are asked.
+ */
+typedef struct
+{
+    pthread_t thread;               /* The read-ahead thread */
+    pthread_mutex_t lock;           /* The lock of the states of the blocks and of stop */
+    pthread_cond_t changed;         /* Signaled when a block is asked, read or when the thread is stopped */
+    int8_t stop;                    /* 1 when the thread must end */
+} ThreadState_t;
+
+#if ASYNC_READER_IO_URING
+/**
+ * @brief Structure to hold an io_uring: its file descriptor and the rings shared with the kernel.
+ *
+ * A block has at most one read in flight, so the submission queue has one entry per block
+ * and never fills up.
+ */
+typedef struct
+{
+    int32_t ring;                   /* The file descriptor of the io_uring */
+    uint8_t *submission_ring;       /* The mapping of the submission ring */
+    size_t submission_ring_size;    /* The number of bytes of the mapping of the submission ring */
+    uint8_t *completion_ring;       /* The mapping of the completion ring */
+    size_t completion_ring_size;    /* The number of bytes of the mapping of the completion ring */
+    struct io_uring_sqe *entries;   /* The mapping of the submission queue entries */
+    size_t entries_size;            /* The number of bytes of the mapping of the submission queue entries */
+    uint32_t *submission_tail;      /* The tail of the submission ring, written by the reader */
+    uint32_t submission_mask;       /* The mask of an index of the submission ring */
+    uint32_t *submission_array;     /* The indexes of the submission queue entries */
+    uint32_t *completion_head;      /* The head of the completion ring, written by the reader */
+    uint32_t *completion_tail;      /* The tail of the completion ring, written by the kernel */
+    uint32_t completion_mask;       /* The mask of an index of the completion ring */
+    struct io_uring_cqe *completions;   /* The completion queue entries */
+    struct iovec vectors[ASYNC_READER_DEPTH];   /* The memory of the read in flight of each block */
+} UringState_t;
+#endif
+#endif
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function asks a block again with the next offset of the file.
+ *
+ * The block becomes idle if the whole file is already asked.
+ *
+ * @param reader The open file.
+ * @param block The block, it isn't used by the caller any more.
+ */
+static void askNextBlock(AsyncReader_t *reader, AsyncBlock_t *block);
+
+/**
+ * @brief This function starts the read of the rest of a block with the backend of the reader.
+ *
+ * @param reader The open file.
+ * @param block The block, its offset, size and count are set.
+ */
+static void startBlockRead(AsyncReader_t *reader, AsyncBlock_t *block);
+
+/**
+ * @brief This function waits until the read of a block is no longer in flight.
+ *
+ * @param reader The open file.
+ * @param block The block.
+ */
+static void waitBlockRead(AsyncReader_t *reader, AsyncBlock_t *block);
+
+/**
+ * @brief This function opens the file and stores its size.
+ *
+ * @param reader The reader.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened.
+ */
+static int32_t openReaderFile(AsyncReader_t *reader, const char *path);
+
+/**
+ * @brief This function closes the file.
+ *
+ * @param reader The reader.
+ */
+static void closeReaderFile(AsyncReader_t *reader);
+
+/**
+ * @brief This function sets up the backend of the reader.
+ *
+ * @param reader The reader with the open file.
+ * @return 0 if the backend is set up, 4 if there isn't enough memory.
+ */
+static int32_t startBackend(AsyncReader_t *reader);
+
+/**
+ * @brief This function releases the backend of the reader, no read is in flight.
+ *
+ * @param reader The reader.
+ */
+static void stopBackend(AsyncReader_t *reader);
+
+#if !defined(_WIN32)
+/**
+ * @brief This function reads the pending blocks in the order of the ring until it is stopped.
+ *
+ * @param argument The reader.
+ * @return NULL.
+ */
+static void *readAhead(void *argument);
+
+#if ASYNC_READER_IO_URING
+/**
+ * @brief This function sets up an io_uring with one submission queue entry per block.
+ *
+ * @param reader The reader, the state of the io_uring is stored in it.
+ * @return 0 if the io_uring is set up, 1 if io_uring isn't available, 4 if there isn't enough memory.
+ */
+static int32_t setupUring(AsyncReader_t *reader);
+
+/**
+ * @brief This function takes the completions of the io_uring, waiting for one if there are none.
+ *
+ * @param reader The reader.
+ * @return 0 if the completions are taken, 1 if the wait failed.
+ */
+static int32_t takeUringCompletions(AsyncReader_t *reader);
+
+/**
+ * @brief This function releases the rings and the file descriptor of an io_uring.
+ *
+ * @param uring The io_uring, the mappings that aren't made are NULL.
+ */
+static void closeUring(UringState_t *uring);
+#endif
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function opens a file and starts the reads of its first blocks.
+ *
+ * With io_uring, the reader falls back to the read-ahead thread if the ring can't be set up.
+ *
+ * @param reader The structure to store the open file.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened, 4 if there isn't enough memory for the blocks.
+ */
+int32_t openAsyncReader(AsyncReader_t *reader, const char *path)
+{
+    int32_t error_code = 0;         /* Error code, initialized to 0 */
+    uint32_t i = 0;                 /* Loop counter */
+
+    memset(reader, 0, sizeof(AsyncReader_t));
+    reader->descriptor = -1;
+    error_code = openReaderFile(reader, path);
+    if (error_code == 0)
+    {
+        reader->buffer = (int8_t *)malloc((size_t)ASYNC_READER_DEPTH * ASYNC_READER_BLOCK_SIZE);
+        error_code = (reader->buffer != NULL) ? startBackend(reader) : 4;
+        if (error_code != 0)
+        {
+            free(reader->buffer);
+            reader->buffer = NULL;
+            closeReaderFile(reader);
+        }
+        else
+        {
+            /* Ask all blocks at once */
+            for (i = 0; i < ASYNC_READER_DEPTH; i++)
+            {
+                reader->blocks[i].data = reader->buffer + ((size_t)i * ASYNC_READER_BLOCK_SIZE);
+                askNextBlock(reader, &(reader->blocks[i]));
+            }
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function gives the next block of the file.
+ *
+ * The block given by the last call is read again with the next offset of the file, then the function waits
+ * until the read of the next block in the order of the file is complete.
+ * The block stays valid until the next call of readAsyncBlock or closeAsyncReader.
+ *
+ * @param reader The open file.
+ * @param data Pointer to store the pointer to the bytes of the block.
+ * @param size Pointer to store the number of bytes of the block.
+ * @return 1 if a block is given, 0 at the end of the file or if a read failed (failed is set).
+ */
+int32_t readAsyncBlock(AsyncReader_t *reader, const int8_t **data, uint32_t *size)
+{
+    int32_t result = 0;             /* Initialize the result to the end of the file */
+    AsyncBlock_t *block = NULL;     /* Pointer to the next block of the file */
+    uint64_t start = readStatisticsClock();     /* The time of the beginning of the wait */
+
+    /* The block given by the last call is free, it reads the part of the file behind the blocks in flight */
+    if (reader->block_given)
+    {
+        askNextBlock(reader, &(reader->blocks[(reader->next_block + ASYNC_READER_DEPTH - 1) % ASYNC_READER_DEPTH]));
+        reader->block_given = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    block = &(reader->blocks[reader->next_block]);
+    if (!reader->failed && (block->state != ASYNC_BLOCK_IDLE))
+    {
+        waitBlockRead(reader, block);
+        if (block->state == ASYNC_BLOCK_FAILED)
+        {
+            reader->failed = 1;
+        }
+        else if (block->count > 0)
+        {
+            *data = block->data;
+            *size = block->count;
+            reader->block_given = 1;
+            reader->next_block = (reader->next_block + 1) % ASYNC_READER_DEPTH;
+            result = 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    reader->wait_time += readStatisticsClock() - start;
+    /* Return the result */
+    return result;
+}
+
+/**
+ * @brief This function waits for the reads in flight and closes the file.
+ *
+ * @param reader The open file.
+ */
+void closeAsyncReader(AsyncReader_t *reader)
+{
+    uint32_t i = 0;                 /* Loop counter */
+
+    if (reader->buffer != NULL)
+    {
+        for (i = 0; i < ASYNC_READER_DEPTH; i++)
+        {
+            waitBlockRead(reader, &(reader->blocks[i]));
+        }
+        stopBackend(reader);
+        closeReaderFile(reader);
+        free(reader->buffer);
+        reader->buffer = NULL;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function asks a block again with the next offset of the file.
+ *
+ * The block becomes idle if the whole file is already asked.
+ *
+ * @param reader The open file.
+ * @param block The block, it isn't used by the caller any more.
+ */
+static void askNextBlock(AsyncReader_t *reader, AsyncBlock_t *block)
+{
+    if (reader->next_offset < reader->size)
+    {
+        block->offset = reader->next_offset;
+        block->size = ((reader->size - reader->next_offset) < ASYNC_READER_BLOCK_SIZE) ?
+                      (uint32_t)(reader->size - reader->next_offset) : ASYNC_READER_BLOCK_SIZE;
+        block->count = 0;
+        reader->next_offset += block->size;
+        startBlockRead(reader, block);
+    }
+    else
+    {
+        block->count = 0;
+        block->state = ASYNC_BLOCK_IDLE;
+    }
+}
+
+#if defined(_WIN32)
+/**
+ * @brief This function opens the file and stores its size.
+ *
+ * The file is opened for overlapped reads, each read carries its own offset.
+ *
+ * @param reader The reader.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened.
+ */
+static int32_t openReaderFile(AsyncReader_t *reader, const char *path)
+{
+    int32_t error_code = 0;                 /* Error code, initialized to 0 */
+    HANDLE file_handle = INVALID_HANDLE_VALUE;  /* Handle of the opened file */
+    LARGE_INTEGER file_size;                /* Size of the file */
+
+    file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if ((file_handle == INVALID_HANDLE_VALUE) || !GetFileSizeEx(file_handle, &file_size))
+    {
+        error_code = 1;
+        if (file_handle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file_handle);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        reader->handle = (void *)file_handle;
+        reader->size = (uint64_t)file_size.QuadPart;
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function closes the file.
+ *
+ * @param reader The reader.
+ */
+static void closeReaderFile(AsyncReader_t *reader)
+{
+    if (reader->handle != NULL)
+    {
+        CloseHandle((HANDLE)reader->handle);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    reader->handle = NULL;
+}
+
+/**
+ * @brief This function sets up the backend of the reader.
+ *
+ * Every block gets a manual-reset event that is signaled when its read is complete.
+ *
+ * @param reader The reader with the open file.
+ * @return 0 if the backend is set up, 4 if there isn't enough memory.
+ */
+static int32_t startBackend(AsyncReader_t *reader)
+{
+    int32_t error_code = 0;                 /* Error code, initialized to 0 */
+    uint32_t i = 0;                         /* Loop counter */
+    OverlappedState_t *overlapped = (OverlappedState_t *)calloc(1, sizeof(OverlappedState_t));  /* The reads */
+
+    reader->backend = ASYNC_BACKEND_OVERLAPPED;
+    if (overlapped == NULL)
+    {
+        error_code = 4;
+    }
+    else
+    {
+        for (i = 0; i < ASYNC_READER_DEPTH; i++)
+        {
+            overlapped->reads[i].hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+            error_code = (overlapped->reads[i].hEvent == NULL) ? 4 : error_code;
+        }
+        reader->state = (void *)overlapped;
+        if (error_code != 0)
+        {
+            stopBackend(reader);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function releases the backend of the reader, no read is in flight.
+ *
+ * @param reader The reader.
+ */
+static void stopBackend(AsyncReader_t *reader)
+{
+    uint32_t i = 0;                         /* Loop counter */
+    OverlappedState_t *overlapped = (OverlappedState_t *)reader->state;     /* The reads */
+
+    if (overlapped != NULL)
+    {
+        for (i = 0; i < ASYNC_READER_DEPTH; i++)
+        {
+            if (overlapped->reads[i].hEvent != NULL)
+            {
+                CloseHandle(overlapped->reads[i].hEvent);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        free(overlapped);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    reader->state = NULL;
+}
+
+/**
+ * @brief This function starts the read of the rest of a block with the backend of the reader.
+ *
+ * A read that completes at once is still taken by GetOverlappedResult when the block is waited for.
+ *
+ * @param reader The open file.
+ * @param block The block, its offset, size and count are set.
+ */
+static void startBlockRead(AsyncReader_t *reader, AsyncBlock_t *block)
+{
+    uint64_t offset = block->offset + block->count;     /* The byte offset of the rest of the block */
+    OVERLAPPED *read = &(((OverlappedState_t *)reader->state)->reads[block - reader->blocks]);  /* The read */
+
+    read->Internal = 0;
+    read->InternalHigh = 0;
+    read->Offset = (DWORD)(offset & 0xFFFFFFFFU);
+    read->OffsetHigh = (DWORD)(offset >> 32);
+    ResetEvent(read->hEvent);
+    block->state = ASYNC_BLOCK_PENDING;
+    if (!ReadFile((HANDLE)reader->handle, block->data + block->count, block->size - block->count, NULL, read) &&
+        (GetLastError() != ERROR_IO_PENDING))
+    {
+        block->state = (GetLastError() == ERROR_HANDLE_EOF) ? ASYNC_BLOCK_READY : ASYNC_BLOCK_FAILED;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function waits until the read of a block is no longer in flight.
+ *
+ * A short read is continued with a new overlapped read of the rest of the block.
+ *
+ * @param reader The open file.
+ * @param block The block.
+ */
+static void waitBlockRead(AsyncReader_t *reader, AsyncBlock_t *block)
+{
+    DWORD count = 0;                /* The number of bytes of the completed read */
+    OVERLAPPED *read = &(((OverlappedState_t *)reader->state)->reads[block - reader->blocks]);  /* The read */
+
+    while (block->state == ASYNC_BLOCK_PENDING)
+    {
+        if (!GetOverlappedResult((HANDLE)reader->handle, read, &count, TRUE))
+        {
+            block->state = (GetLastError() == ERROR_HANDLE_EOF) ? ASYNC_BLOCK_READY : ASYNC_BLOCK_FAILED;
+        }
+        else
+        {
+            block->count += (uint32_t)count;
+            if ((count > 0) && (block->count < block->size))
+            {
+                startBlockRead(reader, block);
+            }
+            else
+            {
+                block->state = ASYNC_BLOCK_READY;
+            }
+        }
+    }
+}
+#else
+/**
+ * @brief This function opens the file and stores its size.
+ *
+ * @param reader The reader.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened.
+ */
+static int32_t openReaderFile(AsyncReader_t *reader, const char *path)
+{
+    int32_t error_code = 0;     /* Error code, initialized to 0 */
+    struct stat file_status;    /* Status of the file, to get its size */
+
+    reader->descriptor = open(path, O_RDONLY);
+    if ((reader->descriptor < 0) || (fstat(reader->descriptor, &file_status) != 0))
+    {
+        error_code = 1;
+        closeReaderFile(reader);
+    }
+    else
+    {
+        reader->size = (uint64_t)file_status.st_size;
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function closes the file.
+ *
+ * @param reader The reader.
+ */
+static void closeReaderFile(AsyncReader_t *reader)
+{
+    if (reader->descriptor >= 0)
+    {
+        close(reader->descriptor);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    reader->descriptor = -1;
+}
+
+/**
+ * @brief This function sets up the backend of the reader.
+ *
+ * The io_uring is tried first, the read-ahead thread is started if io_uring isn't available.
+ *
+ * @param reader The reader with the open file.
+ * @return 0 if the backend is set up, 4 if there isn't enough memory.
+ */
+static int32_t startBackend(AsyncReader_t *reader)
+{
+    int32_t error_code = 1;         /* Error code, 1 until a backend is set up */
+    ThreadState_t *thread = NULL;   /* The state of the read-ahead thread */
+
+#if ASYNC_READER_IO_URING
+    error_code = setupUring(reader);
+#endif
+    if (error_code == 1)
+    {
+        reader->backend = ASYNC_BACKEND_THREAD;
+        thread = (ThreadState_t *)calloc(1, sizeof(ThreadState_t));
+        if (thread == NULL)
+        {
+            error_code = 4;
+        }
+        else
+        {
+            pthread_mutex_init(&(thread->lock), NULL);
+            pthread_cond_init(&(thread->changed), NULL);
+            reader->state = (void *)thread;
+            if (pthread_create(&(thread->thread), NULL, readAhead, reader) != 0)
+            {
+                pthread_cond_destroy(&(thread->changed));
+                pthread_mutex_destroy(&(thread->lock));
+                free(thread);
+                reader->state = NULL;
+                error_code = 4;
+            }
+            else
+            {
+                error_code = 0;
+            }
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function releases the backend of the reader, no read is in flight.
+ *
+ * @param reader The reader.
+ */
+static void stopBackend(AsyncReader_t *reader)
+{
+    ThreadState_t *thread = NULL;   /* The state of the read-ahead thread */
+
+    if (reader->backend == ASYNC_BACKEND_THREAD)
+    {
+        thread = (ThreadState_t *)reader->state;
+        pthread_mutex_lock(&(thread->lock));
+        thread->stop = 1;
+        pthread_cond_broadcast(&(thread->changed));
+        pthread_mutex_unlock(&(thread->lock));
+        pthread_join(thread->thread, NULL);
+        pthread_cond_destroy(&(thread->changed));
+        pthread_mutex_destroy(&(thread->lock));
+        free(thread);
+    }
+    else
+    {
+#if ASYNC_READER_IO_URING
+        closeUring((UringState_t *)reader->state);
+        free(reader->state);
+#endif
+    }
+    reader->state = NULL;
+}
+
+/**
+ * @brief This function starts the read of the rest of a block with the backend of the reader.
+ *
+ * With io_uring, one vectored read is submitted. With the read-ahead thread, the block is marked pending
+ * and the thread is woken up.
+ *
+ * @param reader The open file.
+ * @param block The block, its offset, size and count are set.
+ */
+static void startBlockRead(AsyncReader_t *reader, AsyncBlock_t *block)
+{
+    ThreadState_t *thread = NULL;   /* The state of the read-ahead thread */
+#if ASYNC_READER_IO_URING
+    uint32_t index = (uint32_t)(block - reader->blocks);    /* The index of the block */
+    uint32_t tail = 0;              /* The tail of the submission ring */
+    struct io_uring_sqe *entry = NULL;  /* The submission queue entry of the read */
+    UringState_t *uring = NULL;     /* The io_uring */
+    long submitted = -1;            /* The result of io_uring_enter */
+#endif
+
+    if (reader->backend == ASYNC_BACKEND_THREAD)
+    {
+        thread = (ThreadState_t *)reader->state;
+        pthread_mutex_lock(&(thread->lock));
+        block->state = ASYNC_BLOCK_PENDING;
+        pthread_cond_broadcast(&(thread->changed));
+        pthread_mutex_unlock(&(thread->lock));
+    }
+    else
+    {
+#if ASYNC_READER_IO_URING
+        uring = (UringState_t *)reader->state;
+        uring->vectors[index].iov_base = block->data + block->count;
+        uring->vectors[index].iov_len = block->size - block->count;
+        /* Fill the next entry, then publish it to the kernel by moving the tail */
+        tail = *(uring->submission_tail);
+        entry = &(uring->entries[tail & uring->submission_mask]);
+        memset(entry, 0, sizeof(struct io_uring_sqe));
+        entry->opcode = IORING_OP_READV;
+        entry->fd = reader->descriptor;
+        entry->addr = (uint64_t)(uintptr_t)&(uring->vectors[index]);
+        entry->len = 1;
+        entry->off = block->offset + block->count;
+        entry->user_data = index;
+        uring->submission_array[tail & uring->submission_mask] = tail & uring->submission_mask;
+        __atomic_store_n(uring->submission_tail, tail + 1, __ATOMIC_RELEASE);
+        block->state = ASYNC_BLOCK_PENDING;
+        while ((submitted < 0) && (block->state == ASYNC_BLOCK_PENDING))
+        {
+            submitted = syscall(__NR_io_uring_enter, uring->ring, 1, 0, 0, NULL, 0);
+            if ((submitted < 0) && (errno != EINTR) && (errno != EAGAIN))
+            {
+                block->state = ASYNC_BLOCK_FAILED;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+#endif
+    }
+}
+
+/**
+ * @brief This function waits until the read of a block is no longer in flight.
+ *
+ * With io_uring, the completions of all blocks are taken until the block isn't pending,
+ * a short read is submitted again for the rest of its block.
+ *
+ * @param reader The open file.
+ * @param block The block.
+ */
+static void waitBlockRead(AsyncReader_t *reader, AsyncBlock_t *block)
+{
+    ThreadState_t *thread = NULL;   /* The state of the read-ahead thread */
+
+    if (reader->backend == ASYNC_BACKEND_THREAD)
+    {
+        thread = (ThreadState_t *)reader->state;
+        pthread_mutex_lock(&(thread->lock));
+        while (block->state == ASYNC_BLOCK_PENDING)
+        {
+            pthread_cond_wait(&(thread->changed), &(thread->lock));
+        }
+        pthread_mutex_unlock(&(thread->lock));
+    }
+    else
+    {
+#if ASYNC_READER_IO_URING
+        while (block->state == ASYNC_BLOCK_PENDING)
+        {
+            if (takeUringCompletions(reader) != 0)
+            {
+                block->state = ASYNC_BLOCK_FAILED;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+#endif
+    }
+}
+
+/**
+ * @brief This function reads the pending blocks in the order of the ring until it is stopped.
+ *
+ * The lock is only held to look at the states, the reads are done without it.
+ *
+ * @param argument The reader.
+ * @return NULL.
+ */
+static void *readAhead(void *argument)
+{
+    AsyncReader_t *reader = (AsyncReader_t *)argument;              /* The reader */
+    ThreadState_t *thread = (ThreadState_t *)reader->state;         /* The state of the thread */
+    uint32_t index = 0;             /* The index of the next block read by the thread */
+    int8_t running = 1;             /* Initialize a flag to indicate if the thread goes on */
+    ssize_t count = 1;              /* The number of bytes of one read */
+    AsyncBlock_t *block = NULL;     /* Pointer to the block read */
+
+    while (running)
+    {
+        block = &(reader->blocks[index]);
+        pthread_mutex_lock(&(thread->lock));
+        while (!thread->stop && (block->state != ASYNC_BLOCK_PENDING))
+        {
+            pthread_cond_wait(&(thread->changed), &(thread->lock));
+        }
+        running = !thread->stop;
+        pthread_mutex_unlock(&(thread->lock));
+        if (running)
+        {
+            /* Read the block, pread may return fewer bytes than asked */
+            count = 1;
+            while ((block->count < block->size) && (count > 0))
+            {
+                count = pread(reader->descriptor, block->data + block->count, block->size - block->count,
+                              (off_t)(block->offset + block->count));
+                if (count > 0)
+                {
+                    block->count += (uint32_t)count;
+                }
+                else if ((count < 0) && (errno == EINTR))
+                {
+                    count = 1;
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+            pthread_mutex_lock(&(thread->lock));
+            block->state = (count < 0) ? ASYNC_BLOCK_FAILED : ASYNC_BLOCK_READY;
+            pthread_cond_broadcast(&(thread->changed));
+            pthread_mutex_unlock(&(thread->lock));
+            index = (index + 1) % ASYNC_READER_DEPTH;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    return NULL;
+}
+
+#if ASYNC_READER_IO_URING
+/**
+ * @brief This function sets up an io_uring with one submission queue entry per block.
+ *
+ * The submission ring, the completion ring and the submission queue entries are mapped separately,
+ * which every kernel with io_uring supports.
+ *
+ * @param reader The reader, the state of the io_uring is stored in it.
+ * @return 0 if the io_uring is set up, 1 if io_uring isn't available, 4 if there isn't enough memory.
+ */
+static int32_t setupUring(AsyncReader_t *reader)
+{
+    int32_t error_code = 0;         /* Error code, initialized to 0 */
+    void *mapping = NULL;           /* The result of a mapping */
+    UringState_t *uring = (UringState_t *)calloc(1, sizeof(UringState_t));  /* The io_uring */
+
+    struct io_uring_params parameters;  /* Declaring the parameters of the io_uring */
+
+    memset(&parameters, 0, sizeof(parameters));
+    if (uring == NULL)
+    {
+        error_code = 4;
+    }
+    else
+    {
+        uring->ring = (int32_t)syscall(__NR_io_uring_setup, ASYNC_READER_DEPTH, &parameters);
+        error_code = (uring->ring < 0) ? 1 : 0;
+    }
+    /* Map the rings */
+    if (error_code == 0)
+    {
+        uring->submission_ring_size = parameters.sq_off.array + (parameters.sq_entries * sizeof(uint32_t));
+        mapping = mmap(NULL, uring->submission_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       uring->ring, IORING_OFF_SQ_RING);
+        uring->submission_ring = (mapping != MAP_FAILED) ? (uint8_t *)mapping : NULL;
+        uring->completion_ring_size = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(struct io_uring_cqe));
+        mapping = mmap(NULL, uring->completion_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       uring->ring, IORING_OFF_CQ_RING);
+        uring->completion_ring = (mapping != MAP_FAILED) ? (uint8_t *)mapping : NULL;
+        uring->entries_size = parameters.sq_entries * sizeof(struct io_uring_sqe);
+        mapping = mmap(NULL, uring->entries_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       uring->ring, IORING_OFF_SQES);
+        uring->entries = (mapping != MAP_FAILED) ? (struct io_uring_sqe *)mapping : NULL;
+        if ((uring->submission_ring == NULL) || (uring->completion_ring == NULL) || (uring->entries == NULL))
+        {
+            error_code = 1;
+        }
+        else
+        {
+            uring->submission_tail = (uint32_t *)(uring->submission_ring + parameters.sq_off.tail);
+            uring->submission_mask = *(uint32_t *)(uring->submission_ring + parameters.sq_off.ring_mask);
+            uring->submission_array = (uint32_t *)(uring->submission_ring + parameters.sq_off.array);
+            uring->completion_head = (uint32_t *)(uring->completion_ring + parameters.cq_off.head);
+            uring->completion_tail = (uint32_t *)(uring->completion_ring + parameters.cq_off.tail);
+            uring->completion_mask = *(uint32_t *)(uring->completion_ring + parameters.cq_off.ring_mask);
+            uring->completions = (struct io_uring_cqe *)(uring->completion_ring + parameters.cq_off.cqes);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Keep the io_uring or release what is set up */
+    if (error_code == 0)
+    {
+        reader->backend = ASYNC_BACKEND_IO_URING;
+        reader->state = (void *)uring;
+    }
+    else if (uring != NULL)
+    {
+        closeUring(uring);
+        free(uring);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function takes the completions of the io_uring, waiting for one if there are none.
+ *
+ * A completed read adds its bytes to its block. The block is ready when it is full or when the read
+ * returns 0 bytes at the end of the file, otherwise the rest of the block is submitted again.
+ *
+ * @param reader The reader.
+ * @return 0 if the completions are taken, 1 if the wait failed.
+ */
+static int32_t takeUringCompletions(AsyncReader_t *reader)
+{
+    int32_t error_code = 0;         /* Error code, initialized to 0 */
+    UringState_t *uring = (UringState_t *)reader->state;    /* The io_uring */
+    uint32_t head = *(uring->completion_head);              /* The head of the completion ring */
+    uint32_t tail = __atomic_load_n(uring->completion_tail, __ATOMIC_ACQUIRE);  /* The tail of the completion ring */
+    struct io_uring_cqe *completion = NULL;     /* The current completion */
+    AsyncBlock_t *block = NULL;     /* The block of the current completion */
+
+    if (head == tail)
+    {
+        if ((syscall(__NR_io_uring_enter, uring->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0) &&
+            (errno != EINTR))
+        {
+            error_code = 1;
+        }
+        else
+        {
+            tail = __atomic_load_n(uring->completion_tail, __ATOMIC_ACQUIRE);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    while (head != tail)
+    {
+        completion = &(uring->completions[head & uring->completion_mask]);
+        block = &(reader->blocks[completion->user_data]);
+        if ((completion->res == -EINTR) || (completion->res == -EAGAIN))
+        {
+            block->state = ASYNC_BLOCK_IDLE;
+        }
+        else if (completion->res < 0)
+        {
+            block->state = ASYNC_BLOCK_FAILED;
+        }
+        else
+        {
+            block->count += (uint32_t)completion->res;
+            block->state = ((completion->res > 0) && (block->count < block->size)) ? ASYNC_BLOCK_IDLE :
+                           ASYNC_BLOCK_READY;
+        }
+        head += 1;
+        __atomic_store_n(uring->completion_head, head, __ATOMIC_RELEASE);
+        /* A block left idle has the rest of its bytes to read */
+        if (block->state == ASYNC_BLOCK_IDLE)
+        {
+            startBlockRead(reader, block);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function releases the rings and the file descriptor of an io_uring.
+ *
+ * @param uring The io_uring, the mappings that aren't made are NULL.
+ */
+static void closeUring(UringState_t *uring)
+{
+    if (uring->entries != NULL)
+    {
+        munmap(uring->entries, uring->entries_size);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (uring->completion_ring != NULL)
+    {
+        munmap(uring->completion_ring, uring->completion_ring_size);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (uring->submission_ring != NULL)
+    {
+        munmap(uring->submission_ring, uring->submission_ring_size);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (uring->ring >= 0)
+    {
+        close(uring->ring);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+#endif
+#endif /* EOF */
@@ -0,0 +1,134 @@
+/**
+ * @file async_reader.h
+ * @brief This file contains the prototypes of the asynchronous reader functions.
+ *
+ * The asynchronous reader reads a file in large blocks with several reads in flight: while the upper layer
+ * parses one block, the next blocks are read by the operating system, so the time of the reads is hidden
+ * behind the time of the parse instead of being added to it.
+ * It provides function openAsyncReader to start the reads, function readAsyncBlock to get the blocks
+ * in the order of the file and function closeAsyncReader to stop the reads.
+ * The reads use io_uring on Linux, overlapped ReadFile on Windows and a read-ahead thread with pread on the
+ * other POSIX systems, or on Linux when io_uring isn't available (an old kernel or a sandbox that blocks it).
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef ASYNC_READER_H
+#define ASYNC_READER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef ASYNC_READER_IO_URING
+#if defined(__linux__)
+#define ASYNC_READER_IO_URING 1     /* 1 to read with io_uring, 0 to always use the read-ahead thread */
+#else
+#define ASYNC_READER_IO_URING 0     /* 1 to read with io_uring, 0 to always use the read-ahead thread */
+#endif
+#endif
+
+#define ASYNC_READER_BLOCK_SIZE     (1024 * 1024)   /* The number of bytes of one block */
+#define ASYNC_READER_DEPTH          4               /* The number of blocks, all but the one parsed are read in flight */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief The ways of reading the blocks.
+ */
+typedef enum
+{
+    ASYNC_BACKEND_IO_URING = 0,     /* Reads submitted to an io_uring of the Linux kernel */
+    ASYNC_BACKEND_OVERLAPPED,       /* Overlapped ReadFile of Windows */
+    ASYNC_BACKEND_THREAD            /* A read-ahead thread that reads the blocks with pread */
+} AsyncBackend_t;
+
+/**
+ * @brief The states of a block.
+ */
+typedef enum
+{
+    ASYNC_BLOCK_IDLE = 0,           /* The block isn't read, it is behind the end of the file or given to the caller */
+    ASYNC_BLOCK_PENDING,            /* The read of the block is in flight */
+    ASYNC_BLOCK_READY,              /* The block is read */
+    ASYNC_BLOCK_FAILED              /* The read of the block failed */
+} AsyncBlockState_t;
+
+/**
+ * @brief Structure to hold one block of the file.
+ */
+typedef struct
+{
+    int8_t *data;                   /* The buffer of the block, ASYNC_READER_BLOCK_SIZE bytes */
+    uint64_t offset;                /* The byte offset in the file of the first byte of the block */
+    uint32_t size;                  /* The number of bytes asked */
+    uint32_t count;                 /* The number of bytes read, a short read is continued until count is size */
+    volatile AsyncBlockState_t state;   /* The state of the block, also changed by the read-ahead thread */
+} AsyncBlock_t;
+
+/**
+ * @brief Structure to hold a file read by blocks with several reads in flight.
+ *
+ * The blocks are used as a ring: a block given to the caller is read again with the next offset
+ * of the file at the next call of readAsyncBlock.
+ */
+typedef struct
+{
+    AsyncBackend_t backend;         /* The way of reading the blocks */
+    void *handle;                   /* The file handle of the operating system (Windows only) */
+    int32_t descriptor;             /* The file descriptor (POSIX only) */
+    uint64_t size;                  /* The number of bytes of the file when it is opened */
+    uint64_t next_offset;           /* The byte offset of the next block to read */
+    uint32_t next_block;            /* The index of the next block given to the caller */
+    int8_t block_given;             /* 1 if the block in front of next_block is used by the caller */
+    int8_t failed;                  /* 1 if a read failed, the blocks behind it aren't given */
+    uint64_t wait_time;             /* Time the caller waited for a block, in nanoseconds */
+    void *state;                    /* The state of the backend (rings of io_uring, thread or overlapped reads) */
+    int8_t *buffer;                 /* The memory of all blocks */
+    AsyncBlock_t blocks[ASYNC_READER_DEPTH];    /* The blocks */
+} AsyncReader_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function opens a file and starts the reads of its first blocks.
+ *
+ * With io_uring, the reader falls back to the read-ahead thread if the ring can't be set up.
+ *
+ * @param reader The structure to store the open file.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened, 4 if there isn't enough memory for the blocks.
+ */
+int32_t openAsyncReader(AsyncReader_t *reader, const char *path);
+
+/**
+ * @brief This function gives the next block of the file.
+ *
+ * The block given by the last call is read again with the next offset of the file, then the function waits
+ * until the read of the next block in the order of the file is complete.
+ * The block stays valid until the next call of readAsyncBlock or closeAsyncReader.
+ *
+ * @param reader The open file.
+ * @param data Pointer to store the pointer to the bytes of the block.
+ * @param size Pointer to store the number of bytes of the block.
+ * @return 1 if a block is given, 0 at the end of the file or if a read failed (failed is set).
+ */
+int32_t readAsyncBlock(AsyncReader_t *reader, const int8_t **data, uint32_t *size);
+
+/**
+ * @brief This function waits for the reads in flight and closes the file.
+ *
+ * @param reader The open file.
+ */
+void closeAsyncReader(AsyncReader_t *reader);
+
+#endif /* ASYNC_READER_H */
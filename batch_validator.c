@@ -0,0 +1,608 @@
+/**
+ * @file batch_validator.c
+ * @brief This file contains the implementation of the batch validator functions.
+ *
+ * The workers share a queue which is the index of the next file of the list, protected by a mutex.
+ * A worker takes one file at a time and validates it with validateIntelHexFileCached and its own context,
+ * so the workers only share the queue and the result cache. The calling thread is also a worker,
+ * the batch is still validated if no thread can be created.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "batch_validator.h"   /* Include header file of this function file */
+#include "record_handler.h"    /* Include header file of the record handler of lower layer */
+#include "line_reader.h"       /* Include header file of the line reader of lower layer */
+#include "hex_decoder.h"       /* Include header file of the hexadecimal decoder of lower layer */
+#include <stdlib.h>            /* For malloc(), realloc(), free(), qsort() functions */
+#include <string.h>            /* For memcpy(), strlen(), strcmp() functions */
+#include <ctype.h>             /* For tolower() function */
+#include <pthread.h>           /* For pthread_create(), pthread_join(), pthread_mutex_lock() functions */
+#if defined(_WIN32)
+#include <windows.h>           /* For FindFirstFileA(), QueryPerformanceCounter() functions */
+#else
+#include <dirent.h>            /* For opendir(), readdir() functions */
+#include <sys/stat.h>          /* For stat(), lstat() functions */
+#include <time.h>              /* For clock_gettime() function */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BATCH_MIN_ENTRIES       64      /* The number of entries of the first allocation */
+#if defined(_WIN32)
+#define BATCH_PATH_SEPARATOR    '\\'    /* The separator of the directories of a path */
+#else
+#define BATCH_PATH_SEPARATOR    '/'     /* The separator of the directories of a path */
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the queue of the files shared by the workers.
+ */
+typedef struct
+{
+    BatchList_t *list;              /* The list of files */
+    ResultCache_t *cache;           /* The result cache, NULL if there is none */
+    uint32_t next;                  /* The index of the next file to validate */
+    pthread_mutex_t lock;           /* The mutex protecting the index */
+#if HEX_STATISTICS
+    HexStatistics_t statistics;     /* The statistics of the workers that are done, protected by the mutex */
+#endif
+} BatchQueue_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void *validateBatchFiles(void *argument);
+static void validateBatchEntry(HexContext_t *context, ResultCache_t *cache, BatchEntry_t *entry);
+static int32_t addDirectoryFiles(BatchList_t *list, const char *directory, uint32_t depth);
+static int32_t addDirectoryEntry(BatchList_t *list, const char *directory, const char *name, int8_t is_directory,
+                                 uint32_t depth);
+static int8_t hasHexExtension(const char *name);
+static int compareEntries(const void *first, const void *second);
+static double getTime(void);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function initializes an empty list of files.
+ *
+ * @param list The list to initialize.
+ */
+void initBatchList(BatchList_t *list)
+{
+    list->entries = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+/**
+ * @brief This function adds a file to the list.
+ *
+ * The path is copied. The capacity of the list is doubled when it is full.
+ *
+ * @param list The list of files.
+ * @param path The path of the file.
+ * @return 0 if the file is added, 4 if there isn't enough memory.
+ */
+int32_t addBatchFile(BatchList_t *list, const char *path)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+    uint32_t capacity = 0;                  /* The new number of allocated entries */
+    size_t length = strlen(path);           /* The number of characters of the path */
+    BatchEntry_t *entries = NULL;           /* Pointer to the new entries */
+    char *copy = NULL;                      /* Pointer to the copy of the path */
+
+    if (list->count == list->capacity)
+    {
+        capacity = (list->capacity == 0) ? BATCH_MIN_ENTRIES : list->capacity * 2;
+        entries = (BatchEntry_t *)realloc(list->entries, (size_t)capacity * sizeof(BatchEntry_t));
+        if (entries != NULL)
+        {
+            list->entries = entries;
+            list->capacity = capacity;
+        }
+        else
+        {
+            status = 4;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (status == 0)
+    {
+        copy = (char *)malloc(length + 1);
+        if (copy != NULL)
+        {
+            memcpy(copy, path, length + 1);
+            memset(&(list->entries[list->count]), 0, sizeof(BatchEntry_t));
+            list->entries[list->count].path = copy;
+            list->count += 1;
+        }
+        else
+        {
+            status = 4;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return status;
+}
+
+/**
+ * @brief This function adds the files of a list file to the list.
+ *
+ * The list file has one path per line, empty lines are skipped.
+ *
+ * @param list The list of files.
+ * @param list_path The path of the list file.
+ * @return 0 if the files are added, 3 if the list file can't be opened, 4 if there isn't enough memory.
+ */
+int32_t readBatchListFile(BatchList_t *list, const char *list_path)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+    int8_t *line = NULL;                    /* Pointer to the current line */
+    uint32_t length = 0;                    /* The number of characters of the current line */
+    FILE *fptr = fopen(list_path, "rb");    /* Declaring a file pointer and opening the list file */
+    LineReader_t *reader = NULL;            /* Declaring the line reader of the list file */
+
+    if (fptr == NULL)
+    {
+        status = 3;
+    }
+    else
+    {
+        /* The line reader has a large buffer, it is allocated instead of being on the stack */
+        reader = (LineReader_t *)malloc(sizeof(LineReader_t));
+        if (reader == NULL)
+        {
+            status = 4;
+        }
+        else
+        {
+            openLineReader(reader, fptr);
+            while ((status == 0) && readLine(reader, &line, &length))
+            {
+                /* Remove the carriage return of a CR LF line terminator */
+                if ((length > 0) && (line[length - 1] == '\r'))
+                {
+                    length -= 1;
+                    line[length] = '\0';
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+                if (length > 0)
+                {
+                    status = addBatchFile(list, (const char *)line);
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+            free(reader);
+        }
+        fclose(fptr);
+    }
+    return status;
+}
+
+/**
+ * @brief This function adds the *.hex files of a directory and of its subdirectories to the list.
+ *
+ * The files of a directory are added sorted by path, so the order doesn't depend on the file system.
+ * Subdirectories deeper than BATCH_MAX_DEPTH are skipped.
+ *
+ * @param list The list of files.
+ * @param directory The path of the directory.
+ * @return 0 if the files are added, 3 if the directory can't be opened, 4 if there isn't enough memory.
+ */
+int32_t addBatchDirectory(BatchList_t *list, const char *directory)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+    uint32_t first = list->count;           /* The index of the first file of the directory */
+
+    status = addDirectoryFiles(list, directory, 0);
+    if (list->count - first > 1)
+    {
+        qsort(list->entries + first, list->count - first, sizeof(BatchEntry_t), compareEntries);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return status;
+}
+
+/**
+ * @brief This function validates all files of the list with a pool of worker threads.
+ *
+ * The result and report of each file are stored in its entry. The calling thread is the first worker,
+ * a worker that can't be started leaves its files to the other workers.
+ *
+ * @param list The list of files.
+ * @param thread_count The number of worker threads, 0 to use one thread per processor.
+ * @param cache The result cache shared by the workers, NULL to validate every file.
+ * @param summary The structure to store the aggregate statistics.
+ * @return 0 if all files are valid, 1 if at least one file isn't valid or can't be opened.
+ */
+int32_t validateIntelHexBatch(BatchList_t *list, uint32_t thread_count, ResultCache_t *cache, BatchSummary_t *summary)
+{
+    uint32_t i = 0;                         /* Loop counter */
+    uint32_t worker_count = 0;              /* Number of workers, with the calling thread */
+    double start = getTime();               /* The time of the beginning of the validation */
+    BatchQueue_t queue;                     /* Declaring the queue of the files */
+    pthread_t threads[BATCH_MAX_THREADS];   /* Declaring the threads */
+    int8_t started[BATCH_MAX_THREADS];      /* Flags of the threads that are started */
+
+    /* Use one worker per processor, at most one worker per file */
+    worker_count = (thread_count == 0) ? getProcessorCount() : thread_count;
+    if (worker_count > BATCH_MAX_THREADS)
+    {
+        worker_count = BATCH_MAX_THREADS;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (worker_count > list->count)
+    {
+        worker_count = (list->count > 0) ? list->count : 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    queue.list = list;
+    queue.cache = cache;
+    queue.next = 0;
+    pthread_mutex_init(&(queue.lock), NULL);
+#if HEX_STATISTICS
+    clearHexStatistics(&(queue.statistics));
+#endif
+
+    /* Resolve the kernel of the hexadecimal decoder before the threads use it */
+    getHexKernelName();
+
+    /* Validate the files, this thread is the first worker */
+    for (i = 1; i < worker_count; i++)
+    {
+        started[i] = (pthread_create(&threads[i], NULL, validateBatchFiles, &queue) == 0);
+    }
+    validateBatchFiles(&queue);
+    for (i = 1; i < worker_count; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    pthread_mutex_destroy(&(queue.lock));
+
+    /* Aggregate the results of the files */
+    memset(summary, 0, sizeof(BatchSummary_t));
+    summary->file_count = list->count;
+    summary->thread_count = worker_count;
+#if HEX_STATISTICS
+    summary->statistics = queue.statistics;
+#endif
+    for (i = 0; i < list->count; i++)
+    {
+        if (list->entries[i].result == 0)
+        {
+            summary->valid_count += 1;
+        }
+        else if (list->entries[i].result == 1)
+        {
+            summary->record_error_count += 1;
+        }
+        else if (list->entries[i].result == 2)
+        {
+            summary->eof_error_count += 1;
+        }
+        else
+        {
+            summary->open_error_count += 1;
+        }
+        summary->cached_count += list->entries[i].cached;
+        summary->byte_count += list->entries[i].size;
+        summary->line_count += list->entries[i].report.line_count;
+    }
+    summary->elapsed_seconds = getTime() - start;
+    return (summary->valid_count == summary->file_count) ? 0 : 1;
+}
+
+/**
+ * @brief This function frees the list of files.
+ *
+ * @param list The list to free, it is empty after the call.
+ */
+void freeBatchList(BatchList_t *list)
+{
+    uint32_t i = 0;                 /* Loop counter */
+
+    for (i = 0; i < list->count; i++)
+    {
+        free(list->entries[i].path);
+    }
+    free(list->entries);
+    initBatchList(list);
+}
+
+/**
+ * @brief This function is one worker of a batch, it validates the files of the queue until it is empty.
+ *
+ * @param argument The queue of the files.
+ * @return NULL.
+ */
+static void *validateBatchFiles(void *argument)
+{
+    BatchQueue_t *queue = (BatchQueue_t *)argument;  /* The queue of the files */
+    uint32_t index = 0;             /* The index of the file taken from the queue */
+    HexContext_t context;           /* Declaring the context of the worker */
+
+    initHexContext(&context, NULL);
+    do
+    {
+        /* Take the next file of the queue */
+        pthread_mutex_lock(&(queue->lock));
+        index = queue->next;
+        if (index < queue->list->count)
+        {
+            queue->next += 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        pthread_mutex_unlock(&(queue->lock));
+
+        if (index < queue->list->count)
+        {
+            resetHexContext(&context);
+            validateBatchEntry(&context, queue->cache, &(queue->list->entries[index]));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    } while (index < queue->list->count);
+#if HEX_STATISTICS
+    /* Every worker counts in its own context, the counters are added together once at the end */
+    pthread_mutex_lock(&(queue->lock));
+    mergeHexStatistics(&(queue->statistics), &(context.statistics));
+    pthread_mutex_unlock(&(queue->lock));
+#endif
+    return NULL;
+}
+
+/**
+ * @brief This function validates one file of a batch.
+ *
+ * The file is validated with validateIntelHexFileCached, the segments of the memory image aren't needed.
+ *
+ * @param context The context of the worker.
+ * @param cache The result cache, NULL if there is none.
+ * @param entry The file, its result, size and report are set by the function.
+ */
+static void validateBatchEntry(HexContext_t *context, ResultCache_t *cache, BatchEntry_t *entry)
+{
+    CachedResult_t result;          /* Declaring the result of the file */
+
+    entry->result = validateIntelHexFileCached(cache, context, entry->path, 0, &result);
+    entry->size = result.size;
+    entry->report = result.report;
+    entry->cached = result.cached;
+    freeCachedResult(&result);
+}
+
+/**
+ * @brief This function adds the *.hex files of a directory and of its subdirectories to the list.
+ *
+ * A subdirectory that can't be opened is skipped.
+ *
+ * @param list The list of files.
+ * @param directory The path of the directory.
+ * @param depth The depth of the directory below the directory given to addBatchDirectory.
+ * @return 0 if the files are added, 3 if the directory can't be opened, 4 if there isn't enough memory.
+ */
+static int32_t addDirectoryFiles(BatchList_t *list, const char *directory, uint32_t depth)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+#if defined(_WIN32)
+    size_t length = strlen(directory);      /* The number of characters of the path of the directory */
+    char *pattern = (char *)malloc(length + 3);     /* The search pattern of the files of the directory */
+    HANDLE find = INVALID_HANDLE_VALUE;     /* The handle of the search */
+    WIN32_FIND_DATAA data;                  /* The information of the current file */
+
+    if (pattern == NULL)
+    {
+        status = 4;
+    }
+    else
+    {
+        memcpy(pattern, directory, length);
+        pattern[length] = BATCH_PATH_SEPARATOR;
+        pattern[length + 1] = '*';
+        pattern[length + 2] = '\0';
+        find = FindFirstFileA(pattern, &data);
+        free(pattern);
+        if (find == INVALID_HANDLE_VALUE)
+        {
+            status = 3;
+        }
+        else
+        {
+            do
+            {
+                status = addDirectoryEntry(list, directory, data.cFileName,
+                                           (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0, depth);
+            } while ((status != 4) && FindNextFileA(find, &data));
+            FindClose(find);
+        }
+    }
+#else
+    DIR *handle = opendir(directory);       /* The handle of the directory */
+    struct dirent *entry = NULL;            /* The current file of the directory */
+
+    if (handle == NULL)
+    {
+        status = 3;
+    }
+    else
+    {
+        entry = readdir(handle);
+        while ((status != 4) && (entry != NULL))
+        {
+            status = addDirectoryEntry(list, directory, entry->d_name, -1, depth);
+            entry = readdir(handle);
+        }
+        closedir(handle);
+    }
+#endif
+    return (status == 4) ? 4 : ((status == 3) && (depth == 0)) ? 3 : 0;
+}
+
+/**
+ * @brief This function adds one file of a directory to the list, or the files of a subdirectory.
+ *
+ * The entries "." and ".." are skipped. On POSIX systems a symbolic link to a directory isn't followed,
+ * so a link loop can't make the search endless.
+ *
+ * @param list The list of files.
+ * @param directory The path of the directory.
+ * @param name The name of the file in the directory.
+ * @param is_directory 1 if the file is a directory, 0 if not, -1 if it isn't known yet.
+ * @param depth The depth of the directory.
+ * @return 0 if the file is added or skipped, 3 if a subdirectory can't be opened, 4 if there isn't enough memory.
+ */
+static int32_t addDirectoryEntry(BatchList_t *list, const char *directory, const char *name, int8_t is_directory,
+                                 uint32_t depth)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+    int8_t is_file = 1;                     /* Initialize a flag to indicate if the file is a regular file */
+    size_t directory_length = strlen(directory);    /* The number of characters of the path of the directory */
+    size_t name_length = strlen(name);      /* The number of characters of the name of the file */
+    char *path = NULL;                      /* The path of the file */
+#if !defined(_WIN32)
+    struct stat information;                /* The information of the file */
+#endif
+
+    if ((strcmp(name, ".") == 0) || (strcmp(name, "..") == 0))
+    {
+        /* Do nothing */
+    }
+    else
+    {
+        path = (char *)malloc(directory_length + name_length + 2);
+        if (path == NULL)
+        {
+            status = 4;
+        }
+        else
+        {
+            memcpy(path, directory, directory_length);
+            path[directory_length] = BATCH_PATH_SEPARATOR;
+            memcpy(path + directory_length + 1, name, name_length + 1);
+#if !defined(_WIN32)
+            /* Get the type of the file, lstat doesn't follow a symbolic link, stat gives the type of its target */
+            is_directory = (lstat(path, &information) == 0) && S_ISDIR(information.st_mode);
+            is_file = (stat(path, &information) == 0) && S_ISREG(information.st_mode);
+#endif
+            if (is_directory)
+            {
+                if (depth < BATCH_MAX_DEPTH)
+                {
+                    status = addDirectoryFiles(list, path, depth + 1);
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+            else if (is_file && hasHexExtension(name))
+            {
+                status = addBatchFile(list, path);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            free(path);
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief This function checks if the name of a file ends with ".hex", in any case.
+ *
+ * @param name The name of the file.
+ * @return 1 if the name ends with ".hex", 0 otherwise.
+ */
+static int8_t hasHexExtension(const char *name)
+{
+    const char *extension = ".hex";         /* The extension of the Intel Hex files */
+    size_t length = strlen(name);           /* The number of characters of the name */
+    int8_t matches = (length > 4);          /* Initialize a flag to indicate if the extension matches */
+    uint32_t i = 0;                         /* Loop counter */
+
+    for (i = 0; (i < 4) && matches; i++)
+    {
+        matches = (tolower((unsigned char)name[length - 4 + i]) == extension[i]);
+    }
+    return matches;
+}
+
+/**
+ * @brief This function compares the paths of two files of a batch for qsort.
+ *
+ * @param first The first file.
+ * @param second The second file.
+ * @return A negative number, 0 or a positive number like strcmp.
+ */
+static int compareEntries(const void *first, const void *second)
+{
+    return strcmp(((const BatchEntry_t *)first)->path, ((const BatchEntry_t *)second)->path);
+}
+
+/**
+ * @brief This function returns the time of a monotonic clock.
+ *
+ * @return The time in seconds.
+ */
+static double getTime(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;          /* The value of the performance counter */
+    LARGE_INTEGER frequency;        /* The frequency of the performance counter */
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;            /* The time of the monotonic clock */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+#endif
+} /* EOF */
@@ -0,0 +1,144 @@
+/**
+ * @file batch_validator.h
+ * @brief This file contains the prototypes of the batch validator functions.
+ *
+ * The batch validator validates many Intel Hex files in one invocation. The files are given one by one,
+ * by a list file with one path per line or by a directory searched for *.hex files.
+ * Function validateIntelHexBatch validates the files with a pool of worker threads, each worker takes the next
+ * file of the list when it has finished its file, so the files are balanced over the threads even if their sizes
+ * differ. Each worker has its own context, the results are stored in the entries of the list in list order.
+ * With a result cache, the files whose result is in the cache aren't validated again.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "result_cache.h"              /* Include header file of the result cache */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef BATCH_VALIDATOR_H
+#define BATCH_VALIDATOR_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BATCH_MAX_THREADS       64      /* Maximum number of worker threads of a batch */
+#define BATCH_MAX_DEPTH         32      /* Maximum depth of the subdirectories searched by addBatchDirectory */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold one file of a batch and the result of its validation.
+ */
+typedef struct
+{
+    char *path;                     /* The path of the file */
+    int32_t result;                 /* 0 if the file is valid, 1 record error, 2 End-Of-File error, 3 can't open */
+    uint64_t size;                  /* The number of bytes of the file */
+    FileReport_t report;            /* The report of the validation */
+    int8_t cached;                  /* 1 if the result is found in the result cache */
+} BatchEntry_t;
+
+/**
+ * @brief Structure to hold the list of files of a batch.
+ */
+typedef struct
+{
+    BatchEntry_t *entries;          /* The files, in the order they are added */
+    uint32_t count;                 /* The number of files */
+    uint32_t capacity;              /* The number of allocated entries */
+} BatchList_t;
+
+/**
+ * @brief Structure to hold the aggregate statistics of a batch.
+ */
+typedef struct
+{
+    uint32_t file_count;            /* The number of files */
+    uint32_t valid_count;           /* The number of valid files */
+    uint32_t record_error_count;    /* The number of files with an invalid record */
+    uint32_t eof_error_count;       /* The number of files with an invalid End-Of-File record */
+    uint32_t open_error_count;      /* The number of files that can't be opened */
+    uint32_t cached_count;          /* The number of files whose result is found in the result cache */
+    uint64_t byte_count;            /* The number of bytes of all files */
+    uint64_t line_count;            /* The number of lines of all files */
+    uint32_t thread_count;          /* The number of worker threads */
+    double elapsed_seconds;         /* The time of the validation of all files */
+#if HEX_STATISTICS
+    HexStatistics_t statistics;     /* The statistics of the workers, added together */
+#endif
+} BatchSummary_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function initializes an empty list of files.
+ *
+ * @param list The list to initialize.
+ */
+void initBatchList(BatchList_t *list);
+
+/**
+ * @brief This function adds a file to the list.
+ *
+ * The path is copied.
+ *
+ * @param list The list of files.
+ * @param path The path of the file.
+ * @return 0 if the file is added, 4 if there isn't enough memory.
+ */
+int32_t addBatchFile(BatchList_t *list, const char *path);
+
+/**
+ * @brief This function adds the files of a list file to the list.
+ *
+ * The list file has one path per line, empty lines are skipped.
+ *
+ * @param list The list of files.
+ * @param list_path The path of the list file.
+ * @return 0 if the files are added, 3 if the list file can't be opened, 4 if there isn't enough memory.
+ */
+int32_t readBatchListFile(BatchList_t *list, const char *list_path);
+
+/**
+ * @brief This function adds the *.hex files of a directory and of its subdirectories to the list.
+ *
+ * The files of a directory are added sorted by path, so the order doesn't depend on the file system.
+ * Subdirectories deeper than BATCH_MAX_DEPTH are skipped.
+ *
+ * @param list The list of files.
+ * @param directory The path of the directory.
+ * @return 0 if the files are added, 3 if the directory can't be opened, 4 if there isn't enough memory.
+ */
+int32_t addBatchDirectory(BatchList_t *list, const char *directory);
+
+/**
+ * @brief This function validates all files of the list with a pool of worker threads.
+ *
+ * The result and report of each file are stored in its entry.
+ *
+ * @param list The list of files.
+ * @param thread_count The number of worker threads, 0 to use one thread per processor.
+ * @param cache The result cache shared by the workers, NULL to validate every file.
+ * @param summary The structure to store the aggregate statistics.
+ * @return 0 if all files are valid, 1 if at least one file isn't valid or can't be opened.
+ */
+int32_t validateIntelHexBatch(BatchList_t *list, uint32_t thread_count, ResultCache_t *cache, BatchSummary_t *summary);
+
+/**
+ * @brief This function frees the list of files.
+ *
+ * @param list The list to free, it is empty after the call.
+ */
+void freeBatchList(BatchList_t *list);
+
+#endif /* BATCH_VALIDATOR_H */
@@ -0,0 +1,727 @@
+/**
+ * @file benchmark.c
+ * @brief This file contains the benchmark of the Intel Hex file checker.
+ *
+ * The benchmark generates a deterministic synthetic Intel Hex file with the hex generator and measures
+ * the throughput of checkRecord, analyzeIntelHexFile, checkEOF, the single-pass validations, the stream, the scan of
+ * the prefilter over the whole file and the full flow of the application (validation and print of all records), in MB/s and records/s.
+ * Each case is run several times and the fastest run is reported.
+ * The overlap of the asynchronous reader is measured last: the time to only read the file, to only parse it in memory
+ * and to read and parse it together, and the part of the read time that is hidden behind the parse.
+ * With option --generate, only the file is written, so it can be used as a corpus for other tools.
+ *
+ * Usage: benchmark [--size=MB] [--record-length=N] [--address-interval=N] [--error=C] [--seed=N] [--crlf]
+ *                  [--iterations=N] [--file=path] [--generate]
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdio.h>      /* Include standard input and output library for printf, scanf, ... */
+#include <stdint.h>     /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdlib.h>     /* For malloc(), free(), strtoul() functions */
+#include <string.h>     /* For strcmp(), strncmp() functions */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "record_handler.h"            /* Include header file of the record handler */
+#include "hex_generator.h"             /* Include header file of the generator of synthetic files */
+#include "async_reader.h"              /* Include header file of the asynchronous reader */
+#if defined(_WIN32)
+#include <windows.h>    /* For QueryPerformanceCounter() function */
+#else
+#include <time.h>       /* For clock_gettime() function */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCHMARK_DEFAULT_FILE          "benchmark_corpus.hex"  /* The file generated when no file is given */
+#define BENCHMARK_DEFAULT_SIZE_MB       64                      /* The default size of the generated file in MiB */
+#define BENCHMARK_DEFAULT_ITERATIONS    3                       /* The default number of runs of each case */
+#define BENCHMARK_STREAM_BLOCK          4096                    /* The number of characters of each block given to the stream */
+#define BENCHMARK_USAGE                 "Usage: benchmark [--size=MB] [--record-length=N] [--address-interval=N] " \
+                                        "[--error=C] [--seed=N] [--crlf] [--iterations=N] [--file=path] [--generate]\n"
+#if defined(_WIN32)
+#define BENCHMARK_NULL_DEVICE           "NUL"                   /* The stream that discards the printed text */
+#else
+#define BENCHMARK_NULL_DEVICE           "/dev/null"             /* The stream that discards the printed text */
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the input shared by all benchmark cases.
+ */
+typedef struct
+{
+    const char *path;               /* The path of the generated file */
+    int8_t *buffer;                 /* The content of the file */
+    uint64_t size;                  /* The number of characters of the file */
+    int8_t **lines;                 /* The null-terminated lines of the file for checkRecord */
+    uint32_t line_count;            /* The number of lines of the file */
+} BenchmarkInput_t;
+
+/**
+ * @brief Structure to hold one benchmark case.
+ */
+typedef struct
+{
+    const char *name;                                   /* The name printed in the report */
+    int32_t (*run)(const BenchmarkInput_t *input);      /* The function measured, it returns its result */
+} BenchmarkCase_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static double getTime(void);
+static int32_t splitLines(BenchmarkInput_t *input);
+static int32_t runCheckRecord(const BenchmarkInput_t *input);
+static int32_t runAnalyzeFile(const BenchmarkInput_t *input);
+static int32_t runCheckEOF(const BenchmarkInput_t *input);
+static int32_t runValidateFile(const BenchmarkInput_t *input);
+static int32_t runValidateBuffer(const BenchmarkInput_t *input);
+static int32_t runPrefilter(const BenchmarkInput_t *input);
+static int32_t runValidateMappedFile(const BenchmarkInput_t *input);
+static int32_t runValidateMappedFileParallel(const BenchmarkInput_t *input);
+static int32_t runValidateAsyncFile(const BenchmarkInput_t *input);
+static int32_t runStream(const BenchmarkInput_t *input);
+static int32_t runMainFlow(const BenchmarkInput_t *input);
+static double readAsyncFile(const BenchmarkInput_t *input, int8_t parse, double *wait, AsyncBackend_t *backend);
+static void measureOverlap(const BenchmarkInput_t *input, uint32_t iterations);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const BenchmarkCase_t benchmark_cases[] =
+{
+    { "checkRecord",                         runCheckRecord },
+    { "analyzeIntelHexFile",                 runAnalyzeFile },
+    { "checkEOF",                            runCheckEOF },
+    { "validateIntelHexFile",                runValidateFile },
+    { "validateIntelHexBuffer",              runValidateBuffer },
+    { "prefilterIntelHexBuffer (whole file)", runPrefilter },
+    { "validateIntelHexMappedFile",          runValidateMappedFile },
+    { "validateIntelHexMappedFileParallel",  runValidateMappedFileParallel },
+    { "validateIntelHexAsyncFile",           runValidateAsyncFile },
+    { "feedIntelHexStream (4 KiB blocks)",   runStream },
+    { "main flow (validate + print)",        runMainFlow }
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief The main function of the benchmark.
+ *
+ * The function reads the options, generates the file and runs every benchmark case.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage in the description of the file.
+ * @return 0 if the benchmark has run, 1 if the file can't be generated, 2 if an option is unknown.
+ */
+int32_t main(int32_t argc, char *argv[])
+{
+    int32_t i = 0;                                      /* Loop counter */
+    uint32_t j = 0;                                     /* Loop counter of the runs */
+    int32_t status = 0;                                 /* The exit status of the program */
+    uint32_t iterations = BENCHMARK_DEFAULT_ITERATIONS; /* The number of runs of each case */
+    int8_t generate_only = 0;                           /* Initialize a flag to indicate if only the file is written */
+    int32_t result = 0;                                 /* The result of a benchmark case */
+    double start = 0;                                   /* The time at the beginning of a run */
+    double elapsed = 0;                                 /* The time of a run */
+    double best = 0;                                    /* The time of the fastest run */
+    FILE *fptr = NULL;                                  /* The generated file */
+
+    HexGeneratorConfig_t config;                        /* Declaring the configuration of the generator */
+    HexGeneratorResult_t generated;                     /* Declaring the result of the generator */
+    BenchmarkInput_t input;                             /* Declaring the input of the benchmark cases */
+
+    initHexGeneratorConfig(&config);
+    config.size = (uint64_t)BENCHMARK_DEFAULT_SIZE_MB * 1024 * 1024;
+    input.path = BENCHMARK_DEFAULT_FILE;
+    input.buffer = NULL;
+    input.lines = NULL;
+    /* Read the options */
+    for (i = 1; (i < argc) && (status == 0); i++)
+    {
+        if (strncmp(argv[i], "--size=", 7) == 0)
+        {
+            config.size = (uint64_t)strtoul(argv[i] + 7, NULL, 10) * 1024 * 1024;
+        }
+        else if (strncmp(argv[i], "--record-length=", 16) == 0)
+        {
+            config.record_length = (uint32_t)strtoul(argv[i] + 16, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--address-interval=", 19) == 0)
+        {
+            config.address_interval = (uint32_t)strtoul(argv[i] + 19, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--error=", 8) == 0)
+        {
+            config.error_code = (uint32_t)strtoul(argv[i] + 8, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+        {
+            config.seed = (uint32_t)strtoul(argv[i] + 7, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--crlf") == 0)
+        {
+            config.crlf = 1;
+        }
+        else if (strncmp(argv[i], "--iterations=", 13) == 0)
+        {
+            iterations = (uint32_t)strtoul(argv[i] + 13, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--file=", 7) == 0)
+        {
+            input.path = argv[i] + 7;
+        }
+        else if (strcmp(argv[i], "--generate") == 0)
+        {
+            generate_only = 1;
+        }
+        else
+        {
+            /* An unknown option stops the benchmark before the file is written, it could be a mistyped option */
+            fprintf(stderr, "Unknown option: %s\n" BENCHMARK_USAGE, argv[i]);
+            status = 2;
+        }
+    }
+
+    /* Generate the file on disk and in memory */
+    fptr = (status == 0) ? fopen(input.path, "wb") : NULL;
+    if (status != 0)
+    {
+        /* Do nothing */
+    }
+    else if (fptr == NULL)
+    {
+        printf("Error: Can not open file.\n");
+        status = 1;
+    }
+    else
+    {
+        generateIntelHexFile(&config, fptr, &generated);
+        fclose(fptr);
+        printf("Generated %s: %llu bytes, %u lines, %u data records", input.path,
+               (unsigned long long)generated.size, generated.line_count, generated.data_record_count);
+        if (generated.error_line != 0)
+        {
+            printf(", error %u at line %u", config.error_code, generated.error_line);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        printf("\n");
+        if (!generate_only)
+        {
+            input.buffer = (int8_t *)malloc((size_t)(config.size + (2 * HEX_GENERATOR_MAX_LINE)));
+            input.size = generated.size;
+            if ((input.buffer == NULL) ||
+                (generateIntelHexBuffer(&config, input.buffer, config.size + (2 * HEX_GENERATOR_MAX_LINE),
+                                        &generated) != 0) || !splitLines(&input))
+            {
+                printf("Error: Not enough memory for the benchmark.\n");
+                status = 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    /* Run each case and print the fastest run */
+    if ((status == 0) && !generate_only)
+    {
+        printf("\n%-38s %10s %10s %14s %s\n", "Case", "Time (ms)", "MB/s", "Records/s", "Result");
+        for (i = 0; i < (int32_t)(sizeof(benchmark_cases) / sizeof(benchmark_cases[0])); i++)
+        {
+            best = 0;
+            for (j = 0; j < ((iterations > 0) ? iterations : 1); j++)
+            {
+                start = getTime();
+                result = benchmark_cases[i].run(&input);
+                elapsed = getTime() - start;
+                if ((j == 0) || (elapsed < best))
+                {
+                    best = elapsed;
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+            printf("%-38s %10.1f %10.1f %14.0f %d\n", benchmark_cases[i].name, best * 1000.0,
+                   (best > 0) ? ((double)input.size / (1024.0 * 1024.0)) / best : 0.0,
+                   (best > 0) ? (double)input.line_count / best : 0.0, result);
+        }
+        measureOverlap(&input, (iterations > 0) ? iterations : 1);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* The first line is the beginning of the copy of the buffer */
+    if (input.lines != NULL)
+    {
+        free(input.lines[0]);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    free(input.lines);
+    free(input.buffer);
+    return status;
+}
+
+/**
+ * @brief This function returns the time of a monotonic clock.
+ *
+ * @return The time in seconds.
+ */
+static double getTime(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;          /* The value of the performance counter */
+    LARGE_INTEGER frequency;        /* The frequency of the performance counter */
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;            /* The time of the monotonic clock */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+#endif
+}
+
+/**
+ * @brief This function makes a null-terminated copy of every line of the buffer for checkRecord.
+ *
+ * The line terminators of a copy of the buffer are replaced by null characters.
+ *
+ * @param input The input of the benchmark, the lines and line count are set by the function.
+ * @return 1 if the lines are made, 0 if there isn't enough memory.
+ */
+static int32_t splitLines(BenchmarkInput_t *input)
+{
+    int32_t made = 0;               /* Initialize the result */
+    uint64_t i = 0;                 /* Loop counter */
+    uint32_t count = 0;             /* The number of lines found */
+    int8_t *text = NULL;            /* The copy of the buffer */
+    uint64_t size = 0;              /* The number of characters of the buffer */
+
+    /* Count the lines of the buffer */
+    for (i = 0; i < input->size; i++)
+    {
+        count += (input->buffer[i] == '\n');
+    }
+    size = input->size;
+    text = (int8_t *)malloc((size_t)size + 1);
+    input->lines = (int8_t **)malloc(((size_t)count + 1) * sizeof(int8_t *));
+    if ((text != NULL) && (input->lines != NULL))
+    {
+        memcpy(text, input->buffer, (size_t)size);
+        text[size] = '\0';
+        input->line_count = 0;
+        input->lines[0] = text;
+        for (i = 0; i < size; i++)
+        {
+            if (text[i] == '\n')
+            {
+                text[i] = '\0';
+                input->line_count += 1;
+                input->lines[input->line_count] = text + i + 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        made = 1;
+    }
+    else
+    {
+        free(text);
+        free(input->lines);
+        input->lines = NULL;
+    }
+    return made;
+}
+
+/**
+ * @brief This function checks every line with checkRecord.
+ *
+ * @param input The input of the benchmark.
+ * @return The number of invalid records.
+ */
+static int32_t runCheckRecord(const BenchmarkInput_t *input)
+{
+    uint32_t i = 0;                 /* Loop counter */
+    int32_t invalid = 0;            /* The number of invalid records */
+    HexContext_t context;           /* The context of the file */
+
+    initHexContext(&context, NULL);
+    for (i = 0; i < input->line_count; i++)
+    {
+        invalid += (checkRecord(&context, input->lines[i]) != 0);
+    }
+    return invalid;
+}
+
+/**
+ * @brief This function checks the file with analyzeIntelHexFile.
+ *
+ * @param input The input of the benchmark.
+ * @return The error code of analyzeIntelHexFile.
+ */
+static int32_t runAnalyzeFile(const BenchmarkInput_t *input)
+{
+    int32_t result = -1;            /* Initialize the result */
+    Error_t error;                  /* The error found in the file */
+    HexContext_t context;           /* The context of the file */
+    FILE *fptr = fopen(input->path, "r");   /* The file */
+
+    initHexContext(&context, NULL);
+    if (fptr != NULL)
+    {
+        result = analyzeIntelHexFile(&context, fptr, &error);
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function checks the End-Of-File record of the file with checkEOF.
+ *
+ * @param input The input of the benchmark.
+ * @return The error code of checkEOF.
+ */
+static int32_t runCheckEOF(const BenchmarkInput_t *input)
+{
+    int32_t result = -1;            /* Initialize the result */
+    Error_t error;                  /* The error found in the file */
+    HexContext_t context;           /* The context of the file */
+    FILE *fptr = fopen(input->path, "r");   /* The file */
+
+    initHexContext(&context, NULL);
+    if (fptr != NULL)
+    {
+        result = checkEOF(&context, fptr, &error);
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function validates the file with validateIntelHexFile.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of validateIntelHexFile.
+ */
+static int32_t runValidateFile(const BenchmarkInput_t *input)
+{
+    int32_t result = -1;            /* Initialize the result */
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+    FILE *fptr = fopen(input->path, "r");   /* The file */
+
+    initHexContext(&context, NULL);
+    if (fptr != NULL)
+    {
+        result = validateIntelHexFile(&context, fptr, &report);
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function validates the file in memory with validateIntelHexBuffer.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of validateIntelHexBuffer.
+ */
+static int32_t runValidateBuffer(const BenchmarkInput_t *input)
+{
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+
+    initHexContext(&context, NULL);
+    return validateIntelHexBuffer(&context, input->buffer, input->size, &report);
+}
+
+/**
+ * @brief This function scans the whole file in memory with prefilterIntelHexBuffer.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of prefilterIntelHexBuffer, 1 if the file is rejected.
+ */
+static int32_t runPrefilter(const BenchmarkInput_t *input)
+{
+    FileReport_t report;            /* The result of the validation of a rejected file */
+    HexContext_t context;           /* The context of the file */
+
+    initHexContext(&context, NULL);
+    return prefilterIntelHexBuffer(&context, input->buffer, input->size, 0, &report);
+}
+
+/**
+ * @brief This function validates the file with validateIntelHexMappedFile.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of validateIntelHexMappedFile.
+ */
+static int32_t runValidateMappedFile(const BenchmarkInput_t *input)
+{
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+
+    initHexContext(&context, NULL);
+    return validateIntelHexMappedFile(&context, input->path, &report);
+}
+
+/**
+ * @brief This function validates the file with validateIntelHexMappedFileParallel, one thread per processor.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of validateIntelHexMappedFileParallel.
+ */
+static int32_t runValidateMappedFileParallel(const BenchmarkInput_t *input)
+{
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+
+    initHexContext(&context, NULL);
+    return validateIntelHexMappedFileParallel(&context, input->path, 0, &report);
+}
+
+/**
+ * @brief This function validates the file with validateIntelHexAsyncFile.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of validateIntelHexAsyncFile.
+ */
+static int32_t runValidateAsyncFile(const BenchmarkInput_t *input)
+{
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+
+    initHexContext(&context, NULL);
+    return validateIntelHexAsyncFile(&context, input->path, &report);
+}
+
+/**
+ * @brief This function validates the file in memory with feedIntelHexStream, block by block.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of finishIntelHexStream.
+ */
+static int32_t runStream(const BenchmarkInput_t *input)
+{
+    uint64_t offset = 0;            /* The offset of the current block */
+    uint64_t count = 0;             /* The number of characters of the current block */
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+    HexStream_t stream;             /* The state of the validation of the blocks */
+
+    initHexContext(&context, NULL);
+    openIntelHexStream(&context, &stream, NULL, NULL);
+    while (offset < input->size)
+    {
+        count = ((input->size - offset) < BENCHMARK_STREAM_BLOCK) ? (input->size - offset) : BENCHMARK_STREAM_BLOCK;
+        feedIntelHexStream(&context, &stream, input->buffer + offset, count);
+        offset += count;
+    }
+    return finishIntelHexStream(&context, &stream, &report);
+}
+
+/**
+ * @brief This function runs the flow of the application: validation, then print of all records if the file is valid.
+ *
+ * The text is written to the null device.
+ *
+ * @param input The input of the benchmark.
+ * @return The result of validateIntelHexFile.
+ */
+static int32_t runMainFlow(const BenchmarkInput_t *input)
+{
+    int32_t result = -1;            /* Initialize the result */
+    FileReport_t report;            /* The result of the validation */
+    FILE *fptr = fopen(input->path, "r");               /* The file */
+    FILE *output = fopen(BENCHMARK_NULL_DEVICE, "w");   /* The stream that discards the text */
+    OutputWriter_t writer;          /* The writer of the text */
+    HexContext_t context;           /* The context of the file */
+
+    openOutputWriter(&writer, output);
+    initHexContext(&context, &writer);
+    if ((fptr != NULL) && (output != NULL))
+    {
+        result = validateIntelHexFile(&context, fptr, &report);
+        if (result == 0)
+        {
+            rewind(fptr);
+            printIntelHexFile(&context, fptr);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (fptr != NULL)
+    {
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (output != NULL)
+    {
+        fclose(output);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function reads the file with the asynchronous reader and parses its blocks or only reads them.
+ *
+ * @param input The input of the benchmark.
+ * @param parse 1 to give the blocks to feedIntelHexStream, 0 to only read them.
+ * @param wait Pointer to store the time waited for the blocks, in seconds.
+ * @param backend Pointer to store the way the blocks are read.
+ * @return The time of the whole read, in seconds, or a negative time if the file can't be opened.
+ */
+static double readAsyncFile(const BenchmarkInput_t *input, int8_t parse, double *wait, AsyncBackend_t *backend)
+{
+    double start = getTime();       /* The time of the beginning of the read */
+    double elapsed = -1;            /* The time of the read, negative until the file is read */
+    const int8_t *data = NULL;      /* Pointer to the bytes of the current block */
+    uint32_t size = 0;              /* The number of bytes of the current block */
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+    HexStream_t stream;             /* The state of the validation of the blocks */
+    AsyncReader_t reader;           /* The reader of the blocks */
+
+    initHexContext(&context, NULL);
+    if (openAsyncReader(&reader, input->path) == 0)
+    {
+        openIntelHexStream(&context, &stream, NULL, NULL);
+        while (readAsyncBlock(&reader, &data, &size))
+        {
+            if (parse)
+            {
+                feedIntelHexStream(&context, &stream, data, size);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        finishIntelHexStream(&context, &stream, &report);
+        *wait = (double)reader.wait_time / 1e9;
+        *backend = reader.backend;
+        closeAsyncReader(&reader);
+        elapsed = getTime() - start;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return elapsed;
+}
+
+/**
+ * @brief This function measures how much of the read time the asynchronous reader hides behind the parse.
+ *
+ * A sequential reader needs the read time plus the parse time, the asynchronous reader needs their maximum
+ * in the best case. The fastest run of each measure is used. When the file is in the page cache, the reads
+ * are copies from memory and there is little time to hide.
+ *
+ * @param input The input of the benchmark.
+ * @param iterations The number of runs of each measure.
+ */
+static void measureOverlap(const BenchmarkInput_t *input, uint32_t iterations)
+{
+    uint32_t j = 0;                 /* Loop counter of the runs */
+    double read_time = 0;           /* The fastest time to only read the file */
+    double parse_time = 0;          /* The fastest time to only parse the file in memory */
+    double both_time = 0;           /* The fastest time to read and parse the file */
+    double both_wait = 0;           /* The time waited for the blocks in the fastest run that reads and parses */
+    double elapsed = 0;             /* The time of a run */
+    double wait = 0;                /* The time waited for the blocks in a run */
+    double start = 0;               /* The time at the beginning of a run */
+    double hidden = 0;              /* The part of the read time hidden behind the parse, in percent */
+    AsyncBackend_t backend = ASYNC_BACKEND_THREAD;  /* The way the blocks are read */
+    FileReport_t report;            /* The result of the validation */
+    HexContext_t context;           /* The context of the file */
+    static const char *backend_names[] = { "io_uring", "overlapped ReadFile", "read-ahead thread" };
+
+    for (j = 0; j < iterations; j++)
+    {
+        elapsed = readAsyncFile(input, 0, &wait, &backend);
+        read_time = ((j == 0) || (elapsed < read_time)) ? elapsed : read_time;
+        initHexContext(&context, NULL);
+        start = getTime();
+        validateIntelHexBuffer(&context, input->buffer, input->size, &report);
+        elapsed = getTime() - start;
+        parse_time = ((j == 0) || (elapsed < parse_time)) ? elapsed : parse_time;
+        elapsed = readAsyncFile(input, 1, &wait, &backend);
+        if ((j == 0) || (elapsed < both_time))
+        {
+            both_time = elapsed;
+            both_wait = wait;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    if ((read_time < 0) || (both_time < 0))
+    {
+        printf("\nError: Can not read the file with the asynchronous reader.\n");
+    }
+    else
+    {
+        hidden = (read_time > 0) ? ((read_time + parse_time - both_time) * 100.0) / read_time : 0.0;
+        hidden = (hidden < 0.0) ? 0.0 : ((hidden > 100.0) ? 100.0 : hidden);
+        printf("\nI/O overlap of the asynchronous reader (%s, %u blocks of %u KiB):\n", backend_names[backend],
+               ASYNC_READER_DEPTH, ASYNC_READER_BLOCK_SIZE / 1024);
+        printf("%-38s %10.1f\n", "read only (ms)", read_time * 1000.0);
+        printf("%-38s %10.1f\n", "parse only, in memory (ms)", parse_time * 1000.0);
+        printf("%-38s %10.1f\n", "read + parse (ms)", both_time * 1000.0);
+        printf("%-38s %10.1f\n", "waiting for blocks (ms)", both_wait * 1000.0);
+        printf("%-38s %10.1f\n", "read time hidden by the parse (%)", hidden);
+    }
+} /* EOF */
+
@@ -0,0 +1,71 @@
+# Training run of the profile-guided optimization, called by the target pgo-train.
+#
+# The instrumented benchmark writes a synthetic corpus to PROFILE_DIR/corpus (a large valid file, a file with
+# long CRLF records and extended address records, and one small file for each record error code), then the
+# instrumented programs run on it the way they are used: the default check, the single-pass modes, a batch,
+# the conversions and all cases of the benchmark. The profile of the programs is written to PROFILE_DIR.
+#
+# Variables: CHECKER, BENCHMARK, PROFILE_DIR, TRAINING_SIZE (MiB), LLVM_PROFDATA (Clang only, may be empty).
+cmake_minimum_required(VERSION 3.13)
+
+set(corpus "${PROFILE_DIR}/corpus")
+
+# Run one program of the training, its output isn't needed
+function(train)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Training run failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+# Run the checker on files with an error, it exits with 1, only another status (an invalid option or a crash)
+# is a failure
+function(train_invalid)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+    if(NOT result EQUAL 1)
+        message(FATAL_ERROR "Training run failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+# The profile of an older build doesn't match the objects
+file(GLOB old_profiles "${PROFILE_DIR}/*.gcda" "${PROFILE_DIR}/*.profraw" "${PROFILE_DIR}/*.profdata")
+if(old_profiles)
+    file(REMOVE ${old_profiles})
+endif()
+file(REMOVE_RECURSE "${corpus}")
+file(MAKE_DIRECTORY "${corpus}")
+
+# The corpus
+train("${BENCHMARK}" --generate "--size=${TRAINING_SIZE}" "--file=${corpus}/valid.hex")
+train("${BENCHMARK}" --generate --size=2 --record-length=32 --address-interval=64 --crlf --seed=2
+      "--file=${corpus}/crlf.hex")
+foreach(code 1 2 3 4 5)
+    train("${BENCHMARK}" --generate --size=1 "--error=${code}" "--seed=${code}" "--file=${corpus}/error_${code}.hex")
+endforeach()
+
+# The modes of the application
+train("${CHECKER}" "${corpus}/valid.hex")
+train("${CHECKER}" --async "${corpus}/valid.hex")
+train("${CHECKER}" --segments "${corpus}/valid.hex")
+train("${CHECKER}" --digest "${corpus}/valid.hex")
+train("${CHECKER}" --overlaps --gaps=16 "${corpus}/crlf.hex")
+train("${CHECKER}" --format=json "${corpus}/crlf.hex")
+train("${CHECKER}" --normalize "${corpus}/crlf.hex")
+train("${CHECKER}" "--bin=${PROFILE_DIR}/crlf.bin" "${corpus}/crlf.hex")
+train_invalid("${CHECKER}" "--batch-dir=${corpus}")
+foreach(code 1 2 3 4 5)
+    train_invalid("${CHECKER}" "${corpus}/error_${code}.hex")
+    train_invalid("${CHECKER}" --all-errors "${corpus}/error_${code}.hex")
+endforeach()
+file(REMOVE "${PROFILE_DIR}/crlf.bin")
+
+# All cases of the benchmark, the kernels and the reader of the application
+train("${BENCHMARK}" "--size=${TRAINING_SIZE}" --iterations=1 "--file=${PROFILE_DIR}/benchmark.hex")
+file(REMOVE "${PROFILE_DIR}/benchmark.hex")
+
+# Clang writes raw profiles, they are merged into the profile given to -fprofile-use
+if(LLVM_PROFDATA)
+    file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+    train("${LLVM_PROFDATA}" merge "-output=${PROFILE_DIR}/default.profdata" ${raw_profiles})
+endif()
+message(STATUS "Profile written to ${PROFILE_DIR}")
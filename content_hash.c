@@ -0,0 +1,177 @@
+/**
+ * @file content_hash.c
+ * @brief This file contains the implementation of the content hash functions.
+ *
+ * The hash is XXH64: the bytes are consumed 32 at a time by four independent lanes, the rest of the
+ * bytes 8, 4 and 1 at a time, then the result is mixed by the avalanche step. The words are read
+ * in little-endian order, so the hash is the same on every processor.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "content_hash.h"    /* Include header file of this function file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HASH_PRIME_1    0x9E3779B185EBCA87ULL   /* The first prime of XXH64 */
+#define HASH_PRIME_2    0xC2B2AE3D27D4EB4FULL   /* The second prime of XXH64 */
+#define HASH_PRIME_3    0x165667B19E3779F9ULL   /* The third prime of XXH64 */
+#define HASH_PRIME_4    0x85EBCA77C2B2AE63ULL   /* The fourth prime of XXH64 */
+#define HASH_PRIME_5    0x27D4EB2F165667C5ULL   /* The fifth prime of XXH64 */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint64_t rotateLeft(uint64_t value, uint32_t count);
+static uint64_t readWord64(const uint8_t bytes[]);
+static uint32_t readWord32(const uint8_t bytes[]);
+static uint64_t hashRound(uint64_t lane, uint64_t word);
+static uint64_t mergeLane(uint64_t hash, uint64_t lane);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function computes the 64-bit xxHash (XXH64) of a block of memory.
+ *
+ * The result is the same as the reference implementation of XXH64 with the same seed.
+ *
+ * @param data The bytes to hash.
+ * @param size The number of bytes.
+ * @param seed The seed of the hash, different seeds give independent hashes.
+ * @return The hash.
+ */
+uint64_t hashContent(const int8_t data[], uint64_t size, uint64_t seed)
+{
+    const uint8_t *bytes = (const uint8_t *)data;   /* The bytes not hashed yet */
+    uint64_t remaining = size;      /* The number of bytes not hashed yet */
+    uint64_t hash = 0;              /* The hash */
+    uint64_t lane1 = seed + HASH_PRIME_1 + HASH_PRIME_2;    /* The first lane of the 32-byte stripes */
+    uint64_t lane2 = seed + HASH_PRIME_2;                   /* The second lane */
+    uint64_t lane3 = seed;                                  /* The third lane */
+    uint64_t lane4 = seed - HASH_PRIME_1;                   /* The fourth lane */
+
+    /* Hash the 32-byte stripes with the four lanes */
+    if (remaining >= 32)
+    {
+        while (remaining >= 32)
+        {
+            lane1 = hashRound(lane1, readWord64(bytes));
+            lane2 = hashRound(lane2, readWord64(bytes + 8));
+            lane3 = hashRound(lane3, readWord64(bytes + 16));
+            lane4 = hashRound(lane4, readWord64(bytes + 24));
+            bytes += 32;
+            remaining -= 32;
+        }
+        hash = rotateLeft(lane1, 1) + rotateLeft(lane2, 7) + rotateLeft(lane3, 12) + rotateLeft(lane4, 18);
+        hash = mergeLane(hash, lane1);
+        hash = mergeLane(hash, lane2);
+        hash = mergeLane(hash, lane3);
+        hash = mergeLane(hash, lane4);
+    }
+    else
+    {
+        hash = seed + HASH_PRIME_5;
+    }
+    hash += size;
+
+    /* Hash the last bytes */
+    while (remaining >= 8)
+    {
+        hash ^= hashRound(0, readWord64(bytes));
+        hash = (rotateLeft(hash, 27) * HASH_PRIME_1) + HASH_PRIME_4;
+        bytes += 8;
+        remaining -= 8;
+    }
+    if (remaining >= 4)
+    {
+        hash ^= (uint64_t)readWord32(bytes) * HASH_PRIME_1;
+        hash = (rotateLeft(hash, 23) * HASH_PRIME_2) + HASH_PRIME_3;
+        bytes += 4;
+        remaining -= 4;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    while (remaining > 0)
+    {
+        hash ^= (uint64_t)(*bytes) * HASH_PRIME_5;
+        hash = rotateLeft(hash, 11) * HASH_PRIME_1;
+        bytes += 1;
+        remaining -= 1;
+    }
+
+    /* Mix the bits of the hash */
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**
+ * @brief This function rotates the bits of a 64-bit word to the left.
+ *
+ * @param value The word.
+ * @param count The number of bits (1 to 63).
+ * @return The rotated word.
+ */
+static uint64_t rotateLeft(uint64_t value, uint32_t count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+/**
+ * @brief This function reads a 64-bit little-endian word.
+ *
+ * @param bytes The 8 bytes of the word.
+ * @return The word.
+ */
+static uint64_t readWord64(const uint8_t bytes[])
+{
+    return (uint64_t)readWord32(bytes) | ((uint64_t)readWord32(bytes + 4) << 32);
+}
+
+/**
+ * @brief This function reads a 32-bit little-endian word.
+ *
+ * @param bytes The 4 bytes of the word.
+ * @return The word.
+ */
+static uint32_t readWord32(const uint8_t bytes[])
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * @brief This function adds one word to a lane.
+ *
+ * @param lane The lane.
+ * @param word The word.
+ * @return The new value of the lane.
+ */
+static uint64_t hashRound(uint64_t lane, uint64_t word)
+{
+    lane += word * HASH_PRIME_2;
+    lane = rotateLeft(lane, 31);
+    return lane * HASH_PRIME_1;
+}
+
+/**
+ * @brief This function merges one lane into the hash at the end of the stripes.
+ *
+ * @param hash The hash.
+ * @param lane The lane.
+ * @return The new value of the hash.
+ */
+static uint64_t mergeLane(uint64_t hash, uint64_t lane)
+{
+    hash ^= hashRound(0, lane);
+    return (hash * HASH_PRIME_1) + HASH_PRIME_4;
+} /* EOF */
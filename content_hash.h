@@ -0,0 +1,37 @@
+/**
+ * @file content_hash.h
+ * @brief This file contains the prototypes of the content hash functions.
+ *
+ * The content hash is the 64-bit xxHash (XXH64) of a block of memory. It isn't a cryptographic hash,
+ * it is a fast fingerprint to recognize a file that has been seen before.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function computes the 64-bit xxHash (XXH64) of a block of memory.
+ *
+ * The result is the same as the reference implementation of XXH64 with the same seed.
+ *
+ * @param data The bytes to hash.
+ * @param size The number of bytes.
+ * @param seed The seed of the hash, different seeds give independent hashes.
+ * @return The hash.
+ */
+uint64_t hashContent(const int8_t data[], uint64_t size, uint64_t seed);
+
+#endif /* CONTENT_HASH_H */
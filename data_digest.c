@@ -0,0 +1,514 @@
+/**
+ * @file data_digest.c
+ * @brief This file contains the implementation of the data digest functions.
+ *
+ * The data digests are the checksums used to sign off a memory image: the CRC-32 of IEEE 802.3 and the SHA-256
+ * of FIPS 180-4, both computed incrementally.
+ * Function updateCrc32 uses a kernel selected at runtime for the CPU: the folding with carry-less multiplication
+ * (PCLMULQDQ) of x86, which folds 64 bytes per iteration, the CRC32 instructions of ARMv8 when the build
+ * targets them, or a slicing-by-8 table that adds 8 bytes per iteration with 8 lookups.
+ * All kernels produce exactly the same CRC. SHA-256 is computed in software with the compression of FIPS 180-4.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <string.h>             /* For memcpy */
+#include "data_digest.h"        /* Include header file of this function file */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DATA_DIGEST_X86 1
+#include <immintrin.h>          /* For the PCLMULQDQ and SSE4.1 intrinsics */
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define DATA_DIGEST_ARMV8 1
+#include <arm_acle.h>           /* For the CRC32 intrinsics */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CRC32_POLYNOMIAL        0xEDB88320U     /* The polynomial of the CRC-32 of IEEE 802.3, bit-reflected */
+#define CRC32_FOLD_MINIMUM      64              /* The minimum number of bytes folded with PCLMULQDQ */
+
+#define SHA256_ROTATE(x, n)     (((x) >> (n)) | ((x) << (32 - (n))))    /* Rotation to the right of a word */
+
+/**
+ * @brief Type of the kernel functions, same parameters and return value as updateCrc32.
+ */
+typedef uint32_t (*Crc32Kernel_t)(uint32_t crc, const uint8_t data[], uint64_t size);
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint32_t crc32Resolve(uint32_t crc, const uint8_t data[], uint64_t size);
+static uint32_t crc32Slice8(uint32_t crc, const uint8_t data[], uint64_t size);
+#if defined(DATA_DIGEST_X86)
+static uint32_t crc32PCLMUL(uint32_t crc, const uint8_t data[], uint64_t size);
+static uint32_t foldPCLMUL(const uint8_t data[], uint64_t size, uint32_t crc);
+#endif
+#if defined(DATA_DIGEST_ARMV8)
+static uint32_t crc32ARMv8(uint32_t crc, const uint8_t data[], uint64_t size);
+#endif
+static void compressSha256(uint32_t state[8], const uint8_t block[SHA256_BLOCK_SIZE]);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/**
+ * @brief The lookup tables of the slicing-by-8 kernel, built at the first call of updateCrc32.
+ *
+ * Table 0 is the CRC of each byte value, table k is the CRC of the byte value followed by k zero bytes.
+ */
+static uint32_t crc32_table[8][256];
+
+/**
+ * @brief The round constants of SHA-256, the first 32 bits of the fractional parts of the cube roots
+ *        of the first 64 primes.
+ */
+static const uint32_t sha256_constants[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+static Crc32Kernel_t crc32_kernel = crc32Resolve;   /* The kernel used by updateCrc32, resolved at the first call */
+static const char *crc32_kernel_name = "slice8";    /* The name of the kernel used by updateCrc32 */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function adds bytes to a CRC-32.
+ *
+ * The CRC-32 of a block is updateCrc32(0, data, size), the CRC-32 of several blocks one after the other
+ * is computed by giving the result of each call to the next one.
+ * The kernel is selected at the first call, like the kernel of decodeHexData.
+ *
+ * @param crc The CRC-32 of the bytes before, 0 for the first bytes.
+ * @param data The bytes to add.
+ * @param size The number of bytes.
+ * @return The CRC-32 of the bytes before and the added bytes.
+ */
+uint32_t updateCrc32(uint32_t crc, const uint8_t data[], uint64_t size)
+{
+    return crc32_kernel(crc, data, size);
+}
+
+/**
+ * @brief This function returns the name of the kernel used by updateCrc32.
+ *
+ * @return The name of the kernel ("slice8", "pclmul" or "armv8").
+ */
+const char *getCrc32KernelName(void)
+{
+    /* Resolve the kernel if updateCrc32 hasn't been called yet */
+    if (crc32_kernel == crc32Resolve)
+    {
+        crc32Resolve(0, NULL, 0);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return crc32_kernel_name;
+}
+
+/**
+ * @brief This function starts a SHA-256 computation.
+ *
+ * @param sha The state of the computation.
+ */
+void initSha256(Sha256_t *sha)
+{
+    /* The initial hash value, the first 32 bits of the fractional parts of the square roots of the first 8 primes */
+    sha->state[0] = 0x6A09E667;
+    sha->state[1] = 0xBB67AE85;
+    sha->state[2] = 0x3C6EF372;
+    sha->state[3] = 0xA54FF53A;
+    sha->state[4] = 0x510E527F;
+    sha->state[5] = 0x9B05688C;
+    sha->state[6] = 0x1F83D9AB;
+    sha->state[7] = 0x5BE0CD19;
+    sha->length = 0;
+    sha->block_size = 0;
+}
+
+/**
+ * @brief This function adds bytes to a SHA-256 computation.
+ *
+ * @param sha The state of the computation.
+ * @param data The bytes to add.
+ * @param size The number of bytes.
+ */
+void updateSha256(Sha256_t *sha, const uint8_t data[], uint64_t size)
+{
+    uint64_t offset = 0;        /* Offset of the first byte not added yet */
+    uint64_t count = 0;         /* The number of bytes copied to the block */
+
+    sha->length += size;
+    /* Complete the block not compressed yet */
+    if (sha->block_size > 0)
+    {
+        count = SHA256_BLOCK_SIZE - sha->block_size;
+        count = (count < size) ? count : size;
+        memcpy(sha->block + sha->block_size, data, count);
+        sha->block_size += (uint32_t)count;
+        offset = count;
+        if (sha->block_size == SHA256_BLOCK_SIZE)
+        {
+            compressSha256(sha->state, sha->block);
+            sha->block_size = 0;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* Compress the whole blocks directly from the data */
+    while (size - offset >= SHA256_BLOCK_SIZE)
+    {
+        compressSha256(sha->state, data + offset);
+        offset += SHA256_BLOCK_SIZE;
+    }
+
+    /* Keep the last bytes for the next call */
+    if (offset < size)
+    {
+        memcpy(sha->block, data + offset, size - offset);
+        sha->block_size = (uint32_t)(size - offset);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function finishes a SHA-256 computation and gives the digest.
+ *
+ * The state can't be used anymore, it must be started again with initSha256.
+ *
+ * @param sha The state of the computation.
+ * @param digest The array to store the digest, SHA256_DIGEST_SIZE bytes.
+ */
+void finishSha256(Sha256_t *sha, uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    uint32_t i = 0;                         /* Loop counter */
+    uint64_t bit_length = sha->length * 8;  /* The number of bits of the message */
+
+    /* The padding is a 1 bit, zero bits up to 8 bytes before the end of a block and the length in bits */
+    sha->block[sha->block_size] = 0x80;
+    sha->block_size += 1;
+    if (sha->block_size > SHA256_BLOCK_SIZE - 8)
+    {
+        memset(sha->block + sha->block_size, 0, SHA256_BLOCK_SIZE - sha->block_size);
+        compressSha256(sha->state, sha->block);
+        sha->block_size = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    memset(sha->block + sha->block_size, 0, SHA256_BLOCK_SIZE - 8 - sha->block_size);
+    for (i = 0; i < 8; i++)
+    {
+        sha->block[SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bit_length >> (i * 8));
+    }
+    compressSha256(sha->state, sha->block);
+
+    /* The digest is the hash value in big-endian order */
+    for (i = 0; i < SHA256_DIGEST_SIZE; i++)
+    {
+        digest[i] = (uint8_t)(sha->state[i / 4] >> (24 - ((i % 4) * 8)));
+    }
+}
+
+/**
+ * @brief This function builds the lookup tables and selects the fastest kernel at the first call of updateCrc32.
+ *
+ * The tables are also used by the other kernels for the bytes they don't fold.
+ * The parameters and return value are the same as updateCrc32.
+ */
+static uint32_t crc32Resolve(uint32_t crc, const uint8_t data[], uint64_t size)
+{
+    uint32_t i = 0;             /* Loop counter of the byte values */
+    uint32_t k = 0;             /* Loop counter of the bits and the tables */
+    uint32_t value = 0;         /* The CRC of the byte value */
+
+    for (i = 0; i < 256; i++)
+    {
+        value = i;
+        for (k = 0; k < 8; k++)
+        {
+            value = (value & 1) ? ((value >> 1) ^ CRC32_POLYNOMIAL) : (value >> 1);
+        }
+        crc32_table[0][i] = value;
+    }
+    for (k = 1; k < 8; k++)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            value = crc32_table[k - 1][i];
+            crc32_table[k][i] = (value >> 8) ^ crc32_table[0][value & 0xFF];
+        }
+    }
+
+#if defined(DATA_DIGEST_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    {
+        crc32_kernel = crc32PCLMUL;
+        crc32_kernel_name = "pclmul";
+    }
+    else
+    {
+        crc32_kernel = crc32Slice8;
+        crc32_kernel_name = "slice8";
+    }
+#elif defined(DATA_DIGEST_ARMV8)
+    /* The CRC32 instructions are part of every CPU targeted by this build */
+    crc32_kernel = crc32ARMv8;
+    crc32_kernel_name = "armv8";
+#else
+    crc32_kernel = crc32Slice8;
+    crc32_kernel_name = "slice8";
+#endif
+    return crc32_kernel(crc, data, size);
+}
+
+/**
+ * @brief This function is the slicing-by-8 kernel of updateCrc32, it adds 8 bytes per iteration.
+ *
+ * The parameters and return value are the same as updateCrc32.
+ */
+static uint32_t crc32Slice8(uint32_t crc, const uint8_t data[], uint64_t size)
+{
+    uint64_t i = 0;             /* Offset of the added byte */
+    uint32_t low = 0;           /* The first 4 bytes of the 8 bytes, combined with the CRC */
+    uint32_t high = 0;          /* The last 4 bytes of the 8 bytes */
+
+    crc = ~crc;
+    while (size - i >= 8)
+    {
+        low = crc ^ ((uint32_t)data[i] | ((uint32_t)data[i + 1] << 8) | ((uint32_t)data[i + 2] << 16) |
+                     ((uint32_t)data[i + 3] << 24));
+        high = (uint32_t)data[i + 4] | ((uint32_t)data[i + 5] << 8) | ((uint32_t)data[i + 6] << 16) |
+               ((uint32_t)data[i + 7] << 24);
+        crc = crc32_table[7][low & 0xFF] ^ crc32_table[6][(low >> 8) & 0xFF] ^
+              crc32_table[5][(low >> 16) & 0xFF] ^ crc32_table[4][low >> 24] ^
+              crc32_table[3][high & 0xFF] ^ crc32_table[2][(high >> 8) & 0xFF] ^
+              crc32_table[1][(high >> 16) & 0xFF] ^ crc32_table[0][high >> 24];
+        i += 8;
+    }
+    while (i < size)
+    {
+        crc = crc32_table[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        i++;
+    }
+    return ~crc;
+}
+
+#if defined(DATA_DIGEST_X86)
+/**
+ * @brief This function is the PCLMULQDQ kernel of updateCrc32.
+ *
+ * The bytes are folded 64 bytes per iteration while at least CRC32_FOLD_MINIMUM bytes are left,
+ * the last bytes (less than 16) are added with the slicing-by-8 kernel.
+ * The parameters and return value are the same as updateCrc32.
+ */
+static uint32_t crc32PCLMUL(uint32_t crc, const uint8_t data[], uint64_t size)
+{
+    uint64_t folded = 0;        /* The number of bytes folded, a multiple of 16 */
+
+    if (size >= CRC32_FOLD_MINIMUM)
+    {
+        folded = size & ~(uint64_t)15;
+        crc = ~foldPCLMUL(data, folded, ~crc);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return crc32Slice8(crc, data + folded, size - folded);
+}
+
+/**
+ * @brief This function folds a block of bytes into a CRC-32 with carry-less multiplications.
+ *
+ * The four 128-bit lanes are folded 64 bytes ahead in parallel, then folded into one lane, then reduced
+ * to 32 bits with a Barrett reduction, as described in "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction" (Intel, 2009). The constants are the bit-reflected powers of x modulo
+ * the polynomial of the CRC-32.
+ *
+ * @param data The bytes to fold.
+ * @param size The number of bytes, at least CRC32_FOLD_MINIMUM and a multiple of 16.
+ * @param crc The CRC-32 of the bytes before, not inverted (the state of the register).
+ * @return The state of the register after the bytes, not inverted.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t foldPCLMUL(const uint8_t data[], uint64_t size, uint32_t crc)
+{
+    const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);  /* Fold by 64 bytes */
+    const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);  /* Fold by 16 bytes */
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163CD6124LL);               /* Fold 96 bits to 64 bits */
+    const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);  /* Barrett constant and polynomial */
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);                    /* The low 32 bits of each 64 bits */
+    uint64_t offset = 64;       /* Offset of the first byte not folded yet */
+    __m128i x1, x2, x3, x4;     /* The four lanes */
+    __m128i y1, y2, y3, y4;     /* The products of the low halves of the lanes */
+
+    x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int32_t)crc));
+
+    /* Fold the four lanes 64 bytes ahead */
+    while (size - offset >= 64)
+    {
+        y1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        y2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        y3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        y4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, y1), _mm_loadu_si128((const __m128i *)(data + offset + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, y2), _mm_loadu_si128((const __m128i *)(data + offset + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, y3), _mm_loadu_si128((const __m128i *)(data + offset + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, y4), _mm_loadu_si128((const __m128i *)(data + offset + 0x30)));
+        offset += 64;
+    }
+
+    /* Fold the four lanes into one */
+    y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), y1);
+    y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), y1);
+    y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), y1);
+
+    /* Fold the remaining blocks of 16 bytes */
+    while (size - offset >= 16)
+    {
+        y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, y1), _mm_loadu_si128((const __m128i *)(data + offset)));
+        offset += 16;
+    }
+
+    /* Fold 128 bits to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    /* Barrett reduction to 32 bits */
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#endif
+
+#if defined(DATA_DIGEST_ARMV8)
+/**
+ * @brief This function is the ARMv8 kernel of updateCrc32, it adds 8 bytes per CRC32X instruction.
+ *
+ * The parameters and return value are the same as updateCrc32.
+ */
+static uint32_t crc32ARMv8(uint32_t crc, const uint8_t data[], uint64_t size)
+{
+    uint64_t i = 0;             /* Offset of the added byte */
+    uint64_t word = 0;          /* The 8 bytes added at once, AArch64 is little-endian */
+
+    crc = ~crc;
+    while (size - i >= 8)
+    {
+        memcpy(&word, data + i, sizeof(word));
+        crc = __crc32d(crc, word);
+        i += 8;
+    }
+    while (i < size)
+    {
+        crc = __crc32b(crc, data[i]);
+        i++;
+    }
+    return ~crc;
+}
+#endif
+
+/**
+ * @brief This function compresses one block of 64 bytes into the hash value of SHA-256.
+ *
+ * @param state The hash value.
+ * @param block The block.
+ */
+static void compressSha256(uint32_t state[8], const uint8_t block[SHA256_BLOCK_SIZE])
+{
+    uint32_t i = 0;             /* Loop counter */
+    uint32_t w[64];             /* The message schedule */
+    uint32_t a = state[0];      /* The working variables */
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+    uint32_t t1 = 0;            /* The temporary words of a round */
+    uint32_t t2 = 0;
+
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[(i * 4) + 1] << 16) |
+               ((uint32_t)block[(i * 4) + 2] << 8) | (uint32_t)block[(i * 4) + 3];
+    }
+    for (i = 16; i < 64; i++)
+    {
+        t1 = SHA256_ROTATE(w[i - 2], 17) ^ SHA256_ROTATE(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        t2 = SHA256_ROTATE(w[i - 15], 7) ^ SHA256_ROTATE(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        w[i] = t1 + w[i - 7] + t2 + w[i - 16];
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        t1 = h + (SHA256_ROTATE(e, 6) ^ SHA256_ROTATE(e, 11) ^ SHA256_ROTATE(e, 25)) + ((e & f) ^ (~e & g)) +
+             sha256_constants[i] + w[i];
+        t2 = (SHA256_ROTATE(a, 2) ^ SHA256_ROTATE(a, 13) ^ SHA256_ROTATE(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+} /* EOF */
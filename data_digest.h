@@ -0,0 +1,95 @@
+/**
+ * @file data_digest.h
+ * @brief This file contains the prototypes of the data digest functions.
+ *
+ * The data digests are the checksums used to sign off a memory image: the CRC-32 of IEEE 802.3 (the CRC of zlib,
+ * PNG and the crc32 tool) and the SHA-256 of FIPS 180-4. Both are computed incrementally, so the bytes of an image
+ * can be added record by record while the file is validated.
+ * The CRC-32 is computed with the carry-less multiplication (PCLMULQDQ) of x86 or the CRC32 instructions of ARMv8
+ * when the CPU has them, and with a slicing-by-8 table otherwise.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef DATA_DIGEST_H
+#define DATA_DIGEST_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SHA256_DIGEST_SIZE  32      /* The number of bytes of a SHA-256 digest */
+#define SHA256_BLOCK_SIZE   64      /* The number of bytes of a block of SHA-256 */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of a SHA-256 computation.
+ */
+typedef struct
+{
+    uint32_t state[8];                      /* The hash value of the blocks already compressed */
+    uint64_t length;                        /* The number of bytes added */
+    uint8_t block[SHA256_BLOCK_SIZE];       /* The bytes of the block not compressed yet */
+    uint32_t block_size;                    /* The number of bytes in block */
+} Sha256_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function adds bytes to a CRC-32.
+ *
+ * The CRC-32 of a block is updateCrc32(0, data, size), the CRC-32 of several blocks one after the other
+ * is computed by giving the result of each call to the next one.
+ * The kernel is selected at the first call, like the kernel of decodeHexData.
+ *
+ * @param crc The CRC-32 of the bytes before, 0 for the first bytes.
+ * @param data The bytes to add.
+ * @param size The number of bytes.
+ * @return The CRC-32 of the bytes before and the added bytes.
+ */
+uint32_t updateCrc32(uint32_t crc, const uint8_t data[], uint64_t size);
+
+/**
+ * @brief This function returns the name of the kernel used by updateCrc32.
+ *
+ * @return The name of the kernel ("slice8", "pclmul" or "armv8").
+ */
+const char *getCrc32KernelName(void);
+
+/**
+ * @brief This function starts a SHA-256 computation.
+ *
+ * @param sha The state of the computation.
+ */
+void initSha256(Sha256_t *sha);
+
+/**
+ * @brief This function adds bytes to a SHA-256 computation.
+ *
+ * @param sha The state of the computation.
+ * @param data The bytes to add.
+ * @param size The number of bytes.
+ */
+void updateSha256(Sha256_t *sha, const uint8_t data[], uint64_t size);
+
+/**
+ * @brief This function finishes a SHA-256 computation and gives the digest.
+ *
+ * The state can't be used anymore, it must be started again with initSha256.
+ *
+ * @param sha The state of the computation.
+ * @param digest The array to store the digest, SHA256_DIGEST_SIZE bytes.
+ */
+void finishSha256(Sha256_t *sha, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+#endif /* DATA_DIGEST_H */
@@ -0,0 +1,201 @@
+/**
+ * @file file_mapper.c
+ * @brief This file contains the implementation of the file mapper functions.
+ *
+ * The file mapper maps a whole file into memory so the upper layer can parse the records in place.
+ * It provides function mapFile to map a file for reading and function unmapFile to release the mapping.
+ * The mapping uses mmap on POSIX systems and MapViewOfFile on Windows.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "file_mapper.h"        /* Include header file of this function file */
+#include <stddef.h>             /* For NULL */
+
+#if defined(_WIN32)
+#include <windows.h>            /* For CreateFile(), CreateFileMapping(), MapViewOfFile() functions */
+#else
+#include <fcntl.h>              /* For open() function */
+#include <sys/mman.h>           /* For mmap(), madvise(), munmap() functions */
+#include <sys/stat.h>           /* For fstat() function */
+#include <unistd.h>             /* For close() function */
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#if defined(_WIN32)
+/**
+ * @brief This function maps a file into memory for reading.
+ *
+ * The mapping is read-only and is advised for sequential access.
+ *
+ * @param path The path of the file.
+ * @param file The structure to store the mapping.
+ * @return 0 if the file is mapped, 1 if the file can't be opened or mapped.
+ */
+int32_t mapFile(const char *path, MappedFile_t *file)
+{
+    int32_t error_code = 0;                 /* Error code, initialized to 0 */
+    HANDLE file_handle = INVALID_HANDLE_VALUE;  /* Handle of the opened file */
+    LARGE_INTEGER file_size;                /* Size of the file */
+
+    file->data = NULL;
+    file->size = 0;
+    file->handle = NULL;
+
+    /* Open the file with a hint for sequential access */
+    file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if ((file_handle == INVALID_HANDLE_VALUE) || !GetFileSizeEx(file_handle, &file_size))
+    {
+        error_code = 1;
+    }
+    /* An empty file can't be mapped, it has no content */
+    else if (file_size.QuadPart == 0)
+    {
+        /* Do nothing */
+    }
+    else
+    {
+        file->handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (file->handle != NULL)
+        {
+            file->data = (const int8_t *)MapViewOfFile(file->handle, FILE_MAP_READ, 0, 0, 0);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (file->data == NULL)
+        {
+            error_code = 1;
+            if (file->handle != NULL)
+            {
+                CloseHandle(file->handle);
+                file->handle = NULL;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            file->size = (uint64_t)file_size.QuadPart;
+        }
+    }
+    /* The mapping stays valid after the file is closed */
+    if (file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_handle);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function releases the memory mapping of a file.
+ *
+ * @param file The mapping to release.
+ */
+void unmapFile(MappedFile_t *file)
+{
+    if (file->data != NULL)
+    {
+        UnmapViewOfFile((LPCVOID)file->data);
+        CloseHandle(file->handle);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    file->data = NULL;
+    file->size = 0;
+    file->handle = NULL;
+}
+#else
+/**
+ * @brief This function maps a file into memory for reading.
+ *
+ * The mapping is read-only and is advised for sequential access.
+ *
+ * @param path The path of the file.
+ * @param file The structure to store the mapping.
+ * @return 0 if the file is mapped, 1 if the file can't be opened or mapped.
+ */
+int32_t mapFile(const char *path, MappedFile_t *file)
+{
+    int32_t error_code = 0;     /* Error code, initialized to 0 */
+    int32_t fd = -1;            /* File descriptor of the opened file */
+    void *address = NULL;       /* Address of the mapping */
+    struct stat file_status;    /* Status of the file, to get its size */
+
+    file->data = NULL;
+    file->size = 0;
+    file->handle = NULL;
+
+    fd = open(path, O_RDONLY);
+    if ((fd < 0) || (fstat(fd, &file_status) != 0))
+    {
+        error_code = 1;
+    }
+    /* An empty file can't be mapped, it has no content */
+    else if (file_status.st_size == 0)
+    {
+        /* Do nothing */
+    }
+    else
+    {
+        address = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            error_code = 1;
+        }
+        else
+        {
+            /* The file is read once from the beginning to the end */
+            madvise(address, (size_t)file_status.st_size, MADV_SEQUENTIAL);
+            file->data = (const int8_t *)address;
+            file->size = (uint64_t)file_status.st_size;
+        }
+    }
+    /* The mapping stays valid after the file is closed */
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function releases the memory mapping of a file.
+ *
+ * @param file The mapping to release.
+ */
+void unmapFile(MappedFile_t *file)
+{
+    if (file->data != NULL)
+    {
+        munmap((void *)file->data, (size_t)file->size);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    file->data = NULL;
+    file->size = 0;
+    file->handle = NULL;
+}
+#endif /* EOF */
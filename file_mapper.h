@@ -0,0 +1,60 @@
+/**
+ * @file file_mapper.h
+ * @brief This file contains the prototypes of the file mapper functions.
+ *
+ * The file mapper maps a whole file into memory so the upper layer can parse the records in place.
+ * It provides function mapFile to map a file for reading and function unmapFile to release the mapping.
+ * The mapping uses mmap on POSIX systems and MapViewOfFile on Windows.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef FILE_MAPPER_H
+#define FILE_MAPPER_H
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold a file mapped into memory.
+ *
+ * An empty file has no mapping, data is NULL and size is 0.
+ */
+typedef struct
+{
+    const int8_t *data;     /* The content of the file */
+    uint64_t size;          /* The number of bytes of the file */
+    void *handle;           /* The mapping handle of the operating system (Windows only) */
+} MappedFile_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function maps a file into memory for reading.
+ *
+ * The mapping is read-only and is advised for sequential access.
+ *
+ * @param path The path of the file.
+ * @param file The structure to store the mapping.
+ * @return 0 if the file is mapped, 1 if the file can't be opened or mapped.
+ */
+int32_t mapFile(const char *path, MappedFile_t *file);
+
+/**
+ * @brief This function releases the memory mapping of a file.
+ *
+ * @param file The mapping to release.
+ */
+void unmapFile(MappedFile_t *file);
+
+#endif /* FILE_MAPPER_H */
+
@@ -0,0 +1,1060 @@
+/**
+ * @file fuzz_harness.c
+ * @brief This file contains the fuzzing and differential-testing harness of the Intel Hex file checker.
+ *
+ * The same input is checked by every entry point that validates a record or a file, and all of them must give
+ * the same verdict: the record level compares checkRecord, parseRecord with the scalar and the vectorized decoder
+ * kernels and the record parser fed character by character, the file level compares validateIntelHexBuffer
+ * (both kernels), validateIntelHexFile, the stream (one block, small blocks and single characters), the record
+ * stream of the freestanding build, the parallel validation, the prefilter, the collection of all errors and
+ * the legacy analyzeIntelHexFile and checkEOF.
+ * Any difference is printed with the input and, under a fuzzer, makes the run abort so the input is kept as a crash.
+ *
+ * The files of a corpus replay are also converted like --normalize and --merge, and the converted file must give
+ * the memory image of the input: the tools work on paths, so this check isn't done on the inputs of a fuzzer.
+ *
+ * The legacy checkRecord stops at a null character, so the legacy functions are only compared on inputs without
+ * a null character; the other entry points are compared on every input.
+ *
+ * The sources of the library must be built with -DHEX_PARALLEL_MIN_CHUNK=64 (the CMake target does it), otherwise
+ * the parallel validation never splits an input as small as the fuzz inputs and only the single-thread path is compared.
+ *
+ * Build with libFuzzer: clang -fsanitize=fuzzer,address -DFUZZ_HARNESS_LIBFUZZER=1 -DHEX_PARALLEL_MIN_CHUNK=64 -pthread
+ *                       fuzz_harness.c <sources>
+ * Without libFuzzer the harness has its own main function for AFL (input on the standard input) and for the replay
+ * of a corpus: "fuzz_harness file..." checks each file, "fuzz_harness --print-verdicts file..." prints the verdict
+ * of each file and "fuzz_harness --verdicts=LIST" checks the files of the list against the verdicts stored in it,
+ * so an optimization that changes a verdict is found even if all entry points change the same way.
+ * The lines of the list are "path result record_code record_line eof_code eof_line", like the printed verdicts.
+ * The verdicts depend on the dialect of the build: fuzz_verdicts.txt is the list of HEX_DIALECT_ALL and
+ * fuzz_verdicts_i8hex.txt, fuzz_verdicts_i16hex.txt and fuzz_verdicts_i32hex.txt are the lists of the other dialects.
+ *
+ * Usage: fuzz_harness [--print-verdicts | --verdicts=LIST] [file...]
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdio.h>      /* Include standard input and output library for printf, scanf, ... */
+#include <stdint.h>     /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdlib.h>     /* For malloc(), realloc(), free(), abort() functions */
+#include <string.h>     /* For memcpy(), memcmp(), strcmp(), strncmp() functions */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "record_handler.h"            /* Include header file of the record handler */
+#include "hex_decoder.h"               /* Include header file of the hexadecimal decoder */
+#include "memory_image.h"              /* Include header file of the memory image */
+#include "image_diff.h"                /* Include header file of the comparison of memory images */
+#include "hex_converter.h"             /* Include header file of the converter, for --normalize */
+#include "hex_merger.h"                /* Include header file of the merger, for --merge */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef FUZZ_HARNESS_LIBFUZZER
+#define FUZZ_HARNESS_LIBFUZZER  0       /* 1 when libFuzzer provides the main function */
+#endif
+
+#define FUZZ_PARALLEL_THREADS   4       /* The number of threads of the parallel validation */
+#define FUZZ_MAX_ERRORS         8       /* The capacity of the error report of the collection of all errors */
+#define FUZZ_READ_BLOCK         4096    /* The number of characters read at once from a file or the standard input */
+#define FUZZ_MAX_PATH           1024    /* The maximum number of characters of a path in a verdict list */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the verdict of one entry point on a file.
+ */
+typedef struct
+{
+    int32_t result;                 /* The result of the validation (0, 1 or 2) */
+    FileReport_t report;            /* The report of the validation */
+} FuzzVerdict_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+static int8_t checkInput(const int8_t data[], uint64_t size);
+static int8_t checkRecords(const int8_t data[], uint64_t size, int8_t *legacy_compatible);
+static int8_t checkRecordLine(const int8_t line[], uint32_t length, int8_t *legacy_compatible);
+static int32_t pushRecordLine(const int8_t line[], uint32_t length, RecordParser_t *parser);
+static int8_t sameRecord(const IntelHexRecord_t *first, const IntelHexRecord_t *second);
+static int8_t checkFile(const int8_t data[], uint64_t size, int8_t legacy_compatible);
+static void validateBuffer(const int8_t data[], uint64_t size, HexKernel_t kernel, FuzzVerdict_t *verdict);
+static int8_t validateFile(const int8_t data[], uint64_t size, FuzzVerdict_t *verdict);
+static int8_t validateLegacy(const int8_t data[], uint64_t size, FuzzVerdict_t *verdict);
+static void validateStream(const int8_t data[], uint64_t size, uint64_t block_size, FuzzVerdict_t *verdict);
+static void validateRecordStream(const int8_t data[], uint64_t size, FuzzVerdict_t *verdict);
+static FILE *openMemoryFile(const int8_t data[], uint64_t size);
+static int8_t compareVerdicts(const char *name, const FuzzVerdict_t *expected, const FuzzVerdict_t *verdict,
+                              int8_t full_report);
+static void printVerdict(const char *path, const FuzzVerdict_t *verdict);
+static int8_t *readInput(FILE *fptr, uint64_t *size);
+static int32_t checkVerdictList(const char *list_path);
+static int8_t checkImages(const char *path, const int8_t data[], uint64_t size);
+static int8_t checkOutputImage(const char *name, FILE *output, const MemoryImage_t *expected);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function is the entry point of libFuzzer, it checks one input with all entry points.
+ *
+ * The run is aborted if the entry points don't give the same verdict, so the fuzzer keeps the input.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @return 0, the input is always accepted in the corpus.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (!checkInput((const int8_t *)data, size))
+    {
+        abort();
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return 0;
+}
+
+#if !FUZZ_HARNESS_LIBFUZZER
+/**
+ * @brief The main function of the harness without libFuzzer.
+ *
+ * Without file, the input is read from the standard input and the run is aborted on a difference, for AFL.
+ * With files, each file is checked and the number of files with a difference is printed.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, see the usage in the description of the file.
+ * @return 0 if all files are checked without difference, 1 otherwise.
+ */
+int32_t main(int32_t argc, char *argv[])
+{
+    int32_t i = 0;                  /* Loop counter */
+    int32_t exit_code = 0;          /* The exit status of the program */
+    int8_t print_verdicts = 0;      /* Initialize a flag to indicate if the verdicts are printed */
+    const char *list_path = NULL;   /* The path of the verdict list */
+    uint32_t file_count = 0;        /* The number of files checked */
+    uint32_t failed_count = 0;      /* The number of files with a difference */
+    int8_t *data = NULL;            /* The content of the input */
+    uint64_t size = 0;              /* The number of bytes of the input */
+    FILE *fptr = NULL;              /* Declaring a file pointer */
+    FuzzVerdict_t verdict;          /* Declaring the verdict of a file */
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--print-verdicts") == 0)
+        {
+            print_verdicts = 1;
+        }
+        else if (strncmp(argv[i], "--verdicts=", 11) == 0)
+        {
+            list_path = argv[i] + 11;
+        }
+        else
+        {
+            argv[1 + file_count] = argv[i];
+            file_count += 1;
+        }
+    }
+
+    if (list_path != NULL)
+    {
+        exit_code = checkVerdictList(list_path);
+    }
+    else if (file_count == 0)
+    {
+        /* The input of AFL, a difference must crash the run */
+        data = readInput(stdin, &size);
+        if (data != NULL)
+        {
+            LLVMFuzzerTestOneInput((const uint8_t *)data, size);
+        }
+        else
+        {
+            fprintf(stderr, "Error: Not enough memory for the input.\n");
+            exit_code = 1;
+        }
+        free(data);
+    }
+    else
+    {
+        for (i = 1; i <= (int32_t)file_count; i++)
+        {
+            fptr = fopen(argv[i], "rb");
+            data = (fptr != NULL) ? readInput(fptr, &size) : NULL;
+            if (data == NULL)
+            {
+                fprintf(stderr, "%s: Error: Can not read file.\n", argv[i]);
+                failed_count += 1;
+            }
+            else if (print_verdicts)
+            {
+                validateBuffer(data, size, HEX_KERNEL_AUTO, &verdict);
+                printVerdict(argv[i], &verdict);
+            }
+            else if (!checkInput(data, size))
+            {
+                fprintf(stderr, "%s: the entry points don't give the same verdict.\n", argv[i]);
+                failed_count += 1;
+            }
+            else if (!checkImages(argv[i], data, size))
+            {
+                fprintf(stderr, "%s: the converted file doesn't give the memory image of the file.\n", argv[i]);
+                failed_count += 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            if (fptr != NULL)
+            {
+                fclose(fptr);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            free(data);
+        }
+        if (!print_verdicts)
+        {
+            printf("%u files checked, %u with a difference.\n", file_count, failed_count);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        exit_code = (failed_count == 0) ? 0 : 1;
+    }
+    return exit_code;
+}
+#endif
+
+/**
+ * @brief This function checks one input at the record level and at the file level.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @return 1 if all entry points give the same verdict, 0 otherwise.
+ */
+static int8_t checkInput(const int8_t data[], uint64_t size)
+{
+    int8_t same = 0;                    /* Initialize the result */
+    int8_t legacy_compatible = 1;       /* 1 if the legacy functions can be compared on the input */
+
+    same = checkRecords(data, size, &legacy_compatible);
+    same = checkFile(data, size, legacy_compatible) && same;
+    return same;
+}
+
+/**
+ * @brief This function checks each line of the input with the record entry points.
+ *
+ * The lines end at each line feed, like the lines of the file validations.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param legacy_compatible Pointer to the flag cleared if the legacy functions can't be compared on the input.
+ * @return 1 if all record entry points give the same verdict on every line, 0 otherwise.
+ */
+static int8_t checkRecords(const int8_t data[], uint64_t size, int8_t *legacy_compatible)
+{
+    int8_t same = 1;            /* Initialize the result */
+    uint64_t start = 0;         /* Offset of the first character of the line */
+    uint64_t end = 0;           /* Offset of the line feed of the line, or of the end of the input */
+
+    while (start < size)
+    {
+        end = start;
+        while ((end < size) && (data[end] != '\n'))
+        {
+            end++;
+        }
+        /* A line longer than a record is checked with its length limited, it is invalid anyway */
+        same = checkRecordLine(data + start, (end - start > UINT32_MAX) ? UINT32_MAX : (uint32_t)(end - start),
+                               legacy_compatible) && same;
+        start = end + 1;
+    }
+    return same;
+}
+
+/**
+ * @brief This function checks one line with the record entry points.
+ *
+ * @param line The characters of the line, without the line feed.
+ * @param length The number of characters of the line.
+ * @param legacy_compatible Pointer to the flag cleared if the legacy functions can't be compared on the input.
+ * @return 1 if all record entry points give the same verdict, 0 otherwise.
+ */
+static int8_t checkRecordLine(const int8_t line[], uint32_t length, int8_t *legacy_compatible)
+{
+    int8_t same = 1;                    /* Initialize the result */
+    int32_t expected = 0;               /* The error code of parseRecord with the vectorized kernel */
+    int32_t scalar = 0;                 /* The error code of parseRecord with the scalar kernel */
+    int32_t pushed = 0;                 /* The error code of the record parser */
+    int32_t legacy = 0;                 /* The error code of checkRecord */
+    int8_t *text = NULL;                /* The null-terminated copy of the line for checkRecord */
+
+    HexContext_t context;               /* Declaring the context of the checks */
+    IntelHexRecord_t record;            /* Declaring the record of parseRecord with the vectorized kernel */
+    IntelHexRecord_t scalar_record;     /* Declaring the record of parseRecord with the scalar kernel */
+    RecordParser_t parser;              /* Declaring the record parser */
+
+    initHexContext(&context, NULL);
+    selectHexKernel(HEX_KERNEL_AUTO);
+    expected = parseRecord(&context, line, length, &record);
+    selectHexKernel(HEX_KERNEL_SCALAR);
+    scalar = parseRecord(&context, line, length, &scalar_record);
+    selectHexKernel(HEX_KERNEL_AUTO);
+    pushed = pushRecordLine(line, length, &parser);
+    if ((scalar != expected) || ((expected == 0) && !sameRecord(&record, &scalar_record)))
+    {
+        fprintf(stderr, "parseRecord: scalar kernel gives %d, %s kernel gives %d.\n", scalar, getHexKernelName(),
+                expected);
+        same = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if ((pushed != expected) || ((expected == 0) && !sameRecord(&record, &(parser.record))))
+    {
+        fprintf(stderr, "pushRecordCharacter gives %d, parseRecord gives %d.\n", pushed, expected);
+        same = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* The legacy checkRecord stops at a null character */
+    if (memchr(line, '\0', length) != NULL)
+    {
+        *legacy_compatible = 0;
+    }
+    else
+    {
+        text = (int8_t *)malloc((size_t)length + 1);
+        if (text != NULL)
+        {
+            memcpy(text, line, length);
+            text[length] = '\0';
+            legacy = checkRecord(&context, text);
+            if (legacy != expected)
+            {
+                fprintf(stderr, "checkRecord gives %d, parseRecord gives %d.\n", legacy, expected);
+                same = 0;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            free(text);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    return same;
+}
+
+/**
+ * @brief This function gives the characters of a line and a line feed to a new record parser.
+ *
+ * @param line The characters of the line, without the line feed.
+ * @param length The number of characters of the line.
+ * @param parser The record parser, it holds the record at the end.
+ * @return The first result of pushRecordCharacter that isn't RECORD_PENDING.
+ */
+static int32_t pushRecordLine(const int8_t line[], uint32_t length, RecordParser_t *parser)
+{
+    int32_t result = RECORD_PENDING;    /* Initialize the result of the record parser */
+    uint32_t i = 0;                     /* Loop counter */
+
+    HexContext_t context;               /* Declaring the context of the record parser */
+
+    initHexContext(&context, NULL);
+    initRecordParser(parser);
+    for (i = 0; (i < length) && (result == RECORD_PENDING); i++)
+    {
+        result = pushRecordCharacter(&context, parser, line[i]);
+    }
+    if (result == RECORD_PENDING)
+    {
+        result = pushRecordCharacter(&context, parser, '\n');
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function compares the fields of two valid records.
+ *
+ * @param first The first record.
+ * @param second The second record.
+ * @return 1 if the records have the same fields, 0 otherwise.
+ */
+static int8_t sameRecord(const IntelHexRecord_t *first, const IntelHexRecord_t *second)
+{
+    return (first->byte_count == second->byte_count) && (first->address == second->address) &&
+           (first->record_type == second->record_type) && (first->checksum == second->checksum) &&
+           (memcmp(first->data, second->data, first->byte_count) == 0);
+}
+
+/**
+ * @brief This function checks the input with the file entry points.
+ *
+ * The verdict of validateIntelHexBuffer with the vectorized kernel is the reference.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param legacy_compatible 1 if the legacy functions are compared on the input.
+ * @return 1 if all file entry points give the same verdict, 0 otherwise.
+ */
+static int8_t checkFile(const int8_t data[], uint64_t size, int8_t legacy_compatible)
+{
+    int8_t same = 1;                    /* Initialize the result */
+    int32_t rejected = 0;               /* The result of the prefilter */
+
+    HexContext_t context;               /* Declaring the context of the validations */
+    FuzzVerdict_t expected;             /* Declaring the reference verdict */
+    FuzzVerdict_t verdict;              /* Declaring the verdict of the compared entry point */
+    ErrorReport_t errors;               /* Declaring the error report of the collection of all errors */
+    ErrorEntry_t entries[FUZZ_MAX_ERRORS];  /* Declaring the entries of the error report */
+
+    validateBuffer(data, size, HEX_KERNEL_AUTO, &expected);
+
+    validateBuffer(data, size, HEX_KERNEL_SCALAR, &verdict);
+    same = compareVerdicts("validateIntelHexBuffer (scalar kernel)", &expected, &verdict, 1) && same;
+
+    if (validateFile(data, size, &verdict))
+    {
+        same = compareVerdicts("validateIntelHexFile", &expected, &verdict, 1) && same;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    validateStream(data, size, size, &verdict);
+    same = compareVerdicts("feedIntelHexStream (one block)", &expected, &verdict, 1) && same;
+    validateStream(data, size, 1 + (size % 61), &verdict);
+    same = compareVerdicts("feedIntelHexStream (small blocks)", &expected, &verdict, 1) && same;
+    validateStream(data, size, 1, &verdict);
+    same = compareVerdicts("feedIntelHexStream (single characters)", &expected, &verdict, 1) && same;
+    validateRecordStream(data, size, &verdict);
+    same = compareVerdicts("pushRecordStreamCharacter", &expected, &verdict, 0) && same;
+
+    initHexContext(&context, NULL);
+    verdict.result = validateIntelHexBufferParallel(&context, data, size, FUZZ_PARALLEL_THREADS, &(verdict.report));
+    same = compareVerdicts("validateIntelHexBufferParallel", &expected, &verdict, 1) && same;
+
+    /* A rejected file has exactly the verdict of the whole validation */
+    initHexContext(&context, NULL);
+    rejected = prefilterIntelHexBuffer(&context, data, size, 0, &(verdict.report));
+    if (rejected)
+    {
+        verdict.result = 1;
+        same = compareVerdicts("prefilterIntelHexBuffer", &expected, &verdict, 1) && same;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* The collection goes on behind the first error, only the first error is the same */
+    initHexContext(&context, NULL);
+    errors.entries = entries;
+    errors.capacity = FUZZ_MAX_ERRORS;
+    verdict.result = collectIntelHexBufferErrors(&context, data, size, &errors, &(verdict.report));
+    same = compareVerdicts("collectIntelHexBufferErrors", &expected, &verdict, 0) && same;
+    if ((expected.result == 1) &&
+        ((errors.count == 0) || (entries[0].error_source != HEX_ERROR_SOURCE_RECORD) ||
+         (entries[0].error_code != expected.report.record_error.error_code) ||
+         (entries[0].error_line != expected.report.record_error.error_line)))
+    {
+        fprintf(stderr, "collectIntelHexBufferErrors: the first entry isn't the first invalid record.\n");
+        same = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (legacy_compatible && validateLegacy(data, size, &verdict))
+    {
+        same = compareVerdicts("analyzeIntelHexFile and checkEOF", &expected, &verdict, 0) && same;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (!same)
+    {
+        fprintf(stderr, "Reference (validateIntelHexBuffer, %s kernel): ", getHexKernelName());
+        printVerdict("input", &expected);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return same;
+}
+
+/**
+ * @brief This function validates the input with validateIntelHexBuffer and a given decoder kernel.
+ *
+ * The vectorized kernel is selected again at the end.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param kernel The kernel of the hexadecimal decoder.
+ * @param verdict The verdict of the validation.
+ */
+static void validateBuffer(const int8_t data[], uint64_t size, HexKernel_t kernel, FuzzVerdict_t *verdict)
+{
+    HexContext_t context;               /* Declaring the context of the validation */
+
+    initHexContext(&context, NULL);
+    selectHexKernel(kernel);
+    verdict->result = validateIntelHexBuffer(&context, data, size, &(verdict->report));
+    selectHexKernel(HEX_KERNEL_AUTO);
+}
+
+/**
+ * @brief This function validates the input with validateIntelHexFile.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param verdict The verdict of the validation.
+ * @return 1 if the input is validated, 0 if it can't be opened as a file.
+ */
+static int8_t validateFile(const int8_t data[], uint64_t size, FuzzVerdict_t *verdict)
+{
+    FILE *fptr = openMemoryFile(data, size);    /* The input opened as a file */
+    HexContext_t context;                       /* Declaring the context of the validation */
+
+    if (fptr != NULL)
+    {
+        initHexContext(&context, NULL);
+        verdict->result = validateIntelHexFile(&context, fptr, &(verdict->report));
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return (fptr != NULL);
+}
+
+/**
+ * @brief This function validates the input with the legacy analyzeIntelHexFile and checkEOF.
+ *
+ * The End-Of-File record is only checked if all records are valid, like the application did before
+ * the single-pass validation.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param verdict The verdict of the validation, only the result and the errors are set.
+ * @return 1 if the input is validated, 0 if it can't be opened as a file.
+ */
+static int8_t validateLegacy(const int8_t data[], uint64_t size, FuzzVerdict_t *verdict)
+{
+    FILE *fptr = openMemoryFile(data, size);    /* The input opened as a file */
+    HexContext_t context;                       /* Declaring the context of the validation */
+
+    memset(verdict, 0, sizeof(FuzzVerdict_t));
+    if (fptr != NULL)
+    {
+        initHexContext(&context, NULL);
+        if (analyzeIntelHexFile(&context, fptr, &(verdict->report.record_error)) != 0)
+        {
+            verdict->result = 1;
+        }
+        else
+        {
+            rewind(fptr);
+            verdict->result = (checkEOF(&context, fptr, &(verdict->report.eof_error)) != 0) ? 2 : 0;
+        }
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return (fptr != NULL);
+}
+
+/**
+ * @brief This function validates the input with the stream functions, given block by block.
+ *
+ * The blocks stop being given after the first error, like a transfer that is aborted.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param block_size The number of bytes of each block.
+ * @param verdict The verdict of the validation.
+ */
+static void validateStream(const int8_t data[], uint64_t size, uint64_t block_size, FuzzVerdict_t *verdict)
+{
+    uint64_t offset = 0;                /* Offset of the next block */
+    uint64_t count = 0;                 /* The number of bytes of the block */
+    int32_t fed = 0;                    /* The result of the last block */
+
+    HexContext_t context;               /* Declaring the context of the validation */
+    HexStream_t stream;                 /* Declaring the state of the stream */
+
+    initHexContext(&context, NULL);
+    openIntelHexStream(&context, &stream, NULL, NULL);
+    while ((offset < size) && (fed != 1))
+    {
+        count = ((size - offset) < block_size) ? (size - offset) : block_size;
+        fed = feedIntelHexStream(&context, &stream, data + offset, count);
+        offset += count;
+    }
+    verdict->result = finishIntelHexStream(&context, &stream, &(verdict->report));
+}
+
+/**
+ * @brief This function validates the input character by character with a record stream.
+ *
+ * The record stream only has the errors of the report, the other fields of the report are cleared.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @param verdict The structure to store the verdict.
+ */
+static void validateRecordStream(const int8_t data[], uint64_t size, FuzzVerdict_t *verdict)
+{
+    uint64_t i = 0;                     /* Loop counter */
+    int32_t pushed = 0;                 /* The result of the last character */
+
+    HexContext_t context;               /* Declaring the context of the validation */
+    RecordStream_t stream;              /* Declaring the record stream */
+
+    initHexContext(&context, NULL);
+    initRecordStream(&stream);
+    for (i = 0; (i < size) && (pushed != 1); i++)
+    {
+        pushed = pushRecordStreamCharacter(&context, &stream, data[i]);
+    }
+    verdict->result = finishRecordStream(&context, &stream);
+    memset(&(verdict->report), 0, sizeof(FileReport_t));
+    verdict->report.record_error = stream.record_error;
+    verdict->report.eof_error = stream.eof_error;
+}
+
+/**
+ * @brief This function opens the input as a file that can be read with the functions that take a FILE.
+ *
+ * The input is opened in memory with fmemopen, or written to a temporary file where fmemopen isn't available.
+ *
+ * @param data The input.
+ * @param size The number of bytes of the input.
+ * @return The file, NULL if it can't be opened.
+ */
+static FILE *openMemoryFile(const int8_t data[], uint64_t size)
+{
+    FILE *fptr = NULL;          /* Declaring a file pointer */
+
+#if !defined(_WIN32)
+    /* fmemopen doesn't accept an empty buffer on every C library */
+    if (size > 0)
+    {
+        fptr = fmemopen((void *)data, (size_t)size, "rb");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+#endif
+    if (fptr == NULL)
+    {
+        fptr = tmpfile();
+        if ((fptr != NULL) && (fwrite(data, 1, (size_t)size, fptr) == size))
+        {
+            rewind(fptr);
+        }
+        else if (fptr != NULL)
+        {
+            fclose(fptr);
+            fptr = NULL;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return fptr;
+}
+
+/**
+ * @brief This function compares the verdict of an entry point with the reference and prints a difference.
+ *
+ * The result and the error of the result are always compared. The other fields of the report, the number
+ * of lines, the data bytes, the address range and the start address, are compared for a valid file.
+ *
+ * @param name The name of the entry point.
+ * @param expected The reference verdict.
+ * @param verdict The verdict of the entry point.
+ * @param full_report 1 to compare the other fields of the report, 0 to compare only the result and the error.
+ * @return 1 if the verdicts are the same, 0 otherwise.
+ */
+static int8_t compareVerdicts(const char *name, const FuzzVerdict_t *expected, const FuzzVerdict_t *verdict,
+                              int8_t full_report)
+{
+    int8_t same = 1;                    /* Initialize the result */
+    const FileReport_t *first = &(expected->report);    /* The reference report */
+    const FileReport_t *second = &(verdict->report);    /* The report of the entry point */
+
+    if (verdict->result != expected->result)
+    {
+        same = 0;
+    }
+    else if ((expected->result == 1) &&
+             ((second->record_error.error_code != first->record_error.error_code) ||
+              (second->record_error.error_line != first->record_error.error_line)))
+    {
+        same = 0;
+    }
+    /* The line of a missing End-Of-File record isn't meaningful */
+    else if ((expected->result == 2) &&
+             ((second->eof_error.error_code != first->eof_error.error_code) ||
+              ((first->eof_error.error_code != 1) &&
+               (second->eof_error.error_line != first->eof_error.error_line))))
+    {
+        same = 0;
+    }
+    else if (full_report && (expected->result == 0) &&
+             ((second->line_count != first->line_count) || (second->data_byte_count != first->data_byte_count) ||
+              (second->lowest_address != first->lowest_address) ||
+              (second->highest_address != first->highest_address) ||
+              (second->start_record_type != first->start_record_type) ||
+              (second->start_address != first->start_address)))
+    {
+        same = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (!same)
+    {
+        fprintf(stderr, "%s: ", name);
+        printVerdict("input", verdict);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return same;
+}
+
+/**
+ * @brief This function prints a verdict as one line of a verdict list.
+ *
+ * The line is "path result record_code record_line eof_code eof_line", the error that isn't the one
+ * of the result is printed as 0 0.
+ *
+ * @param path The path of the file.
+ * @param verdict The verdict.
+ */
+static void printVerdict(const char *path, const FuzzVerdict_t *verdict)
+{
+    const Error_t *record_error = &(verdict->report.record_error);  /* The record error of the report */
+    const Error_t *eof_error = &(verdict->report.eof_error);        /* The End-Of-File error of the report */
+
+    printf("%s %d %u %u %u %u\n", path, verdict->result,
+           (verdict->result == 1) ? record_error->error_code : 0, (verdict->result == 1) ? record_error->error_line : 0,
+           (verdict->result == 2) ? eof_error->error_code : 0,
+           ((verdict->result == 2) && (eof_error->error_code != 1)) ? eof_error->error_line : 0);
+    fflush(stdout);
+}
+
+/**
+ * @brief This function reads a whole file into memory.
+ *
+ * @param fptr The file.
+ * @param size Pointer to store the number of bytes read.
+ * @return The bytes of the file, to release with free, NULL if there isn't enough memory.
+ */
+static int8_t *readInput(FILE *fptr, uint64_t *size)
+{
+    int8_t *data = NULL;                /* The bytes read */
+    int8_t *grown = NULL;               /* The bytes read after a reallocation */
+    uint64_t capacity = FUZZ_READ_BLOCK;    /* The number of bytes that fit in data */
+    uint64_t count = FUZZ_READ_BLOCK;   /* The number of bytes of the last read */
+
+    *size = 0;
+    data = (int8_t *)malloc((size_t)capacity);
+    while ((data != NULL) && (count == FUZZ_READ_BLOCK))
+    {
+        if (*size + FUZZ_READ_BLOCK > capacity)
+        {
+            capacity *= 2;
+            grown = (int8_t *)realloc(data, (size_t)capacity);
+            if (grown == NULL)
+            {
+                free(data);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            data = grown;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (data != NULL)
+        {
+            count = fread(data + *size, 1, FUZZ_READ_BLOCK, fptr);
+            *size += count;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief This function checks the files of a verdict list against the verdicts stored in the list.
+ *
+ * Each file is also checked with all entry points like the files given on the command line.
+ *
+ * @param list_path The path of the verdict list.
+ * @return 0 if all files have their stored verdict and no difference, 1 otherwise.
+ */
+static int32_t checkVerdictList(const char *list_path)
+{
+    uint32_t file_count = 0;            /* The number of files checked */
+    uint32_t failed_count = 0;          /* The number of files with another verdict or a difference */
+    char path[FUZZ_MAX_PATH];           /* The path of the file of the current line */
+    int32_t result = 0;                 /* The stored result */
+    uint32_t record_code = 0;           /* The stored record error code */
+    uint32_t record_line = 0;           /* The stored record error line */
+    uint32_t eof_code = 0;              /* The stored End-Of-File error code */
+    uint32_t eof_line = 0;              /* The stored End-Of-File error line */
+    int8_t *data = NULL;                /* The content of the file */
+    uint64_t size = 0;                  /* The number of bytes of the file */
+    FILE *fptr = NULL;                  /* Declaring a file pointer of the file */
+    FuzzVerdict_t expected;             /* Declaring the stored verdict */
+    FuzzVerdict_t verdict;              /* Declaring the verdict of the file */
+
+    /* Open the verdict list in read mode */
+    FILE *list = fopen(list_path, "r");
+
+    if (list == NULL)
+    {
+        fprintf(stderr, "Error: Can not open the verdict list.\n");
+        failed_count = 1;
+    }
+    else
+    {
+        while (fscanf(list, "%1023s %d %u %u %u %u", path, &result, &record_code, &record_line, &eof_code,
+                      &eof_line) == 6)
+        {
+            file_count += 1;
+            memset(&expected, 0, sizeof(FuzzVerdict_t));
+            expected.result = result;
+            expected.report.record_error.error_code = record_code;
+            expected.report.record_error.error_line = record_line;
+            expected.report.eof_error.error_code = eof_code;
+            expected.report.eof_error.error_line = eof_line;
+            fptr = fopen(path, "rb");
+            data = (fptr != NULL) ? readInput(fptr, &size) : NULL;
+            if (data == NULL)
+            {
+                fprintf(stderr, "%s: Error: Can not read file.\n", path);
+                failed_count += 1;
+            }
+            else
+            {
+                validateBuffer(data, size, HEX_KERNEL_AUTO, &verdict);
+                if (!compareVerdicts(path, &expected, &verdict, 0) || !checkInput(data, size) ||
+                    !checkImages(path, data, size))
+                {
+                    fprintf(stderr, "%s: the verdict changed, the entry points don't give the same verdict or "
+                            "the converted file doesn't give the memory image.\n", path);
+                    failed_count += 1;
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+            if (fptr != NULL)
+            {
+                fclose(fptr);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            free(data);
+        }
+        fclose(list);
+        printf("%u files checked, %u with another verdict or a difference.\n", file_count, failed_count);
+    }
+    return ((failed_count == 0) && (file_count > 0)) ? 0 : 1;
+}
+
+/**
+ * @brief This function converts a file like --normalize and --merge and checks the converted files.
+ *
+ * Both conversions must accept the same files as buildMemoryImageFromBuffer, except a file with a data record
+ * that crosses the end of the 4 GiB address space, which both must reject with the result 5. The converted file
+ * must give the same memory image as the file, this is only checked if the image has no overlapping segments,
+ * the value of an overlapped address isn't unique.
+ *
+ * @param path The path of the file, the conversions read the file again.
+ * @param data The content of the file.
+ * @param size The number of bytes of the file.
+ * @return 1 if the conversions give the memory image of the file, 0 otherwise.
+ */
+static int8_t checkImages(const char *path, const int8_t data[], uint64_t size)
+{
+    int8_t same = 1;                    /* Initialize the result */
+    int32_t result = 0;                 /* The result of the memory image of the file */
+    int32_t normalized = 0;             /* The result of the normalization */
+    int32_t merged = 0;                 /* The result of the merge */
+    FILE *output = NULL;                /* The temporary file of a converted file */
+
+    HexContext_t context;               /* Declaring the context of the conversions */
+    FileReport_t report;                /* Declaring the report of the conversions */
+    MemoryImage_t expected;             /* Declaring the memory image of the file */
+    OutputWriter_t writer;              /* Declaring the writer of a converted file */
+    HexMerger_t merger;                 /* Declaring the state of the merge */
+
+    initHexContext(&context, NULL);
+    initMemoryImage(&expected);
+    result = buildMemoryImageFromBuffer(&context, data, size, &expected, &report);
+
+    output = tmpfile();
+    if (output != NULL)
+    {
+        openOutputWriter(&writer, output);
+        initHexContext(&context, NULL);
+        normalized = normalizeIntelHexFile(&context, path, &writer, HEX_CONVERTER_RECORD_SIZE, &report);
+        if ((normalized != result) && (normalized != 5))
+        {
+            fprintf(stderr, "normalizeIntelHexFile: result %d, the memory image gives %d.\n", normalized, result);
+            same = 0;
+        }
+        else if ((normalized == 0) && (expected.overlap_count == 0))
+        {
+            same = checkOutputImage("normalizeIntelHexFile", output, &expected) && same;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        fclose(output);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    output = tmpfile();
+    if (output != NULL)
+    {
+        openOutputWriter(&writer, output);
+        initHexContext(&context, NULL);
+        merged = openHexMerger(&merger, &context, &path, 1);
+        if (merged != normalized)
+        {
+            fprintf(stderr, "openHexMerger: result %d, normalizeIntelHexFile gives %d.\n", merged, normalized);
+            same = 0;
+        }
+        else if ((merged == 0) && (findMergeConflicts(&merger, NULL, 0) == 0))
+        {
+            initHexContext(&context, NULL);
+            writeMergedIntelHex(&merger, &context, &writer, HEX_CONVERTER_RECORD_SIZE);
+            same = checkOutputImage("writeMergedIntelHex", output, &expected) && same;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        closeHexMerger(&merger);
+        fclose(output);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    freeMemoryImage(&expected);
+    return same;
+}
+
+/**
+ * @brief This function checks that a converted file is valid and gives the expected memory image.
+ *
+ * @param name The name of the conversion.
+ * @param output The converted file, read from its start.
+ * @param expected The memory image of the file before the conversion.
+ * @return 1 if the converted file gives the same memory image, 0 otherwise.
+ */
+static int8_t checkOutputImage(const char *name, FILE *output, const MemoryImage_t *expected)
+{
+    int8_t same = 0;                    /* Initialize the result */
+    int32_t result = 0;                 /* The result of the memory image of the converted file */
+    int8_t *data = NULL;                /* The content of the converted file */
+    uint64_t size = 0;                  /* The number of bytes of the converted file */
+
+    HexContext_t context;               /* Declaring the context of the converted file */
+    FileReport_t report;                /* Declaring the report of the converted file */
+    MemoryImage_t image;                /* Declaring the memory image of the converted file */
+    ImageDiffSummary_t summary;         /* Declaring the result of the comparison */
+
+    rewind(output);
+    data = readInput(output, &size);
+    initMemoryImage(&image);
+    if (data != NULL)
+    {
+        initHexContext(&context, NULL);
+        result = buildMemoryImageFromBuffer(&context, data, size, &image, &report);
+        if (result != 0)
+        {
+            fprintf(stderr, "%s: the converted file isn't valid (result %d).\n", name, result);
+        }
+        else if (compareMemoryImages(expected, &image, NULL, NULL, &summary) != 0)
+        {
+            fprintf(stderr, "%s: %llu ranges of the memory image differ.\n", name,
+                    (unsigned long long)summary.range_count);
+        }
+        else
+        {
+            same = 1;
+        }
+    }
+    else
+    {
+        fprintf(stderr, "%s: Error: Not enough memory for the converted file.\n", name);
+    }
+    freeMemoryImage(&image);
+    free(data);
+    return same;
+} /* EOF */
@@ -0,0 +1,694 @@
+/**
+ * @file hex_converter.c
+ * @brief This file contains the implementation of the converter functions.
+ *
+ * The data records are given by the single-pass validation of the Intel Hex file analyzer with their absolute
+ * address, resolved with the extended address records like displayRecordInfo does.
+ * The binary file is written through one block: the bytes of the records are copied into the block of their
+ * offset, the block is written when a record falls into another block. A block that is already in the binary file
+ * is read back before it is changed, so the records don't need to be in address order.
+ * The validation before a conversion also looks for a data record that crosses the end of the 4 GiB address space,
+ * the encoder and the binary writer only get addresses that don't wrap.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "hex_converter.h"      /* Include header file of this function file */
+#include "file_mapper.h"        /* Include header file of the file mapper of lower layer */
+#include <stdlib.h>             /* For malloc(), free() functions */
+#include <string.h>             /* For memcpy(), memset() functions */
+
+#if !defined(_WIN32)
+#include <sys/types.h>          /* For off_t type of fseeko() function */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HEX_CONVERTER_PAGE_SIZE     0x10000U    /* The bytes addressed by the 16-bit address field of a record */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of the writing of a binary file.
+ */
+typedef struct
+{
+    FILE *output;               /* The binary file */
+    uint8_t *block;             /* The block being changed */
+    uint8_t *fill_block;        /* A block of fill bytes */
+    int8_t block_loaded;        /* 1 if the block holds the bytes of block_offset */
+    uint64_t block_offset;      /* The offset of the block in the binary file */
+    uint64_t written_size;      /* The number of bytes already in the binary file */
+    uint64_t size;              /* The number of bytes of the binary file at the end */
+    uint64_t first_address;     /* The absolute address of the first byte of the binary file */
+    uint8_t fill;               /* The value of the bytes that no record writes */
+    int8_t failed;              /* 1 if a read or a write of the binary file failed */
+} BinaryWriter_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void findAddressOverflow(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                                uint32_t line_number);
+static void writeBinaryRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                              uint32_t line_number);
+static int8_t loadBinaryBlock(BinaryWriter_t *writer, uint64_t offset);
+static int8_t storeBinaryBlock(BinaryWriter_t *writer);
+static int8_t extendBinaryFile(BinaryWriter_t *writer, uint64_t size);
+static int8_t seekBinaryFile(FILE *output, uint64_t offset);
+static void normalizeRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                            uint32_t line_number);
+static void writeEncodedData(HexEncoder_t *encoder);
+static void writeHexRecord(OutputWriter_t *output, uint32_t record_type, uint32_t address, const uint8_t data[],
+                           uint32_t byte_count);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function validates an Intel Hex file and writes its memory image to a binary file.
+ *
+ * The first byte of the binary file is the lowest address written by the file, or first_address if the range
+ * is clipped. The records can be in any order: a block that is written again is read back from the binary file.
+ * Nothing is written if the file isn't valid.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param output The binary file, opened for update in binary mode ("w+b"), it is written from offset 0.
+ * @param options The fill value and the range of the conversion.
+ * @param report The report structure to store the result of the validation.
+ * @param size Pointer to store the number of bytes of the binary file.
+ * @return 0 if the file is converted, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if the file can't be opened or the binary file can't be written, 4 if there isn't enough memory,
+ *         5 if a data record crosses the end of the 4 GiB address space.
+ */
+int32_t convertIntelHexToBinary(HexContext_t *context, const char *path, FILE *output, const BinaryOptions_t *options,
+                                FileReport_t *report, uint64_t *size)
+{
+    int32_t result = 0;             /* Initialize the result of the conversion */
+    uint64_t last_address = 0;      /* The absolute address of the last byte of the binary file */
+    uint32_t overflow_line = 0;     /* The line of the first data record that crosses the end of the address space */
+
+    MappedFile_t file;              /* Declaring the memory mapping of the file */
+    BinaryWriter_t writer;          /* Declaring the state of the writing of the binary file */
+
+    *size = 0;
+    memset(&writer, 0, sizeof(BinaryWriter_t));
+    writer.output = output;
+    writer.fill = options->fill;
+    /* Map the file into memory */
+    if (mapFile(path, &file) != 0)
+    {
+        memset(report, 0, sizeof(FileReport_t));
+        resetHexContext(context);
+        result = 3;
+    }
+    else
+    {
+        /* Validate the file first, the range of the addresses of the binary file is known at the end */
+        result = visitIntelHexBuffer(context, file.data, file.size, findAddressOverflow, &overflow_line, report);
+        if ((result == 0) && (overflow_line != 0))
+        {
+            result = 5;
+        }
+        else if (result == 0)
+        {
+            if (options->clip)
+            {
+                writer.first_address = options->first_address;
+                last_address = options->last_address;
+            }
+            else
+            {
+                writer.first_address = report->lowest_address;
+                last_address = report->highest_address;
+            }
+            /* A file without data bytes or an empty range gives an empty binary file */
+            if (((report->data_byte_count > 0) || options->clip) && (last_address >= writer.first_address))
+            {
+                writer.size = last_address - writer.first_address + 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            writer.block = (uint8_t *)malloc(2 * HEX_CONVERTER_BLOCK_SIZE);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        if (result != 0)
+        {
+            /* Do nothing */
+        }
+        else if (writer.block == NULL)
+        {
+            result = 4;
+        }
+        else
+        {
+            /* Write the data records while they are decoded a second time */
+            writer.fill_block = writer.block + HEX_CONVERTER_BLOCK_SIZE;
+            memset(writer.fill_block, writer.fill, HEX_CONVERTER_BLOCK_SIZE);
+            visitIntelHexBuffer(context, file.data, file.size, writeBinaryRecord, &writer, report);
+            /* Write the last block and the fill bytes behind the last record */
+            if (!storeBinaryBlock(&writer) || !extendBinaryFile(&writer, writer.size) || (fflush(output) != 0))
+            {
+                writer.failed = 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            result = writer.failed ? 3 : 0;
+            *size = writer.size;
+        }
+        free(writer.block);
+        unmapFile(&file);
+    }
+    /* Return the result of the conversion */
+    return result;
+}
+
+/**
+ * @brief This function validates an Intel Hex file and writes it again as normalized Intel Hex.
+ *
+ * The data bytes are written in the order of the file, the bytes of consecutive addresses are joined into
+ * records of record_size bytes that never cross a 64 KiB page. Only extended linear address records are used,
+ * the start address of the file is kept. Nothing is written if the file isn't valid.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param output The writer of the normalized Intel Hex file, it is flushed at the end.
+ * @param record_size The number of data bytes of a record, 1 to 255.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is converted, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if the file can't be opened, 5 if a data record crosses the end of the 4 GiB address space.
+ */
+int32_t normalizeIntelHexFile(HexContext_t *context, const char *path, OutputWriter_t *output, uint32_t record_size,
+                              FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the conversion */
+    uint32_t overflow_line = 0;     /* The line of the first data record that crosses the end of the address space */
+
+    MappedFile_t file;              /* Declaring the memory mapping of the file */
+    HexEncoder_t encoder;           /* Declaring the state of the writing of the records */
+
+    /* Map the file into memory */
+    if (mapFile(path, &file) != 0)
+    {
+        memset(report, 0, sizeof(FileReport_t));
+        resetHexContext(context);
+        result = 3;
+    }
+    else
+    {
+        /* Validate the file first, then write the records while they are decoded a second time */
+        result = visitIntelHexBuffer(context, file.data, file.size, findAddressOverflow, &overflow_line, report);
+        if ((result == 0) && (overflow_line != 0))
+        {
+            result = 5;
+        }
+        else if (result == 0)
+        {
+            openHexEncoder(&encoder, output, record_size);
+            encoder.start_record_type = report->start_record_type;
+            encoder.start_address = report->start_address;
+            visitIntelHexBuffer(context, file.data, file.size, normalizeRecord, &encoder, report);
+            finishHexEncoder(&encoder);
+            flushOutputWriter(output);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        unmapFile(&file);
+    }
+    /* Return the result of the conversion */
+    return result;
+}
+
+/**
+ * @brief This function writes a binary file as Intel Hex.
+ *
+ * The binary file is read in blocks of HEX_CONVERTER_BLOCK_SIZE bytes.
+ *
+ * @param input The binary file, read from its current position.
+ * @param output The writer of the Intel Hex file, it is flushed at the end.
+ * @param base_address The absolute address of the first byte of the binary file.
+ * @param record_size The number of data bytes of a record, 1 to 255.
+ * @return 0 if the file is converted, 3 if the binary file can't be read or is larger than the address space.
+ */
+int32_t convertBinaryToIntelHex(FILE *input, OutputWriter_t *output, uint32_t base_address, uint32_t record_size)
+{
+    int32_t result = 0;                         /* Initialize the result of the conversion */
+    size_t count = 0;                           /* The number of bytes of a block */
+    uint64_t address = base_address;            /* The absolute address of the next byte */
+    uint8_t block[HEX_CONVERTER_BLOCK_SIZE];    /* The bytes read from the binary file */
+
+    HexEncoder_t encoder;                       /* Declaring the state of the writing of the records */
+
+    openHexEncoder(&encoder, output, record_size);
+    count = fread(block, 1, sizeof(block), input);
+    /* Write each block until the end of the binary file */
+    while ((count > 0) && (result == 0))
+    {
+        /* The addresses end at 4 GiB */
+        if (address + count > HEX_ADDRESS_SPACE_SIZE)
+        {
+            result = 3;
+        }
+        else
+        {
+            encodeHexData(&encoder, (uint32_t)address, block, (uint32_t)count);
+            address += count;
+            count = fread(block, 1, sizeof(block), input);
+        }
+    }
+    if (ferror(input))
+    {
+        result = 3;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    finishHexEncoder(&encoder);
+    flushOutputWriter(output);
+    /* Return the result of the conversion */
+    return result;
+}
+
+/**
+ * @brief This function starts writing Intel Hex records.
+ *
+ * @param encoder The state of the writing.
+ * @param output The writer of the records.
+ * @param record_size The number of data bytes of a full record, 1 to 255, 0 for HEX_CONVERTER_RECORD_SIZE.
+ */
+void openHexEncoder(HexEncoder_t *encoder, OutputWriter_t *output, uint32_t record_size)
+{
+    encoder->output = output;
+    if (record_size == 0)
+    {
+        encoder->record_size = HEX_CONVERTER_RECORD_SIZE;
+    }
+    else if (record_size > RECORD_MAX_DATA_BYTES)
+    {
+        encoder->record_size = RECORD_MAX_DATA_BYTES;
+    }
+    else
+    {
+        encoder->record_size = record_size;
+    }
+    /* The page 0 doesn't need an extended linear address record */
+    encoder->page = 0;
+    encoder->address = 0;
+    encoder->count = 0;
+    encoder->start_record_type = 0;
+    encoder->start_address = 0;
+}
+
+/**
+ * @brief This function writes data bytes at an absolute address.
+ *
+ * The bytes are joined with the bytes written just before them if their addresses follow each other.
+ * A record is written as soon as it is full or reaches the end of a 64 KiB page.
+ * The bytes must not go past the end of the 4 GiB address space.
+ *
+ * @param encoder The state of the writing.
+ * @param address The absolute address of the first byte.
+ * @param data The bytes.
+ * @param count The number of bytes.
+ */
+void encodeHexData(HexEncoder_t *encoder, uint32_t address, const uint8_t data[], uint32_t count)
+{
+    uint32_t i = 0;                 /* The number of bytes collected */
+    uint32_t length = 0;            /* The number of bytes added to the record */
+    uint32_t page_room = 0;         /* The number of bytes to the end of the page of the record */
+
+    while (i < count)
+    {
+        /* The bytes that don't follow the bytes collected start a new record */
+        if ((encoder->count > 0) && (encoder->address + encoder->count != address + i))
+        {
+            writeEncodedData(encoder);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (encoder->count == 0)
+        {
+            encoder->address = address + i;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Add the bytes up to the end of the record or of its page */
+        length = encoder->record_size - encoder->count;
+        page_room = HEX_CONVERTER_PAGE_SIZE - ((encoder->address + encoder->count) & (HEX_CONVERTER_PAGE_SIZE - 1));
+        length = (length > page_room) ? page_room : length;
+        length = (length > count - i) ? count - i : length;
+        memcpy(encoder->data + encoder->count, data + i, length);
+        encoder->count += length;
+        i += length;
+        if ((encoder->count == encoder->record_size) ||
+            (((encoder->address + encoder->count) & (HEX_CONVERTER_PAGE_SIZE - 1)) == 0))
+        {
+            writeEncodedData(encoder);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+}
+
+/**
+ * @brief This function writes the records of the bytes collected, the start address and the End-Of-File record.
+ *
+ * The writer isn't flushed.
+ *
+ * @param encoder The state of the writing.
+ */
+void finishHexEncoder(HexEncoder_t *encoder)
+{
+    uint8_t start[4];               /* The data of the start address record */
+
+    writeEncodedData(encoder);
+    if (encoder->start_record_type != 0)
+    {
+        start[0] = (uint8_t)(encoder->start_address >> 24);
+        start[1] = (uint8_t)((encoder->start_address >> 16) & 0xFF);
+        start[2] = (uint8_t)((encoder->start_address >> 8) & 0xFF);
+        start[3] = (uint8_t)(encoder->start_address & 0xFF);
+        writeHexRecord(encoder->output, encoder->start_record_type, 0, start, 4);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    writeHexRecord(encoder->output, 0x01, 0, NULL, 0);
+}
+
+/**
+ * @brief This function finds the first data record that crosses the end of the 4 GiB address space, it is the visitor
+ *        of the validation before a conversion.
+ *
+ * @param visitor_context Pointer to the line of the first data record found, 0 while there is none.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void findAddressOverflow(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                                uint32_t line_number)
+{
+    uint32_t *overflow_line = (uint32_t *)visitor_context;      /* The line of the first data record found */
+
+    if ((record->record_type == 0x00) && (*overflow_line == 0) &&
+        ((uint64_t)absolute_address + record->byte_count > HEX_ADDRESS_SPACE_SIZE))
+    {
+        *overflow_line = line_number;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function copies the data of a valid record to the binary file, it is the visitor of the validation.
+ *
+ * @param visitor_context The state of the writing of the binary file.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void writeBinaryRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                              uint32_t line_number)
+{
+    BinaryWriter_t *writer = (BinaryWriter_t *)visitor_context;     /* The state of the writing */
+    uint64_t first = absolute_address;          /* The address of the first byte copied */
+    uint64_t end = first + record->byte_count;  /* The address behind the last byte copied */
+    uint64_t offset = 0;                        /* The offset of the next byte in the binary file */
+    uint64_t length = 0;                        /* The number of bytes copied into one block */
+
+    (void)line_number;
+    /* Only the bytes of data records inside the range are copied */
+    if (record->record_type == 0x00)
+    {
+        first = (first < writer->first_address) ? writer->first_address : first;
+        end = (end > writer->first_address + writer->size) ? writer->first_address + writer->size : end;
+        while ((first < end) && !writer->failed)
+        {
+            offset = first - writer->first_address;
+            if (!loadBinaryBlock(writer, offset - (offset % HEX_CONVERTER_BLOCK_SIZE)))
+            {
+                writer->failed = 1;
+            }
+            else
+            {
+                length = HEX_CONVERTER_BLOCK_SIZE - (offset - writer->block_offset);
+                length = (length > end - first) ? end - first : length;
+                memcpy(writer->block + (offset - writer->block_offset), record->data + (first - absolute_address),
+                       (size_t)length);
+                first += length;
+            }
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function makes a block of the binary file the block being changed.
+ *
+ * The block being changed before is written first. The bytes of the new block that are already in the binary file
+ * are read back, the other bytes get the fill value.
+ *
+ * @param writer The state of the writing.
+ * @param offset The offset of the block, a multiple of HEX_CONVERTER_BLOCK_SIZE.
+ * @return 1 if the block is loaded, 0 if a read or a write failed.
+ */
+static int8_t loadBinaryBlock(BinaryWriter_t *writer, uint64_t offset)
+{
+    int8_t loaded = 1;              /* Initialize the result */
+    uint64_t length = 0;            /* The number of bytes of the block already in the binary file */
+
+    if (writer->block_loaded && (writer->block_offset == offset))
+    {
+        /* Do nothing */
+    }
+    else if (!storeBinaryBlock(writer))
+    {
+        loaded = 0;
+    }
+    else
+    {
+        memset(writer->block, writer->fill, HEX_CONVERTER_BLOCK_SIZE);
+        if (offset < writer->written_size)
+        {
+            length = writer->written_size - offset;
+            length = (length > HEX_CONVERTER_BLOCK_SIZE) ? HEX_CONVERTER_BLOCK_SIZE : length;
+            loaded = seekBinaryFile(writer->output, offset) &&
+                     (fread(writer->block, 1, (size_t)length, writer->output) == (size_t)length);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        writer->block_offset = offset;
+        writer->block_loaded = loaded;
+    }
+    return loaded;
+}
+
+/**
+ * @brief This function writes the block being changed to the binary file.
+ *
+ * The gap between the end of the binary file and the block is filled first.
+ *
+ * @param writer The state of the writing.
+ * @return 1 if the block is written or if no block is loaded, 0 if a write failed.
+ */
+static int8_t storeBinaryBlock(BinaryWriter_t *writer)
+{
+    int8_t stored = 1;              /* Initialize the result */
+    uint64_t length = 0;            /* The number of bytes of the block inside the binary file */
+
+    if (writer->block_loaded)
+    {
+        length = writer->size - writer->block_offset;
+        length = (length > HEX_CONVERTER_BLOCK_SIZE) ? HEX_CONVERTER_BLOCK_SIZE : length;
+        stored = extendBinaryFile(writer, writer->block_offset) && seekBinaryFile(writer->output, writer->block_offset) &&
+                 (fwrite(writer->block, 1, (size_t)length, writer->output) == (size_t)length);
+        if (writer->block_offset + length > writer->written_size)
+        {
+            writer->written_size = writer->block_offset + length;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        writer->block_loaded = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return stored;
+}
+
+/**
+ * @brief This function makes the binary file at least size bytes long with fill bytes.
+ *
+ * If the fill value is 0, only the last byte is written: the seek leaves a hole in the file,
+ * which reads as 0 and takes no space on the file systems that support sparse files.
+ *
+ * @param writer The state of the writing.
+ * @param size The number of bytes of the binary file.
+ * @return 1 if the file is extended, 0 if a write failed.
+ */
+static int8_t extendBinaryFile(BinaryWriter_t *writer, uint64_t size)
+{
+    int8_t extended = 1;            /* Initialize the result */
+    uint64_t length = 0;            /* The number of bytes of one write */
+
+    if (writer->written_size >= size)
+    {
+        /* Do nothing */
+    }
+    else if (writer->fill == 0)
+    {
+        extended = seekBinaryFile(writer->output, size - 1) && (fwrite(writer->fill_block, 1, 1, writer->output) == 1);
+        writer->written_size = size;
+    }
+    else
+    {
+        extended = seekBinaryFile(writer->output, writer->written_size);
+        while (extended && (writer->written_size < size))
+        {
+            length = size - writer->written_size;
+            length = (length > HEX_CONVERTER_BLOCK_SIZE) ? HEX_CONVERTER_BLOCK_SIZE : length;
+            extended = (fwrite(writer->fill_block, 1, (size_t)length, writer->output) == (size_t)length);
+            writer->written_size += length;
+        }
+    }
+    return extended;
+}
+
+/**
+ * @brief This function moves the position of the binary file, the offset can be larger than 2 GiB.
+ *
+ * @param output The binary file.
+ * @param offset The offset from the beginning of the file.
+ * @return 1 if the position is moved, 0 otherwise.
+ */
+static int8_t seekBinaryFile(FILE *output, uint64_t offset)
+{
+#if defined(_WIN32)
+    return (_fseeki64(output, (__int64)offset, SEEK_SET) == 0);
+#else
+    return (fseeko(output, (off_t)offset, SEEK_SET) == 0);
+#endif
+}
+
+/**
+ * @brief This function writes a valid record again as normalized Intel Hex, it is the visitor of the validation.
+ *
+ * The data records are given to the encoder with their absolute address, the extended address records
+ * aren't written because the encoder writes its own. The start address of the report is written at the end.
+ *
+ * @param visitor_context The state of the writing of the records.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void normalizeRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                            uint32_t line_number)
+{
+    HexEncoder_t *encoder = (HexEncoder_t *)visitor_context;     /* The state of the writing */
+
+    (void)line_number;
+    if (record->record_type == 0x00)
+    {
+        encodeHexData(encoder, absolute_address, record->data, record->byte_count);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function writes the bytes collected by the encoder as a data record.
+ *
+ * An extended linear address record is written first if the record is in another page than the previous record.
+ *
+ * @param encoder The state of the writing.
+ */
+static void writeEncodedData(HexEncoder_t *encoder)
+{
+    uint8_t page[2];                /* The data of the extended linear address record */
+
+    if (encoder->count > 0)
+    {
+        if ((encoder->address >> 16) != encoder->page)
+        {
+            encoder->page = encoder->address >> 16;
+            page[0] = (uint8_t)(encoder->page >> 8);
+            page[1] = (uint8_t)(encoder->page & 0xFF);
+            writeHexRecord(encoder->output, 0x04, 0, page, 2);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        writeHexRecord(encoder->output, 0x00, encoder->address & 0xFFFF, encoder->data, encoder->count);
+        encoder->count = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function writes one Intel Hex record with its checksum.
+ *
+ * @param output The writer of the record.
+ * @param record_type The record type.
+ * @param address The 16-bit address field.
+ * @param data The data field.
+ * @param byte_count The number of data bytes.
+ */
+static void writeHexRecord(OutputWriter_t *output, uint32_t record_type, uint32_t address, const uint8_t data[],
+                           uint32_t byte_count)
+{
+    uint32_t i = 0;                 /* Loop counter */
+    uint32_t sum = byte_count + (address >> 8) + (address & 0xFF) + record_type;   /* The sum of the bytes of the record */
+
+    for (i = 0; i < byte_count; i++)
+    {
+        sum += data[i];
+    }
+    writeString(output, ":");
+    writeHex(output, byte_count, 2);
+    writeHex(output, address, 4);
+    writeHex(output, record_type, 2);
+    writeHexBytes(output, data, byte_count);
+    /* The checksum is the two's complement of the sum of the other bytes */
+    writeHex(output, (0x100 - (sum & 0xFF)) & 0xFF, 2);
+    writeString(output, "\n");
+} /* EOF */
@@ -0,0 +1,155 @@
+/**
+ * @file hex_converter.h
+ * @brief This file contains the prototypes of the converter functions.
+ *
+ * The converter turns a valid Intel Hex file into a flat binary file, re-emits it as normalized Intel Hex
+ * (records of one size, extended linear address records only) and turns a binary file into Intel Hex.
+ * The Intel Hex file is validated first, then its records are decoded a second time by the single-pass validation
+ * and written while they are decoded, so the memory used doesn't depend on the size of the file.
+ * The binary file is written in blocks of HEX_CONVERTER_BLOCK_SIZE bytes aligned on their offset. The bytes
+ * between the records get the fill value, a gap filled with 0 is skipped with a seek, so an image that spans
+ * several GiB is written as a sparse file on the file systems that support it.
+ * Both conversions of an Intel Hex file reject a data record whose bytes go past the end of the 4 GiB address space,
+ * so its addresses never wrap to 0.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef HEX_CONVERTER_H
+#define HEX_CONVERTER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HEX_CONVERTER_BLOCK_SIZE    (64 * 1024)     /* The size of the blocks of the binary file */
+#define HEX_CONVERTER_RECORD_SIZE   16              /* The default number of data bytes of a written record */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the options of the conversion to a binary file.
+ */
+typedef struct
+{
+    uint8_t fill;               /* The value of the bytes that no record writes */
+    int8_t clip;                /* 1 to convert only the addresses from first_address to last_address */
+    uint32_t first_address;     /* The absolute address of the first byte of the binary file if clip is 1 */
+    uint32_t last_address;      /* The absolute address of the last byte of the binary file if clip is 1 */
+} BinaryOptions_t;
+
+/**
+ * @brief Structure to hold the state of the writing of Intel Hex records.
+ *
+ * The data bytes of consecutive addresses are collected until a record is full, an extended linear address record
+ * is written in front of the first record of every 64 KiB page.
+ */
+typedef struct
+{
+    OutputWriter_t *output;                     /* The writer of the records */
+    uint32_t record_size;                       /* The number of data bytes of a full record */
+    uint32_t page;                              /* The upper 16 bits of the address of the last extended linear address record */
+    uint32_t address;                           /* The absolute address of the first byte collected */
+    uint32_t count;                             /* The number of bytes collected */
+    uint8_t data[RECORD_MAX_DATA_BYTES];        /* The bytes collected */
+    uint32_t start_record_type;                 /* Record type of the start address written at the end (0x03 or 0x05), 0 for none */
+    uint32_t start_address;                     /* The start address, like the start address of FileReport_t */
+} HexEncoder_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function validates an Intel Hex file and writes its memory image to a binary file.
+ *
+ * The first byte of the binary file is the lowest address written by the file, or first_address if the range
+ * is clipped. The records can be in any order: a block that is written again is read back from the binary file.
+ * Nothing is written if the file isn't valid.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param output The binary file, opened for update in binary mode ("w+b"), it is written from offset 0.
+ * @param options The fill value and the range of the conversion.
+ * @param report The report structure to store the result of the validation.
+ * @param size Pointer to store the number of bytes of the binary file.
+ * @return 0 if the file is converted, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if the file can't be opened or the binary file can't be written, 4 if there isn't enough memory,
+ *         5 if a data record crosses the end of the 4 GiB address space.
+ */
+int32_t convertIntelHexToBinary(HexContext_t *context, const char *path, FILE *output, const BinaryOptions_t *options,
+                                FileReport_t *report, uint64_t *size);
+
+/**
+ * @brief This function validates an Intel Hex file and writes it again as normalized Intel Hex.
+ *
+ * The data bytes are written in the order of the file, the bytes of consecutive addresses are joined into
+ * records of record_size bytes that never cross a 64 KiB page. Only extended linear address records are used,
+ * the start address of the file is kept. Nothing is written if the file isn't valid.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param output The writer of the normalized Intel Hex file, it is flushed at the end.
+ * @param record_size The number of data bytes of a record, 1 to 255.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is converted, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if the file can't be opened, 5 if a data record crosses the end of the 4 GiB address space.
+ */
+int32_t normalizeIntelHexFile(HexContext_t *context, const char *path, OutputWriter_t *output, uint32_t record_size,
+                              FileReport_t *report);
+
+/**
+ * @brief This function writes a binary file as Intel Hex.
+ *
+ * The binary file is read in blocks of HEX_CONVERTER_BLOCK_SIZE bytes.
+ *
+ * @param input The binary file, read from its current position.
+ * @param output The writer of the Intel Hex file, it is flushed at the end.
+ * @param base_address The absolute address of the first byte of the binary file.
+ * @param record_size The number of data bytes of a record, 1 to 255.
+ * @return 0 if the file is converted, 3 if the binary file can't be read or is larger than the address space.
+ */
+int32_t convertBinaryToIntelHex(FILE *input, OutputWriter_t *output, uint32_t base_address, uint32_t record_size);
+
+/**
+ * @brief This function starts writing Intel Hex records.
+ *
+ * @param encoder The state of the writing.
+ * @param output The writer of the records.
+ * @param record_size The number of data bytes of a full record, 1 to 255, 0 for HEX_CONVERTER_RECORD_SIZE.
+ */
+void openHexEncoder(HexEncoder_t *encoder, OutputWriter_t *output, uint32_t record_size);
+
+/**
+ * @brief This function writes data bytes at an absolute address.
+ *
+ * The bytes are joined with the bytes written just before them if their addresses follow each other.
+ * A record is written as soon as it is full or reaches the end of a 64 KiB page.
+ * The bytes must not go past the end of the 4 GiB address space.
+ *
+ * @param encoder The state of the writing.
+ * @param address The absolute address of the first byte.
+ * @param data The bytes.
+ * @param count The number of bytes.
+ */
+void encodeHexData(HexEncoder_t *encoder, uint32_t address, const uint8_t data[], uint32_t count);
+
+/**
+ * @brief This function writes the records of the bytes collected, the start address and the End-Of-File record.
+ *
+ * The writer isn't flushed.
+ *
+ * @param encoder The state of the writing.
+ */
+void finishHexEncoder(HexEncoder_t *encoder);
+
+#endif /* HEX_CONVERTER_H */
@@ -0,0 +1,557 @@
+/**
+ * @file hex_decoder.c
+ * @brief This file contains the implementation of the hexadecimal decoder functions.
+ *
+ * The hexadecimal decoder converts the ASCII hexadecimal characters of a record to bytes.
+ * It provides functions decodeHexDigit and decodeHexByte to decode one digit or one byte with a lookup table
+ * and function decodeHexData to decode, validate and sum a whole field of bytes.
+ * Function decodeHexData uses a vectorized kernel (AVX2 or SSSE3) selected at runtime for the CPU,
+ * with a scalar kernel as fallback that produces exactly the same results, the other CPUs (AArch64 too) use the scalar kernel.
+ * Function findInvalidHexCharacter finds the first character that can't be part of an Intel Hex file
+ * with a kernel of the same instruction set, it is the prefilter that rejects files that aren't Intel Hex at all.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "hex_decoder.h"        /* Include header file of this function file */
+
+/* A freestanding build has no vectorized kernel, the runtime CPU detection needs the C library */
+#if !HEX_FREESTANDING && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HEX_DECODER_X86 1
+#include <immintrin.h>          /* For the SSSE3 and AVX2 intrinsics */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HEX_INVALID_DIGIT   0xFF    /* Value of the characters that aren't hexadecimal digits in hex_digit_table */
+
+/**
+ * @brief Type of the kernel functions, same parameters and return value as decodeHexData.
+ */
+typedef int32_t (*DecodeKernel_t)(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum);
+
+/**
+ * @brief Type of the scan kernel functions, same parameters and return value as findInvalidHexCharacter.
+ */
+typedef uint64_t (*ScanKernel_t)(const int8_t text[], uint64_t length);
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static int32_t decodeScalar(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum);
+static int32_t decodeResolve(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum);
+static uint64_t scanScalar(const int8_t text[], uint64_t length);
+static uint64_t scanResolve(const int8_t text[], uint64_t length);
+static void setKernel(DecodeKernel_t decode, ScanKernel_t scan, const char *name);
+#if defined(HEX_DECODER_X86)
+static int32_t decodeSSSE3(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum);
+static int32_t decodeAVX2(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum);
+static uint64_t scanSSSE3(const int8_t text[], uint64_t length);
+static uint64_t scanAVX2(const int8_t text[], uint64_t length);
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/**
+ * @brief Lookup table to convert an ASCII character to the value of the hexadecimal digit.
+ *
+ * The characters '0'-'9', 'A'-'F' and 'a'-'f' have the value 0x00 to 0x0F,
+ * all other characters have the value HEX_INVALID_DIGIT.
+ */
+static const uint8_t hex_digit_table[256] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+/* The kernels are resolved at the first call of any thread, they are only accessed with atomic loads and stores */
+static DecodeKernel_t decode_kernel = decodeResolve;    /* The kernel used by decodeHexData, resolved at the first call */
+static ScanKernel_t scan_kernel = scanResolve;          /* The kernel used by findInvalidHexCharacter, resolved with decode_kernel */
+static const char *kernel_name = "scalar";              /* The name of the kernel used by decodeHexData */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function converts one hexadecimal character to the value of the digit.
+ *
+ * @param character The character.
+ * @param value Pointer to store the value of the digit (0x00 to 0x0F).
+ * @return 1 if the character is a hexadecimal digit, 0 if not.
+ */
+int32_t decodeHexDigit(int8_t character, uint32_t *value)
+{
+    *value = hex_digit_table[(uint8_t)character];
+    return (*value & 0xF0) == 0;
+}
+
+/**
+ * @brief This function converts two hexadecimal characters to a byte.
+ *
+ * @param text Pointer to the two characters.
+ * @param value Pointer to store the value of the byte.
+ * @return 1 if both characters are hexadecimal digits, 0 if not.
+ */
+int32_t decodeHexByte(const int8_t text[], uint32_t *value)
+{
+    uint8_t high = hex_digit_table[(uint8_t)text[0]];   /* Value of the high nibble */
+    uint8_t low = hex_digit_table[(uint8_t)text[1]];    /* Value of the low nibble */
+
+    *value = ((uint32_t)high << 4) | low;
+    /* Both nibbles are valid only if none of them is HEX_INVALID_DIGIT */
+    return ((high | low) & 0xF0) == 0;
+}
+
+/**
+ * @brief This function checks if all characters of a text are hexadecimal digits.
+ *
+ * @param text Pointer to the characters.
+ * @param length The number of characters.
+ * @return 1 if all characters are hexadecimal digits, 0 if not.
+ */
+int32_t isHexText(const int8_t text[], uint32_t length)
+{
+    uint32_t i = 0;             /* Loop counter */
+    uint8_t invalid = 0;        /* The bits of HEX_INVALID_DIGIT collected from all characters */
+
+    for (i = 0; i < length; i++)
+    {
+        invalid |= hex_digit_table[(uint8_t)text[i]];
+    }
+    return (invalid & 0xF0) == 0;
+}
+
+/**
+ * @brief This function decodes a field of hexadecimal characters to bytes.
+ *
+ * The function converts byte_count * 2 characters to byte_count bytes and adds all the decoded bytes together,
+ * so the checksum of a record is checked by decoding the data and checksum fields in one call.
+ * If a character isn't a hexadecimal digit, the content of data and sum is undefined.
+ *
+ * @param text Pointer to the hexadecimal characters.
+ * @param byte_count The number of bytes to decode.
+ * @param data The array to store the decoded bytes, at least byte_count bytes.
+ * @param sum Pointer to store the sum of all decoded bytes.
+ * @return 1 if all characters are hexadecimal digits, 0 if not.
+ */
+int32_t decodeHexData(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum)
+{
+    DecodeKernel_t kernel = __atomic_load_n(&decode_kernel, __ATOMIC_ACQUIRE);  /* The kernel to use */
+
+    return kernel(text, byte_count, data, sum);
+}
+
+/**
+ * @brief This function finds the first character that can't be part of an Intel Hex file.
+ *
+ * The characters of an Intel Hex file are the hexadecimal digits, the start code ':' and the line terminators
+ * CR and LF, any other character makes the record of its line invalid.
+ * The text is scanned with the kernel selected for decodeHexData, 16 or 32 characters per iteration.
+ *
+ * @param text Pointer to the characters.
+ * @param length The number of characters.
+ * @return The offset of the first invalid character, length if all characters are valid.
+ */
+uint64_t findInvalidHexCharacter(const int8_t text[], uint64_t length)
+{
+    ScanKernel_t kernel = __atomic_load_n(&scan_kernel, __ATOMIC_ACQUIRE);  /* The kernel to use */
+
+    return kernel(text, length);
+}
+
+/**
+ * @brief This function selects the kernel used by decodeHexData and findInvalidHexCharacter.
+ *
+ * HEX_KERNEL_AUTO selects the fastest kernel supported by the CPU, this is also the default.
+ * The kernel is shared by the whole process, it isn't part of the context of a file: it must be selected
+ * before the threads that decode records are started. Without a selection the default kernel is resolved
+ * atomically at the first call, so threads that validate different files at the same time need no selection.
+ *
+ * @param kernel The kernel to use.
+ * @return 0 if the kernel is selected, 1 if the kernel isn't supported by this build or this CPU.
+ */
+int32_t selectHexKernel(HexKernel_t kernel)
+{
+    int32_t error_code = 0;     /* Error code, initialized to 0 */
+
+#if defined(HEX_DECODER_X86)
+    __builtin_cpu_init();
+#endif
+    switch (kernel)
+    {
+        case HEX_KERNEL_AUTO:
+        {
+            /* Try the kernels from the fastest to the slowest */
+            if ((selectHexKernel(HEX_KERNEL_AVX2) != 0) && (selectHexKernel(HEX_KERNEL_SSSE3) != 0))
+            {
+                selectHexKernel(HEX_KERNEL_SCALAR);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            break;
+        }
+        case HEX_KERNEL_SCALAR:
+        {
+            setKernel(decodeScalar, scanScalar, "scalar");
+            break;
+        }
+#if defined(HEX_DECODER_X86)
+        case HEX_KERNEL_SSSE3:
+        {
+            if (__builtin_cpu_supports("ssse3"))
+            {
+                setKernel(decodeSSSE3, scanSSSE3, "ssse3");
+            }
+            else
+            {
+                error_code = 1;
+            }
+            break;
+        }
+        case HEX_KERNEL_AVX2:
+        {
+            if (__builtin_cpu_supports("avx2"))
+            {
+                setKernel(decodeAVX2, scanAVX2, "avx2");
+            }
+            else
+            {
+                error_code = 1;
+            }
+            break;
+        }
+#endif
+        /* The kernel isn't available in this build */
+        default:
+        {
+            error_code = 1;
+        }
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function returns the name of the kernel used by decodeHexData.
+ *
+ * @return The name of the kernel ("scalar", "ssse3" or "avx2").
+ */
+const char *getHexKernelName(void)
+{
+    /* Resolve the kernel if decodeHexData hasn't been called yet */
+    if (__atomic_load_n(&decode_kernel, __ATOMIC_ACQUIRE) == decodeResolve)
+    {
+        selectHexKernel(HEX_KERNEL_AUTO);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return __atomic_load_n(&kernel_name, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief This function selects the fastest kernel at the first call of decodeHexData.
+ *
+ * The parameters and return value are the same as decodeHexData.
+ */
+static int32_t decodeResolve(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum)
+{
+    selectHexKernel(HEX_KERNEL_AUTO);
+    return decodeHexData(text, byte_count, data, sum);
+}
+
+/**
+ * @brief This function selects the fastest kernel at the first call of findInvalidHexCharacter.
+ *
+ * The parameters and return value are the same as findInvalidHexCharacter.
+ */
+static uint64_t scanResolve(const int8_t text[], uint64_t length)
+{
+    selectHexKernel(HEX_KERNEL_AUTO);
+    return findInvalidHexCharacter(text, length);
+}
+
+/**
+ * @brief This function sets the kernels used by decodeHexData and findInvalidHexCharacter.
+ *
+ * The kernels are stored atomically: a thread that decodes while another thread resolves the kernels uses either
+ * the resolver or a resolved kernel, and all kernels give the same results.
+ *
+ * @param decode The kernel of decodeHexData.
+ * @param scan The kernel of findInvalidHexCharacter.
+ * @param name The name of the kernels.
+ */
+static void setKernel(DecodeKernel_t decode, ScanKernel_t scan, const char *name)
+{
+    __atomic_store_n(&kernel_name, name, __ATOMIC_RELEASE);
+    __atomic_store_n(&scan_kernel, scan, __ATOMIC_RELEASE);
+    __atomic_store_n(&decode_kernel, decode, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief This function is the scalar kernel of decodeHexData, it decodes one byte per iteration.
+ *
+ * The parameters and return value are the same as decodeHexData.
+ */
+static int32_t decodeScalar(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum)
+{
+    uint32_t i = 0;             /* Loop counter */
+    uint32_t total = 0;         /* The sum of the decoded bytes */
+    uint8_t invalid = 0;        /* The bits of HEX_INVALID_DIGIT collected from all characters */
+    uint8_t high = 0;           /* Value of the high nibble */
+    uint8_t low = 0;            /* Value of the low nibble */
+
+    for (i = 0; i < byte_count; i++)
+    {
+        high = hex_digit_table[(uint8_t)text[i * 2]];
+        low = hex_digit_table[(uint8_t)text[(i * 2) + 1]];
+        invalid |= high | low;
+        data[i] = (uint8_t)((high << 4) | low);
+        total += data[i];
+    }
+    *sum = total;
+    /* All characters are valid only if no HEX_INVALID_DIGIT has been found */
+    return (invalid & 0xF0) == 0;
+}
+
+/**
+ * @brief This function is the scalar kernel of findInvalidHexCharacter, it checks one character per iteration.
+ *
+ * The parameters and return value are the same as findInvalidHexCharacter.
+ */
+static uint64_t scanScalar(const int8_t text[], uint64_t length)
+{
+    uint64_t i = 0;             /* Offset of the checked character */
+    uint8_t character = 0;      /* The checked character */
+    int8_t found = 0;           /* Initialize a flag to indicate if an invalid character is found */
+
+    while ((i < length) && !found)
+    {
+        character = (uint8_t)text[i];
+        if (((hex_digit_table[character] & 0xF0) == 0) || (character == ':') || (character == '\r') ||
+            (character == '\n'))
+        {
+            i++;
+        }
+        else
+        {
+            found = 1;
+        }
+    }
+    return i;
+}
+
+#if defined(HEX_DECODER_X86)
+/**
+ * @brief This function converts 16 hexadecimal characters to the values of the nibbles.
+ *
+ * @param chars The 16 characters.
+ * @param valid Pointer to the mask of valid characters, the invalid characters are removed from the mask.
+ * @return The 16 values of the nibbles.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i nibblesSSSE3(__m128i chars, __m128i *valid)
+{
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));                                /* '0'-'9' become 0-9 */
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a')); /* 'A'-'F', 'a'-'f' become 0-5 */
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);        /* Characters '0'-'9' */
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);        /* Characters 'A'-'F', 'a'-'f' */
+
+    *valid = _mm_and_si128(*valid, _mm_or_si128(is_digit, is_alpha));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+/**
+ * @brief This function is the SSSE3 kernel of decodeHexData, it decodes 16 bytes per iteration.
+ *
+ * The pairs of nibbles are combined with _mm_maddubs_epi16 (high * 16 + low) and packed to bytes,
+ * the bytes are added together with _mm_sad_epu8.
+ * The parameters and return value are the same as decodeHexData.
+ */
+__attribute__((target("ssse3")))
+static int32_t decodeSSSE3(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum)
+{
+    uint32_t i = 0;                                 /* Number of decoded bytes */
+    uint32_t tail_sum = 0;                          /* The sum of the bytes decoded by the scalar kernel */
+    int32_t tail_valid = 1;                         /* The result of the scalar kernel */
+    __m128i valid = _mm_set1_epi8(-1);              /* The mask of valid characters */
+    __m128i total = _mm_setzero_si128();            /* The two 64-bit sums of the decoded bytes */
+    __m128i weights = _mm_set1_epi16(0x0110);       /* Weight 16 for the high nibble, 1 for the low nibble */
+    __m128i first;                                  /* Characters 0-15 of an iteration */
+    __m128i second;                                 /* Characters 16-31 of an iteration */
+    __m128i bytes;                                  /* The 16 decoded bytes of an iteration */
+
+    for (i = 0; i + 16 <= byte_count; i += 16)
+    {
+        first = nibblesSSSE3(_mm_loadu_si128((const __m128i *)(text + (i * 2))), &valid);
+        second = nibblesSSSE3(_mm_loadu_si128((const __m128i *)(text + (i * 2) + 16)), &valid);
+        bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128((__m128i *)(data + i), bytes);
+        total = _mm_add_epi64(total, _mm_sad_epu8(bytes, _mm_setzero_si128()));
+    }
+    /* Decode the remaining bytes with the scalar kernel */
+    tail_valid = decodeScalar(text + (i * 2), byte_count - i, data + i, &tail_sum);
+    *sum = (uint32_t)(_mm_cvtsi128_si32(total) + _mm_cvtsi128_si32(_mm_srli_si128(total, 8))) + tail_sum;
+    return tail_valid && (_mm_movemask_epi8(valid) == 0xFFFF);
+}
+
+/**
+ * @brief This function is the SSSE3 kernel of findInvalidHexCharacter, it checks 16 characters per iteration.
+ *
+ * The characters '0' to ':' are contiguous, so the digits and the start code are checked with one comparison.
+ * The parameters and return value are the same as findInvalidHexCharacter.
+ */
+__attribute__((target("ssse3")))
+static uint64_t scanSSSE3(const int8_t text[], uint64_t length)
+{
+    uint64_t i = 0;                                 /* Offset of the checked characters */
+    int32_t mask = 0xFFFF;                          /* The bits of the valid characters of an iteration */
+    __m128i chars;                                  /* The characters of an iteration */
+    __m128i digit;                                  /* '0'-'9' and ':' become 0-10 */
+    __m128i alpha;                                  /* 'A'-'F' and 'a'-'f' become 0-5 */
+    __m128i valid;                                  /* The mask of valid characters */
+
+    for (i = 0; (i + 16 <= length) && (mask == 0xFFFF); i += 16)
+    {
+        chars = _mm_loadu_si128((const __m128i *)(text + i));
+        digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        valid = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(10)), digit),
+                             _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha));
+        valid = _mm_or_si128(valid, _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')),
+                                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'))));
+        mask = _mm_movemask_epi8(valid);
+    }
+    /* The lowest cleared bit of the iteration in front of i is the first invalid character,
+    the remaining characters are checked by the scalar kernel */
+    if (mask != 0xFFFF)
+    {
+        i = i - 16 + (uint64_t)__builtin_ctz(~(uint32_t)mask);
+    }
+    else
+    {
+        i += scanScalar(text + i, length - i);
+    }
+    return i;
+}
+
+/**
+ * @brief This function converts 32 hexadecimal characters to the values of the nibbles.
+ *
+ * @param chars The 32 characters.
+ * @param valid Pointer to the mask of valid characters, the invalid characters are removed from the mask.
+ * @return The 32 values of the nibbles.
+ */
+__attribute__((target("avx2")))
+static inline __m256i nibblesAVX2(__m256i chars, __m256i *valid)
+{
+    __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    *valid = _mm256_and_si256(*valid, _mm256_or_si256(is_digit, is_alpha));
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                           _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+/**
+ * @brief This function is the AVX2 kernel of decodeHexData, it decodes 32 bytes per iteration.
+ *
+ * Same algorithm as the SSSE3 kernel, _mm256_packus_epi16 packs inside each 128-bit lane so the
+ * 64-bit quarters are put back in order with _mm256_permute4x64_epi64.
+ * The parameters and return value are the same as decodeHexData.
+ */
+__attribute__((target("avx2")))
+static int32_t decodeAVX2(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum)
+{
+    uint32_t i = 0;                                 /* Number of decoded bytes */
+    uint32_t tail_sum = 0;                          /* The sum of the bytes decoded by the SSSE3 kernel */
+    int32_t tail_valid = 1;                         /* The result of the SSSE3 kernel */
+    __m256i valid = _mm256_set1_epi8(-1);           /* The mask of valid characters */
+    __m256i total = _mm256_setzero_si256();         /* The four 64-bit sums of the decoded bytes */
+    __m256i weights = _mm256_set1_epi16(0x0110);    /* Weight 16 for the high nibble, 1 for the low nibble */
+    __m256i first;                                  /* Characters 0-31 of an iteration */
+    __m256i second;                                 /* Characters 32-63 of an iteration */
+    __m256i bytes;                                  /* The 32 decoded bytes of an iteration */
+    __m128i half;                                   /* The sum of the two halves of total */
+
+    for (i = 0; i + 32 <= byte_count; i += 32)
+    {
+        first = nibblesAVX2(_mm256_loadu_si256((const __m256i *)(text + (i * 2))), &valid);
+        second = nibblesAVX2(_mm256_loadu_si256((const __m256i *)(text + (i * 2) + 32)), &valid);
+        bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        bytes = _mm256_permute4x64_epi64(bytes, 0xD8);
+        _mm256_storeu_si256((__m256i *)(data + i), bytes);
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    /* Decode the remaining bytes with the SSSE3 kernel */
+    tail_valid = decodeSSSE3(text + (i * 2), byte_count - i, data + i, &tail_sum);
+    half = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    *sum = (uint32_t)(_mm_cvtsi128_si32(half) + _mm_cvtsi128_si32(_mm_srli_si128(half, 8))) + tail_sum;
+    return tail_valid && (_mm256_movemask_epi8(valid) == -1);
+}
+
+/**
+ * @brief This function is the AVX2 kernel of findInvalidHexCharacter, it checks 32 characters per iteration.
+ *
+ * Same algorithm as the SSSE3 kernel, the remaining characters are checked by the SSSE3 kernel.
+ * The parameters and return value are the same as findInvalidHexCharacter.
+ */
+__attribute__((target("avx2")))
+static uint64_t scanAVX2(const int8_t text[], uint64_t length)
+{
+    uint64_t i = 0;                                 /* Offset of the checked characters */
+    int32_t mask = -1;                              /* The bits of the valid characters of an iteration */
+    __m256i chars;                                  /* The characters of an iteration */
+    __m256i digit;                                  /* '0'-'9' and ':' become 0-10 */
+    __m256i alpha;                                  /* 'A'-'F' and 'a'-'f' become 0-5 */
+    __m256i valid;                                  /* The mask of valid characters */
+
+    for (i = 0; (i + 32 <= length) && (mask == -1); i += 32)
+    {
+        chars = _mm256_loadu_si256((const __m256i *)(text + i));
+        digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+        alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        valid = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(10)), digit),
+                                _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha));
+        valid = _mm256_or_si256(valid, _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\r')),
+                                                       _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n'))));
+        mask = _mm256_movemask_epi8(valid);
+    }
+    /* The lowest cleared bit of the iteration in front of i is the first invalid character,
+    the remaining characters are checked by the SSSE3 kernel */
+    if (mask != -1)
+    {
+        i = i - 32 + (uint64_t)__builtin_ctz(~(uint32_t)mask);
+    }
+    else
+    {
+        i += scanSSSE3(text + i, length - i);
+    }
+    return i;
+}
+#endif /* EOF */
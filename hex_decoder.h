@@ -0,0 +1,128 @@
+/**
+ * @file hex_decoder.h
+ * @brief This file contains the prototypes of the hexadecimal decoder functions.
+ *
+ * The hexadecimal decoder converts the ASCII hexadecimal characters of a record to bytes.
+ * It provides functions decodeHexDigit and decodeHexByte to decode one digit or one byte with a lookup table
+ * and function decodeHexData to decode, validate and sum a whole field of bytes.
+ * Function decodeHexData uses a vectorized kernel (AVX2 or SSSE3) selected at runtime for the CPU,
+ * with a scalar kernel as fallback that produces exactly the same results, the other CPUs (AArch64 too) use the scalar kernel.
+ * A freestanding build (HEX_FREESTANDING set to 1) only has the scalar kernel, which needs no CPU detection.
+ * Function findInvalidHexCharacter finds the first character that can't be part of an Intel Hex file
+ * with a kernel of the same instruction set, it is the prefilter that rejects files that aren't Intel Hex at all.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef HEX_DECODER_H
+#define HEX_DECODER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef HEX_FREESTANDING
+#define HEX_FREESTANDING 0  /* 1 to build only the checks and the record parser, without the C library */
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief The kernels that can be used by decodeHexData.
+ */
+typedef enum
+{
+    HEX_KERNEL_AUTO = 0,    /* Select the fastest kernel supported by the CPU */
+    HEX_KERNEL_SCALAR,      /* Lookup-table kernel, available on every CPU */
+    HEX_KERNEL_SSSE3,       /* x86 kernel, 16 bytes per iteration */
+    HEX_KERNEL_AVX2         /* x86 kernel, 32 bytes per iteration */
+} HexKernel_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function converts one hexadecimal character to the value of the digit.
+ *
+ * @param character The character.
+ * @param value Pointer to store the value of the digit (0x00 to 0x0F).
+ * @return 1 if the character is a hexadecimal digit, 0 if not.
+ */
+int32_t decodeHexDigit(int8_t character, uint32_t *value);
+
+/**
+ * @brief This function converts two hexadecimal characters to a byte.
+ *
+ * @param text Pointer to the two characters.
+ * @param value Pointer to store the value of the byte.
+ * @return 1 if both characters are hexadecimal digits, 0 if not.
+ */
+int32_t decodeHexByte(const int8_t text[], uint32_t *value);
+
+/**
+ * @brief This function checks if all characters of a text are hexadecimal digits.
+ *
+ * @param text Pointer to the characters.
+ * @param length The number of characters.
+ * @return 1 if all characters are hexadecimal digits, 0 if not.
+ */
+int32_t isHexText(const int8_t text[], uint32_t length);
+
+/**
+ * @brief This function decodes a field of hexadecimal characters to bytes.
+ *
+ * The function converts byte_count * 2 characters to byte_count bytes and adds all the decoded bytes together,
+ * so the checksum of a record is checked by decoding the data and checksum fields in one call.
+ * If a character isn't a hexadecimal digit, the content of data and sum is undefined.
+ *
+ * @param text Pointer to the hexadecimal characters.
+ * @param byte_count The number of bytes to decode.
+ * @param data The array to store the decoded bytes, at least byte_count bytes.
+ * @param sum Pointer to store the sum of all decoded bytes.
+ * @return 1 if all characters are hexadecimal digits, 0 if not.
+ */
+int32_t decodeHexData(const int8_t text[], uint32_t byte_count, uint8_t data[], uint32_t *sum);
+
+/**
+ * @brief This function finds the first character that can't be part of an Intel Hex file.
+ *
+ * The characters of an Intel Hex file are the hexadecimal digits, the start code ':' and the line terminators
+ * CR and LF, any other character makes the record of its line invalid.
+ * The text is scanned with the kernel selected for decodeHexData, 16 or 32 characters per iteration.
+ *
+ * @param text Pointer to the characters.
+ * @param length The number of characters.
+ * @return The offset of the first invalid character, length if all characters are valid.
+ */
+uint64_t findInvalidHexCharacter(const int8_t text[], uint64_t length);
+
+/**
+ * @brief This function selects the kernel used by decodeHexData and findInvalidHexCharacter.
+ *
+ * HEX_KERNEL_AUTO selects the fastest kernel supported by the CPU, this is also the default.
+ * The kernel is shared by the whole process, it isn't part of the context of a file: it must be selected
+ * before the threads that decode records are started. Without a selection the default kernel is resolved
+ * atomically at the first call, so threads that validate different files at the same time need no selection.
+ *
+ * @param kernel The kernel to use.
+ * @return 0 if the kernel is selected, 1 if the kernel isn't supported by this build or this CPU.
+ */
+int32_t selectHexKernel(HexKernel_t kernel);
+
+/**
+ * @brief This function returns the name of the kernel used by decodeHexData.
+ *
+ * @return The name of the kernel ("scalar", "ssse3" or "avx2").
+ */
+const char *getHexKernelName(void);
+
+#endif /* HEX_DECODER_H */
+
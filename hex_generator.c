@@ -0,0 +1,367 @@
+/**
+ * @file hex_generator.c
+ * @brief This file contains the implementation of the synthetic Intel Hex file generator functions.
+ *
+ * The generator writes data records with pseudo-random data (xorshift generator) at increasing addresses.
+ * An extended linear address record is written when the 16-bit address of the data records wraps and,
+ * if configured, every address_interval data records. The file ends with the End-Of-File record.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "hex_generator.h"   /* Include header file of this function file */
+#include "output_writer.h"   /* Include header file of the output writer */
+#include <string.h>          /* For memcpy() function */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HEX_GENERATOR_DEFAULT_SIZE  (1024 * 1024)   /* The default size of the file */
+#define HEX_GENERATOR_DEFAULT_SEED  0x2545F491U     /* The default seed, also used instead of a seed of 0 */
+#define HEX_GENERATOR_INVALID_TYPE  0x06            /* The record type of an injected record with error code 3 */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the destination of the generated lines.
+ *
+ * The lines are written to the writer if there is one, to the buffer if not.
+ */
+typedef struct
+{
+    OutputWriter_t *writer;         /* The writer to the stream, NULL to write to the buffer */
+    int8_t *buffer;                 /* The buffer */
+    uint64_t capacity;              /* The number of characters of the buffer */
+    int8_t overflow;                /* 1 if a line didn't fit in the buffer */
+} GeneratorSink_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void generateLines(const HexGeneratorConfig_t *config, GeneratorSink_t *sink, HexGeneratorResult_t *result);
+static void writeLine(GeneratorSink_t *sink, HexGeneratorResult_t *result, const int8_t line[], uint32_t length);
+static uint32_t formatRecord(int8_t line[], uint32_t record_type, uint32_t address, const uint8_t data[],
+                             uint32_t byte_count, uint32_t error_code, int8_t crlf);
+static void formatByte(int8_t text[], uint32_t value);
+static uint32_t nextRandom(uint32_t *state);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const int8_t hex_digits[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function initializes a configuration of the generator with the default values.
+ *
+ * The default file has 1 MiB, records of 16 data bytes, no extra address records, LF line endings and no error.
+ *
+ * @param config The configuration to initialize.
+ */
+void initHexGeneratorConfig(HexGeneratorConfig_t *config)
+{
+    config->size = HEX_GENERATOR_DEFAULT_SIZE;
+    config->record_length = 16;
+    config->address_interval = 0;
+    config->seed = HEX_GENERATOR_DEFAULT_SEED;
+    config->error_code = 0;
+    config->crlf = 0;
+}
+
+/**
+ * @brief This function writes a synthetic Intel Hex file to a stream.
+ *
+ * The injected record, if any, is the data record in the middle of the file.
+ *
+ * @param config The configuration of the generator.
+ * @param fptr The stream the file is written to.
+ * @param result The result of the generator.
+ */
+void generateIntelHexFile(const HexGeneratorConfig_t *config, FILE *fptr, HexGeneratorResult_t *result)
+{
+    OutputWriter_t writer;          /* Declaring the writer to the stream */
+    GeneratorSink_t sink;           /* Declaring the destination of the lines */
+
+    openOutputWriter(&writer, fptr);
+    sink.writer = &writer;
+    sink.buffer = NULL;
+    sink.capacity = 0;
+    sink.overflow = 0;
+    generateLines(config, &sink, result);
+    flushOutputWriter(&writer);
+}
+
+/**
+ * @brief This function writes a synthetic Intel Hex file to a buffer.
+ *
+ * The function writes the same characters as generateIntelHexFile. The buffer needs config->size
+ * plus 2 * HEX_GENERATOR_MAX_LINE characters.
+ *
+ * @param config The configuration of the generator.
+ * @param buffer The buffer the file is written to.
+ * @param capacity The number of characters of the buffer.
+ * @param result The result of the generator.
+ * @return 0 if the file is written, 1 if the buffer is too small.
+ */
+int32_t generateIntelHexBuffer(const HexGeneratorConfig_t *config, int8_t buffer[], uint64_t capacity,
+                               HexGeneratorResult_t *result)
+{
+    GeneratorSink_t sink;           /* Declaring the destination of the lines */
+
+    sink.writer = NULL;
+    sink.buffer = buffer;
+    sink.capacity = capacity;
+    sink.overflow = 0;
+    generateLines(config, &sink, result);
+    return sink.overflow;
+}
+
+/**
+ * @brief This function generates all lines of the file.
+ *
+ * The data record with the error is chosen from an estimate of the number of data records,
+ * so it is close to the middle of the file and it doesn't depend on the destination.
+ *
+ * @param config The configuration of the generator.
+ * @param sink The destination of the lines.
+ * @param result The result of the generator.
+ */
+static void generateLines(const HexGeneratorConfig_t *config, GeneratorSink_t *sink, HexGeneratorResult_t *result)
+{
+    int8_t line[HEX_GENERATOR_MAX_LINE];    /* The characters of the current line */
+    uint8_t data[256];                      /* The data bytes of the current record */
+    uint32_t length = 0;                    /* The number of characters of the current line */
+    uint32_t record_length = config->record_length;     /* The number of data bytes of each data record */
+    uint32_t random_state = (config->seed != 0) ? config->seed : HEX_GENERATOR_DEFAULT_SEED;   /* The state of the pseudo-random generator */
+    uint32_t upper_address = 0;             /* The upper 16 bits of the address of the data records */
+    uint32_t address = 0;                   /* The lower 16 bits of the address of the next data record */
+    uint32_t i = 0;                         /* Loop counter */
+    uint64_t data_line_length = 0;          /* The number of characters of a data record line */
+    uint64_t error_record = 0;              /* The index of the data record with the error */
+    uint32_t line_end = config->crlf ? 2 : 1;   /* The number of characters of the line terminator */
+
+    if ((record_length == 0) || (record_length > 255))
+    {
+        record_length = 16;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    result->size = 0;
+    result->line_count = 0;
+    result->data_record_count = 0;
+    result->error_line = 0;
+
+    /* Estimate the number of data records to inject the error in the middle of the file */
+    data_line_length = 11 + (record_length * 2) + line_end;
+    if (config->address_interval > 0)
+    {
+        data_line_length += (15 + line_end) / config->address_interval;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    error_record = (config->size / data_line_length) / 2;
+
+    /* Write the data records until the file is large enough */
+    while ((result->size < config->size) && !sink->overflow)
+    {
+        /* Write an extended linear address record if the address wraps or at the configured interval */
+        if ((address + record_length > 0x10000) ||
+            ((config->address_interval > 0) && ((result->data_record_count % config->address_interval) == 0)))
+        {
+            if (address + record_length > 0x10000)
+            {
+                upper_address = (upper_address + 1) & 0xFFFF;
+                address = 0;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            data[0] = (uint8_t)(upper_address >> 8);
+            data[1] = (uint8_t)upper_address;
+            length = formatRecord(line, 0x04, 0, data, 2, 0, config->crlf);
+            writeLine(sink, result, line, length);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        /* Write the data record, with the error if it is the chosen record */
+        for (i = 0; i < record_length; i++)
+        {
+            data[i] = (uint8_t)nextRandom(&random_state);
+        }
+        if ((config->error_code != 0) && (result->data_record_count == error_record))
+        {
+            length = formatRecord(line, 0x00, address, data, record_length, config->error_code, config->crlf);
+            result->error_line = result->line_count + 1;
+        }
+        else
+        {
+            length = formatRecord(line, 0x00, address, data, record_length, 0, config->crlf);
+        }
+        writeLine(sink, result, line, length);
+        result->data_record_count += 1;
+        address += record_length;
+    }
+
+    /* Write the End-Of-File record */
+    length = formatRecord(line, 0x01, 0, data, 0, 0, config->crlf);
+    writeLine(sink, result, line, length);
+}
+
+/**
+ * @brief This function writes one line to the destination.
+ *
+ * @param sink The destination of the lines.
+ * @param result The result of the generator.
+ * @param line The characters of the line.
+ * @param length The number of characters of the line.
+ */
+static void writeLine(GeneratorSink_t *sink, HexGeneratorResult_t *result, const int8_t line[], uint32_t length)
+{
+    if (sink->writer != NULL)
+    {
+        writeText(sink->writer, line, length);
+    }
+    else if (result->size + length <= sink->capacity)
+    {
+        memcpy(sink->buffer + result->size, line, length);
+    }
+    else
+    {
+        sink->overflow = 1;
+    }
+
+    if (!sink->overflow)
+    {
+        result->size += length;
+        result->line_count += 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function formats a record and injects an error in it.
+ *
+ * Error code 1 replaces the start code, 2 puts a character that isn't a hexadecimal digit in the address,
+ * 3 uses a record type that isn't valid, 4 removes the last data byte and 5 changes the checksum.
+ *
+ * @param line The characters of the line.
+ * @param record_type The record type.
+ * @param address The address field.
+ * @param data The data bytes.
+ * @param byte_count The number of data bytes.
+ * @param error_code The error code to inject, 0 for a valid record.
+ * @param crlf 1 to end the line with CR LF, 0 for LF.
+ * @return The number of characters of the line.
+ */
+static uint32_t formatRecord(int8_t line[], uint32_t record_type, uint32_t address, const uint8_t data[],
+                             uint32_t byte_count, uint32_t error_code, int8_t crlf)
+{
+    uint32_t i = 0;                 /* Loop counter */
+    uint32_t sum = 0;               /* The sum of all bytes of the record */
+    uint32_t length = 9;            /* The number of characters of the line */
+
+    if (error_code == 3)
+    {
+        record_type = HEX_GENERATOR_INVALID_TYPE;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    line[0] = ':';
+    formatByte(line + 1, byte_count);
+    formatByte(line + 3, (address >> 8) & 0xFF);
+    formatByte(line + 5, address & 0xFF);
+    formatByte(line + 7, record_type);
+    sum = byte_count + ((address >> 8) & 0xFF) + (address & 0xFF) + record_type;
+    for (i = 0; i < byte_count; i++)
+    {
+        formatByte(line + length, data[i]);
+        sum += data[i];
+        length += 2;
+    }
+    formatByte(line + length, (0x100 - (sum & 0xFF)) & 0xFF);
+    length += 2;
+
+    /* Inject the error */
+    if (error_code == 1)
+    {
+        line[0] = ';';
+    }
+    else if (error_code == 2)
+    {
+        line[3] = 'G';
+    }
+    else if ((error_code == 4) && (byte_count > 0))
+    {
+        /* Move the checksum over the last data byte */
+        line[length - 4] = line[length - 2];
+        line[length - 3] = line[length - 1];
+        length -= 2;
+    }
+    else if (error_code == 5)
+    {
+        line[length - 1] = (line[length - 1] == '0') ? '1' : '0';
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (crlf)
+    {
+        line[length] = '\r';
+        length += 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    line[length] = '\n';
+    return length + 1;
+}
+
+/**
+ * @brief This function formats a byte as two upper-case hexadecimal digits.
+ *
+ * @param text The two characters.
+ * @param value The byte.
+ */
+static void formatByte(int8_t text[], uint32_t value)
+{
+    text[0] = hex_digits[(value >> 4) & 0x0F];
+    text[1] = hex_digits[value & 0x0F];
+}
+
+/**
+ * @brief This function returns the next number of the xorshift32 pseudo-random generator.
+ *
+ * @param state The state of the generator, never 0.
+ * @return The next pseudo-random number.
+ */
+static uint32_t nextRandom(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+} /* EOF */
+
@@ -0,0 +1,96 @@
+/**
+ * @file hex_generator.h
+ * @brief This file contains the prototypes of the synthetic Intel Hex file generator functions.
+ *
+ * The generator writes deterministic synthetic Intel Hex files for benchmarks and tests.
+ * The size of the file, the number of data bytes of each record and the density of the extended linear
+ * address records are configurable, and one record with an error (error codes 1 to 5 of checkRecord)
+ * can be injected. The same configuration always gives the same file.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for FILE, fwrite, ... */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef HEX_GENERATOR_H
+#define HEX_GENERATOR_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HEX_GENERATOR_MAX_LINE  (1 + 8 + 255 * 2 + 2 + 2)  /* The longest generated line with CR LF */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the configuration of the generator.
+ */
+typedef struct
+{
+    uint64_t size;                  /* The minimum number of characters of the file, the End-Of-File record is behind */
+    uint32_t record_length;         /* The number of data bytes of each data record (1 to 255) */
+    uint32_t address_interval;      /* An extended linear address record is written every address_interval data records, 0 only when the address wraps */
+    uint32_t seed;                  /* The seed of the pseudo-random data bytes */
+    uint32_t error_code;            /* The error code (1 to 5 of checkRecord) of the injected record, 0 for a valid file */
+    int8_t crlf;                    /* 1 to end the lines with CR LF, 0 for LF */
+} HexGeneratorConfig_t;
+
+/**
+ * @brief Structure to hold the result of the generator.
+ */
+typedef struct
+{
+    uint64_t size;                  /* The number of characters of the file */
+    uint32_t line_count;            /* The number of lines of the file */
+    uint32_t data_record_count;     /* The number of data records of the file */
+    uint32_t error_line;            /* The line of the injected record, 0 if there is none */
+} HexGeneratorResult_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function initializes a configuration of the generator with the default values.
+ *
+ * The default file has 1 MiB, records of 16 data bytes, no extra address records, LF line endings and no error.
+ *
+ * @param config The configuration to initialize.
+ */
+void initHexGeneratorConfig(HexGeneratorConfig_t *config);
+
+/**
+ * @brief This function writes a synthetic Intel Hex file to a stream.
+ *
+ * The injected record, if any, is the data record in the middle of the file.
+ *
+ * @param config The configuration of the generator.
+ * @param fptr The stream the file is written to.
+ * @param result The result of the generator.
+ */
+void generateIntelHexFile(const HexGeneratorConfig_t *config, FILE *fptr, HexGeneratorResult_t *result);
+
+/**
+ * @brief This function writes a synthetic Intel Hex file to a buffer.
+ *
+ * The function writes the same characters as generateIntelHexFile. The buffer needs config->size
+ * plus 2 * HEX_GENERATOR_MAX_LINE characters.
+ *
+ * @param config The configuration of the generator.
+ * @param buffer The buffer the file is written to.
+ * @param capacity The number of characters of the buffer.
+ * @param result The result of the generator.
+ * @return 0 if the file is written, 1 if the buffer is too small.
+ */
+int32_t generateIntelHexBuffer(const HexGeneratorConfig_t *config, int8_t buffer[], uint64_t capacity,
+                               HexGeneratorResult_t *result);
+
+#endif /* HEX_GENERATOR_H */
+
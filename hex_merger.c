@@ -0,0 +1,659 @@
+/**
+ * @file hex_merger.c
+ * @brief This file contains the implementation of the merger functions.
+ *
+ * The k-way merge keeps a binary heap of the input files ordered by the address of their next segment,
+ * so giving the segments of all files in address order costs O(S log N) time for S segments and N files.
+ * The data bytes of a segment are never copied into memory: its records are decoded again from the mapped file
+ * and given to the encoder of the converter while the merged file is written.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "hex_merger.h"         /* Include header file of this function file */
+#include "hex_converter.h"      /* Include header file of the converter, for the encoder of the records */
+#include <stdlib.h>             /* For malloc(), realloc(), calloc(), free(), qsort() functions */
+#include <string.h>             /* For memchr(), memcpy(), memset() functions */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MERGE_MIN_SEGMENTS      64      /* The number of segments of the first allocation of an input file */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of the collection of the segments of one input file.
+ */
+typedef struct
+{
+    HexContext_t *context;      /* The context of the validation, for the offset of the current record */
+    MergeInput_t *input;        /* The input file */
+    uint64_t segment_end;       /* The address after the last segment */
+    int8_t out_of_memory;       /* 1 if an allocation failed */
+} SegmentCollector_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function adds a valid record to the segments of the input file, it is the visitor of the validation.
+ *
+ * @param visitor_context The state of the collection.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void collectSegment(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                           uint32_t line_number);
+
+/**
+ * @brief This function makes sure the input file can hold one more segment.
+ *
+ * @param input The input file.
+ * @return 1 if the array of segments is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveMergeSegment(MergeInput_t *input);
+
+/**
+ * @brief This function compares two segments by address, then by position in the file, for qsort.
+ *
+ * @param first The first segment.
+ * @param second The second segment.
+ * @return A negative value, 0 or a positive value if the first segment is before, same as or after the second one.
+ */
+static int compareMergeSegments(const void *first, const void *second);
+
+/**
+ * @brief This function starts the k-way merge with the first segment of each input file.
+ *
+ * @param merger The state of the merge.
+ */
+static void startMergeQueue(HexMerger_t *merger);
+
+/**
+ * @brief This function gives the next segment of all input files in address order.
+ *
+ * @param merger The state of the merge.
+ * @param input_index Pointer to store the index of the input file of the segment.
+ * @return The segment, NULL if all segments are given.
+ */
+static const MergeSegment_t *nextMergeSegment(HexMerger_t *merger, uint32_t *input_index);
+
+/**
+ * @brief This function moves an input file down the heap of the k-way merge to its place.
+ *
+ * @param merger The state of the merge.
+ * @param position The position of the input file in the heap.
+ */
+static void siftMergeQueue(HexMerger_t *merger, uint32_t position);
+
+/**
+ * @brief This function checks if the next segment of an input file comes before the next segment of another one.
+ *
+ * @param merger The state of the merge.
+ * @param first The index of the first input file.
+ * @param second The index of the second input file.
+ * @return 1 if the segment of the first input file comes first, 0 otherwise.
+ */
+static int8_t isMergeSegmentBefore(const HexMerger_t *merger, uint32_t first, uint32_t second);
+
+/**
+ * @brief This function decodes the records of a segment again and gives their data bytes to the encoder.
+ *
+ * @param context The context used to decode the records.
+ * @param input The input file of the segment.
+ * @param segment The segment.
+ * @param encoder The encoder of the merged file.
+ */
+static void writeMergeSegment(HexContext_t *context, const MergeInput_t *input, const MergeSegment_t *segment,
+                              HexEncoder_t *encoder);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function maps and validates the input files of a merge and collects their segments.
+ *
+ * All files are validated, the result of each file is stored in its input.
+ * A file with a data record whose bytes go past the end of the 4 GiB address space isn't merged, its addresses
+ * would wrap to 0 and write over the data at the lowest addresses without a conflict.
+ * The merger must be released with closeHexMerger, even if the function fails.
+ *
+ * @param merger The state of the merge.
+ * @param context The context used to validate the files.
+ * @param paths The paths of the Intel Hex files.
+ * @param path_count The number of files.
+ * @return 0 if all files are valid, 1 if a file has an invalid record, 2 if a file has an invalid End-Of-File
+ *         record, 3 if a file can't be opened, 4 if there isn't enough memory, 5 if a data record of a file crosses
+ *         the end of the 4 GiB address space. The first error of the files is returned.
+ */
+int32_t openHexMerger(HexMerger_t *merger, HexContext_t *context, const char *paths[], uint32_t path_count)
+{
+    int32_t result = 0;             /* Initialize the result of the function */
+    uint32_t i = 0;                 /* Loop counter */
+    MergeInput_t *input = NULL;     /* Pointer to the current input file */
+
+    SegmentCollector_t collector;   /* Declaring the state of the collection of the segments */
+
+    merger->input_count = 0;
+    merger->segment_count = 0;
+    merger->queue_count = 0;
+    merger->inputs = (MergeInput_t *)calloc((path_count > 0) ? path_count : 1, sizeof(MergeInput_t));
+    merger->queue = (uint32_t *)malloc(((path_count > 0) ? path_count : 1) * sizeof(uint32_t));
+    if ((merger->inputs == NULL) || (merger->queue == NULL))
+    {
+        result = 4;
+    }
+    else
+    {
+        merger->input_count = path_count;
+        for (i = 0; i < path_count; i++)
+        {
+            input = &(merger->inputs[i]);
+            input->path = paths[i];
+            if (mapFile(paths[i], &(input->file)) != 0)
+            {
+                memset(&(input->report), 0, sizeof(FileReport_t));
+                resetHexContext(context);
+                input->result = 3;
+            }
+            else
+            {
+                /* Validate the file and collect its segments in the same pass */
+                input->mapped = 1;
+                collector.context = context;
+                collector.input = input;
+                collector.segment_end = 0;
+                collector.out_of_memory = 0;
+                input->result = visitIntelHexBuffer(context, input->file.data, input->file.size, collectSegment,
+                                                    &collector, &(input->report));
+                if ((input->result == 0) && collector.out_of_memory)
+                {
+                    input->result = 4;
+                }
+                else if ((input->result == 0) && (input->overflow_line != 0))
+                {
+                    input->result = 5;
+                }
+                else if ((input->result == 0) && (input->segment_count > 1))
+                {
+                    qsort(input->segments, input->segment_count, sizeof(MergeSegment_t), compareMergeSegments);
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+                merger->segment_count += input->segment_count;
+            }
+            /* Keep the first error of the files */
+            if (result == 0)
+            {
+                result = input->result;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief This function finds the segments that overlap each other.
+ *
+ * The segments of all files are merged in address order, a segment that starts before the end of
+ * the segments before it is a conflict. Only the segment lists are read, not the files.
+ *
+ * @param merger The state of the merge, opened without error.
+ * @param conflicts The array to store the first conflicts, NULL if capacity is 0.
+ * @param capacity The number of conflicts that fit in the array.
+ * @return The number of conflicts, conflicts behind the capacity are only counted.
+ */
+uint64_t findMergeConflicts(HexMerger_t *merger, MergeConflict_t conflicts[], uint32_t capacity)
+{
+    uint64_t count = 0;                         /* Initialize the number of conflicts */
+    uint64_t end = 0;                           /* The address after the segments given so far */
+    uint64_t segment_end = 0;                   /* The address after the current segment */
+    uint32_t input_index = 0;                   /* The index of the input file of the current segment */
+    uint32_t end_input = 0;                     /* The index of the input file of the segment that reaches end */
+    uint32_t end_line = 0;                      /* The line number of the segment that reaches end */
+    const MergeSegment_t *segment = NULL;       /* Pointer to the current segment */
+    MergeConflict_t *conflict = NULL;           /* Pointer to the conflict stored */
+
+    startMergeQueue(merger);
+    segment = nextMergeSegment(merger, &input_index);
+    while (segment != NULL)
+    {
+        segment_end = (uint64_t)segment->address + segment->size;
+        /* The segment starts before the end of a segment given before it */
+        if (segment->address < end)
+        {
+            if (count < capacity)
+            {
+                conflict = &(conflicts[count]);
+                conflict->address = segment->address;
+                conflict->size = ((segment_end < end) ? segment_end : end) - segment->address;
+                conflict->first_input = end_input;
+                conflict->first_line = end_line;
+                conflict->second_input = input_index;
+                conflict->second_line = segment->line_number;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            count += 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (segment_end > end)
+        {
+            end = segment_end;
+            end_input = input_index;
+            end_line = segment->line_number;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        segment = nextMergeSegment(merger, &input_index);
+    }
+    return count;
+}
+
+/**
+ * @brief This function writes the merged Intel Hex file.
+ *
+ * The data bytes are written in address order with records of record_size bytes and extended linear address
+ * records, the start address of the first input file that has one is kept, then the only End-Of-File record
+ * is written. The merger must have no conflict.
+ *
+ * @param merger The state of the merge, opened without error.
+ * @param context The context used to decode the records again.
+ * @param output The writer of the merged file, it is flushed at the end.
+ * @param record_size The number of data bytes of a record, 1 to 255.
+ */
+void writeMergedIntelHex(HexMerger_t *merger, HexContext_t *context, OutputWriter_t *output, uint32_t record_size)
+{
+    uint32_t i = 0;                             /* Loop counter */
+    uint32_t input_index = 0;                   /* The index of the input file of the current segment */
+    const MergeSegment_t *segment = NULL;       /* Pointer to the current segment */
+
+    HexEncoder_t encoder;                       /* Declaring the state of the writing of the records */
+
+    openHexEncoder(&encoder, output, record_size);
+    /* Keep the start address of the first input file that has one */
+    for (i = 0; (i < merger->input_count) && (encoder.start_record_type == 0); i++)
+    {
+        if (merger->inputs[i].report.start_record_type != 0)
+        {
+            encoder.start_record_type = merger->inputs[i].report.start_record_type;
+            encoder.start_address = merger->inputs[i].report.start_address;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    /* Write the segments of all files in address order */
+    startMergeQueue(merger);
+    segment = nextMergeSegment(merger, &input_index);
+    while (segment != NULL)
+    {
+        writeMergeSegment(context, &(merger->inputs[input_index]), segment, &encoder);
+        segment = nextMergeSegment(merger, &input_index);
+    }
+    finishHexEncoder(&encoder);
+    flushOutputWriter(output);
+}
+
+/**
+ * @brief This function releases the mappings and the memory of a merge.
+ *
+ * @param merger The state of the merge.
+ */
+void closeHexMerger(HexMerger_t *merger)
+{
+    uint32_t i = 0;                 /* Loop counter */
+
+    for (i = 0; i < merger->input_count; i++)
+    {
+        if (merger->inputs[i].mapped)
+        {
+            unmapFile(&(merger->inputs[i].file));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        free(merger->inputs[i].segments);
+    }
+    free(merger->inputs);
+    free(merger->queue);
+    merger->inputs = NULL;
+    merger->queue = NULL;
+    merger->input_count = 0;
+    merger->segment_count = 0;
+    merger->queue_count = 0;
+}
+
+/**
+ * @brief This function adds a valid record to the segments of the input file, it is the visitor of the validation.
+ *
+ * A data record that starts at the end of the last segment extends it, any other data record starts a new segment.
+ * The line of the first data record that crosses the end of the 4 GiB address space is kept in the input file.
+ *
+ * @param visitor_context The state of the collection.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void collectSegment(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                           uint32_t line_number)
+{
+    SegmentCollector_t *collector = (SegmentCollector_t *)visitor_context;     /* The state of the collection */
+    MergeInput_t *input = collector->input;                                     /* The input file */
+    MergeSegment_t *segment = NULL;                                             /* Pointer to the new segment */
+
+    if ((record->record_type == 0x00) && (record->byte_count > 0) && !collector->out_of_memory)
+    {
+        if ((input->overflow_line == 0) && ((uint64_t)absolute_address + record->byte_count > HEX_ADDRESS_SPACE_SIZE))
+        {
+            input->overflow_line = line_number;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Check if the record extends the last segment */
+        if ((input->segment_count > 0) && (collector->segment_end == absolute_address) &&
+            ((uint64_t)input->segments[input->segment_count - 1].size + record->byte_count <= 0xFFFFFFFFU))
+        {
+            input->segments[input->segment_count - 1].size += record->byte_count;
+        }
+        else if (!reserveMergeSegment(input))
+        {
+            collector->out_of_memory = 1;
+        }
+        /* Start a new segment */
+        else
+        {
+            segment = &(input->segments[input->segment_count]);
+            segment->address = absolute_address;
+            segment->size = record->byte_count;
+            segment->base_address = absolute_address - record->address;
+            segment->line_number = line_number;
+            segment->offset = collector->context->line_offset;
+            input->segment_count += 1;
+        }
+        collector->segment_end = (uint64_t)absolute_address + record->byte_count;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function makes sure the input file can hold one more segment.
+ *
+ * The capacity of the array of segments is doubled, so adding n segments costs O(n) time in total.
+ *
+ * @param input The input file.
+ * @return 1 if the array of segments is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveMergeSegment(MergeInput_t *input)
+{
+    int8_t reserved = 1;                            /* Initialize the result */
+    uint64_t capacity = input->segment_capacity;    /* The new capacity of the array of segments */
+    MergeSegment_t *segments = NULL;                /* The new array of segments */
+
+    if (input->segment_count == input->segment_capacity)
+    {
+        capacity = (capacity < MERGE_MIN_SEGMENTS) ? MERGE_MIN_SEGMENTS : capacity * 2;
+        if (capacity > 0xFFFFFFFFU)
+        {
+            capacity = 0xFFFFFFFFU;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (capacity > input->segment_count)
+        {
+            segments = (MergeSegment_t *)realloc(input->segments, (size_t)capacity * sizeof(MergeSegment_t));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (segments == NULL)
+        {
+            reserved = 0;
+        }
+        else
+        {
+            input->segments = segments;
+            input->segment_capacity = (uint32_t)capacity;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return reserved;
+}
+
+/**
+ * @brief This function compares two segments by address, then by position in the file, for qsort.
+ *
+ * @param first The first segment.
+ * @param second The second segment.
+ * @return A negative value, 0 or a positive value if the first segment is before, same as or after the second one.
+ */
+static int compareMergeSegments(const void *first, const void *second)
+{
+    const MergeSegment_t *a = (const MergeSegment_t *)first;        /* The first segment */
+    const MergeSegment_t *b = (const MergeSegment_t *)second;       /* The second segment */
+    int result = 0;                                                 /* Initialize the result of the comparison */
+
+    if (a->address != b->address)
+    {
+        result = (a->address < b->address) ? -1 : 1;
+    }
+    else if (a->offset != b->offset)
+    {
+        result = (a->offset < b->offset) ? -1 : 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function starts the k-way merge with the first segment of each input file.
+ *
+ * The input files that have segments are put in the heap, then the heap is built from its last parent.
+ *
+ * @param merger The state of the merge.
+ */
+static void startMergeQueue(HexMerger_t *merger)
+{
+    uint32_t i = 0;                 /* Loop counter */
+
+    merger->queue_count = 0;
+    for (i = 0; i < merger->input_count; i++)
+    {
+        merger->inputs[i].next_segment = 0;
+        if (merger->inputs[i].segment_count > 0)
+        {
+            merger->queue[merger->queue_count] = i;
+            merger->queue_count += 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    for (i = merger->queue_count / 2; i > 0; i--)
+    {
+        siftMergeQueue(merger, i - 1);
+    }
+}
+
+/**
+ * @brief This function gives the next segment of all input files in address order.
+ *
+ * The input file at the top of the heap gives its next segment, then it moves down the heap
+ * or leaves it if it has no more segments.
+ *
+ * @param merger The state of the merge.
+ * @param input_index Pointer to store the index of the input file of the segment.
+ * @return The segment, NULL if all segments are given.
+ */
+static const MergeSegment_t *nextMergeSegment(HexMerger_t *merger, uint32_t *input_index)
+{
+    const MergeSegment_t *segment = NULL;       /* Initialize the segment given */
+    MergeInput_t *input = NULL;                 /* Pointer to the input file at the top of the heap */
+
+    if (merger->queue_count > 0)
+    {
+        *input_index = merger->queue[0];
+        input = &(merger->inputs[*input_index]);
+        segment = &(input->segments[input->next_segment]);
+        input->next_segment += 1;
+        if (input->next_segment == input->segment_count)
+        {
+            merger->queue_count -= 1;
+            merger->queue[0] = merger->queue[merger->queue_count];
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        siftMergeQueue(merger, 0);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return segment;
+}
+
+/**
+ * @brief This function moves an input file down the heap of the k-way merge to its place.
+ *
+ * @param merger The state of the merge.
+ * @param position The position of the input file in the heap.
+ */
+static void siftMergeQueue(HexMerger_t *merger, uint32_t position)
+{
+    uint32_t child = 0;             /* The position of the child that comes first */
+    uint32_t swap = 0;              /* The input file exchanged with its child */
+    int8_t placed = 0;              /* Initialize a flag to indicate if the input file is at its place */
+
+    while (!placed)
+    {
+        child = (2 * position) + 1;
+        if ((child + 1 < merger->queue_count) &&
+            isMergeSegmentBefore(merger, merger->queue[child + 1], merger->queue[child]))
+        {
+            child += 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if ((child < merger->queue_count) &&
+            isMergeSegmentBefore(merger, merger->queue[child], merger->queue[position]))
+        {
+            swap = merger->queue[position];
+            merger->queue[position] = merger->queue[child];
+            merger->queue[child] = swap;
+            position = child;
+        }
+        else
+        {
+            placed = 1;
+        }
+    }
+}
+
+/**
+ * @brief This function checks if the next segment of an input file comes before the next segment of another one.
+ *
+ * The segments are ordered by address, then by the order of the input files.
+ *
+ * @param merger The state of the merge.
+ * @param first The index of the first input file.
+ * @param second The index of the second input file.
+ * @return 1 if the segment of the first input file comes first, 0 otherwise.
+ */
+static int8_t isMergeSegmentBefore(const HexMerger_t *merger, uint32_t first, uint32_t second)
+{
+    uint32_t first_address = merger->inputs[first].segments[merger->inputs[first].next_segment].address;
+    uint32_t second_address = merger->inputs[second].segments[merger->inputs[second].next_segment].address;
+
+    return (first_address < second_address) || ((first_address == second_address) && (first < second));
+}
+
+/**
+ * @brief This function decodes the records of a segment again and gives their data bytes to the encoder.
+ *
+ * The records are decoded from the first record of the segment with the base address of that record,
+ * the extended address records between them update the base address like in the validation.
+ *
+ * @param context The context used to decode the records.
+ * @param input The input file of the segment.
+ * @param segment The segment.
+ * @param encoder The encoder of the merged file.
+ */
+static void writeMergeSegment(HexContext_t *context, const MergeInput_t *input, const MergeSegment_t *segment,
+                              HexEncoder_t *encoder)
+{
+    const int8_t *line = input->file.data + segment->offset;    /* Pointer to the beginning of the current line */
+    const int8_t *end = input->file.data + input->file.size;    /* Pointer to the end of the file */
+    const int8_t *newline = NULL;                               /* Pointer to the line feed of the current line */
+    uint32_t remaining = segment->size;                         /* The number of bytes of the segment not written */
+    uint32_t count = 0;                                         /* The number of bytes of the record written */
+
+    IntelHexRecord_t record;                                    /* Declaring the record decoded */
+
+    context->base_address = segment->base_address;
+    context->line_number = segment->line_number - 1;
+    while ((remaining > 0) && (line < end))
+    {
+        newline = (const int8_t *)memchr(line, '\n', (size_t)(end - line));
+        /* The last line may not have a line terminator */
+        if (newline == NULL)
+        {
+            newline = end;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if ((parseRecord(context, line, (uint32_t)(newline - line), &record) == 0) &&
+            (record.record_type == 0x00) && (record.byte_count > 0))
+        {
+            count = (record.byte_count > remaining) ? remaining : record.byte_count;
+            encodeHexData(encoder, context->base_address + record.address, record.data, count);
+            remaining -= count;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        line = newline + 1;
+    }
+} /* EOF */
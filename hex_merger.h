@@ -0,0 +1,147 @@
+/**
+ * @file hex_merger.h
+ * @brief This file contains the prototypes of the merger functions.
+ *
+ * The merger combines several Intel Hex files (for example a bootloader, an application and its calibration data)
+ * into one Intel Hex file with a single End-Of-File record.
+ * Each file is mapped into memory and validated once, the validation gives its segments: the runs of data records
+ * of consecutive addresses. Only the address, the size and the position in the file of each segment are kept,
+ * so the memory used grows with the number of segments and not with the size of the image.
+ * The segments of each file are sorted by address and the files are merged with a k-way merge on the absolute
+ * address. Segments that overlap are conflicts, the merged file is only written if there is none: the records
+ * of each segment are then decoded again from the mapped file and written in address order.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "file_mapper.h"               /* Include header file of the file mapper */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef HEX_MERGER_H
+#define HEX_MERGER_H
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold one segment of an input file of the merger.
+ *
+ * The records of the segment follow each other in the file from the record at offset, only the data records
+ * with data bytes are part of the segment.
+ */
+typedef struct
+{
+    uint32_t address;           /* The absolute memory address of the first byte of the segment */
+    uint32_t size;              /* The number of bytes of the segment */
+    uint32_t base_address;      /* The base address of the first record of the segment */
+    uint32_t line_number;       /* The line number of the first record of the segment */
+    uint64_t offset;            /* The offset of the first record of the segment in the file */
+} MergeSegment_t;
+
+/**
+ * @brief Structure to hold one input file of the merger.
+ */
+typedef struct
+{
+    const char *path;           /* The path of the file */
+    MappedFile_t file;          /* The memory mapping of the file */
+    int8_t mapped;              /* 1 if the file is mapped */
+    int32_t result;             /* The result of the validation of the file (same values as openHexMerger) */
+    uint32_t overflow_line;     /* The line of the first data record that crosses the end of the 4 GiB address space */
+    FileReport_t report;        /* The result of the validation of the file */
+    MergeSegment_t *segments;   /* The segments of the file, sorted by address */
+    uint32_t segment_count;     /* The number of segments */
+    uint32_t segment_capacity;  /* The number of segments that fit in the allocated array */
+    uint32_t next_segment;      /* The index of the next segment given by the k-way merge */
+} MergeInput_t;
+
+/**
+ * @brief Structure to hold a conflict: bytes written by two segments.
+ *
+ * Both segments can be segments of the same file.
+ */
+typedef struct
+{
+    uint32_t address;           /* The absolute memory address of the first byte written twice */
+    uint64_t size;              /* The number of bytes written twice */
+    uint32_t first_input;       /* The index of the input file of the segment with the lower address */
+    uint32_t first_line;        /* The line number of the first record of the segment with the lower address */
+    uint32_t second_input;      /* The index of the input file of the other segment */
+    uint32_t second_line;       /* The line number of the first record of the other segment */
+} MergeConflict_t;
+
+/**
+ * @brief Structure to hold the state of a merge.
+ */
+typedef struct
+{
+    MergeInput_t *inputs;       /* The input files in the order of the command line */
+    uint32_t input_count;       /* The number of input files */
+    uint64_t segment_count;     /* The number of segments of all input files */
+    uint32_t *queue;            /* The heap of the k-way merge, the inputs ordered by their next segment */
+    uint32_t queue_count;       /* The number of inputs in the heap */
+} HexMerger_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function maps and validates the input files of a merge and collects their segments.
+ *
+ * All files are validated, the result of each file is stored in its input.
+ * A file with a data record whose bytes go past the end of the 4 GiB address space isn't merged, its addresses
+ * would wrap to 0 and write over the data at the lowest addresses without a conflict.
+ * The merger must be released with closeHexMerger, even if the function fails.
+ *
+ * @param merger The state of the merge.
+ * @param context The context used to validate the files.
+ * @param paths The paths of the Intel Hex files.
+ * @param path_count The number of files.
+ * @return 0 if all files are valid, 1 if a file has an invalid record, 2 if a file has an invalid End-Of-File
+ *         record, 3 if a file can't be opened, 4 if there isn't enough memory, 5 if a data record of a file crosses
+ *         the end of the 4 GiB address space. The first error of the files is returned.
+ */
+int32_t openHexMerger(HexMerger_t *merger, HexContext_t *context, const char *paths[], uint32_t path_count);
+
+/**
+ * @brief This function finds the segments that overlap each other.
+ *
+ * The segments of all files are merged in address order, a segment that starts before the end of
+ * the segments before it is a conflict. Only the segment lists are read, not the files.
+ *
+ * @param merger The state of the merge, opened without error.
+ * @param conflicts The array to store the first conflicts, NULL if capacity is 0.
+ * @param capacity The number of conflicts that fit in the array.
+ * @return The number of conflicts, conflicts behind the capacity are only counted.
+ */
+uint64_t findMergeConflicts(HexMerger_t *merger, MergeConflict_t conflicts[], uint32_t capacity);
+
+/**
+ * @brief This function writes the merged Intel Hex file.
+ *
+ * The data bytes are written in address order with records of record_size bytes and extended linear address
+ * records, the start address of the first input file that has one is kept, then the only End-Of-File record
+ * is written. The merger must have no conflict.
+ *
+ * @param merger The state of the merge, opened without error.
+ * @param context The context used to decode the records again.
+ * @param output The writer of the merged file, it is flushed at the end.
+ * @param record_size The number of data bytes of a record, 1 to 255.
+ */
+void writeMergedIntelHex(HexMerger_t *merger, HexContext_t *context, OutputWriter_t *output, uint32_t record_size);
+
+/**
+ * @brief This function releases the mappings and the memory of a merge.
+ *
+ * @param merger The state of the merge.
+ */
+void closeHexMerger(HexMerger_t *merger);
+
+#endif /* HEX_MERGER_H */
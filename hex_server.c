@@ -0,0 +1,1183 @@
+/**
+ * @file hex_server.c
+ * @brief This file contains the implementation of the validation server functions.
+ *
+ * The listening thread waits for the connections with poll and a short timeout, so a stop asked by a signal
+ * handler or by a shutdown request is seen without waking the thread. The workers share the queue of the
+ * connections and the metrics, protected by one mutex, and nothing else but the result cache. The requests
+ * of a connection are read from a buffer of the worker, the bytes of an inline file are copied from the buffer
+ * first and the rest is received directly into the file buffer of the worker, which only grows.
+ * The answers are written with the output writer of the worker on a stream opened on the socket.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "hex_server.h"        /* Include header file of this function file */
+#include "hex_converter.h"     /* Include header file of the converter */
+#include "record_handler.h"    /* Include header file of the record handler of lower layer */
+#include "hex_decoder.h"       /* Include header file of the hexadecimal decoder of lower layer */
+#include "file_mapper.h"       /* Include header file of the file mapper of lower layer */
+#include "output_writer.h"     /* Include header file of the output writer of lower layer */
+#include "hex_statistics.h"    /* Include header file of the statistics of lower layer */
+#include <stdlib.h>            /* For malloc(), realloc(), calloc(), free(), strtoull(), qsort() functions */
+#include <string.h>            /* For memcpy(), memmove(), memchr(), strchr(), strcmp() functions */
+#if !defined(_WIN32)
+#include <errno.h>             /* For errno, EINTR */
+#include <poll.h>              /* For poll() function */
+#include <signal.h>            /* For signal() function */
+#include <unistd.h>            /* For close(), dup(), unlink() functions */
+#include <sys/socket.h>        /* For socket(), bind(), listen(), accept(), recv() functions */
+#include <sys/un.h>            /* For sockaddr_un structure */
+#include <sys/stat.h>          /* For lstat(), umask() functions, S_ISSOCK macro */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SERVER_POLL_INTERVAL    200             /* The time in milliseconds between two checks of the stop flag */
+#define SERVER_BACKLOG          64              /* The number of connections waiting in the listening socket */
+#define SERVER_BUFFER_SIZE      (64 * 1024)     /* The number of bytes received at once from a connection */
+#define SERVER_MAX_LINE         4096            /* The maximum number of characters of a request line */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of a worker of the server, kept from one request to the next.
+ */
+typedef struct ServerWorker
+{
+    HexServer_t *server;                    /* The server of the worker */
+    pthread_t thread;                       /* The thread of the worker */
+    int8_t started;                         /* 1 if the thread is started */
+    HexContext_t context;                   /* The context of the files of the worker */
+    OutputWriter_t output;                  /* The writer of the answers of the current connection */
+    int32_t connection;                     /* The socket of the current connection */
+    uint8_t buffer[SERVER_BUFFER_SIZE];     /* The bytes received but not used yet */
+    uint32_t buffer_start;                  /* The index of the first byte not used */
+    uint32_t buffer_end;                    /* The index after the last byte received */
+    char line[SERVER_MAX_LINE + 1];         /* The current request line, ended by a NULL character */
+    int8_t *file;                           /* The buffer of the inline files */
+    uint64_t file_capacity;                 /* The number of bytes of the buffer of the inline files */
+} ServerWorker_t;
+
+/**
+ * @brief Structure to hold the outcome of a request, written in its answer.
+ */
+typedef struct
+{
+    const char *name;               /* The name of the request */
+    ServerRequest_t kind;           /* The kind of the request in the metrics */
+    int32_t result;                 /* The result of the request */
+    FileReport_t report;            /* The report of the validation of the file */
+    uint64_t size;                  /* The number of bytes of the file */
+    int8_t cached;                  /* 1 if the result is found in the result cache */
+    int8_t converted;               /* 1 for a conversion, its binary size is written */
+    uint64_t binary_size;           /* The number of bytes of the binary file of a conversion */
+} ServerAnswer_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+#if !defined(_WIN32)
+/**
+ * @brief This function is one worker of the server, it serves the connections of the queue until the server stops.
+ *
+ * @param argument The worker.
+ * @return NULL.
+ */
+static void *serveConnections(void *argument);
+
+/**
+ * @brief This function takes the next connection of the queue, it waits while the queue is empty.
+ *
+ * @param server The server.
+ * @return The socket of the connection, -1 if the server stops.
+ */
+static int32_t takeConnection(HexServer_t *server);
+
+/**
+ * @brief This function answers the requests of a connection until the client closes it.
+ *
+ * @param worker The worker, its connection is set.
+ */
+static void serveConnection(ServerWorker_t *worker);
+
+/**
+ * @brief This function answers one request.
+ *
+ * @param worker The worker, its line holds the request.
+ * @return 1 if the next request of the connection can be read, 0 if the connection must be closed.
+ */
+static int8_t answerRequest(ServerWorker_t *worker);
+
+/**
+ * @brief This function receives the inline file of a request in the file buffer of the worker.
+ *
+ * @param worker The worker.
+ * @param argument The size argument of the request.
+ * @param size Pointer to store the number of bytes of the file.
+ * @return 0 if the file is received, 3 if the connection is closed before its end,
+ *         4 if there isn't enough memory, SERVER_INVALID_REQUEST if the size isn't valid.
+ */
+static int32_t receiveInlineFile(ServerWorker_t *worker, const char *argument, uint64_t *size);
+
+/**
+ * @brief This function validates a file stored in memory and writes its valid records as JSON lines.
+ *
+ * @param worker The worker, the lines are written with its output writer.
+ * @param buffer The content of the file.
+ * @param size The number of bytes of the file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+static int32_t dumpBuffer(ServerWorker_t *worker, const int8_t buffer[], uint64_t size, FileReport_t *report);
+
+/**
+ * @brief This function writes one valid record as a JSON line, it is the visitor of dumpBuffer.
+ *
+ * @param visitor_context The context of the worker.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void dumpRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                       uint32_t line_number);
+
+/**
+ * @brief This function writes the answer of a request.
+ *
+ * @param output The writer of the answer.
+ * @param answer The outcome of the request.
+ * @param latency The latency of the request in nanoseconds.
+ */
+static void writeAnswer(OutputWriter_t *output, const ServerAnswer_t *answer, uint64_t latency);
+
+/**
+ * @brief This function writes the answer of a metrics request.
+ *
+ * @param server The server.
+ * @param output The writer of the answer.
+ */
+static void writeMetrics(HexServer_t *server, OutputWriter_t *output);
+
+/**
+ * @brief This function adds the latency of a request to the metrics.
+ *
+ * @param server The server.
+ * @param kind The kind of the request.
+ * @param result The result of the request.
+ * @param latency The latency of the request in nanoseconds.
+ */
+static void addLatency(HexServer_t *server, ServerRequest_t kind, int32_t result, uint64_t latency);
+
+/**
+ * @brief This function writes the counters and the latency percentiles of one kind of requests.
+ *
+ * @param server The server.
+ * @param output The writer of the answer.
+ * @param kind The kind of the requests.
+ * @param window An array of SERVER_LATENCY_WINDOW latencies used to sort the latencies.
+ */
+static void writeLatency(HexServer_t *server, OutputWriter_t *output, ServerRequest_t kind, uint64_t window[]);
+
+/**
+ * @brief This function reads the next request line of the connection into the line of the worker.
+ *
+ * A carriage return at the end of the line is removed.
+ *
+ * @param worker The worker.
+ * @return 1 if a line is read, 0 if the connection is closed, the line is too long or the server stops.
+ */
+static int8_t readRequestLine(ServerWorker_t *worker);
+
+/**
+ * @brief This function receives bytes of the connection directly into a buffer, after the bytes of the worker buffer.
+ *
+ * @param worker The worker.
+ * @param data The buffer to store the bytes.
+ * @param size The number of bytes to receive.
+ * @return 1 if all bytes are received, 0 if the connection is closed before or the server stops.
+ */
+static int8_t receiveBytes(ServerWorker_t *worker, uint8_t data[], uint64_t size);
+
+/**
+ * @brief This function waits until bytes can be received from the connection.
+ *
+ * @param worker The worker.
+ * @return 1 if bytes can be received, 0 if the server stops.
+ */
+static int8_t waitForBytes(ServerWorker_t *worker);
+
+/**
+ * @brief This function compares two latencies for qsort.
+ *
+ * @param first The first latency.
+ * @param second The second latency.
+ * @return A negative value, 0 or a positive value if the first latency is shorter, equal or longer.
+ */
+static int compareLatencies(const void *first, const void *second);
+
+/**
+ * @brief This function tells if the server is asked to stop.
+ *
+ * @param server The server.
+ * @return 1 if the server is asked to stop, 0 otherwise.
+ */
+static int8_t isStopping(HexServer_t *server);
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function opens a validation server on a Unix domain socket and starts its workers.
+ *
+ * A socket that already exists at the path of the socket is replaced, the server doesn't start if another kind
+ * of file is at the path. The socket has the mode 0600, only the user of the server can connect to it, because
+ * the requests can read and write files with the rights of the server. The signal SIGPIPE is ignored,
+ * so a client that closes its connection early doesn't stop the server.
+ *
+ * @param server The server to open.
+ * @param socket_path The path of the socket, it must stay valid until the server is closed.
+ * @param thread_count The number of worker threads, 0 to use one thread per processor.
+ * @param cache The result cache shared by the workers, NULL to validate every file.
+ * @return 0 if the server is open, 3 if the socket can't be created (a file that isn't a socket is at its path
+ *         or the system has no Unix domain sockets), 4 if there isn't enough memory or no worker can be started.
+ */
+int32_t openHexServer(HexServer_t *server, const char *socket_path, uint32_t thread_count, ResultCache_t *cache)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+#if !defined(_WIN32)
+    uint32_t i = 0;                         /* Loop counter */
+    uint32_t worker_count = 0;              /* The number of workers */
+    struct sockaddr_un address;             /* Declaring the address of the socket */
+    struct stat existing;                   /* Declaring the status of the file at the path of the socket */
+    mode_t mask = 0;                        /* The file mode creation mask of the process */
+    int8_t bound = 0;                       /* 1 if the socket is bound to its path */
+#endif
+
+    memset(server, 0, sizeof(HexServer_t));
+    server->listener = -1;
+    server->socket_path = socket_path;
+    server->cache = cache;
+    server->start_time = readStatisticsClock();
+#if defined(_WIN32)
+    /* The C runtime of the project has no Unix domain sockets */
+    (void)thread_count;
+    status = 3;
+#else
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) < sizeof(address.sun_path))
+    {
+        strcpy(address.sun_path, socket_path);
+        server->listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Only a socket left by a previous server is replaced, any other file at the path is kept */
+    if ((server->listener >= 0) && (lstat(socket_path, &existing) == 0) && !S_ISSOCK(existing.st_mode))
+    {
+        close(server->listener);
+        server->listener = -1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (server->listener >= 0)
+    {
+        unlink(socket_path);
+        /* The socket is created with the mode 0600, so only the user of the server can send requests,
+        no thread is started yet when the mask of the process is changed */
+        mask = umask(0177);
+        bound = (bind(server->listener, (struct sockaddr *)&address, sizeof(address)) == 0);
+        umask(mask);
+        if (!bound || (listen(server->listener, SERVER_BACKLOG) != 0))
+        {
+            close(server->listener);
+            server->listener = -1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (server->listener < 0)
+    {
+        status = 3;
+    }
+    else
+    {
+        worker_count = (thread_count == 0) ? getProcessorCount() : thread_count;
+        if (worker_count > SERVER_MAX_THREADS)
+        {
+            worker_count = SERVER_MAX_THREADS;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* The workers have large buffers, they are allocated instead of being on the stack */
+        server->workers = (ServerWorker_t *)calloc(worker_count, sizeof(ServerWorker_t));
+        if (server->workers == NULL)
+        {
+            status = 4;
+        }
+        else
+        {
+            signal(SIGPIPE, SIG_IGN);
+            pthread_mutex_init(&(server->lock), NULL);
+            pthread_cond_init(&(server->pending_ready), NULL);
+            /* Resolve the kernel of the hexadecimal decoder before the threads use it */
+            getHexKernelName();
+            for (i = 0; i < worker_count; i++)
+            {
+                server->workers[i].server = server;
+                server->workers[i].connection = -1;
+                initHexContext(&(server->workers[i].context), &(server->workers[i].output));
+                server->workers[i].started = (pthread_create(&(server->workers[i].thread), NULL, serveConnections,
+                                                             &(server->workers[i])) == 0);
+                server->thread_count += (uint32_t)server->workers[i].started;
+            }
+            server->worker_count = worker_count;
+            if (server->thread_count == 0)
+            {
+                closeHexServer(server);
+                status = 4;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        if ((status != 0) && (server->listener >= 0))
+        {
+            close(server->listener);
+            server->listener = -1;
+            unlink(socket_path);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+#endif
+    return status;
+}
+
+/**
+ * @brief This function accepts the connections of the clients until the server is stopped.
+ *
+ * The listening socket is only polled while the queue has room, the connections beyond wait in its backlog.
+ *
+ * @param server The open server.
+ */
+void runHexServer(HexServer_t *server)
+{
+#if !defined(_WIN32)
+    int32_t connection = -1;                /* The socket of an accepted connection */
+    int8_t has_room = 0;                    /* 1 if the queue has room for a connection */
+    struct pollfd listener;                 /* Declaring the poll state of the listening socket */
+
+    listener.fd = server->listener;
+    listener.events = POLLIN;
+    while (!isStopping(server))
+    {
+        pthread_mutex_lock(&(server->lock));
+        has_room = (server->pending_count < SERVER_MAX_PENDING);
+        pthread_mutex_unlock(&(server->lock));
+
+        listener.revents = 0;
+        if (has_room && (poll(&listener, 1, SERVER_POLL_INTERVAL) > 0) && ((listener.revents & POLLIN) != 0))
+        {
+            connection = accept(server->listener, NULL, NULL);
+        }
+        else
+        {
+            if (!has_room)
+            {
+                /* Wait for a worker to take a connection */
+                poll(NULL, 0, SERVER_POLL_INTERVAL);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            connection = -1;
+        }
+
+        if (connection >= 0)
+        {
+            pthread_mutex_lock(&(server->lock));
+            server->pending[(server->pending_first + server->pending_count) % SERVER_MAX_PENDING] = connection;
+            server->pending_count += 1;
+            server->connection_count += 1;
+            pthread_cond_signal(&(server->pending_ready));
+            pthread_mutex_unlock(&(server->lock));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    /* Wake up the workers waiting for a connection */
+    pthread_mutex_lock(&(server->lock));
+    pthread_cond_broadcast(&(server->pending_ready));
+    pthread_mutex_unlock(&(server->lock));
+#else
+    (void)server;
+#endif
+}
+
+/**
+ * @brief This function asks the server to stop.
+ *
+ * The function only sets a flag, it can be called from a signal handler. The server stops accepting connections,
+ * the workers close their connections once the request in progress is answered.
+ *
+ * @param server The server.
+ */
+void stopHexServer(HexServer_t *server)
+{
+    /* A lock-free store, so the function can be called from a signal handler */
+    __atomic_store_n(&(server->stopping), 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief This function waits for the workers, closes the connections and removes the socket.
+ *
+ * The connections still in the queue are closed without an answer.
+ *
+ * @param server The server, runHexServer must have returned.
+ */
+void closeHexServer(HexServer_t *server)
+{
+#if !defined(_WIN32)
+    uint32_t i = 0;                         /* Loop counter */
+
+    if (server->workers != NULL)
+    {
+        stopHexServer(server);
+        pthread_mutex_lock(&(server->lock));
+        pthread_cond_broadcast(&(server->pending_ready));
+        pthread_mutex_unlock(&(server->lock));
+        for (i = 0; i < server->worker_count; i++)
+        {
+            if (server->workers[i].started)
+            {
+                pthread_join(server->workers[i].thread, NULL);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            free(server->workers[i].file);
+        }
+        for (i = 0; i < server->pending_count; i++)
+        {
+            close(server->pending[(server->pending_first + i) % SERVER_MAX_PENDING]);
+        }
+        server->pending_count = 0;
+        pthread_cond_destroy(&(server->pending_ready));
+        pthread_mutex_destroy(&(server->lock));
+        free(server->workers);
+        server->workers = NULL;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (server->listener >= 0)
+    {
+        close(server->listener);
+        server->listener = -1;
+        unlink(server->socket_path);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+#else
+    (void)server;
+#endif
+}
+
+#if !defined(_WIN32)
+/**
+ * @brief This function is one worker of the server, it serves the connections of the queue until the server stops.
+ *
+ * The context of the worker is kept from one connection to the next, only its state is reset for each file.
+ *
+ * @param argument The worker.
+ * @return NULL.
+ */
+static void *serveConnections(void *argument)
+{
+    ServerWorker_t *worker = (ServerWorker_t *)argument;    /* The worker */
+
+    do
+    {
+        worker->connection = takeConnection(worker->server);
+        if (worker->connection >= 0)
+        {
+            serveConnection(worker);
+            close(worker->connection);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    } while (worker->connection >= 0);
+    return NULL;
+}
+
+/**
+ * @brief This function takes the next connection of the queue, it waits while the queue is empty.
+ *
+ * @param server The server.
+ * @return The socket of the connection, -1 if the server stops.
+ */
+static int32_t takeConnection(HexServer_t *server)
+{
+    int32_t connection = -1;                /* The socket of the connection taken */
+
+    pthread_mutex_lock(&(server->lock));
+    while ((server->pending_count == 0) && !isStopping(server))
+    {
+        pthread_cond_wait(&(server->pending_ready), &(server->lock));
+    }
+    if ((server->pending_count > 0) && !isStopping(server))
+    {
+        connection = server->pending[server->pending_first];
+        server->pending_first = (server->pending_first + 1) % SERVER_MAX_PENDING;
+        server->pending_count -= 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    pthread_mutex_unlock(&(server->lock));
+    return connection;
+}
+
+/**
+ * @brief This function answers the requests of a connection until the client closes it.
+ *
+ * The answers are written on a stream opened on a copy of the socket, so closing the stream keeps the socket.
+ *
+ * @param worker The worker, its connection is set.
+ */
+static void serveConnection(ServerWorker_t *worker)
+{
+    int8_t continue_serving = 1;            /* Initialize a flag to control the loop */
+    int32_t copy = dup(worker->connection); /* The copy of the socket used by the stream */
+    FILE *stream = (copy >= 0) ? fdopen(copy, "wb") : NULL;    /* The stream of the answers */
+
+    if (stream == NULL)
+    {
+        if (copy >= 0)
+        {
+            close(copy);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        worker->buffer_start = 0;
+        worker->buffer_end = 0;
+        openOutputWriter(&(worker->output), stream);
+        while (continue_serving && readRequestLine(worker))
+        {
+            continue_serving = answerRequest(worker);
+            flushOutputWriter(&(worker->output));
+            fflush(stream);
+        }
+        fclose(stream);
+    }
+}
+
+/**
+ * @brief This function answers one request.
+ *
+ * The latency of the request is measured from the end of its line to the end of its answer, with the bytes
+ * of an inline file. The answer of a metrics request holds the metrics instead of a file report.
+ *
+ * @param worker The worker, its line holds the request.
+ * @return 1 if the next request of the connection can be read, 0 if the connection must be closed.
+ */
+static int8_t answerRequest(ServerWorker_t *worker)
+{
+    int8_t continue_serving = 1;            /* Initialize the result of the function */
+    uint64_t start = readStatisticsClock(); /* The time of the beginning of the request */
+    char *argument = strchr(worker->line, ' ');     /* The arguments of the request, after the first space */
+    char *path = NULL;                      /* The path of the Intel Hex file of a conversion */
+    FILE *output = NULL;                    /* The binary file of a conversion */
+    ServerAnswer_t answer;                  /* Declaring the outcome of the request */
+    CachedResult_t cached;                  /* Declaring the result of the file with the result cache */
+    MappedFile_t mapping;                   /* Declaring the mapping of a dumped file */
+    BinaryOptions_t options = { 0xFF, 0, 0, 0 };    /* The fill value of a conversion, the whole image is written */
+
+    memset(&answer, 0, sizeof(ServerAnswer_t));
+    answer.name = "invalid";
+    answer.kind = SERVER_REQUEST_OTHER;
+    answer.result = SERVER_INVALID_REQUEST;
+    if (argument != NULL)
+    {
+        *argument = '\0';
+        argument += 1;
+    }
+    else
+    {
+        argument = worker->line + strlen(worker->line);
+    }
+    resetHexContext(&(worker->context));
+
+    if ((strcmp(worker->line, "validate") == 0) && (*argument != '\0'))
+    {
+        answer.name = "validate";
+        answer.kind = SERVER_REQUEST_VALIDATE;
+        answer.result = validateIntelHexFileCached(worker->server->cache, &(worker->context), argument, 0, &cached);
+        answer.report = cached.report;
+        answer.size = cached.size;
+        answer.cached = cached.cached;
+        freeCachedResult(&cached);
+    }
+    else if (strcmp(worker->line, "validate-inline") == 0)
+    {
+        answer.name = "validate-inline";
+        answer.kind = SERVER_REQUEST_VALIDATE;
+        answer.result = receiveInlineFile(worker, argument, &(answer.size));
+        if (answer.result == 0)
+        {
+            answer.result = validateIntelHexBuffer(&(worker->context), worker->file, answer.size, &(answer.report));
+        }
+        else
+        {
+            continue_serving = 0;
+        }
+    }
+    else if ((strcmp(worker->line, "dump") == 0) && (*argument != '\0'))
+    {
+        answer.name = "dump";
+        answer.kind = SERVER_REQUEST_DUMP;
+        if (mapFile(argument, &mapping) == 0)
+        {
+            answer.size = mapping.size;
+            answer.result = dumpBuffer(worker, mapping.data, mapping.size, &(answer.report));
+            unmapFile(&mapping);
+        }
+        else
+        {
+            answer.result = 3;
+        }
+    }
+    else if (strcmp(worker->line, "dump-inline") == 0)
+    {
+        answer.name = "dump-inline";
+        answer.kind = SERVER_REQUEST_DUMP;
+        answer.result = receiveInlineFile(worker, argument, &(answer.size));
+        if (answer.result == 0)
+        {
+            answer.result = dumpBuffer(worker, worker->file, answer.size, &(answer.report));
+        }
+        else
+        {
+            continue_serving = 0;
+        }
+    }
+    else if ((strcmp(worker->line, "convert") == 0) && ((path = strchr(argument, ' ')) != NULL))
+    {
+        answer.name = "convert";
+        answer.kind = SERVER_REQUEST_CONVERT;
+        answer.converted = 1;
+        *path = '\0';
+        path += 1;
+        /* Open the binary file in update mode, the blocks written are read back when a record changes them again */
+        output = fopen(argument, "w+b");
+        if (output != NULL)
+        {
+            answer.result = convertIntelHexToBinary(&(worker->context), path, output, &options, &(answer.report),
+                                                    &(answer.binary_size));
+            fclose(output);
+            /* The binary file of an invalid file is removed */
+            if (answer.result != 0)
+            {
+                remove(argument);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            answer.result = 3;
+        }
+    }
+    else if ((strcmp(worker->line, "metrics") == 0) && (*argument == '\0'))
+    {
+        answer.name = "metrics";
+        answer.result = 0;
+    }
+    else if ((strcmp(worker->line, "shutdown") == 0) && (*argument == '\0'))
+    {
+        answer.name = "shutdown";
+        answer.result = 0;
+        stopHexServer(worker->server);
+        continue_serving = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (strcmp(answer.name, "metrics") == 0)
+    {
+        writeMetrics(worker->server, &(worker->output));
+    }
+    else
+    {
+        writeAnswer(&(worker->output), &answer, readStatisticsClock() - start);
+    }
+    addLatency(worker->server, answer.kind, answer.result, readStatisticsClock() - start);
+    return continue_serving;
+}
+
+/**
+ * @brief This function receives the inline file of a request in the file buffer of the worker.
+ *
+ * The file buffer of the worker is only enlarged, so the next inline files of the same size don't allocate memory.
+ * The connection can't be used after an invalid size, the bytes of the file can't be told from the next request.
+ *
+ * @param worker The worker.
+ * @param argument The size argument of the request.
+ * @param size Pointer to store the number of bytes of the file.
+ * @return 0 if the file is received, 3 if the connection is closed before its end,
+ *         4 if there isn't enough memory, SERVER_INVALID_REQUEST if the size isn't valid.
+ */
+static int32_t receiveInlineFile(ServerWorker_t *worker, const char *argument, uint64_t *size)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+    char *end = NULL;                       /* The end of the size argument */
+    int8_t *file = NULL;                    /* Pointer to the enlarged file buffer */
+
+    *size = (uint64_t)strtoull(argument, &end, 10);
+    if ((*argument < '0') || (*argument > '9') || (*end != '\0') || (*size > SERVER_MAX_INLINE_SIZE))
+    {
+        *size = 0;
+        status = SERVER_INVALID_REQUEST;
+    }
+    else if (*size > worker->file_capacity)
+    {
+        file = (int8_t *)realloc(worker->file, (size_t)*size);
+        if (file != NULL)
+        {
+            worker->file = file;
+            worker->file_capacity = *size;
+        }
+        else
+        {
+            status = 4;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if ((status == 0) && (*size > 0) && !receiveBytes(worker, (uint8_t *)worker->file, *size))
+    {
+        status = 3;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return status;
+}
+
+/**
+ * @brief This function validates a file stored in memory and writes its valid records as JSON lines.
+ *
+ * The lines are the lines of exportIntelHexFile, they are written until the first invalid record.
+ *
+ * @param worker The worker, the lines are written with its output writer.
+ * @param buffer The content of the file.
+ * @param size The number of bytes of the file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+static int32_t dumpBuffer(ServerWorker_t *worker, const int8_t buffer[], uint64_t size, FileReport_t *report)
+{
+    writeRecordHeader(&(worker->context), RECORD_FORMAT_JSON);
+    return visitIntelHexBuffer(&(worker->context), buffer, size, dumpRecord, &(worker->context), report);
+}
+
+/**
+ * @brief This function writes one valid record as a JSON line, it is the visitor of dumpBuffer.
+ *
+ * @param visitor_context The context of the worker.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void dumpRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                       uint32_t line_number)
+{
+    writeRecordLine((HexContext_t *)visitor_context, record, line_number, absolute_address, RECORD_FORMAT_JSON);
+}
+
+/**
+ * @brief This function writes the answer of a request.
+ *
+ * The errors have the fields of Error_t, the other fields are the counters of FileReport_t.
+ *
+ * @param output The writer of the answer.
+ * @param answer The outcome of the request.
+ * @param latency The latency of the request in nanoseconds.
+ */
+static void writeAnswer(OutputWriter_t *output, const ServerAnswer_t *answer, uint64_t latency)
+{
+    writeString(output, "{\"request\":\"");
+    writeString(output, answer->name);
+    writeString(output, "\",\"result\":");
+    writeDecimal(output, answer->result);
+    writeString(output, ",\"record_error\":{\"error_code\":");
+    writeDecimal(output, answer->report.record_error.error_code);
+    writeString(output, ",\"error_line\":");
+    writeDecimal(output, answer->report.record_error.error_line);
+    writeString(output, "},\"eof_error\":{\"error_code\":");
+    writeDecimal(output, answer->report.eof_error.error_code);
+    writeString(output, ",\"error_line\":");
+    writeDecimal(output, answer->report.eof_error.error_line);
+    writeString(output, "},\"line_count\":");
+    writeDecimal(output, answer->report.line_count);
+    writeString(output, ",\"data_byte_count\":");
+    writeDecimal(output, answer->report.data_byte_count);
+    writeString(output, ",\"lowest_address\":");
+    writeDecimal(output, answer->report.lowest_address);
+    writeString(output, ",\"highest_address\":");
+    writeDecimal(output, answer->report.highest_address);
+    writeString(output, ",\"start_record_type\":");
+    writeDecimal(output, answer->report.start_record_type);
+    writeString(output, ",\"start_address\":");
+    writeDecimal(output, answer->report.start_address);
+    writeString(output, ",\"size\":");
+    writeDecimal(output, (int64_t)answer->size);
+    writeString(output, ",\"cached\":");
+    writeDecimal(output, answer->cached);
+    if (answer->converted)
+    {
+        writeString(output, ",\"binary_size\":");
+        writeDecimal(output, (int64_t)answer->binary_size);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    writeString(output, ",\"latency_us\":");
+    writeDecimal(output, (int64_t)(latency / 1000U));
+    writeString(output, "}\n");
+}
+
+/**
+ * @brief This function writes the answer of a metrics request.
+ *
+ * @param server The server.
+ * @param output The writer of the answer.
+ */
+static void writeMetrics(HexServer_t *server, OutputWriter_t *output)
+{
+    uint64_t connection_count = 0;          /* The number of connections accepted */
+    uint32_t pending_count = 0;             /* The number of connections waiting for a worker */
+    /* The latencies are sorted in a copy, so the requests of the other workers aren't blocked by the sort */
+    uint64_t *window = (uint64_t *)malloc(SERVER_LATENCY_WINDOW * sizeof(uint64_t));
+
+    pthread_mutex_lock(&(server->lock));
+    connection_count = server->connection_count;
+    pending_count = server->pending_count;
+    pthread_mutex_unlock(&(server->lock));
+
+    writeString(output, "{\"request\":\"metrics\",\"result\":");
+    writeDecimal(output, (window != NULL) ? 0 : 4);
+    writeString(output, ",\"uptime_ms\":");
+    writeDecimal(output, (int64_t)((readStatisticsClock() - server->start_time) / 1000000U));
+    writeString(output, ",\"threads\":");
+    writeDecimal(output, server->thread_count);
+    writeString(output, ",\"connections\":");
+    writeDecimal(output, (int64_t)connection_count);
+    writeString(output, ",\"pending\":");
+    writeDecimal(output, pending_count);
+    writeString(output, ",\"kernel\":\"");
+    writeString(output, getHexKernelName());
+    writeString(output, "\"");
+    if (window != NULL)
+    {
+        writeString(output, ",\"validate\":");
+        writeLatency(server, output, SERVER_REQUEST_VALIDATE, window);
+        writeString(output, ",\"dump\":");
+        writeLatency(server, output, SERVER_REQUEST_DUMP, window);
+        writeString(output, ",\"convert\":");
+        writeLatency(server, output, SERVER_REQUEST_CONVERT, window);
+        writeString(output, ",\"other\":");
+        writeLatency(server, output, SERVER_REQUEST_OTHER, window);
+        free(window);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    writeString(output, "}\n");
+}
+
+/**
+ * @brief This function adds the latency of a request to the metrics.
+ *
+ * The latency replaces the oldest latency of the window of its kind.
+ *
+ * @param server The server.
+ * @param kind The kind of the request.
+ * @param result The result of the request.
+ * @param latency The latency of the request in nanoseconds.
+ */
+static void addLatency(HexServer_t *server, ServerRequest_t kind, int32_t result, uint64_t latency)
+{
+    ServerLatency_t *metrics = &(server->latency[kind]);    /* The metrics of the kind of the request */
+
+    pthread_mutex_lock(&(server->lock));
+    metrics->latencies[metrics->count % SERVER_LATENCY_WINDOW] = latency;
+    metrics->count += 1;
+    metrics->failed += (result != 0) ? 1 : 0;
+    metrics->max_latency = (latency > metrics->max_latency) ? latency : metrics->max_latency;
+    pthread_mutex_unlock(&(server->lock));
+}
+
+/**
+ * @brief This function writes the counters and the latency percentiles of one kind of requests.
+ *
+ * The percentiles are the nearest-rank percentiles of the latencies of the window, in microseconds.
+ *
+ * @param server The server.
+ * @param output The writer of the answer.
+ * @param kind The kind of the requests.
+ * @param window An array of SERVER_LATENCY_WINDOW latencies used to sort the latencies.
+ */
+static void writeLatency(HexServer_t *server, OutputWriter_t *output, ServerRequest_t kind, uint64_t window[])
+{
+    uint32_t i = 0;                         /* Loop counter */
+    uint64_t count = 0;                     /* The number of requests answered */
+    uint64_t failed = 0;                    /* The number of requests whose result isn't 0 */
+    uint64_t max_latency = 0;               /* The longest latency of all requests */
+    uint32_t window_count = 0;              /* The number of latencies in the window */
+    static const uint32_t percentiles[3] = { 50, 90, 99 };  /* The percentiles written */
+
+    pthread_mutex_lock(&(server->lock));
+    count = server->latency[kind].count;
+    failed = server->latency[kind].failed;
+    max_latency = server->latency[kind].max_latency;
+    window_count = (count < SERVER_LATENCY_WINDOW) ? (uint32_t)count : SERVER_LATENCY_WINDOW;
+    memcpy(window, server->latency[kind].latencies, (size_t)window_count * sizeof(uint64_t));
+    pthread_mutex_unlock(&(server->lock));
+
+    qsort(window, window_count, sizeof(uint64_t), compareLatencies);
+    writeString(output, "{\"count\":");
+    writeDecimal(output, (int64_t)count);
+    writeString(output, ",\"failed\":");
+    writeDecimal(output, (int64_t)failed);
+    for (i = 0; i < 3; i++)
+    {
+        writeString(output, ",\"p");
+        writeDecimal(output, percentiles[i]);
+        writeString(output, "_us\":");
+        writeDecimal(output, (window_count > 0) ?
+                     (int64_t)(window[((window_count * percentiles[i]) + 99) / 100 - 1] / 1000U) : 0);
+    }
+    writeString(output, ",\"max_us\":");
+    writeDecimal(output, (int64_t)(max_latency / 1000U));
+    writeString(output, "}");
+}
+
+/**
+ * @brief This function reads the next request line of the connection into the line of the worker.
+ *
+ * A carriage return at the end of the line is removed.
+ *
+ * @param worker The worker.
+ * @return 1 if a line is read, 0 if the connection is closed, the line is too long or the server stops.
+ */
+static int8_t readRequestLine(ServerWorker_t *worker)
+{
+    int8_t status = 2;                      /* 2 while the line isn't complete, then the result of the function */
+    uint8_t *line = NULL;                   /* Pointer to the first character of the line in the buffer */
+    uint8_t *newline = NULL;                /* Pointer to the new line character of the line */
+    uint32_t length = 0;                    /* The number of characters of the line */
+    ssize_t received = 0;                   /* The number of bytes received */
+
+    while (status == 2)
+    {
+        newline = (uint8_t *)memchr(worker->buffer + worker->buffer_start, '\n',
+                                    worker->buffer_end - worker->buffer_start);
+        if (newline != NULL)
+        {
+            line = worker->buffer + worker->buffer_start;
+            length = (uint32_t)(newline - line);
+            worker->buffer_start += length + 1;
+            if ((length > 0) && (line[length - 1] == '\r'))
+            {
+                length -= 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            if (length <= SERVER_MAX_LINE)
+            {
+                memcpy(worker->line, line, length);
+                worker->line[length] = '\0';
+                status = 1;
+            }
+            else
+            {
+                status = 0;
+            }
+        }
+        else if (worker->buffer_end - worker->buffer_start > SERVER_MAX_LINE)
+        {
+            status = 0;
+        }
+        else
+        {
+            /* Move the beginning of the line to the front of the buffer and receive more bytes */
+            memmove(worker->buffer, worker->buffer + worker->buffer_start, worker->buffer_end - worker->buffer_start);
+            worker->buffer_end -= worker->buffer_start;
+            worker->buffer_start = 0;
+            received = 0;
+            while ((received == 0) && waitForBytes(worker))
+            {
+                received = recv(worker->connection, worker->buffer + worker->buffer_end,
+                                SERVER_BUFFER_SIZE - worker->buffer_end, 0);
+                if ((received < 0) && (errno == EINTR))
+                {
+                    received = 0;
+                }
+                else if (received <= 0)
+                {
+                    /* The connection is closed */
+                    received = -1;
+                }
+                else
+                {
+                    worker->buffer_end += (uint32_t)received;
+                }
+            }
+            status = (received > 0) ? 2 : 0;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief This function receives bytes of the connection directly into a buffer, after the bytes of the worker buffer.
+ *
+ * @param worker The worker.
+ * @param data The buffer to store the bytes.
+ * @param size The number of bytes to receive.
+ * @return 1 if all bytes are received, 0 if the connection is closed before or the server stops.
+ */
+static int8_t receiveBytes(ServerWorker_t *worker, uint8_t data[], uint64_t size)
+{
+    uint64_t count = worker->buffer_end - worker->buffer_start;     /* The number of bytes in the worker buffer */
+    ssize_t received = 0;                   /* The number of bytes received at once */
+
+    /* Take the bytes already received with the request line first */
+    count = (count < size) ? count : size;
+    memcpy(data, worker->buffer + worker->buffer_start, (size_t)count);
+    worker->buffer_start += (uint32_t)count;
+    while ((count < size) && (received >= 0) && waitForBytes(worker))
+    {
+        received = recv(worker->connection, data + count, (size_t)(size - count), 0);
+        if ((received < 0) && (errno == EINTR))
+        {
+            received = 0;
+        }
+        else if (received <= 0)
+        {
+            /* The connection is closed */
+            received = -1;
+        }
+        else
+        {
+            count += (uint64_t)received;
+        }
+    }
+    return (count == size);
+}
+
+/**
+ * @brief This function waits until bytes can be received from the connection.
+ *
+ * The stop flag is checked every SERVER_POLL_INTERVAL milliseconds, so an idle client doesn't keep the server open.
+ *
+ * @param worker The worker.
+ * @return 1 if bytes can be received, 0 if the server stops.
+ */
+static int8_t waitForBytes(ServerWorker_t *worker)
+{
+    int8_t ready = 0;                       /* Initialize the result of the function */
+    struct pollfd connection;               /* Declaring the poll state of the connection */
+
+    connection.fd = worker->connection;
+    connection.events = POLLIN;
+    while (!ready && !isStopping(worker->server))
+    {
+        connection.revents = 0;
+        /* A closed or failed connection is readable too, recv returns 0 or an error then */
+        ready = (poll(&connection, 1, SERVER_POLL_INTERVAL) > 0);
+    }
+    return ready;
+}
+
+/**
+ * @brief This function compares two latencies for qsort.
+ *
+ * @param first The first latency.
+ * @param second The second latency.
+ * @return A negative value, 0 or a positive value if the first latency is shorter, equal or longer.
+ */
+static int compareLatencies(const void *first, const void *second)
+{
+    uint64_t first_latency = *(const uint64_t *)first;      /* The first latency */
+    uint64_t second_latency = *(const uint64_t *)second;    /* The second latency */
+
+    return (first_latency > second_latency) - (first_latency < second_latency);
+}
+
+/**
+ * @brief This function tells if the server is asked to stop.
+ *
+ * The flag is set by stopHexServer from any thread or from a signal handler.
+ *
+ * @param server The server.
+ * @return 1 if the server is asked to stop, 0 otherwise.
+ */
+static int8_t isStopping(HexServer_t *server)
+{
+    return (__atomic_load_n(&(server->stopping), __ATOMIC_RELAXED) != 0);
+}
+#endif /* EOF */
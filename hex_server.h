@@ -0,0 +1,153 @@
+/**
+ * @file hex_server.h
+ * @brief This file contains the prototypes of the validation server functions.
+ *
+ * The validation server is a long-running process that validates, converts and dumps Intel Hex files for its
+ * clients over a Unix domain socket, so a build that checks many files doesn't start a process for each file.
+ * The server has a pool of worker threads started once. Each worker has its own context, output writer and
+ * buffer that are kept from one request to the next, and serves one connection at a time: the listening thread
+ * puts the accepted connections in a queue and the next free worker takes them, the listening thread stops
+ * accepting while the queue is full so the clients wait in the backlog of the socket. The workers share the result
+ * cache, so a file checked before by any client isn't validated again.
+ *
+ * A request is one line of text ended by a new line, its words are separated by one space and the last argument
+ * is the rest of the line, so only the last path can have spaces:
+ *   validate PATH              validates the file PATH of the server
+ *   validate-inline SIZE       validates the SIZE bytes that follow the line
+ *   dump PATH                  validates the file and writes its valid records as JSON lines first
+ *   dump-inline SIZE           does the same for the SIZE bytes that follow the line
+ *   convert OUT PATH           validates the file and writes its memory image to the binary file OUT (fill FF)
+ *   metrics                    writes the counters and the latency percentiles of the requests
+ *   shutdown                   stops the server once the requests in progress are answered
+ * Each request is answered by one JSON line starting with {"request": with the result of the request (0 to 5,
+ * like the result of validateIntelHexFileCached and convertIntelHexToBinary, or SERVER_INVALID_REQUEST), the error
+ * code and line of the record check and of the End-Of-File check, like Error_t, the counters of the file report
+ * and the latency of the request in microseconds. The requests of one connection are answered in order.
+ *
+ * The server needs Unix domain sockets, it is only available on POSIX systems.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include <pthread.h>  /* For pthread_mutex_t, pthread_cond_t types */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "result_cache.h"              /* Include header file of the result cache */
+#include "batch_validator.h"           /* Include header file of the batch validator */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef HEX_SERVER_H
+#define HEX_SERVER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SERVER_MAX_THREADS          BATCH_MAX_THREADS   /* Maximum number of worker threads of the server */
+#define SERVER_MAX_PENDING          64                  /* Maximum number of connections waiting for a worker */
+#define SERVER_LATENCY_WINDOW       4096                /* Number of last requests of each kind in the percentiles */
+#define SERVER_MAX_INLINE_SIZE      (256U * 1024U * 1024U)  /* Maximum number of bytes of an inline file */
+#define SERVER_INVALID_REQUEST      6                   /* Result of a request that isn't understood */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Enumeration of the kinds of requests that are measured.
+ */
+typedef enum
+{
+    SERVER_REQUEST_VALIDATE = 0,    /* validate and validate-inline */
+    SERVER_REQUEST_DUMP,            /* dump and dump-inline */
+    SERVER_REQUEST_CONVERT,         /* convert */
+    SERVER_REQUEST_OTHER,           /* metrics, shutdown and the invalid requests */
+    SERVER_REQUEST_KINDS            /* The number of kinds */
+} ServerRequest_t;
+
+/**
+ * @brief Structure to hold the latencies of one kind of requests.
+ *
+ * The latencies of the last SERVER_LATENCY_WINDOW requests are kept, so the percentiles follow the recent load.
+ */
+typedef struct
+{
+    uint64_t count;                             /* The number of requests answered */
+    uint64_t failed;                            /* The number of requests whose result isn't 0 */
+    uint64_t max_latency;                       /* The longest latency of all requests, in nanoseconds */
+    uint64_t latencies[SERVER_LATENCY_WINDOW];  /* The latencies of the last requests, in nanoseconds */
+} ServerLatency_t;
+
+/* The workers are only used by the server, their structure is in hex_server.c */
+struct ServerWorker;
+
+/**
+ * @brief Structure to hold the state of a validation server.
+ */
+typedef struct
+{
+    int32_t listener;                           /* The listening socket */
+    const char *socket_path;                    /* The path of the socket, removed when the server is closed */
+    ResultCache_t *cache;                       /* The result cache shared by the workers, NULL if there is none */
+    int32_t stopping;                           /* 1 once the server is asked to stop, accessed atomically */
+    uint32_t worker_count;                      /* The number of workers allocated */
+    uint32_t thread_count;                      /* The number of worker threads started */
+    struct ServerWorker *workers;               /* The workers */
+    pthread_mutex_t lock;                       /* The mutex protecting the queue and the metrics */
+    pthread_cond_t pending_ready;               /* Signaled when a connection is queued or the server stops */
+    int32_t pending[SERVER_MAX_PENDING];        /* The queue of the accepted connections */
+    uint32_t pending_first;                     /* The index of the first connection of the queue */
+    uint32_t pending_count;                     /* The number of connections in the queue */
+    uint64_t connection_count;                  /* The number of connections accepted */
+    uint64_t start_time;                        /* The time the server is opened, in nanoseconds */
+    ServerLatency_t latency[SERVER_REQUEST_KINDS];  /* The latencies of each kind of requests */
+} HexServer_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function opens a validation server on a Unix domain socket and starts its workers.
+ *
+ * A socket that already exists at the path of the socket is replaced, the server doesn't start if another kind
+ * of file is at the path. The socket has the mode 0600, only the user of the server can connect to it, because
+ * the requests can read and write files with the rights of the server.
+ *
+ * @param server The server to open.
+ * @param socket_path The path of the socket, it must stay valid until the server is closed.
+ * @param thread_count The number of worker threads, 0 to use one thread per processor.
+ * @param cache The result cache shared by the workers, NULL to validate every file.
+ * @return 0 if the server is open, 3 if the socket can't be created (a file that isn't a socket is at its path
+ *         or the system has no Unix domain sockets), 4 if there isn't enough memory or no worker can be started.
+ */
+int32_t openHexServer(HexServer_t *server, const char *socket_path, uint32_t thread_count, ResultCache_t *cache);
+
+/**
+ * @brief This function accepts the connections of the clients until the server is stopped.
+ *
+ * @param server The open server.
+ */
+void runHexServer(HexServer_t *server);
+
+/**
+ * @brief This function asks the server to stop.
+ *
+ * The function only sets a flag, it can be called from a signal handler. The server stops accepting connections,
+ * the workers close their connections once the request in progress is answered.
+ *
+ * @param server The server.
+ */
+void stopHexServer(HexServer_t *server);
+
+/**
+ * @brief This function waits for the workers, closes the connections and removes the socket.
+ *
+ * @param server The server, runHexServer must have returned.
+ */
+void closeHexServer(HexServer_t *server);
+
+#endif /* HEX_SERVER_H */
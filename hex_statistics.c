@@ -0,0 +1,251 @@
+/**
+ * @file hex_statistics.c
+ * @brief This file contains the implementation of the statistics functions.
+ *
+ * The functions are always built, so a program can link them whether HEX_STATISTICS is set or not,
+ * only the counting inside the validation is removed from a default build.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "hex_statistics.h"     /* Include header file of this function file */
+#include <string.h>             /* For memset() function */
+
+#if defined(_WIN32)
+#include <windows.h>            /* For QueryPerformanceCounter() function */
+#else
+#include <time.h>               /* For clock_gettime() function */
+#endif
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function writes one counter of the statistics.
+ *
+ * @param output The writer of the statistics.
+ * @param name The name of the counter.
+ * @param value The value of the counter.
+ * @param format The format of the statistics.
+ * @param first 1 for the first counter of a JSON object, no comma is written in front of it.
+ */
+static void writeCounter(OutputWriter_t *output, const char *name, uint64_t value, StatisticsFormat_t format,
+                         int8_t first);
+
+/**
+ * @brief This function writes a list of counters indexed by a number, the counters that are 0 are left out.
+ *
+ * @param output The writer of the statistics.
+ * @param name The name of the list.
+ * @param counters The counters.
+ * @param first_index The index of the first counter written.
+ * @param count The number of counters.
+ * @param format The format of the statistics.
+ */
+static void writeCounterList(OutputWriter_t *output, const char *name, const uint64_t counters[],
+                             uint32_t first_index, uint32_t count, StatisticsFormat_t format);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function clears all counters.
+ *
+ * @param statistics The statistics to clear.
+ */
+void clearHexStatistics(HexStatistics_t *statistics)
+{
+    memset(statistics, 0, sizeof(HexStatistics_t));
+}
+
+/**
+ * @brief This function adds the counters of other statistics, for example the counters of a thread.
+ *
+ * The peak buffer size is the largest of both.
+ *
+ * @param statistics The statistics that get the counters.
+ * @param other The statistics added.
+ */
+void mergeHexStatistics(HexStatistics_t *statistics, const HexStatistics_t *other)
+{
+    uint32_t i = 0;                 /* Loop counter */
+
+    statistics->file_count += other->file_count;
+    statistics->character_count += other->character_count;
+    for (i = 0; i < HEX_STATISTICS_RECORD_TYPES; i++)
+    {
+        statistics->record_count[i] += other->record_count[i];
+    }
+    for (i = 0; i < HEX_STATISTICS_ERROR_CODES; i++)
+    {
+        statistics->error_count[i] += other->error_count[i];
+    }
+    statistics->decoded_byte_count += other->decoded_byte_count;
+    statistics->io_time += other->io_time;
+    statistics->parse_time += other->parse_time;
+    statistics->output_time += other->output_time;
+    if (other->peak_buffer_size > statistics->peak_buffer_size)
+    {
+        statistics->peak_buffer_size = other->peak_buffer_size;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function writes the statistics as a block of lines or as a JSON object.
+ *
+ * The text block has one counter per line, the JSON object is written on one line with the times in nanoseconds.
+ *
+ * @param output The writer of the statistics, it isn't flushed.
+ * @param statistics The statistics to write.
+ * @param format The format of the statistics.
+ */
+void writeHexStatistics(OutputWriter_t *output, const HexStatistics_t *statistics, StatisticsFormat_t format)
+{
+    if (format == STATISTICS_FORMAT_JSON)
+    {
+        writeString(output, "{");
+    }
+    else
+    {
+        writeString(output, "*** STATISTICS ***\n");
+    }
+    writeCounter(output, "files", statistics->file_count, format, 1);
+    writeCounter(output, "characters", statistics->character_count, format, 0);
+    writeCounterList(output, "records", statistics->record_count, 0, HEX_STATISTICS_RECORD_TYPES, format);
+    writeCounterList(output, "errors", statistics->error_count, 1, HEX_STATISTICS_ERROR_CODES, format);
+    writeCounter(output, "decoded_bytes", statistics->decoded_byte_count, format, 0);
+    writeCounter(output, "io_ns", statistics->io_time, format, 0);
+    writeCounter(output, "parse_ns", statistics->parse_time, format, 0);
+    writeCounter(output, "output_ns", statistics->output_time, format, 0);
+    writeCounter(output, "peak_buffer_bytes", statistics->peak_buffer_size, format, 0);
+    if (format == STATISTICS_FORMAT_JSON)
+    {
+        writeString(output, "}\n");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function reads a monotonic clock.
+ *
+ * @return The time in nanoseconds since an arbitrary origin.
+ */
+uint64_t readStatisticsClock(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;          /* The value of the performance counter */
+    LARGE_INTEGER frequency;        /* The frequency of the performance counter */
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    /* Split the counter in seconds and the rest, so the product doesn't overflow */
+    return ((uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000U) +
+           (((uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000U) / (uint64_t)frequency.QuadPart);
+#else
+    struct timespec now;            /* The time of the monotonic clock */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief This function writes one counter of the statistics.
+ *
+ * @param output The writer of the statistics.
+ * @param name The name of the counter.
+ * @param value The value of the counter.
+ * @param format The format of the statistics.
+ * @param first 1 for the first counter of a JSON object, no comma is written in front of it.
+ */
+static void writeCounter(OutputWriter_t *output, const char *name, uint64_t value, StatisticsFormat_t format,
+                         int8_t first)
+{
+    if (format == STATISTICS_FORMAT_JSON)
+    {
+        writeString(output, first ? "\"" : ",\"");
+        writeString(output, name);
+        writeString(output, "\":");
+    }
+    else
+    {
+        writeString(output, name);
+        writeString(output, ": ");
+    }
+    writeDecimal(output, (int64_t)value);
+    if (format != STATISTICS_FORMAT_JSON)
+    {
+        writeString(output, "\n");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function writes a list of counters indexed by a number, the counters that are 0 are left out.
+ *
+ * The list is a JSON object with the indexes as names ("00": 12), the text block has one line
+ * with the indexes and the counters (records: 00=12 01=1).
+ *
+ * @param output The writer of the statistics.
+ * @param name The name of the list.
+ * @param counters The counters.
+ * @param first_index The index of the first counter written.
+ * @param count The number of counters.
+ * @param format The format of the statistics.
+ */
+static void writeCounterList(OutputWriter_t *output, const char *name, const uint64_t counters[],
+                             uint32_t first_index, uint32_t count, StatisticsFormat_t format)
+{
+    uint32_t i = 0;                 /* Loop counter */
+    int8_t first = 1;               /* Initialize a flag to indicate if no counter of the list is written yet */
+
+    if (format == STATISTICS_FORMAT_JSON)
+    {
+        writeString(output, ",\"");
+        writeString(output, name);
+        writeString(output, "\":{");
+    }
+    else
+    {
+        writeString(output, name);
+        writeString(output, ":");
+    }
+    for (i = first_index; i < count; i++)
+    {
+        if (counters[i] != 0)
+        {
+            if (format == STATISTICS_FORMAT_JSON)
+            {
+                writeString(output, first ? "\"" : ",\"");
+                writeHex(output, i, 2);
+                writeString(output, "\":");
+            }
+            else
+            {
+                writeString(output, " ");
+                writeHex(output, i, 2);
+                writeString(output, "=");
+            }
+            writeDecimal(output, (int64_t)counters[i]);
+            first = 0;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    writeString(output, (format == STATISTICS_FORMAT_JSON) ? "}" : "\n");
+} /* EOF */
@@ -0,0 +1,117 @@
+/**
+ * @file hex_statistics.h
+ * @brief This file contains the prototypes of the statistics functions.
+ *
+ * The statistics count where the work of a validation goes: the records of each type, the data bytes decoded,
+ * the invalid records of each error code, the time spent reading the file, parsing the records and printing
+ * them, and the largest block of the file held in memory.
+ * They are only collected in a build with HEX_STATISTICS set to 1 (e.g. -DHEX_STATISTICS=1), the counters are
+ * then part of the context of a file, so every thread counts in its own context without any lock and the counters
+ * of the threads are added together with mergeHexStatistics at the end. In a default build the macros
+ * HEX_STATISTICS_ADD, HEX_STATISTICS_MAX, HEX_STATISTICS_CLOCK and HEX_STATISTICS_ELAPSED expand to nothing.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include "output_writer.h"   /* Include header file of the output writer */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef HEX_STATISTICS_H
+#define HEX_STATISTICS_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef HEX_STATISTICS
+#define HEX_STATISTICS 0            /* 1 to collect the statistics, 0 to remove them from the build */
+#endif
+
+#define HEX_STATISTICS_RECORD_TYPES 6   /* Number of record types counted, the record types 00 to 05 */
+#define HEX_STATISTICS_ERROR_CODES  7   /* Number of error codes counted, indexed by the error code 1 to 6 of checkRecord */
+
+#if HEX_STATISTICS
+#define HEX_STATISTICS_ADD(counter, amount)     ((counter) += (uint64_t)(amount))
+#define HEX_STATISTICS_MAX(counter, value)      ((counter) = ((uint64_t)(value) > (counter)) ? (uint64_t)(value) : (counter))
+#define HEX_STATISTICS_CLOCK()                  readStatisticsClock()
+#define HEX_STATISTICS_ELAPSED(counter, start)  ((counter) += readStatisticsClock() - (start))
+#else
+#define HEX_STATISTICS_ADD(counter, amount)     ((void)0)
+#define HEX_STATISTICS_MAX(counter, value)      ((void)0)
+#define HEX_STATISTICS_CLOCK()                  0
+#define HEX_STATISTICS_ELAPSED(counter, start)  ((void)(start))
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the statistics of the files processed with a context.
+ *
+ * The times are in nanoseconds. The times of the threads of a parallel validation are added together,
+ * so they can be longer than the elapsed time.
+ */
+typedef struct
+{
+    uint64_t file_count;                                    /* Number of files validated */
+    uint64_t character_count;                               /* Number of characters of the files validated */
+    uint64_t record_count[HEX_STATISTICS_RECORD_TYPES];     /* Number of valid records parsed for each record type */
+    uint64_t error_count[HEX_STATISTICS_ERROR_CODES];       /* Number of invalid records for each error code */
+    uint64_t decoded_byte_count;                            /* Number of data bytes decoded from the valid records */
+    uint64_t io_time;                                       /* Time spent mapping or reading the files */
+    uint64_t parse_time;                                    /* Time spent parsing and checking the records */
+    uint64_t output_time;                                   /* Time spent printing or exporting the records */
+    uint64_t peak_buffer_size;                              /* Largest block of a file held in memory, in bytes */
+} HexStatistics_t;
+
+/**
+ * @brief The formats of writeHexStatistics.
+ */
+typedef enum
+{
+    STATISTICS_FORMAT_TEXT = 0,     /* A block of lines, one counter per line */
+    STATISTICS_FORMAT_JSON          /* One JSON object */
+} StatisticsFormat_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function clears all counters.
+ *
+ * @param statistics The statistics to clear.
+ */
+void clearHexStatistics(HexStatistics_t *statistics);
+
+/**
+ * @brief This function adds the counters of other statistics, for example the counters of a thread.
+ *
+ * The peak buffer size is the largest of both.
+ *
+ * @param statistics The statistics that get the counters.
+ * @param other The statistics added.
+ */
+void mergeHexStatistics(HexStatistics_t *statistics, const HexStatistics_t *other);
+
+/**
+ * @brief This function writes the statistics as a block of lines or as a JSON object.
+ *
+ * @param output The writer of the statistics, it isn't flushed.
+ * @param statistics The statistics to write.
+ * @param format The format of the statistics.
+ */
+void writeHexStatistics(OutputWriter_t *output, const HexStatistics_t *statistics, StatisticsFormat_t format);
+
+/**
+ * @brief This function reads a monotonic clock.
+ *
+ * @return The time in nanoseconds since an arbitrary origin.
+ */
+uint64_t readStatisticsClock(void);
+
+#endif /* HEX_STATISTICS_H */
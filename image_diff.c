@@ -0,0 +1,300 @@
+/**
+ * @file image_diff.c
+ * @brief This file contains the implementation of the memory image comparison functions.
+ *
+ * The comparison walks the addresses from one segment boundary to the next: at each step the current range
+ * is inside a segment of both images, of one image or of none, and the next boundary is the nearest start
+ * or end of the current segments. The last range found is kept until the next one, so adjacent ranges
+ * of the same kind are given to the visitor as one range.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "image_diff.h"         /* Include header file of this function file */
+#include <string.h>             /* For memcmp(), memset() functions */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IMAGE_DIFF_NO_SEGMENT   0x100000000ULL  /* The address of a segment behind the last segment, after all addresses */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of a comparison.
+ */
+typedef struct
+{
+    DifferenceVisitor_t visitor;            /* The function called for each range that differs */
+    void *visitor_context;                  /* The context given to the visitor */
+    ImageDiffSummary_t *summary;            /* The result of the comparison */
+    int8_t pending;                         /* 1 if a range is kept in difference */
+    ImageDifference_t difference;           /* The last range found, not given to the visitor yet */
+} DiffState_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function compares the bytes of a range written by both images.
+ *
+ * @param state The state of the comparison.
+ * @param first The bytes of the first image.
+ * @param second The bytes of the second image.
+ * @param address The absolute memory address of the first byte.
+ * @param size The number of bytes.
+ */
+static void compareCommonBytes(DiffState_t *state, const uint8_t first[], const uint8_t second[], uint64_t address,
+                               uint64_t size);
+
+/**
+ * @brief This function adds a range that differs, it is joined with the last range if they are adjacent.
+ *
+ * @param state The state of the comparison.
+ * @param kind The kind of the difference.
+ * @param address The absolute memory address of the first byte of the range.
+ * @param size The number of bytes of the range.
+ */
+static void addDifference(DiffState_t *state, DifferenceKind_t kind, uint64_t address, uint64_t size);
+
+/**
+ * @brief This function gives the range kept in the state to the visitor.
+ *
+ * @param state The state of the comparison.
+ */
+static void flushDifference(DiffState_t *state);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function compares two memory images and gives each range of addresses that differs to a visitor.
+ *
+ * The segments of both images must be sorted and must not overlap each other (overlap_count is 0),
+ * otherwise the value at an address isn't unique and the images aren't compared.
+ *
+ * @param first The first memory image.
+ * @param second The second memory image.
+ * @param visitor The function called for each range that differs, NULL to only count the differences.
+ * @param visitor_context The context given to the visitor.
+ * @param summary The structure to store the result of the comparison.
+ * @return 0 if the images are the same, 1 if they differ, 5 if an image has overlapping segments.
+ */
+int32_t compareMemoryImages(const MemoryImage_t *first, const MemoryImage_t *second, DifferenceVisitor_t visitor,
+                            void *visitor_context, ImageDiffSummary_t *summary)
+{
+    int32_t result = 0;                 /* Initialize the result of the comparison */
+    uint32_t i = 0;                     /* The index of the current segment of the first image */
+    uint32_t j = 0;                     /* The index of the current segment of the second image */
+    uint64_t address = 0;               /* The address of the beginning of the current range */
+    uint64_t boundary = 0;              /* The address of the end of the current range */
+    uint64_t first_start = 0;           /* The address of the current segment of the first image */
+    uint64_t first_end = 0;             /* The address after the current segment of the first image */
+    uint64_t second_start = 0;          /* The address of the current segment of the second image */
+    uint64_t second_end = 0;            /* The address after the current segment of the second image */
+    const MemorySegment_t *a = NULL;    /* Pointer to the current segment of the first image */
+    const MemorySegment_t *b = NULL;    /* Pointer to the current segment of the second image */
+
+    DiffState_t state;                  /* Declaring the state of the comparison */
+
+    memset(summary, 0, sizeof(ImageDiffSummary_t));
+    state.visitor = visitor;
+    state.visitor_context = visitor_context;
+    state.summary = summary;
+    state.pending = 0;
+    if ((first->overlap_count > 0) || (second->overlap_count > 0))
+    {
+        result = 5;
+    }
+    else
+    {
+        while ((i < first->segment_count) || (j < second->segment_count))
+        {
+            a = (i < first->segment_count) ? &(first->segments[i]) : NULL;
+            b = (j < second->segment_count) ? &(second->segments[j]) : NULL;
+            first_start = (a != NULL) ? a->address : IMAGE_DIFF_NO_SEGMENT;
+            first_end = (a != NULL) ? (uint64_t)a->address + a->size : IMAGE_DIFF_NO_SEGMENT;
+            second_start = (b != NULL) ? b->address : IMAGE_DIFF_NO_SEGMENT;
+            second_end = (b != NULL) ? (uint64_t)b->address + b->size : IMAGE_DIFF_NO_SEGMENT;
+
+            /* Skip the addresses written by no image */
+            if ((address < first_start) && (address < second_start))
+            {
+                address = (first_start < second_start) ? first_start : second_start;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            /* The range ends at the nearest boundary of the current segments */
+            boundary = (address >= first_start) ? first_end : first_start;
+            if (address >= second_start)
+            {
+                boundary = (second_end < boundary) ? second_end : boundary;
+            }
+            else
+            {
+                boundary = (second_start < boundary) ? second_start : boundary;
+            }
+
+            if ((address >= first_start) && (address >= second_start))
+            {
+                compareCommonBytes(&state, first->data + a->data_offset + (address - first_start),
+                                   second->data + b->data_offset + (address - second_start), address,
+                                   boundary - address);
+            }
+            else if (address >= first_start)
+            {
+                addDifference(&state, DIFFERENCE_FIRST_ONLY, address, boundary - address);
+            }
+            else
+            {
+                addDifference(&state, DIFFERENCE_SECOND_ONLY, address, boundary - address);
+            }
+
+            /* Go to the next segment of the images whose segment ends at the boundary */
+            address = boundary;
+            if ((a != NULL) && (address >= first_end))
+            {
+                i += 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            if ((b != NULL) && (address >= second_end))
+            {
+                j += 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        flushDifference(&state);
+        result = (summary->range_count > 0) ? 1 : 0;
+    }
+    return result;
+}
+
+/**
+ * @brief This function compares the bytes of a range written by both images.
+ *
+ * The blocks of IMAGE_DIFF_BLOCK_SIZE bytes that are the same are skipped with one memcmp,
+ * only the blocks that differ are compared byte by byte to find the ranges of changed bytes.
+ *
+ * @param state The state of the comparison.
+ * @param first The bytes of the first image.
+ * @param second The bytes of the second image.
+ * @param address The absolute memory address of the first byte.
+ * @param size The number of bytes.
+ */
+static void compareCommonBytes(DiffState_t *state, const uint8_t first[], const uint8_t second[], uint64_t address,
+                               uint64_t size)
+{
+    uint64_t offset = 0;            /* The offset of the current block in the range */
+    uint64_t length = 0;            /* The number of bytes of the current block */
+    uint64_t k = 0;                 /* The offset of the current byte in the block */
+    uint64_t changed = 0;           /* The offset of the first byte of the current run of changed bytes */
+
+    while (offset < size)
+    {
+        length = ((size - offset) > IMAGE_DIFF_BLOCK_SIZE) ? IMAGE_DIFF_BLOCK_SIZE : (size - offset);
+        if (memcmp(first + offset, second + offset, (size_t)length) == 0)
+        {
+            state->summary->equal_bytes += length;
+        }
+        else
+        {
+            /* Find the runs of changed bytes of the block */
+            k = 0;
+            while (k < length)
+            {
+                if (first[offset + k] == second[offset + k])
+                {
+                    state->summary->equal_bytes += 1;
+                    k += 1;
+                }
+                else
+                {
+                    changed = k;
+                    while ((k < length) && (first[offset + k] != second[offset + k]))
+                    {
+                        k += 1;
+                    }
+                    addDifference(state, DIFFERENCE_CHANGED, address + offset + changed, k - changed);
+                }
+            }
+        }
+        offset += length;
+    }
+}
+
+/**
+ * @brief This function adds a range that differs, it is joined with the last range if they are adjacent.
+ *
+ * @param state The state of the comparison.
+ * @param kind The kind of the difference.
+ * @param address The absolute memory address of the first byte of the range.
+ * @param size The number of bytes of the range.
+ */
+static void addDifference(DiffState_t *state, DifferenceKind_t kind, uint64_t address, uint64_t size)
+{
+    /* Count the bytes of the range */
+    if (kind == DIFFERENCE_CHANGED)
+    {
+        state->summary->changed_bytes += size;
+    }
+    else if (kind == DIFFERENCE_FIRST_ONLY)
+    {
+        state->summary->first_only_bytes += size;
+    }
+    else
+    {
+        state->summary->second_only_bytes += size;
+    }
+    /* Join the range with the last range or keep it instead of the last range */
+    if (state->pending && (state->difference.kind == kind) &&
+        ((uint64_t)state->difference.address + state->difference.size == address))
+    {
+        state->difference.size += size;
+    }
+    else
+    {
+        flushDifference(state);
+        state->difference.kind = kind;
+        state->difference.address = (uint32_t)address;
+        state->difference.size = size;
+        state->pending = 1;
+    }
+}
+
+/**
+ * @brief This function gives the range kept in the state to the visitor.
+ *
+ * @param state The state of the comparison.
+ */
+static void flushDifference(DiffState_t *state)
+{
+    if (state->pending)
+    {
+        state->summary->range_count += 1;
+        if (state->visitor != NULL)
+        {
+            state->visitor(state->visitor_context, &(state->difference));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        state->pending = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+} /* EOF */
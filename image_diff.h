@@ -0,0 +1,96 @@
+/**
+ * @file image_diff.h
+ * @brief This file contains the prototypes of the memory image comparison functions.
+ *
+ * Two Intel Hex files with the same memory contents can be very different as text: other record lengths,
+ * extended segment instead of extended linear address records, records in another order. The comparison
+ * works on their memory images instead, so only the bytes written at each address count.
+ * The segment lists of both images are walked together once, the addresses written by only one image are
+ * reported at once and the addresses written by both images are compared block by block with memcmp,
+ * so the time is linear in the number of segments and the bytes are only compared, never copied.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include "memory_image.h"   /* Include header file of the memory image builder */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef IMAGE_DIFF_H
+#define IMAGE_DIFF_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IMAGE_DIFF_BLOCK_SIZE   4096    /* The number of bytes compared at once with memcmp */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief The kinds of differences between two memory images.
+ */
+typedef enum
+{
+    DIFFERENCE_CHANGED = 0,         /* The addresses are written by both images with other values */
+    DIFFERENCE_FIRST_ONLY,          /* The addresses are only written by the first image */
+    DIFFERENCE_SECOND_ONLY          /* The addresses are only written by the second image */
+} DifferenceKind_t;
+
+/**
+ * @brief Structure to hold one range of addresses that differs between two memory images.
+ *
+ * Adjacent differing addresses of the same kind are reported as one range.
+ */
+typedef struct
+{
+    DifferenceKind_t kind;          /* The kind of the difference */
+    uint32_t address;               /* The absolute memory address of the first byte of the range */
+    uint64_t size;                  /* The number of bytes of the range */
+} ImageDifference_t;
+
+/**
+ * @brief Function called for each range of addresses that differs, in address order.
+ *
+ * @param context The context given to compareMemoryImages.
+ * @param difference The range that differs.
+ */
+typedef void (*DifferenceVisitor_t)(void *context, const ImageDifference_t *difference);
+
+/**
+ * @brief Structure to hold the result of the comparison of two memory images.
+ */
+typedef struct
+{
+    uint64_t range_count;           /* Number of ranges that differ */
+    uint64_t equal_bytes;           /* Number of addresses written by both images with the same value */
+    uint64_t changed_bytes;         /* Number of addresses written by both images with other values */
+    uint64_t first_only_bytes;      /* Number of addresses only written by the first image */
+    uint64_t second_only_bytes;     /* Number of addresses only written by the second image */
+} ImageDiffSummary_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function compares two memory images and gives each range of addresses that differs to a visitor.
+ *
+ * The segments of both images must be sorted and must not overlap each other (overlap_count is 0),
+ * otherwise the value at an address isn't unique and the images aren't compared.
+ *
+ * @param first The first memory image.
+ * @param second The second memory image.
+ * @param visitor The function called for each range that differs, NULL to only count the differences.
+ * @param visitor_context The context given to the visitor.
+ * @param summary The structure to store the result of the comparison.
+ * @return 0 if the images are the same, 1 if they differ, 5 if an image has overlapping segments.
+ */
+int32_t compareMemoryImages(const MemoryImage_t *first, const MemoryImage_t *second, DifferenceVisitor_t visitor,
+                            void *visitor_context, ImageDiffSummary_t *summary);
+
+#endif /* IMAGE_DIFF_H */
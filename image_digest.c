@@ -0,0 +1,487 @@
+/**
+ * @file image_digest.c
+ * @brief This file contains the implementation of the memory image digest functions.
+ *
+ * The digests are computed by the visitor of the single-pass validation of the Intel Hex file analyzer:
+ * a data record that starts at the end of the last segment adds its bytes to the digests of the segment,
+ * a data record after the end starts a new segment, both add their bytes to the digests of the image.
+ * A data record before the end of the last segment means that the records aren't in address order,
+ * the visitor stops and the sorted segments of the memory image are digested after the validation instead.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "image_digest.h"    /* Include header file of this function file */
+#include "memory_image.h"    /* Include header file of the memory image builder */
+#include <stdlib.h>          /* For realloc(), free() functions */
+#include <string.h>          /* For memset() function */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IMAGE_DIGEST_MIN_SEGMENTS   64      /* The number of segments of the first allocation */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of the computation of the digests of a memory image.
+ */
+typedef struct
+{
+    ImageDigest_t *digest;      /* The image digest being computed */
+    Sha256_t segment_sha;       /* The SHA-256 of the last segment, finished when the next segment starts */
+    Sha256_t image_sha;         /* The SHA-256 of the whole image */
+    uint64_t last_end;          /* The address after the last segment */
+    int8_t sorted;              /* 1 while the data records are in address order and don't overlap */
+    int8_t out_of_memory;       /* 1 if an allocation failed */
+} DigestBuilder_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function starts the computation of the digests of a memory image.
+ *
+ * @param builder The state of the computation.
+ * @param digest The image digest to compute.
+ */
+static void startDigestBuilder(DigestBuilder_t *builder, ImageDigest_t *digest);
+
+/**
+ * @brief This function adds the data of a valid record to the digests, it is the visitor of the validation.
+ *
+ * @param context The state of the computation.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void digestRecord(void *context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                         uint32_t line_number);
+
+/**
+ * @brief This function adds bytes at an address after the last segment to the digests.
+ *
+ * The bytes extend the last segment if they start at its end, otherwise they start a new segment.
+ *
+ * @param builder The state of the computation.
+ * @param address The absolute memory address of the first byte.
+ * @param data The bytes.
+ * @param size The number of bytes.
+ */
+static void addDigestBytes(DigestBuilder_t *builder, uint32_t address, const uint8_t data[], uint32_t size);
+
+/**
+ * @brief This function finishes the SHA-256 of the last segment, if there is one.
+ *
+ * @param builder The state of the computation.
+ */
+static void closeDigestSegment(DigestBuilder_t *builder);
+
+/**
+ * @brief This function makes sure the image digest can hold one more segment.
+ *
+ * The capacity of the array of segments is doubled, so adding n segments costs O(n) time in total.
+ *
+ * @param digest The image digest.
+ * @return 1 if the array of segments is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveDigestSegment(ImageDigest_t *digest);
+
+/**
+ * @brief This function computes the digests from the sorted segments of a memory image.
+ *
+ * @param builder The state of the computation, started again.
+ * @param image The memory image.
+ * @return 0 if the digests are computed, 4 if there isn't enough memory, 5 if segments overlap.
+ */
+static int32_t digestMemoryImage(DigestBuilder_t *builder, const MemoryImage_t *image);
+
+/**
+ * @brief This function finishes the computation of the digests of a memory image.
+ *
+ * @param builder The state of the computation.
+ * @param result The result of the validation of the file.
+ * @return The result of the computation (same values as digestIntelHexFile).
+ */
+static int32_t finishDigestBuilder(DigestBuilder_t *builder, int32_t result);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function initializes an empty image digest.
+ *
+ * @param digest The image digest to initialize.
+ * @param algorithms The digests to compute, IMAGE_DIGEST_CRC32 and/or IMAGE_DIGEST_SHA256.
+ */
+void initImageDigest(ImageDigest_t *digest, uint32_t algorithms)
+{
+    memset(digest, 0, sizeof(ImageDigest_t));
+    digest->algorithms = algorithms;
+    digest->single_pass = 1;
+}
+
+/**
+ * @brief This function validates the Intel Hex file and computes the digests of its memory image.
+ *
+ * The digests are computed in the same pass as the validation if the data records are in address order.
+ * Otherwise the file is read again from its beginning to build the memory image, with a copy of the context
+ * so the statistics of the context only count the file once.
+ * The digests are only complete if the function returns 0, they must be released with freeImageDigest.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file, it must be at the beginning of the file.
+ * @param digest The image digest to compute, it must be initialized with initImageDigest.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the digests are computed, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory, 5 if data records overlap (the image has no single content).
+ */
+int32_t digestIntelHexFile(HexContext_t *context, FILE *fptr, ImageDigest_t *digest, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    DigestBuilder_t builder;        /* Declaring the state of the computation */
+    HexContext_t second_context;    /* Declaring the context of the second pass */
+    FileReport_t second_report;     /* Declaring the report of the second pass */
+    MemoryImage_t image;            /* Declaring the memory image of the second pass */
+
+    startDigestBuilder(&builder, digest);
+    /* Validate the file and add each valid record to the digests */
+    result = visitIntelHexFile(context, fptr, digestRecord, &builder, report);
+    if ((result == 0) && !builder.out_of_memory && !builder.sorted)
+    {
+        /* The records aren't in address order, build the memory image to digest its sorted segments */
+        second_context = *context;
+        initMemoryImage(&image);
+        rewind(fptr);
+        result = buildMemoryImage(&second_context, fptr, &image, &second_report);
+        result = (result == 0) ? digestMemoryImage(&builder, &image) : result;
+        freeMemoryImage(&image);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the computation */
+    return finishDigestBuilder(&builder, result);
+}
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and computes the digests of its memory image.
+ *
+ * The function does the same as digestIntelHexFile on a file stored in memory (a buffer or a memory-mapped file).
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param digest The image digest to compute, it must be initialized with initImageDigest.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the digests are computed, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory, 5 if data records overlap (the image has no single content).
+ */
+int32_t digestIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, ImageDigest_t *digest,
+                             FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    DigestBuilder_t builder;        /* Declaring the state of the computation */
+    HexContext_t second_context;    /* Declaring the context of the second pass */
+    FileReport_t second_report;     /* Declaring the report of the second pass */
+    MemoryImage_t image;            /* Declaring the memory image of the second pass */
+
+    startDigestBuilder(&builder, digest);
+    /* Validate the file and add each valid record to the digests */
+    result = visitIntelHexBuffer(context, buffer, size, digestRecord, &builder, report);
+    if ((result == 0) && !builder.out_of_memory && !builder.sorted)
+    {
+        /* The records aren't in address order, build the memory image to digest its sorted segments */
+        second_context = *context;
+        initMemoryImage(&image);
+        result = buildMemoryImageFromBuffer(&second_context, buffer, size, &image, &second_report);
+        result = (result == 0) ? digestMemoryImage(&builder, &image) : result;
+        freeMemoryImage(&image);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the computation */
+    return finishDigestBuilder(&builder, result);
+}
+
+/**
+ * @brief This function releases the memory of an image digest and makes it empty.
+ *
+ * The selected algorithms are kept, the image digest can be computed again.
+ *
+ * @param digest The image digest to release.
+ */
+void freeImageDigest(ImageDigest_t *digest)
+{
+    uint32_t algorithms = digest->algorithms;   /* The digests to compute */
+
+    free(digest->segments);
+    initImageDigest(digest, algorithms);
+}
+
+/**
+ * @brief This function starts the computation of the digests of a memory image.
+ *
+ * @param builder The state of the computation.
+ * @param digest The image digest to compute.
+ */
+static void startDigestBuilder(DigestBuilder_t *builder, ImageDigest_t *digest)
+{
+    /* The digests are computed again from an empty image, the allocated memory is reused */
+    digest->segment_count = 0;
+    digest->data_size = 0;
+    digest->crc32 = 0;
+    memset(digest->sha256, 0, SHA256_DIGEST_SIZE);
+    builder->digest = digest;
+    builder->last_end = 0;
+    builder->sorted = 1;
+    builder->out_of_memory = 0;
+    initSha256(&(builder->image_sha));
+}
+
+/**
+ * @brief This function adds the data of a valid record to the digests, it is the visitor of the validation.
+ *
+ * @param context The state of the computation.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void digestRecord(void *context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                         uint32_t line_number)
+{
+    DigestBuilder_t *builder = (DigestBuilder_t *)context;  /* The state of the computation */
+
+    (void)line_number;
+    /* Only data records with data bytes are added, until a record isn't in address order */
+    if ((record->record_type == 0x00) && (record->byte_count > 0) && builder->sorted && !builder->out_of_memory)
+    {
+        if ((builder->digest->segment_count > 0) && (absolute_address < builder->last_end))
+        {
+            builder->sorted = 0;
+        }
+        else
+        {
+            addDigestBytes(builder, absolute_address, record->data, record->byte_count);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function adds bytes at an address after the last segment to the digests.
+ *
+ * The bytes extend the last segment if they start at its end, otherwise they start a new segment.
+ *
+ * @param builder The state of the computation.
+ * @param address The absolute memory address of the first byte.
+ * @param data The bytes.
+ * @param size The number of bytes.
+ */
+static void addDigestBytes(DigestBuilder_t *builder, uint32_t address, const uint8_t data[], uint32_t size)
+{
+    ImageDigest_t *digest = builder->digest;    /* The image digest being computed */
+    SegmentDigest_t *last = NULL;               /* The last segment */
+
+    if (digest->segment_count > 0)
+    {
+        last = &(digest->segments[digest->segment_count - 1]);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* Check if the bytes extend the last segment, like a data record extends the last segment of a memory image */
+    if ((last != NULL) && (builder->last_end == address) && ((uint64_t)last->size + size <= 0xFFFFFFFFU))
+    {
+        last->size += size;
+    }
+    else if (!reserveDigestSegment(digest))
+    {
+        builder->out_of_memory = 1;
+    }
+    /* Start a new segment */
+    else
+    {
+        closeDigestSegment(builder);
+        last = &(digest->segments[digest->segment_count]);
+        memset(last, 0, sizeof(SegmentDigest_t));
+        last->address = address;
+        last->size = size;
+        digest->segment_count += 1;
+        initSha256(&(builder->segment_sha));
+    }
+
+    if (!builder->out_of_memory)
+    {
+        if (digest->algorithms & IMAGE_DIGEST_CRC32)
+        {
+            last->crc32 = updateCrc32(last->crc32, data, size);
+            digest->crc32 = updateCrc32(digest->crc32, data, size);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (digest->algorithms & IMAGE_DIGEST_SHA256)
+        {
+            updateSha256(&(builder->segment_sha), data, size);
+            updateSha256(&(builder->image_sha), data, size);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        digest->data_size += size;
+        builder->last_end = (uint64_t)address + size;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function finishes the SHA-256 of the last segment, if there is one.
+ *
+ * @param builder The state of the computation.
+ */
+static void closeDigestSegment(DigestBuilder_t *builder)
+{
+    ImageDigest_t *digest = builder->digest;    /* The image digest being computed */
+
+    if ((digest->segment_count > 0) && (digest->algorithms & IMAGE_DIGEST_SHA256))
+    {
+        finishSha256(&(builder->segment_sha), digest->segments[digest->segment_count - 1].sha256);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function makes sure the image digest can hold one more segment.
+ *
+ * The capacity of the array of segments is doubled, so adding n segments costs O(n) time in total.
+ *
+ * @param digest The image digest.
+ * @return 1 if the array of segments is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveDigestSegment(ImageDigest_t *digest)
+{
+    int8_t reserved = 1;                            /* Initialize the result */
+    uint64_t capacity = digest->segment_capacity;   /* The new capacity of the array of segments */
+    SegmentDigest_t *segments = NULL;               /* The new array of segments */
+
+    if (digest->segment_count == digest->segment_capacity)
+    {
+        capacity = (capacity < IMAGE_DIGEST_MIN_SEGMENTS) ? IMAGE_DIGEST_MIN_SEGMENTS : capacity * 2;
+        if (capacity > 0xFFFFFFFFU)
+        {
+            capacity = 0xFFFFFFFFU;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (capacity > digest->segment_count)
+        {
+            segments = (SegmentDigest_t *)realloc(digest->segments, (size_t)capacity * sizeof(SegmentDigest_t));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (segments == NULL)
+        {
+            reserved = 0;
+        }
+        else
+        {
+            digest->segments = segments;
+            digest->segment_capacity = (uint32_t)capacity;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return reserved;
+}
+
+/**
+ * @brief This function computes the digests from the sorted segments of a memory image.
+ *
+ * @param builder The state of the computation, started again.
+ * @param image The memory image.
+ * @return 0 if the digests are computed, 4 if there isn't enough memory, 5 if segments overlap.
+ */
+static int32_t digestMemoryImage(DigestBuilder_t *builder, const MemoryImage_t *image)
+{
+    int32_t result = 0;         /* Initialize the result */
+    uint32_t i = 0;             /* Loop counter */
+
+    startDigestBuilder(builder, builder->digest);
+    builder->digest->single_pass = 0;
+    if (image->overlap_count > 0)
+    {
+        result = 5;
+    }
+    else
+    {
+        /* The segments are sorted and don't overlap, they are added in address order */
+        for (i = 0; (i < image->segment_count) && !builder->out_of_memory; i++)
+        {
+            addDigestBytes(builder, image->segments[i].address, image->data + image->segments[i].data_offset,
+                           image->segments[i].size);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief This function finishes the computation of the digests of a memory image.
+ *
+ * @param builder The state of the computation.
+ * @param result The result of the validation of the file.
+ * @return The result of the computation (same values as digestIntelHexFile).
+ */
+static int32_t finishDigestBuilder(DigestBuilder_t *builder, int32_t result)
+{
+    /* An allocation failure is reported before the result of the validation */
+    if (builder->out_of_memory)
+    {
+        result = 4;
+    }
+    else if (result == 0)
+    {
+        closeDigestSegment(builder);
+        if (builder->digest->algorithms & IMAGE_DIGEST_SHA256)
+        {
+            finishSha256(&(builder->image_sha), builder->digest->sha256);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+} /* EOF */
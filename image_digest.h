@@ -0,0 +1,122 @@
+/**
+ * @file image_digest.h
+ * @brief This file contains the prototypes of the memory image digest functions.
+ *
+ * The digests of a memory image are the CRC-32 and the SHA-256 of the bytes of each segment and of the bytes
+ * of the whole image, all segments one after the other in address order (the addresses between the segments
+ * aren't part of the digest). They are used to sign off an image without writing it to a binary file first.
+ * The digests are computed while the file is validated: each data record adds its bytes to the digests of
+ * its segment and of the image, so the file is read once and the memory image isn't built.
+ * Only if the records aren't in address order, the memory image is built in a second pass and its sorted
+ * segments are digested.
+ * The segments are the same as the segments of the memory image.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "data_digest.h"               /* Include header file of the data digest functions of lower layer */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef IMAGE_DIGEST_H
+#define IMAGE_DIGEST_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IMAGE_DIGEST_CRC32      0x01    /* Compute the CRC-32 of the segments and of the image */
+#define IMAGE_DIGEST_SHA256     0x02    /* Compute the SHA-256 of the segments and of the image */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the digests of one contiguous segment of a memory image.
+ */
+typedef struct
+{
+    uint32_t address;                       /* The absolute memory address of the first byte of the segment */
+    uint32_t size;                          /* The number of bytes of the segment */
+    uint32_t crc32;                         /* The CRC-32 of the bytes of the segment */
+    uint8_t sha256[SHA256_DIGEST_SIZE];     /* The SHA-256 of the bytes of the segment */
+} SegmentDigest_t;
+
+/**
+ * @brief Structure to hold the digests of a memory image.
+ *
+ * The digests of the algorithms not selected are 0.
+ */
+typedef struct
+{
+    uint32_t algorithms;                    /* The digests computed, IMAGE_DIGEST_CRC32 and/or IMAGE_DIGEST_SHA256 */
+    SegmentDigest_t *segments;              /* The digests of the segments, in address order */
+    uint32_t segment_count;                 /* The number of segments */
+    uint32_t segment_capacity;              /* The number of segments that fit in the allocated array */
+    uint64_t data_size;                     /* The number of bytes of all segments */
+    uint32_t crc32;                         /* The CRC-32 of the whole image */
+    uint8_t sha256[SHA256_DIGEST_SIZE];     /* The SHA-256 of the whole image */
+    int8_t single_pass;                     /* 1 if the digests are computed during the validation, 0 if the memory
+                                               image is built in a second pass because the records aren't in order */
+} ImageDigest_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function initializes an empty image digest.
+ *
+ * @param digest The image digest to initialize.
+ * @param algorithms The digests to compute, IMAGE_DIGEST_CRC32 and/or IMAGE_DIGEST_SHA256.
+ */
+void initImageDigest(ImageDigest_t *digest, uint32_t algorithms);
+
+/**
+ * @brief This function validates the Intel Hex file and computes the digests of its memory image.
+ *
+ * The digests are computed in the same pass as the validation if the data records are in address order.
+ * Otherwise the file is read again from its beginning to build the memory image, with a copy of the context
+ * so the statistics of the context only count the file once.
+ * The digests are only complete if the function returns 0, they must be released with freeImageDigest.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file, it must be at the beginning of the file.
+ * @param digest The image digest to compute, it must be initialized with initImageDigest.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the digests are computed, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory, 5 if data records overlap (the image has no single content).
+ */
+int32_t digestIntelHexFile(HexContext_t *context, FILE *fptr, ImageDigest_t *digest, FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and computes the digests of its memory image.
+ *
+ * The function does the same as digestIntelHexFile on a file stored in memory (a buffer or a memory-mapped file).
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param digest The image digest to compute, it must be initialized with initImageDigest.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the digests are computed, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory, 5 if data records overlap (the image has no single content).
+ */
+int32_t digestIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, ImageDigest_t *digest,
+                             FileReport_t *report);
+
+/**
+ * @brief This function releases the memory of an image digest and makes it empty.
+ *
+ * The selected algorithms are kept, the image digest can be computed again.
+ *
+ * @param digest The image digest to release.
+ */
+void freeImageDigest(ImageDigest_t *digest);
+
+#endif /* IMAGE_DIGEST_H */
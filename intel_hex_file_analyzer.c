@@ -6,6 +6,10 @@
  * It provides function analyzeIntelHexFile to check the validity of the file and returns error code
  * to upper layer (Application layer).
  * The Intel Hex file analyzer also provides function checkEOF to check if the End-Of-File record valid.
+ * Function validateIntelHexFile does all checks of analyzeIntelHexFile and checkEOF in one pass over the file.
+ * All the state of a file is kept in the context given by the caller, the threads of a parallel validation
+ * have their own contexts. In a build with HEX_STATISTICS, the time spent reading, parsing and printing a file
+ * is added to the statistics of its context, the statistics of the threads are merged at the end.
  *
  * @author Viet Ha Nguyen
  * @date 4/26/2024
@@ -15,6 +19,77 @@
  ******************************************************************************/
 #include "intel_hex_file_analyzer.h"             /* Include header file of this function file */
 #include "record_handler.h"  /* Include header file of lower layer */
+#include "file_mapper.h"     /* Include header file of the file mapper of lower layer */
+#include "line_reader.h"     /* Include header file of the line reader of lower layer */
+#include "async_reader.h"    /* Include header file of the asynchronous reader of lower layer */
+#include "hex_decoder.h"     /* Include header file of the hexadecimal decoder of lower layer */
+#include "output_writer.h"   /* Include header file of the output writer of lower layer */
+#include "hex_statistics.h"  /* Include header file of the statistics of lower layer */
+#include <pthread.h>         /* For pthread_create(), pthread_join() functions */
+#if defined(_WIN32)
+#include <windows.h>         /* For GetSystemInfo() function */
+#else
+#include <unistd.h>          /* For sysconf() function */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef HEX_PARALLEL_MIN_CHUNK
+#define HEX_PARALLEL_MIN_CHUNK      (1024 * 1024)   /* Minimum number of characters validated by one thread */
+#endif
+#define HEX_PARALLEL_MAX_THREADS    64              /* Maximum number of threads of a parallel validation */
+#define HEX_EOF_RECORD_CHARS        11              /* Number of characters of an End-Of-File record (no data bytes) */
+#define HEX_PREFILTER_LINE          (2 * (RECORD_MAX_DATA_BYTES + 8))   /* Longer than any record with its line terminator */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold a chunk of a parallel validation and its result.
+ */
+typedef struct
+{
+    const int8_t *begin;            /* The first character of the chunk, at the beginning of a line */
+    uint64_t size;                  /* The number of characters of the chunk, the chunk ends after a line feed */
+    HexContext_t context;           /* The context of the chunk */
+    ValidationState_t state;        /* The state of the validation at the end of the chunk */
+    FileReport_t report;            /* The result of the validation, line numbers are relative to the chunk */
+} ValidationChunk_t;
+
+/**
+ * @brief Structure to hold the state of the export of the records in a machine-readable format.
+ */
+typedef struct
+{
+    HexContext_t *context;          /* The context of the file, the lines are written to its output writer */
+    RecordFormat_t format;          /* The format of the lines */
+} RecordExport_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void startValidation(ValidationState_t *state, HexContext_t *context, FileReport_t *report);
+static void validateLine(ValidationState_t *state, FileReport_t *report, const int8_t line[], uint32_t length);
+static void acceptRecord(ValidationState_t *state, FileReport_t *report, const IntelHexRecord_t *record);
+static int8_t isEOFRecord(const int8_t line[], uint32_t length);
+static void acceptStreamRecord(HexStream_t *stream, uint32_t last_line);
+static int32_t finishValidation(const ValidationState_t *state, FileReport_t *report);
+static void checkEOFRecords(const ValidationState_t *state, FileReport_t *report);
+static void collectLine(ValidationState_t *state, FileReport_t *report, ErrorReport_t *errors, Error_t *first_error,
+                        const int8_t line[], uint32_t length, uint64_t offset);
+static int32_t finishCollection(const ValidationState_t *state, FileReport_t *report, ErrorReport_t *errors,
+                                const Error_t *first_error, uint64_t size);
+static void addError(ErrorReport_t *errors, uint32_t error_source, const Error_t *error, uint64_t offset);
+static uint32_t clampLineLength(uint64_t length);
+static void validateLines(ValidationState_t *state, FileReport_t *report, const int8_t buffer[], uint64_t size);
+static void addAddressRange(FileReport_t *report, uint32_t lowest, uint64_t highest, uint64_t byte_count);
+static void *validateChunk(void *argument);
+static void mergeChunk(ValidationState_t *state, FileReport_t *report, const ValidationChunk_t *chunk);
+static void storeResult(HexContext_t *context, const FileReport_t *report);
+static void countFileRead(HexContext_t *context, const LineReader_t *reader, uint64_t start);
+static void exportRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                         uint32_t line_number);
 
 /*******************************************************************************
  * Code
@@ -26,33 +101,39 @@
  * checkRecord function of lower layer (Middleware).
  * If any line is found to be invalid, the function stops analyzing and returns the error code.
  * If all lines are valid, the function returns 0, indicating that the file is valid.
+ * The line numbers are counted by the context.
  *
+ * @param context The context of the file.
  * @param fptr The file pointer to the Intel Hex file.
  * @param error The error structure to store the error code and line number.
  * @return An error code indicating the result of the analysis.
  */
-int32_t analyzeIntelHexFile(FILE *fptr, Error_t *error)
+int32_t analyzeIntelHexFile(HexContext_t *context, FILE *fptr, Error_t *error)
 {
-    int8_t line[100];               /* Initialize a character array to store each line of the file */
+    int8_t *line = NULL;            /* Initialize a pointer to each line of the file */
+    uint32_t length = 0;            /* Initialize the number of characters of the line */
     int8_t continue_process = 1;    /* Initialize a flag to control the loop */
-    int32_t line_of_file = 1;       /* Initialize a counter to keep track of the line number */
 
+    LineReader_t reader;            /* Declaring the reader of the lines of the file */
+
+    error->error_code = 0;
+    resetHexContext(context);
+    openLineReader(&reader, fptr);
     /* Loop through each line of the file until the end of the file is reached or an error is encountered */
-    while ((fgets(line, sizeof(line), fptr) != NULL) && (continue_process))
+    while ((continue_process) && (readLine(&reader, &line, &length) != 0))
     {
         /* Check the validity of the current line and store the error code in the error structure */
-        error->error_code = checkRecord(line);
+        error->error_code = checkRecord(context, line);
         /* If an error is encountered, set the continue_process flag to 0 and
         store the line number in the error structure */
         if (error->error_code != 0)
         {
             continue_process = 0;
-            error->error_line = line_of_file;
+            error->error_line = context->line_number;
         }
-        /* If no error is encountered, increment the line number */
         else
         {
-            line_of_file += 1;
+            /* Do nothing */
         }
     }
     /* Return the error code stored in the error structure */
@@ -63,35 +144,42 @@ int32_t analyzeIntelHexFile(FILE *fptr, Error_t *error)
  * @brief This function checks the End-Of-File record.
  *
  * The function reads the file line by line and checks if the line is the End-Of-File record.
+ * An End-Of-File record is any valid record of type 01, whatever its address and the case of its hexadecimal
+ * digits, so the single-pass validations recognize the same End-Of-File records.
  * If the End-Of-File record is found and this record is at the end of file, the function returns 0,
  * indicating that the file is valid.
  * If the End-Of-File record is not found or End-Of-File record is found but it's not at the end of file,
  * the function returns an error code.
+ * The line numbers are counted by the context, the error is also stored in the context.
  *
+ * @param context The context of the file.
  * @param fptr The file pointer to the Intel Hex file.
  * @param error The error structure to store the error code and line number.
  * @return An error code indicating the result of the check.
  */
-int32_t checkEOF(FILE *fptr, Error_t *error)
+int32_t checkEOF(HexContext_t *context, FILE *fptr, Error_t *error)
 {
-    int8_t line[100];               /* Initialize a character array to store each line of the file */
-    int8_t EOF_line[100];           /* Initialize a character array to store the End-Of-File record */
-    int8_t last_line[100];          /* Initialize a character array to store the last line of the file */
-    int8_t found_EOF = 0;           /* Initialize a flag to indicate if the End-Of-File record is found */
-    int32_t line_of_file = 1;       /* Initialize a counter to keep track of the line number */
+    int8_t *line = NULL;            /* Initialize a pointer to each line of the file */
+    uint32_t length = 0;            /* Initialize the number of characters of the line */
+    uint32_t found_EOF = 0;         /* Initialize a counter of the End-Of-File records */
+    uint32_t EOF_line = 0;          /* Initialize the line number of the End-Of-File record */
 
+    LineReader_t reader;            /* Declaring the reader of the lines of the file */
+
+    resetHexContext(context);
+    openLineReader(&reader, fptr);
     /* Loop through each line of the file until the end of the file is reached */
-    while (fgets(line, sizeof(line), fptr) != NULL)
+    while (readLine(&reader, &line, &length) != 0)
     {
-        /* Copy the current line to the last line */
-        strcpy(last_line, line);
+        /* Count the line, the counter is the line number of the last line */
+        context->line_number += 1;
         /* Check if the current line is the End-Of-File record */
-        if (strncmp(line, ":00000001FF", 11) == 0)
+        if (isEOFRecord(line, length))
         {
             /* If the End-Of-File record is found for the first time, store the line number in the error structure */
             if (!found_EOF)
             {
-                error->error_line = line_of_file;
+                error->error_line = context->line_number;
             }
             else
             {
@@ -99,14 +187,13 @@ int32_t checkEOF(FILE *fptr, Error_t *error)
             }
             /* Increment the count of the End-Of-File record */
             found_EOF += 1;
-            /* Copy the End-Of-File record to the EOF_line */
-            strcpy(EOF_line, line);
+            /* Keep the line number of the End-Of-File record */
+            EOF_line = context->line_number;
         }
         else
         {
             /* Do nothing */
         }
-        line_of_file += 1;
     }
     /* If the End-Of-File record is not found, set the error code to 1 */
     if (!found_EOF)
@@ -117,7 +204,7 @@ int32_t checkEOF(FILE *fptr, Error_t *error)
     else if (found_EOF == 1)
     {
         /* If last line of file is different from End-Of-File record, set the error code to 2 */
-        if (strcmp(last_line, EOF_line) != 0)
+        if (context->line_number != EOF_line)
         {
             error->error_code = 2;
         }
@@ -132,6 +219,15 @@ int32_t checkEOF(FILE *fptr, Error_t *error)
     {
         error->error_code = 3;
     }
+    /* Store the error in the context */
+    if (error->error_code != 0)
+    {
+        context->error = *error;
+    }
+    else
+    {
+        /* Do nothing */
+    }
     /* Return the error code */
     return error->error_code;
 }
@@ -140,27 +236,1443 @@ int32_t checkEOF(FILE *fptr, Error_t *error)
  * @brief This function prints the entire content of an Intel Hex File.
  *
  * The function reads each line of the file and prints it along with its line number.
- * It also calls the displayRecordInfo function to print the information of each records.
+ * It also prints the information of each records like the displayRecordInfo function.
+ * The text is written to the output writer of the context, which writes it in large blocks.
+ * The records parsed to print them aren't counted again in the statistics, only the time is counted.
  *
+ * @param context The context of the file.
  * @param fptr The file pointer to the Intel Hex File.
  */
-void printIntelHexFile(FILE *fptr)
+void printIntelHexFile(HexContext_t *context, FILE *fptr)
 {
-    int8_t line[100];               /* Initialize a character array to store each line of the file */
-    int32_t line_of_file = 1;       /* Initialize a variable to store the line number */
+    int8_t *line = NULL;            /* Initialize a pointer to each line of the file */
+    uint32_t length = 0;            /* Initialize the number of characters of the line */
+    OutputWriter_t *writer = context->output;   /* The writer of the text */
 
+    LineReader_t reader;            /* Declaring the reader of the lines of the file */
+#if HEX_STATISTICS
+    uint64_t start = readStatisticsClock();         /* The time of the beginning of the print */
+    HexStatistics_t counted = context->statistics;  /* The statistics before the print */
+#endif
+
+    resetHexContext(context);
+    openLineReader(&reader, fptr);
     /* Read each line of the file until the end of the file is reached */
-    while (fgets(line, sizeof(line), fptr) != NULL)
-    {
-        printf("----------------\n");
-        /* Print the line number */
-        printf("Line %d of file: \n", line_of_file);
-        /* Print the line of file */
-        printf("%s\n", line);
-        /* Display the information of the record */
-        displayRecordInfo(line, line_of_file);
-        printf("----------------\n\n");
-        line_of_file += 1;
+    while (readLine(&reader, &line, &length) != 0)
+    {
+        context->line_number += 1;
+        writeString(writer, "----------------\nLine ");
+        /* Write the line number */
+        writeDecimal(writer, context->line_number);
+        writeString(writer, " of file: \n");
+        /* Write the line of file without the carriage return of a CR LF line terminator */
+        writeText(writer, line, ((length > 0) && (line[length - 1] == '\r')) ? length - 1 : length);
+        writeString(writer, "\n\n");
+        /* Write the information of the record */
+        writeRecordInfo(context, line, length, context->line_number);
+        writeString(writer, "----------------\n\n");
     }
-} /* EOF */
+    flushOutputWriter(writer);
+#if HEX_STATISTICS
+    /* Keep the counters of the validation, the time of the print is the time of the output */
+    counted.io_time += reader.read_time;
+    counted.output_time += readStatisticsClock() - start - reader.read_time;
+    context->statistics = counted;
+#endif
+}
+
+/**
+ * @brief This function validates the Intel Hex file and writes its valid records in a machine-readable format.
+ *
+ * The function validates the file in a single pass like validateIntelHexFile and writes one line for each
+ * valid record (line number, record type, absolute memory address and data) as JSON lines or CSV.
+ * The lines are written to the output writer of the context until the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex File.
+ * @param format The format of the lines.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t exportIntelHexFile(HexContext_t *context, FILE *fptr, RecordFormat_t format, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    RecordExport_t export_state;    /* Declaring the state of the export */
+#if HEX_STATISTICS
+    uint64_t output_time = context->statistics.output_time;    /* The time of the output before the export */
+#endif
+
+    export_state.context = context;
+    export_state.format = format;
+    writeRecordHeader(context, format);
+    /* Validate the file and write each valid record */
+    result = visitIntelHexFile(context, fptr, exportRecord, &export_state, report);
+    flushOutputWriter(context->output);
+#if HEX_STATISTICS
+    /* The lines are written while the file is parsed, their time is moved from the parse time to the output time */
+    context->statistics.parse_time -= context->statistics.output_time - output_time;
+#endif
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function validates the Intel Hex file in a single pass.
+ *
+ * The function reads the file line by line only once. Each line is parsed one time to check the record
+ * (same error codes as analyzeIntelHexFile), to detect the position and duplicates of the End-Of-File record
+ * (same error codes as checkEOF) and to resolve the absolute memory address of the data records
+ * with the extended segment (02) and extended linear (04) address records.
+ * The function stops reading at the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t validateIntelHexFile(HexContext_t *context, FILE *fptr, FileReport_t *report)
+{
+    int8_t *line = NULL;            /* Initialize a pointer to each line of the file */
+    uint32_t length = 0;            /* Initialize the number of characters of the line */
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the validation */
+
+    ValidationState_t state;        /* Declaring the state of the validation */
+    LineReader_t reader;            /* Declaring the reader of the lines of the file */
+
+    startValidation(&state, context, report);
+    openLineReader(&reader, fptr);
+    /* Loop through each line of the file until the end of the file is reached or an invalid record is found */
+    while ((report->record_error.error_code == 0) && (readLine(&reader, &line, &length) != 0))
+    {
+        context->line_offset = reader.line_offset;
+        validateLine(&state, report, line, length);
+    }
+    countFileRead(context, &reader, start);
+    /* Return the result of the validation */
+    return finishValidation(&state, report);
+}
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory in a single pass.
+ *
+ * The function does the same checks as validateIntelHexFile, but the records are parsed in place
+ * inside the buffer, without copying each line.
+ * The last line doesn't need a line terminator and the buffer doesn't need a null terminator.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t validateIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, FileReport_t *report)
+{
+    ValidationState_t state;                /* Declaring the state of the validation */
+
+    startValidation(&state, context, report);
+    HEX_STATISTICS_ADD(context->statistics.character_count, size);
+    HEX_STATISTICS_MAX(context->statistics.peak_buffer_size, size);
+    validateLines(&state, report, buffer, size);
+    /* Return the result of the validation */
+    return finishValidation(&state, report);
+}
+
+/**
+ * @brief This function rejects an Intel Hex file stored in memory if it has an obviously invalid line.
+ *
+ * The first characters of the buffer are scanned for a character that can't be part of an Intel Hex file
+ * (anything else than hexadecimal digits, ':', CR and LF) with findInvalidHexCharacter, and for a line
+ * that doesn't start with ':'. Such a line can't be a valid record, so the file is validated with
+ * validateIntelHexBuffer up to the end of this line only: the report and the context get exactly the result
+ * of the validation of the whole file, without reading the rest of the file.
+ * If no such line is found, nothing is stored and the file must be validated as usual.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param limit The number of characters scanned, 0 to scan the whole buffer.
+ * @param report The report structure to store the result of the validation of a rejected file.
+ * @return 1 if the file is rejected (the result of validateIntelHexBuffer is 1), 0 if the file must be validated.
+ */
+int32_t prefilterIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, uint64_t limit,
+                                FileReport_t *report)
+{
+    int32_t rejected = 0;                   /* Initialize a flag to indicate if the file is rejected */
+    uint64_t length = size;                 /* The number of characters scanned */
+    uint64_t invalid = 0;                   /* The offset of the first invalid character or line */
+    uint64_t end = 0;                       /* The end of the characters validated for a rejected file */
+    const int8_t *line = buffer;            /* Pointer to the beginning of the current line */
+    const int8_t *newline = NULL;           /* Pointer to the line feed of a line */
+    int8_t found = 0;                       /* Initialize a flag to indicate if the line of the invalid character is found */
+
+    if ((limit != 0) && (limit < size))
+    {
+        length = limit;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Find the first invalid character, then the first line in front of it that doesn't start with ':',
+    line is the beginning of the line of the invalid character at the end of the loop */
+    invalid = findInvalidHexCharacter(buffer, length);
+    while ((line < buffer + length) && !found)
+    {
+        newline = (const int8_t *)memchr(line, '\n', (size_t)(invalid - (uint64_t)(line - buffer)));
+        if (*line != ':')
+        {
+            invalid = (uint64_t)(line - buffer);
+            found = 1;
+        }
+        else if (newline == NULL)
+        {
+            found = 1;
+        }
+        else
+        {
+            line = newline + 1;
+        }
+    }
+
+    /* Validate the file up to the end of the line of the invalid character. A line longer than HEX_PREFILTER_LINE
+    can't be a record, the error code of such a line is found in its first characters, so only the first
+    characters of a long line are validated */
+    if (invalid < length)
+    {
+        end = (uint64_t)(line - buffer) + HEX_PREFILTER_LINE;
+        end = (end <= invalid) ? invalid + 1 : end;
+        end = (end > size) ? size : end;
+        newline = (const int8_t *)memchr(buffer + invalid, '\n', (size_t)(end - invalid));
+        end = (newline == NULL) ? end : (uint64_t)(newline - buffer) + 1;
+        rejected = (validateIntelHexBuffer(context, buffer, end, report) == 1);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the flag of the rejected file */
+    return rejected;
+}
+
+/**
+ * @brief This function validates an Intel Hex file through a memory mapping of the file.
+ *
+ * The function maps the file into memory with mapFile function and validates it with validateIntelHexBuffer,
+ * so the records are parsed directly in the page cache without any copy.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ * 3 if the file can't be opened.
+ */
+int32_t validateIntelHexMappedFile(HexContext_t *context, const char *path, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the mapping */
+
+    MappedFile_t file;              /* Declaring the memory mapping of the file */
+
+    /* Map the file into memory */
+    if (mapFile(path, &file) != 0)
+    {
+        memset(report, 0, sizeof(FileReport_t));
+        resetHexContext(context);
+        result = 3;
+    }
+    else
+    {
+        HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+        result = validateIntelHexBuffer(context, file.data, file.size, report);
+        start = HEX_STATISTICS_CLOCK();
+        unmapFile(&file);
+        HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+    }
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory with several threads.
+ *
+ * The buffer is split into chunks at line boundaries and every thread validates the records of one chunk.
+ * The results of the chunks are merged in the order of the chunks, so the report is exactly the same as
+ * the report of validateIntelHexBuffer: the first invalid record of the file is reported with its line number,
+ * and the base address of the extended address records is carried from the end of a chunk to the next chunk.
+ * Small buffers are validated by the calling thread only. Each chunk has its own context, the result of
+ * the merge is stored in the context of the caller.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param thread_count The number of threads, 0 to use one thread per processor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t validateIntelHexBufferParallel(HexContext_t *context, const int8_t buffer[], uint64_t size,
+                                       uint32_t thread_count, FileReport_t *report)
+{
+    int32_t result = 0;                     /* Initialize the result of the validation */
+    uint32_t i = 0;                         /* Loop counter */
+    uint32_t chunk_count = 0;               /* Number of chunks, one per thread */
+    uint64_t chunk_begin = 0;               /* Offset of the beginning of a chunk */
+    uint64_t chunk_end = 0;                 /* Offset of the end of a chunk */
+    const int8_t *newline = NULL;           /* Pointer to the line feed at the end of a chunk */
+    int8_t *started = NULL;                 /* Flags of the chunks validated by a thread */
+    int8_t rejected = 0;                    /* Initialize a flag to indicate if the file is rejected by the prefilter */
+
+    ValidationState_t state;                /* Declaring the state of the merged validation */
+    ValidationChunk_t *chunks = NULL;       /* Declaring the chunks */
+    pthread_t *threads = NULL;              /* Declaring the threads */
+
+    /* Use one thread per processor and at least HEX_PARALLEL_MIN_CHUNK characters per thread */
+    chunk_count = (thread_count == 0) ? getProcessorCount() : thread_count;
+    if (chunk_count > HEX_PARALLEL_MAX_THREADS)
+    {
+        chunk_count = HEX_PARALLEL_MAX_THREADS;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if ((uint64_t)chunk_count * HEX_PARALLEL_MIN_CHUNK > size)
+    {
+        chunk_count = (uint32_t)(size / HEX_PARALLEL_MIN_CHUNK);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* A file with an obviously invalid line at the beginning is rejected before the threads are started */
+    if (chunk_count > 1)
+    {
+        rejected = prefilterIntelHexBuffer(context, buffer, size, HEX_PREFILTER_SIZE, report);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if ((chunk_count > 1) && !rejected)
+    {
+        chunks = (ValidationChunk_t *)calloc(chunk_count, sizeof(ValidationChunk_t));
+        threads = (pthread_t *)calloc(chunk_count, sizeof(pthread_t));
+        started = (int8_t *)calloc(chunk_count, sizeof(int8_t));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* The report of a rejected file is already stored */
+    if (rejected)
+    {
+        result = 1;
+    }
+    /* If the file is too small to be split or the chunks can't be allocated, validate it in this thread */
+    else if ((chunks == NULL) || (threads == NULL) || (started == NULL))
+    {
+        result = validateIntelHexBuffer(context, buffer, size, report);
+    }
+    else
+    {
+        /* Resolve the kernel of the hexadecimal decoder before the threads use it */
+        getHexKernelName();
+
+        /* Split the buffer into chunks, every chunk ends after the first line feed behind its share of the buffer */
+        for (i = 0; i < chunk_count; i++)
+        {
+            chunk_end = (i == chunk_count - 1) ? size : (size / chunk_count) * (i + 1);
+            if (chunk_end < chunk_begin)
+            {
+                chunk_end = chunk_begin;
+            }
+            else if (chunk_end < size)
+            {
+                newline = (const int8_t *)memchr(buffer + chunk_end, '\n', (size_t)(size - chunk_end));
+                chunk_end = (newline == NULL) ? size : (uint64_t)(newline - buffer) + 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            chunks[i].begin = buffer + chunk_begin;
+            chunks[i].size = chunk_end - chunk_begin;
+            initHexContext(&(chunks[i].context), context->output);
+            startValidation(&(chunks[i].state), &(chunks[i].context), &(chunks[i].report));
+            /* Only the first chunk starts with the base address 0, the others get it from the previous chunk */
+            chunks[i].state.base_known = (i == 0);
+            chunk_begin = chunk_end;
+        }
+
+        /* Validate the chunks, the first chunk is validated by this thread */
+        for (i = 1; i < chunk_count; i++)
+        {
+            started[i] = (pthread_create(&threads[i], NULL, validateChunk, &chunks[i]) == 0);
+        }
+        validateChunk(&chunks[0]);
+        for (i = 1; i < chunk_count; i++)
+        {
+            /* If a thread can't be created, validate its chunk in this thread */
+            if (started[i])
+            {
+                pthread_join(threads[i], NULL);
+            }
+            else
+            {
+                validateChunk(&chunks[i]);
+            }
+        }
+
+        /* Merge the results of the chunks in order until the first invalid record */
+        startValidation(&state, context, report);
+        HEX_STATISTICS_ADD(context->statistics.character_count, size);
+        HEX_STATISTICS_MAX(context->statistics.peak_buffer_size, size);
+#if HEX_STATISTICS
+        /* The records of all chunks are counted, even behind the first invalid record */
+        for (i = 0; i < chunk_count; i++)
+        {
+            mergeHexStatistics(&(context->statistics), &(chunks[i].context.statistics));
+        }
+#endif
+        for (i = 0; (i < chunk_count) && (report->record_error.error_code == 0); i++)
+        {
+            mergeChunk(&state, report, &chunks[i]);
+        }
+        result = finishValidation(&state, report);
+    }
+
+    free(chunks);
+    free(threads);
+    free(started);
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function validates an Intel Hex file through a memory mapping of the file with several threads.
+ *
+ * The function maps the file into memory and validates it with validateIntelHexBufferParallel.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param thread_count The number of threads, 0 to use one thread per processor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ * 3 if the file can't be opened.
+ */
+int32_t validateIntelHexMappedFileParallel(HexContext_t *context, const char *path, uint32_t thread_count,
+                                           FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the mapping */
+
+    MappedFile_t file;              /* Declaring the memory mapping of the file */
+
+    /* Map the file into memory */
+    if (mapFile(path, &file) != 0)
+    {
+        memset(report, 0, sizeof(FileReport_t));
+        resetHexContext(context);
+        result = 3;
+    }
+    else
+    {
+        HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+        result = validateIntelHexBufferParallel(context, file.data, file.size, thread_count, report);
+        start = HEX_STATISTICS_CLOCK();
+        unmapFile(&file);
+        HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+    }
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function validates an Intel Hex file read by blocks with several reads in flight.
+ *
+ * The blocks of the asynchronous reader are given to the stream functions, so each block is parsed
+ * while the next blocks are read and only ASYNC_READER_DEPTH blocks of the file are in memory.
+ * The report is the same as the report of validateIntelHexMappedFile. The reads stop at the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ * 3 if the file can't be opened or read.
+ */
+int32_t validateIntelHexAsyncFile(HexContext_t *context, const char *path, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+    const int8_t *data = NULL;      /* Pointer to the bytes of the current block */
+    uint32_t size = 0;              /* The number of bytes of the current block */
+
+    AsyncReader_t reader;           /* Declaring the reader of the blocks */
+    HexStream_t stream;             /* Declaring the state of the validation of the blocks */
+
+    /* Start the reads of the first blocks */
+    if (openAsyncReader(&reader, path) != 0)
+    {
+        memset(report, 0, sizeof(FileReport_t));
+        resetHexContext(context);
+        result = 3;
+    }
+    else
+    {
+        /* Parse each block while the next blocks are read, until the first invalid record */
+        openIntelHexStream(context, &stream, NULL, NULL);
+        while ((result != 1) && readAsyncBlock(&reader, &data, &size))
+        {
+            result = feedIntelHexStream(context, &stream, data, size);
+        }
+        result = finishIntelHexStream(context, &stream, report);
+        /* A file that can't be read to its end has no result */
+        if (reader.failed)
+        {
+            memset(report, 0, sizeof(FileReport_t));
+            result = 3;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        HEX_STATISTICS_ADD(context->statistics.io_time, reader.wait_time);
+        HEX_STATISTICS_MAX(context->statistics.peak_buffer_size,
+                           (uint64_t)ASYNC_READER_DEPTH * ASYNC_READER_BLOCK_SIZE);
+        closeAsyncReader(&reader);
+    }
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function validates the Intel Hex file in a single pass and gives each valid record to a visitor.
+ *
+ * The function does the same checks as validateIntelHexFile. The visitor is called in the order of the file
+ * for every valid record until the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param visitor The function called for each valid record.
+ * @param visitor_context The context given to the visitor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t visitIntelHexFile(HexContext_t *context, FILE *fptr, RecordVisitor_t visitor, void *visitor_context,
+                          FileReport_t *report)
+{
+    int8_t *line = NULL;            /* Initialize a pointer to each line of the file */
+    uint32_t length = 0;            /* Initialize the number of characters of the line */
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the validation */
+
+    ValidationState_t state;        /* Declaring the state of the validation */
+    LineReader_t reader;            /* Declaring the reader of the lines of the file */
+
+    startValidation(&state, context, report);
+    state.visitor = visitor;
+    state.visitor_context = visitor_context;
+    openLineReader(&reader, fptr);
+    /* Loop through each line of the file until the end of the file is reached or an invalid record is found */
+    while ((report->record_error.error_code == 0) && (readLine(&reader, &line, &length) != 0))
+    {
+        context->line_offset = reader.line_offset;
+        validateLine(&state, report, line, length);
+    }
+    countFileRead(context, &reader, start);
+    /* Return the result of the validation */
+    return finishValidation(&state, report);
+}
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and gives each valid record to a visitor.
+ *
+ * The function does the same checks as validateIntelHexBuffer. The visitor is called in the order of the file
+ * for every valid record until the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param visitor The function called for each valid record.
+ * @param visitor_context The context given to the visitor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t visitIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, RecordVisitor_t visitor,
+                            void *visitor_context, FileReport_t *report)
+{
+    ValidationState_t state;                /* Declaring the state of the validation */
+
+    startValidation(&state, context, report);
+    state.visitor = visitor;
+    state.visitor_context = visitor_context;
+    HEX_STATISTICS_ADD(context->statistics.character_count, size);
+    HEX_STATISTICS_MAX(context->statistics.peak_buffer_size, size);
+    validateLines(&state, report, buffer, size);
+    /* Return the result of the validation */
+    return finishValidation(&state, report);
+}
+
+/**
+ * @brief This function validates the whole Intel Hex file and collects all errors.
+ *
+ * The function does the same checks as validateIntelHexFile, but it doesn't stop at the first invalid record.
+ * Every invalid record is stored in the error report until the report is full, the following errors are only
+ * counted. The End-Of-File error, if any, is stored behind the record errors.
+ * The report of the validation holds the first invalid record, like the report of validateIntelHexFile.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param errors The error report, its entries and capacity are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if only the End-Of-File record isn't valid.
+ */
+int32_t collectIntelHexFileErrors(HexContext_t *context, FILE *fptr, ErrorReport_t *errors, FileReport_t *report)
+{
+    int8_t *line = NULL;            /* Initialize a pointer to each line of the file */
+    uint32_t length = 0;            /* Initialize the number of characters of the line */
+    Error_t first_error = {0, 0};   /* Initialize the first invalid record */
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the validation */
+
+    ValidationState_t state;        /* Declaring the state of the validation */
+    LineReader_t reader;            /* Declaring the reader of the lines of the file */
+
+    startValidation(&state, context, report);
+    errors->count = 0;
+    errors->total = 0;
+    openLineReader(&reader, fptr);
+    /* Loop through each line of the file until the end of the file is reached */
+    while (readLine(&reader, &line, &length) != 0)
+    {
+        collectLine(&state, report, errors, &first_error, line, length, reader.line_offset);
+    }
+    countFileRead(context, &reader, start);
+    /* Return the result of the validation */
+    return finishCollection(&state, report, errors, &first_error, reader.buffer_offset + reader.end);
+}
+
+/**
+ * @brief This function validates the whole Intel Hex file stored in memory and collects all errors.
+ *
+ * The function does the same checks as collectIntelHexFileErrors, the records are parsed in place inside the buffer.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param errors The error report, its entries and capacity are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if only the End-Of-File record isn't valid.
+ */
+int32_t collectIntelHexBufferErrors(HexContext_t *context, const int8_t buffer[], uint64_t size, ErrorReport_t *errors,
+                                    FileReport_t *report)
+{
+    const int8_t *line = buffer;            /* Pointer to the beginning of the current line */
+    const int8_t *end = buffer + size;      /* Pointer to the end of the buffer */
+    const int8_t *newline = NULL;           /* Pointer to the line feed of the current line */
+    Error_t first_error = {0, 0};           /* Initialize the first invalid record */
+    uint64_t start = HEX_STATISTICS_CLOCK(); /* The time of the beginning of the validation */
+
+    ValidationState_t state;                /* Declaring the state of the validation */
+
+    startValidation(&state, context, report);
+    errors->count = 0;
+    errors->total = 0;
+    HEX_STATISTICS_ADD(context->statistics.character_count, size);
+    HEX_STATISTICS_MAX(context->statistics.peak_buffer_size, size);
+    /* Loop through each line of the buffer until the end of the buffer is reached */
+    while (line < end)
+    {
+        newline = (const int8_t *)memchr(line, '\n', (size_t)(end - line));
+        /* The last line may not have a line terminator */
+        if (newline == NULL)
+        {
+            newline = end;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        collectLine(&state, report, errors, &first_error, line, clampLineLength((uint64_t)(newline - line)),
+                    (uint64_t)(line - buffer));
+        line = newline + 1;
+    }
+    HEX_STATISTICS_ELAPSED(context->statistics.parse_time, start);
+    /* Return the result of the validation */
+    return finishCollection(&state, report, errors, &first_error, size);
+}
 
+/**
+ * @brief This function starts the validation of an Intel Hex file received block by block.
+ *
+ * The blocks of the file are given to feedIntelHexStream in the order of the file, the validation
+ * is ended by finishIntelHexStream. The visitor, if any, is called for every valid record as soon as
+ * its line feed is received.
+ *
+ * @param context The context of the file, it is reset for a new file.
+ * @param stream The state of the validation.
+ * @param visitor The function called for each valid record, NULL if there is none.
+ * @param visitor_context The context given to the visitor.
+ */
+void openIntelHexStream(HexContext_t *context, HexStream_t *stream, RecordVisitor_t visitor, void *visitor_context)
+{
+    startValidation(&(stream->state), context, &(stream->report));
+    stream->state.visitor = visitor;
+    stream->state.visitor_context = visitor_context;
+    initRecordStream(&(stream->records));
+}
+
+/**
+ * @brief This function validates the next block of an Intel Hex file.
+ *
+ * The block can end anywhere, even inside a record. The lines that are complete in the block are parsed in place,
+ * the characters of a line split between two blocks are checked one by one by the record parser, with the same
+ * checks and error codes as validateIntelHexBuffer. An invalid record is reported as soon as its error is found
+ * and the characters behind it are ignored: the transfer of the file can be aborted.
+ * A second End-Of-File record is also reported at once, the End-Of-File error is then sure (error code 3 of
+ * checkEOF) but the following records are still checked.
+ *
+ * @param context The context of the file.
+ * @param stream The state of the validation.
+ * @param data The characters of the block.
+ * @param size The number of characters of the block.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t feedIntelHexStream(HexContext_t *context, HexStream_t *stream, const int8_t data[], uint64_t size)
+{
+    uint64_t i = 0;                 /* Position of the next character of the block */
+    uint32_t last_line = 0;         /* The line of the last valid record before the line or the character */
+    const int8_t *newline = NULL;   /* Pointer to the line feed of a line that is complete in the block */
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the block */
+
+    stream->state.context = context;
+    HEX_STATISTICS_ADD(context->statistics.character_count, size);
+    HEX_STATISTICS_MAX(context->statistics.peak_buffer_size, size);
+    /* Check the lines of the block until the end of the block or the first invalid record */
+    while ((i < size) && (stream->records.record_error.error_code == 0))
+    {
+        last_line = stream->records.last_line;
+        /* A line that starts and ends in the block is parsed in place like validateIntelHexBuffer does */
+        newline = NULL;
+        if (!stream->records.parser.line_started)
+        {
+            newline = (const int8_t *)memchr(data + i, '\n', (size_t)(size - i));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (newline != NULL)
+        {
+            pushRecordStreamLine(context, &(stream->records), data + i,
+                                 clampLineLength((uint64_t)(newline - (data + i))));
+            i = (uint64_t)(newline - data) + 1;
+        }
+        /* The characters of a line split between two blocks are given one by one to the record parser */
+        else
+        {
+            pushRecordStreamCharacter(context, &(stream->records), data[i]);
+            i += 1;
+        }
+        acceptStreamRecord(stream, last_line);
+    }
+    HEX_STATISTICS_ELAPSED(context->statistics.parse_time, start);
+    /* Return the result of the characters received */
+    return getRecordStreamResult(&(stream->records));
+}
+
+/**
+ * @brief This function ends the validation of an Intel Hex file received block by block.
+ *
+ * The last line is checked even if it doesn't have a line terminator, then the End-Of-File records are checked
+ * by the record stream with the rules of checkEOF. The report is the same as the report of validateIntelHexBuffer
+ * on the whole file.
+ *
+ * @param context The context of the file.
+ * @param stream The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t finishIntelHexStream(HexContext_t *context, HexStream_t *stream, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+    uint32_t last_line = stream->records.last_line;     /* The line of the last valid record before the last line */
+
+    stream->state.context = context;
+    result = finishRecordStream(context, &(stream->records));
+    acceptStreamRecord(stream, last_line);
+    /* The errors of the report are the errors of the record stream */
+    stream->report.line_count = context->line_number;
+    stream->report.record_error = stream->records.record_error;
+    stream->report.eof_error = stream->records.eof_error;
+    storeResult(context, &(stream->report));
+    *report = stream->report;
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function starts a single-pass validation.
+ *
+ * @param state The state of the validation.
+ * @param context The context of the file, it is reset for a new file.
+ * @param report The report structure to store the result of the validation.
+ */
+static void startValidation(ValidationState_t *state, HexContext_t *context, FileReport_t *report)
+{
+    /* Clear the state, the context and the report */
+    memset(state, 0, sizeof(ValidationState_t));
+    memset(report, 0, sizeof(FileReport_t));
+    resetHexContext(context);
+    state->context = context;
+    /* The base address is 0 until the first extended address record */
+    state->base_known = 1;
+    /* No record is given to a visitor */
+    state->visitor = NULL;
+}
+
+/**
+ * @brief This function validates one line of a single-pass validation.
+ *
+ * The function parses and checks the record of the line, tracks the End-Of-File records and resolves
+ * the absolute memory address of the data records.
+ * If the record is invalid, the error code and line number are stored in the record error of the report.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @param line The line to validate.
+ * @param length The number of characters of the line, with or without the line terminator.
+ */
+static void validateLine(ValidationState_t *state, FileReport_t *report, const int8_t line[], uint32_t length)
+{
+    IntelHexRecord_t record;        /* Declaring an Intel Hex record */
+
+    report->line_count += 1;
+    state->context->line_number = report->line_count;
+    /* Parse and check the record of the current line, the base address of the context is set by
+    the extended address records */
+    report->record_error.error_code = parseRecord(state->context, line, length, &record);
+    /* If the record is invalid, store the line number */
+    if (report->record_error.error_code != 0)
+    {
+        report->record_error.error_line = report->line_count;
+    }
+    /* Update the state of the validation with the valid record */
+    else
+    {
+        acceptRecord(state, report, &record);
+    }
+}
+
+/**
+ * @brief This function updates the report of a stream with the record completed by a line or a character, if any.
+ *
+ * The record stream keeps the line of its last valid record, a valid record is complete if the line changes.
+ * The address range and the start address of the report are updated and the record is given to the visitor,
+ * the End-Of-File records are checked by the record stream.
+ *
+ * @param stream The state of the validation.
+ * @param last_line The line of the last valid record of the record stream before the line or the character.
+ */
+static void acceptStreamRecord(HexStream_t *stream, uint32_t last_line)
+{
+    if (stream->records.last_line != last_line)
+    {
+        stream->report.line_count = stream->records.last_line;
+        acceptRecord(&(stream->state), &(stream->report), &(stream->records.parser.record));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function updates the state and the report of a single-pass validation with a valid record.
+ *
+ * The End-Of-File records are counted, the address range of the data records and the start address are updated
+ * and the record is given to the visitor, if any.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @param record The valid record, its line number is the line count of the report.
+ */
+static void acceptRecord(ValidationState_t *state, FileReport_t *report, const IntelHexRecord_t *record)
+{
+    uint32_t abs_address = 0;       /* Initialize the absolute address of a data record */
+
+    /* Check if the record is an End-Of-File record */
+    if (record->record_type == 0x01)
+    {
+        /* If the End-Of-File record is found for the first time, store the line number */
+        if (!state->found_EOF)
+        {
+            report->eof_error.error_line = report->line_count;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        state->found_EOF += 1;
+        state->last_EOF_line = report->line_count;
+    }
+    /* Check if the record is an extended segment or extended linear address record */
+    else if ((record->record_type == 0x02) || (record->record_type == 0x04))
+    {
+        state->base_known = 1;
+    }
+    /* Check if the record is a start segment or start linear address record, its byte count is always 4 */
+    else if ((record->record_type == 0x03) || (record->record_type == 0x05))
+    {
+        report->start_record_type = record->record_type;
+        report->start_address = ((uint32_t)record->data[0] << 24) | ((uint32_t)record->data[1] << 16) |
+                                ((uint32_t)record->data[2] << 8) | record->data[3];
+    }
+    /* Check if the record is a data record with data bytes */
+    else if ((record->record_type == 0x00) && (record->byte_count > 0))
+    {
+        /* Resolve the absolute address and update the address range */
+        if (state->base_known)
+        {
+            abs_address = state->context->base_address + record->address;
+            addAddressRange(report, abs_address, (uint64_t)abs_address + record->byte_count - 1, record->byte_count);
+        }
+        /* If the base address isn't known yet, keep the range without the base for the merge of the chunks */
+        else
+        {
+            if ((state->prefix_byte_count == 0) || (record->address < state->prefix_lowest))
+            {
+                state->prefix_lowest = record->address;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            if ((state->prefix_byte_count == 0) || (record->address + record->byte_count - 1 > state->prefix_highest))
+            {
+                state->prefix_highest = record->address + record->byte_count - 1;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            state->prefix_byte_count += record->byte_count;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Give the valid record and its absolute address to the visitor */
+    if (state->visitor != NULL)
+    {
+        state->visitor(state->visitor_context, record, state->context->base_address + record->address,
+                       report->line_count);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function checks if a line is an End-Of-File record.
+ *
+ * The line is an End-Of-File record if it is a valid record of type 01: no data bytes, any address
+ * and a valid checksum, the hexadecimal digits can be in upper or lower case.
+ *
+ * @param line The line, without its line feed.
+ * @param length The number of characters of the line, with or without the carriage return of a CR LF line terminator.
+ * @return 1 if the line is an End-Of-File record, 0 otherwise.
+ */
+static int8_t isEOFRecord(const int8_t line[], uint32_t length)
+{
+    int8_t is_EOF = 0;              /* Initialize the result of the function */
+    uint32_t byte_count = 0;        /* The byte count of the record */
+    uint32_t address_high = 0;      /* The high byte of the address */
+    uint32_t address_low = 0;       /* The low byte of the address */
+    uint32_t record_type = 0;       /* The record type */
+    uint32_t checksum = 0;          /* The checksum of the record */
+
+    /* Remove the carriage return of a CR LF line terminator like parseRecord */
+    if ((length > 0) && (line[length - 1] == '\r'))
+    {
+        length -= 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if ((length == HEX_EOF_RECORD_CHARS) && (line[0] == ':') && decodeHexByte(line + 1, &byte_count) &&
+        decodeHexByte(line + 3, &address_high) && decodeHexByte(line + 5, &address_low) &&
+        decodeHexByte(line + 7, &record_type) && decodeHexByte(line + 9, &checksum))
+    {
+        is_EOF = (byte_count == 0) && (record_type == 0x01) &&
+                 (((address_high + address_low + record_type + checksum) & 0xFF) == 0);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return is_EOF;
+}
+
+/**
+ * @brief This function finishes a single-pass validation.
+ *
+ * If no record is invalid, the function checks the End-Of-File records found during the validation
+ * with the same rules as checkEOF function. The number of lines and the error are stored in the context.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+static int32_t finishValidation(const ValidationState_t *state, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    /* An invalid record stops the validation */
+    if (report->record_error.error_code != 0)
+    {
+        result = 1;
+    }
+    else
+    {
+        checkEOFRecords(state, report);
+        /* Set the result if the End-Of-File record isn't valid */
+        if (report->eof_error.error_code != 0)
+        {
+            result = 2;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    storeResult(state->context, report);
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function checks the End-Of-File records found during a single-pass validation.
+ *
+ * The rules and error codes are the same as checkEOF function, the error code is stored in
+ * the End-Of-File error of the report.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the check.
+ */
+static void checkEOFRecords(const ValidationState_t *state, FileReport_t *report)
+{
+    /* If the End-Of-File record is not found, set the error code to 1 */
+    if (!state->found_EOF)
+    {
+        report->eof_error.error_code = 1;
+    }
+    /* If the End-Of-File record is found only once, it must be the last line of the file */
+    else if (state->found_EOF == 1)
+    {
+        if (state->last_EOF_line != report->line_count)
+        {
+            report->eof_error.error_code = 2;
+        }
+        else
+        {
+            report->eof_error.error_code = 0;
+        }
+    }
+    /* If the End-Of-File record is found more than once, set the error code to 3 */
+    else
+    {
+        report->eof_error.error_code = 3;
+    }
+}
+
+/**
+ * @brief This function limits the length of a line to the range of uint32_t.
+ *
+ * A line that long can't be a valid record, the limited length is still too long for a record.
+ *
+ * @param length The length of the line.
+ * @return The length of the line limited to UINT32_MAX.
+ */
+static uint32_t clampLineLength(uint64_t length)
+{
+    return (length > UINT32_MAX) ? UINT32_MAX : (uint32_t)length;
+}
+
+/**
+ * @brief This function validates all lines of a buffer until the end of the buffer or the first invalid record.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @param buffer The lines to validate.
+ * @param size The number of characters in the buffer.
+ */
+static void validateLines(ValidationState_t *state, FileReport_t *report, const int8_t buffer[], uint64_t size)
+{
+    const int8_t *line = buffer;            /* Pointer to the beginning of the current line */
+    const int8_t *end = buffer + size;      /* Pointer to the end of the buffer */
+    const int8_t *newline = NULL;           /* Pointer to the line feed of the current line */
+    uint64_t start = HEX_STATISTICS_CLOCK(); /* The time of the beginning of the validation */
+
+    /* Loop through each line of the buffer until the end of the buffer is reached or an invalid record is found */
+    while ((report->record_error.error_code == 0) && (line < end))
+    {
+        newline = (const int8_t *)memchr(line, '\n', (size_t)(end - line));
+        /* The last line may not have a line terminator */
+        if (newline == NULL)
+        {
+            newline = end;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        state->context->line_offset = (uint64_t)(line - buffer);
+        validateLine(state, report, line, clampLineLength((uint64_t)(newline - line)));
+        line = newline + 1;
+    }
+    HEX_STATISTICS_ELAPSED(state->context->statistics.parse_time, start);
+}
+
+/**
+ * @brief This function adds the address range of data bytes to the address range of the report.
+ *
+ * The highest address is given in 64 bits, it is clamped to the end of the 4 GiB address space
+ * instead of wrapping to a low address.
+ *
+ * @param report The report structure to update.
+ * @param lowest The lowest absolute address of the data bytes.
+ * @param highest The highest absolute address of the data bytes, it can be past 0xFFFFFFFF.
+ * @param byte_count The number of data bytes, nothing is added if it is 0.
+ */
+static void addAddressRange(FileReport_t *report, uint32_t lowest, uint64_t highest, uint64_t byte_count)
+{
+    if (highest >= HEX_ADDRESS_SPACE_SIZE)
+    {
+        highest = HEX_ADDRESS_SPACE_SIZE - 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (byte_count > 0)
+    {
+        if ((report->data_byte_count == 0) || (lowest < report->lowest_address))
+        {
+            report->lowest_address = lowest;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if ((report->data_byte_count == 0) || (highest > report->highest_address))
+        {
+            report->highest_address = (uint32_t)highest;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        report->data_byte_count += byte_count;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function is the thread function of a parallel validation, it validates one chunk.
+ *
+ * @param argument The chunk to validate (ValidationChunk_t).
+ * @return Always NULL.
+ */
+static void *validateChunk(void *argument)
+{
+    ValidationChunk_t *chunk = (ValidationChunk_t *)argument;   /* The chunk to validate */
+
+    validateLines(&(chunk->state), &(chunk->report), chunk->begin, chunk->size);
+    return NULL;
+}
+
+/**
+ * @brief This function merges the result of a chunk into the result of a parallel validation.
+ *
+ * The line numbers of the chunk are moved behind the lines of the previous chunks, the data bytes read
+ * before the first extended address record of the chunk get the base address of the previous chunks.
+ *
+ * @param state The state of the merged validation, at the end of the previous chunk.
+ * @param report The report of the merged validation.
+ * @param chunk The chunk to merge.
+ */
+static void mergeChunk(ValidationState_t *state, FileReport_t *report, const ValidationChunk_t *chunk)
+{
+    uint32_t line_offset = report->line_count;     /* Number of lines of the previous chunks */
+
+    /* The data read before the first extended address record of the chunk use the base address of the previous chunks */
+    addAddressRange(report, state->context->base_address + chunk->state.prefix_lowest,
+                    (uint64_t)state->context->base_address + chunk->state.prefix_highest, chunk->state.prefix_byte_count);
+    addAddressRange(report, chunk->report.lowest_address, chunk->report.highest_address, chunk->report.data_byte_count);
+    if (chunk->state.found_EOF > 0)
+    {
+        /* Keep the line number of the first End-Of-File record of the file */
+        if (state->found_EOF == 0)
+        {
+            report->eof_error.error_line = line_offset + chunk->report.eof_error.error_line;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        state->found_EOF += chunk->state.found_EOF;
+        state->last_EOF_line = line_offset + chunk->state.last_EOF_line;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Keep the start address of the last chunk that has one */
+    if (chunk->report.start_record_type != 0)
+    {
+        report->start_record_type = chunk->report.start_record_type;
+        report->start_address = chunk->report.start_address;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Carry the base address of the last extended address record of the chunk */
+    if (chunk->state.base_known)
+    {
+        state->context->base_address = chunk->context.base_address;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (chunk->report.record_error.error_code != 0)
+    {
+        report->record_error.error_code = chunk->report.record_error.error_code;
+        report->record_error.error_line = line_offset + chunk->report.record_error.error_line;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    report->line_count = line_offset + chunk->report.line_count;
+}
+
+/**
+ * @brief This function returns the number of processors online.
+ *
+ * @return The number of processors, at least 1.
+ */
+uint32_t getProcessorCount(void)
+{
+    uint32_t count = 1;         /* Number of processors */
+
+#if defined(_WIN32)
+    SYSTEM_INFO system_info;    /* Information of the system */
+
+    GetSystemInfo(&system_info);
+    count = (uint32_t)system_info.dwNumberOfProcessors;
+#else
+    long online = sysconf(_SC_NPROCESSORS_ONLN);   /* Number of processors online */
+
+    count = (online > 0) ? (uint32_t)online : 1;
+#endif
+    return (count > 0) ? count : 1;
+}
+
+/**
+ * @brief This function validates one line of a validation that collects all errors.
+ *
+ * An invalid record is added to the error report and doesn't stop the validation,
+ * the first invalid record is kept for the report of the validation.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @param errors The error report.
+ * @param first_error The first invalid record of the file.
+ * @param line The line to validate.
+ * @param length The number of characters of the line, with or without the line terminator.
+ * @param offset The byte offset of the line in the file.
+ */
+static void collectLine(ValidationState_t *state, FileReport_t *report, ErrorReport_t *errors, Error_t *first_error,
+                        const int8_t line[], uint32_t length, uint64_t offset)
+{
+    uint32_t found_EOF = state->found_EOF;     /* Number of End-Of-File records before this line */
+
+    validateLine(state, report, line, length);
+    /* Keep the offset of the first End-Of-File record for the End-Of-File error */
+    if ((found_EOF == 0) && (state->found_EOF == 1))
+    {
+        state->first_EOF_offset = offset;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (report->record_error.error_code != 0)
+    {
+        addError(errors, HEX_ERROR_SOURCE_RECORD, &(report->record_error), offset);
+        /* Keep the first invalid record */
+        if (first_error->error_code == 0)
+        {
+            *first_error = report->record_error;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Continue with the next line */
+        report->record_error.error_code = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function finishes a validation that collects all errors.
+ *
+ * The End-Of-File records are checked even if a record is invalid, the End-Of-File error is added to
+ * the error report behind the record errors.
+ *
+ * @param state The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @param errors The error report.
+ * @param first_error The first invalid record of the file.
+ * @param size The number of characters of the file, the offset of a missing End-Of-File record.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if only the End-Of-File record isn't valid.
+ */
+static int32_t finishCollection(const ValidationState_t *state, FileReport_t *report, ErrorReport_t *errors,
+                                const Error_t *first_error, uint64_t size)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    checkEOFRecords(state, report);
+    if (report->eof_error.error_code != 0)
+    {
+        addError(errors, HEX_ERROR_SOURCE_EOF, &(report->eof_error),
+                 (report->eof_error.error_code == 1) ? size : state->first_EOF_offset);
+        result = 2;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    report->record_error = *first_error;
+    if (first_error->error_code != 0)
+    {
+        result = 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    storeResult(state->context, report);
+    /* Return the result of the validation */
+    return result;
+}
+
+/**
+ * @brief This function adds an error to the error report.
+ *
+ * If the report is full, the error is only counted.
+ *
+ * @param errors The error report.
+ * @param error_source The check that found the error (HEX_ERROR_SOURCE_RECORD or HEX_ERROR_SOURCE_EOF).
+ * @param error The error code and line number.
+ * @param offset The byte offset of the line of the error.
+ */
+static void addError(ErrorReport_t *errors, uint32_t error_source, const Error_t *error, uint64_t offset)
+{
+    if (errors->count < errors->capacity)
+    {
+        errors->entries[errors->count].error_source = error_source;
+        errors->entries[errors->count].error_code = error->error_code;
+        errors->entries[errors->count].error_line = error->error_line;
+        errors->entries[errors->count].error_offset = offset;
+        errors->count += 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    errors->total += 1;
+}
+
+/**
+ * @brief This function writes a valid record in a machine-readable format, it is the visitor of the export.
+ *
+ * @param visitor_context The state of the export.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void exportRecord(void *visitor_context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                         uint32_t line_number)
+{
+    RecordExport_t *export_state = (RecordExport_t *)visitor_context;     /* The state of the export */
+    uint64_t start = HEX_STATISTICS_CLOCK();                            /* The time of the beginning of the line */
+
+    writeRecordLine(export_state->context, record, line_number, absolute_address, export_state->format);
+    HEX_STATISTICS_ELAPSED(export_state->context->statistics.output_time, start);
+}
+
+/**
+ * @brief This function stores the result of a single-pass validation in the context of the file.
+ *
+ * The line counter of the context is set to the number of lines of the file, the error of the context
+ * is the first invalid record or, if all records are valid, the End-Of-File error.
+ * The file is counted in the statistics of the context.
+ *
+ * @param context The context of the file.
+ * @param report The result of the validation.
+ */
+static void storeResult(HexContext_t *context, const FileReport_t *report)
+{
+    HEX_STATISTICS_ADD(context->statistics.file_count, 1);
+    context->line_number = report->line_count;
+    if (report->record_error.error_code != 0)
+    {
+        context->error = report->record_error;
+    }
+    else if (report->eof_error.error_code != 0)
+    {
+        context->error = report->eof_error;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function adds the reads and the parse of a file read by a line reader to the statistics.
+ *
+ * The time of the reads of the line reader is the time of the I/O, the rest of the time is the time of the parse.
+ * Nothing is counted in a build without HEX_STATISTICS.
+ *
+ * @param context The context of the file.
+ * @param reader The line reader at the end of the validation.
+ * @param start The time of the beginning of the validation.
+ */
+static void countFileRead(HexContext_t *context, const LineReader_t *reader, uint64_t start)
+{
+#if HEX_STATISTICS
+    context->statistics.io_time += reader->read_time;
+    context->statistics.parse_time += readStatisticsClock() - start - reader->read_time;
+    context->statistics.character_count += reader->buffer_offset + reader->end;
+    HEX_STATISTICS_MAX(context->statistics.peak_buffer_size, LINE_READER_BUFFER_SIZE);
+#else
+    (void)context;
+    (void)reader;
+    (void)start;
+#endif
+} /* EOF */
@@ -6,6 +6,15 @@
  * It provides function analyzeIntelHexFile to check the validity of the file and returns error code
  * to upper layer (Application layer).
  * The Intel Hex file analyzer also provides function checkEOF to check if the End-Of-File record valid.
+ * Function validateIntelHexFile does all checks of analyzeIntelHexFile and checkEOF in one pass over the file,
+ * functions validateIntelHexBuffer and validateIntelHexMappedFile do the same on a file stored in memory,
+ * with one thread or with several threads (validateIntelHexBufferParallel, validateIntelHexMappedFileParallel).
+ * Function validateIntelHexAsyncFile parses each block of the file while the next blocks are read.
+ * Function prefilterIntelHexBuffer rejects a file that isn't Intel Hex at all after a scan of its first characters.
+ * Functions visitIntelHexFile and visitIntelHexBuffer validate the file and give each valid record to a visitor.
+ * Function exportIntelHexFile writes the valid records as JSON lines or CSV.
+ * Functions openIntelHexStream, feedIntelHexStream and finishIntelHexStream validate a file received
+ * block by block, for example over a serial line or a network connection, without storing it.
  *
  * @author Viet Ha Nguyen
  * @date 4/26/2024
@@ -17,6 +26,7 @@
 #include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
 #include <stdlib.h>   /* For malloc(), free() functions*/
 #include <string.h>   /* For strcpy(), strcmp() functions*/
+#include "record_handler.h"   /* For the record structure given to a visitor */
 
 /*******************************************************************************
  * Header guards
@@ -24,14 +34,113 @@
 #ifndef INTEL_HEX_FILE_ANALYZER_H
 #define INTEL_HEX_FILE_ANALYZER_H
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HEX_ERROR_SOURCE_RECORD 0   /* The error is found by the check of a record (error codes of checkRecord) */
+#define HEX_ERROR_SOURCE_EOF    1   /* The error is found by the check of the End-Of-File record (error codes of checkEOF) */
+#define HEX_VALIDATOR_VERSION   2   /* Version of the validation rules, it changes when a file can get another result */
+#define HEX_PREFILTER_SIZE      (64 * 1024)     /* Number of characters scanned by the prefilter before a validation */
+#define HEX_ADDRESS_SPACE_SIZE  0x100000000ULL  /* Number of absolute memory addresses (4 GiB) of the memory image tools */
+
 /*******************************************************************************
  * Declarations
  ******************************************************************************/
+/**
+ * @brief Structure to hold the result of the single-pass validation of an Intel Hex file.
+ *
+ * The record error uses the error codes of checkRecord, the End-Of-File error uses the error codes of checkEOF.
+ * The End-Of-File error is only meaningful if there is no record error.
+ * The address range is the range of absolute memory addresses written by the data records, the end of a record
+ * is computed in 64 bits, so a record that crosses the end of the 4 GiB address space gives 0xFFFFFFFF and not
+ * a low address.
+ * The start address is the one of the last start segment (03) or start linear (05) address record of the file.
+ */
+typedef struct
+{
+    Error_t record_error;           /* Error code and line number of the first invalid record */
+    Error_t eof_error;              /* Error code and line number of the End-Of-File check */
+    uint32_t line_count;            /* Number of lines read from the file */
+    uint64_t data_byte_count;       /* Number of data bytes of all data records, 4 GiB or more for a large file */
+    uint32_t lowest_address;        /* Lowest absolute memory address written by a data record */
+    uint32_t highest_address;       /* Highest absolute memory address written by a data record, at most 0xFFFFFFFF */
+    uint32_t start_record_type;     /* Record type of the start address (0x03 or 0x05), 0 if the file has none */
+    uint32_t start_address;         /* Start address, CS in the upper and IP in the lower 16 bits for a record 03 */
+} FileReport_t;
+
+/**
+ * @brief Type of the function called for each valid record by visitIntelHexFile and visitIntelHexBuffer.
+ *
+ * The absolute address is the address of the record with the base address of the last extended segment (02)
+ * or extended linear (04) address record, it is meaningful for data records.
+ *
+ * @param context The context given by the caller of the visit.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+typedef void (*RecordVisitor_t)(void *context, const IntelHexRecord_t *record, uint32_t absolute_address,
+                                uint32_t line_number);
+
+/**
+ * @brief Structure to hold the state of a single-pass validation between two lines.
+ *
+ * The state is kept in a stream (HexStream_t) between two blocks of data, its fields are only used
+ * by the functions of the analyzer.
+ */
+typedef struct
+{
+    uint32_t found_EOF;             /* Number of End-Of-File records found */
+    uint32_t last_EOF_line;         /* Line number of the last End-Of-File record */
+    HexContext_t *context;          /* The context of the file, it holds the line number and the base address */
+    int8_t base_known;              /* 0 while the base address isn't known (chunk of a parallel validation) */
+    uint64_t prefix_byte_count;     /* Number of data bytes read while the base address isn't known */
+    uint32_t prefix_lowest;         /* Lowest address (without base address) read while the base address isn't known */
+    uint32_t prefix_highest;        /* Highest address (without base address) read while the base address isn't known */
+    uint64_t first_EOF_offset;      /* Byte offset of the first End-Of-File record, only kept when all errors are collected */
+    RecordVisitor_t visitor;        /* The function called for each valid record, NULL if there is none */
+    void *visitor_context;          /* The context given to the visitor */
+} ValidationState_t;
+
+/**
+ * @brief Structure to hold the state of the validation of a file received block by block.
+ *
+ * The stream doesn't keep the characters of the file, a record split between two blocks is checked
+ * character by character by the record parser. The records and the End-Of-File records are checked by a record
+ * stream (RecordStream_t), the same code as the freestanding build, the state of the validation only keeps
+ * the address range and the start address of the report.
+ */
 typedef struct
 {
-    uint32_t error_code;
-    uint32_t error_line;
-} Error_t;
+    ValidationState_t state;        /* The state of the validation between two records */
+    RecordStream_t records;         /* The record parser and the End-Of-File check of the file */
+    FileReport_t report;            /* The result of the validation of the characters received */
+} HexStream_t;
+
+/**
+ * @brief Structure to hold one error of a validation that collects all errors.
+ */
+typedef struct
+{
+    uint32_t error_source;          /* The check that found the error (HEX_ERROR_SOURCE_RECORD or HEX_ERROR_SOURCE_EOF) */
+    uint32_t error_code;            /* The error code of checkRecord or checkEOF */
+    uint32_t error_line;            /* The line number of the error, 0 for a missing End-Of-File record */
+    uint64_t error_offset;          /* The byte offset of the line in the file, the size of the file for a missing End-Of-File record */
+} ErrorEntry_t;
+
+/**
+ * @brief Structure to hold the errors of a validation that collects all errors.
+ *
+ * The entries are allocated by the caller, so the memory used by the report is bounded by the capacity
+ * whatever the number of errors in the file.
+ */
+typedef struct
+{
+    ErrorEntry_t *entries;          /* The array of errors, given by the caller */
+    uint32_t capacity;              /* The number of entries of the array */
+    uint32_t count;                 /* The number of errors stored in the array */
+    uint32_t total;                 /* The number of errors found, errors behind the capacity are only counted */
+} ErrorReport_t;
 
 /*******************************************************************************
  * Prototype
@@ -43,37 +152,293 @@ typedef struct
  * checkRecord function of lower layer (Middleware).
  * If any line is found to be invalid, the function stops analyzing and returns the error code.
  * If all lines are valid, the function returns 0, indicating that the file is valid.
+ * The line numbers are counted by the context.
  *
+ * @param context The context of the file.
  * @param fptr The file pointer to the Intel Hex file.
  * @param error The error structure to store the error code and line number.
  * @return An error code indicating the result of the analysis.
  */
-int32_t analyzeIntelHexFile(FILE *fptr, Error_t *error);
+int32_t analyzeIntelHexFile(HexContext_t *context, FILE *fptr, Error_t *error);
 
 /**
  * @brief This function checks the End-Of-File record.
  *
  * The function reads the file line by line and checks if the line is the End-Of-File record.
+ * An End-Of-File record is any valid record of type 01, whatever its address and the case of its hexadecimal
+ * digits, like in validateIntelHexFile.
  * If the End-Of-File record is found and this record is at the end of file, the function returns 0,
  * indicating that the file is valid.
  * If the End-Of-File record is not found or End-Of-File record is found but it's not at the end of file,
  * the function returns an error code.
+ * The line numbers are counted by the context, the error is also stored in the context.
  *
+ * @param context The context of the file.
  * @param fptr The file pointer to the Intel Hex file.
  * @param error The error structure to store the error code and line number.
  * @return An error code indicating the result of the check.
  */
-int32_t checkEOF(FILE *fptr, Error_t *error);
+int32_t checkEOF(HexContext_t *context, FILE *fptr, Error_t *error);
 
 /**
  * @brief This function prints the entire content of an Intel Hex File.
  *
  * The function reads each line of the file and prints it along with its line number.
- * It also calls the displayRecordInfo function to print the information of each records.
+ * It also prints the information of each records like the displayRecordInfo function.
+ * The text is written to the output writer of the context, which writes it in large blocks.
  *
+ * @param context The context of the file.
  * @param fptr The file pointer to the Intel Hex File.
  */
-void printIntelHexFile(FILE *fptr);
+void printIntelHexFile(HexContext_t *context, FILE *fptr);
+
+/**
+ * @brief This function validates the Intel Hex file and writes its valid records in a machine-readable format.
+ *
+ * The function validates the file in a single pass like validateIntelHexFile and writes one line for each
+ * valid record (line number, record type, absolute memory address and data) as JSON lines or CSV.
+ * The lines are written to the output writer of the context until the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex File.
+ * @param format The format of the lines.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t exportIntelHexFile(HexContext_t *context, FILE *fptr, RecordFormat_t format, FileReport_t *report);
+
+/**
+ * @brief This function validates the Intel Hex file in a single pass.
+ *
+ * The function reads the file line by line only once. Each line is parsed one time to check the record
+ * (same error codes as analyzeIntelHexFile), to detect the position and duplicates of the End-Of-File record
+ * (same error codes as checkEOF) and to resolve the absolute memory address of the data records
+ * with the extended segment (02) and extended linear (04) address records.
+ * The function stops reading at the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t validateIntelHexFile(HexContext_t *context, FILE *fptr, FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory in a single pass.
+ *
+ * The function does the same checks as validateIntelHexFile, but the records are parsed in place
+ * inside the buffer, without copying each line.
+ * The last line doesn't need a line terminator and the buffer doesn't need a null terminator.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t validateIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, FileReport_t *report);
+
+/**
+ * @brief This function rejects an Intel Hex file stored in memory if it has an obviously invalid line.
+ *
+ * The first characters of the buffer are scanned for a character that can't be part of an Intel Hex file
+ * (anything else than hexadecimal digits, ':', CR and LF) with findInvalidHexCharacter, and for a line
+ * that doesn't start with ':'. Such a line can't be a valid record, so the file is validated with
+ * validateIntelHexBuffer up to the end of this line only: the report and the context get exactly the result
+ * of the validation of the whole file, without reading the rest of the file.
+ * If no such line is found, nothing is stored and the file must be validated as usual.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param limit The number of characters scanned, 0 to scan the whole buffer.
+ * @param report The report structure to store the result of the validation of a rejected file.
+ * @return 1 if the file is rejected (the result of validateIntelHexBuffer is 1), 0 if the file must be validated.
+ */
+int32_t prefilterIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, uint64_t limit,
+                                FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file through a memory mapping of the file.
+ *
+ * The function maps the file into memory and validates it with validateIntelHexBuffer,
+ * so the records are parsed directly in the page cache without any copy.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ * 3 if the file can't be opened.
+ */
+int32_t validateIntelHexMappedFile(HexContext_t *context, const char *path, FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory with several threads.
+ *
+ * The buffer is split into chunks at line boundaries and every thread validates the records of one chunk.
+ * The results of the chunks are merged in the order of the chunks, so the report is exactly the same as
+ * the report of validateIntelHexBuffer: the first invalid record of the file is reported with its line number,
+ * and the base address of the extended address records is carried from the end of a chunk to the next chunk.
+ * Small buffers are validated by the calling thread only. Each chunk has its own context, the result of
+ * the merge is stored in the context of the caller.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param thread_count The number of threads, 0 to use one thread per processor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t validateIntelHexBufferParallel(HexContext_t *context, const int8_t buffer[], uint64_t size,
+                                       uint32_t thread_count, FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file through a memory mapping of the file with several threads.
+ *
+ * The function maps the file into memory and validates it with validateIntelHexBufferParallel.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param thread_count The number of threads, 0 to use one thread per processor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ * 3 if the file can't be opened.
+ */
+int32_t validateIntelHexMappedFileParallel(HexContext_t *context, const char *path, uint32_t thread_count,
+                                           FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file read by blocks with several reads in flight.
+ *
+ * The blocks of the asynchronous reader are given to the stream functions, so each block is parsed
+ * while the next blocks are read and only ASYNC_READER_DEPTH blocks of the file are in memory.
+ * The report is the same as the report of validateIntelHexMappedFile. The reads stop at the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ * 3 if the file can't be opened or read.
+ */
+int32_t validateIntelHexAsyncFile(HexContext_t *context, const char *path, FileReport_t *report);
+
+/**
+ * @brief This function validates the Intel Hex file in a single pass and gives each valid record to a visitor.
+ *
+ * The function does the same checks as validateIntelHexFile. The visitor is called in the order of the file
+ * for every valid record until the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param visitor The function called for each valid record.
+ * @param visitor_context The context given to the visitor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t visitIntelHexFile(HexContext_t *context, FILE *fptr, RecordVisitor_t visitor, void *visitor_context,
+                          FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and gives each valid record to a visitor.
+ *
+ * The function does the same checks as validateIntelHexBuffer. The visitor is called in the order of the file
+ * for every valid record until the first invalid record.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param visitor The function called for each valid record.
+ * @param visitor_context The context given to the visitor.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t visitIntelHexBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, RecordVisitor_t visitor,
+                            void *visitor_context, FileReport_t *report);
+
+/**
+ * @brief This function validates the whole Intel Hex file and collects all errors.
+ *
+ * The function does the same checks as validateIntelHexFile, but it doesn't stop at the first invalid record.
+ * Every invalid record is stored in the error report until the report is full, the following errors are only
+ * counted. The End-Of-File error, if any, is stored behind the record errors.
+ * The report of the validation holds the first invalid record, like the report of validateIntelHexFile.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param errors The error report, its entries and capacity are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if only the End-Of-File record isn't valid.
+ */
+int32_t collectIntelHexFileErrors(HexContext_t *context, FILE *fptr, ErrorReport_t *errors, FileReport_t *report);
+
+/**
+ * @brief This function validates the whole Intel Hex file stored in memory and collects all errors.
+ *
+ * The function does the same checks as collectIntelHexFileErrors, the records are parsed in place inside the buffer.
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param errors The error report, its entries and capacity are given by the caller.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if only the End-Of-File record isn't valid.
+ */
+int32_t collectIntelHexBufferErrors(HexContext_t *context, const int8_t buffer[], uint64_t size, ErrorReport_t *errors,
+                                    FileReport_t *report);
+
+/**
+ * @brief This function starts the validation of an Intel Hex file received block by block.
+ *
+ * The blocks of the file are given to feedIntelHexStream in the order of the file, the validation
+ * is ended by finishIntelHexStream. The visitor, if any, is called for every valid record as soon as
+ * its line feed is received.
+ *
+ * @param context The context of the file, it is reset for a new file.
+ * @param stream The state of the validation.
+ * @param visitor The function called for each valid record, NULL if there is none.
+ * @param visitor_context The context given to the visitor.
+ */
+void openIntelHexStream(HexContext_t *context, HexStream_t *stream, RecordVisitor_t visitor, void *visitor_context);
+
+/**
+ * @brief This function validates the next block of an Intel Hex file.
+ *
+ * The block can end anywhere, even inside a record. The lines that are complete in the block are parsed in place,
+ * the characters of a line split between two blocks are checked one by one by the record parser, with the same
+ * checks and error codes as validateIntelHexBuffer. An invalid record is reported as soon as its error is found
+ * and the characters behind it are ignored: the transfer of the file can be aborted.
+ * A second End-Of-File record is also reported at once, the End-Of-File error is then sure (error code 3 of
+ * checkEOF) but the following records are still checked.
+ *
+ * @param context The context of the file.
+ * @param stream The state of the validation.
+ * @param data The characters of the block.
+ * @param size The number of characters of the block.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t feedIntelHexStream(HexContext_t *context, HexStream_t *stream, const int8_t data[], uint64_t size);
+
+/**
+ * @brief This function ends the validation of an Intel Hex file received block by block.
+ *
+ * The last line is checked even if it doesn't have a line terminator, then the End-Of-File records are checked
+ * like validateIntelHexBuffer does. The report is the same as the report of validateIntelHexBuffer on the whole file.
+ *
+ * @param context The context of the file.
+ * @param stream The state of the validation.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t finishIntelHexStream(HexContext_t *context, HexStream_t *stream, FileReport_t *report);
+
+/**
+ * @brief This function returns the number of processors online.
+ *
+ * It gives the default number of threads of the functions that validate with several threads.
+ *
+ * @return The number of processors, at least 1.
+ */
+uint32_t getProcessorCount(void);
 
 #endif /* INTEL_HEX_FILE_ANALYZER_H */
 
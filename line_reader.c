@@ -0,0 +1,199 @@
+/**
+ * @file line_reader.c
+ * @brief This file contains the implementation of the line reader functions.
+ *
+ * The line reader reads the lines of a file in large blocks, so a line has no length limit
+ * up to the size of the buffer of the reader, which is much larger than the longest Intel Hex record.
+ * It provides function openLineReader to start reading a file and function readLine to get the next line.
+ * The lines end with LF or CR LF, the last line of the file doesn't need a line terminator.
+ * Only the line feed is removed, the carriage return of a CR LF line terminator is removed by the record parser
+ * (parseRecord), so a line terminator is removed in one place whatever reads the file.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "line_reader.h"        /* Include header file of this function file */
+#include <string.h>             /* For memchr(), memmove() functions */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function reads the next block of the file behind the characters kept in the buffer.
+ *
+ * @param reader The line reader.
+ */
+static void fillBuffer(LineReader_t *reader);
+
+/**
+ * @brief This function returns a line of the buffer without its line feed.
+ *
+ * @param reader The line reader.
+ * @param begin Position of the first character of the line.
+ * @param end Position behind the last character of the line, without the line feed.
+ * @param line Pointer to store the pointer to the line.
+ * @param length Pointer to store the number of characters of the line.
+ */
+static void returnLine(LineReader_t *reader, uint32_t begin, uint32_t end, int8_t **line, uint32_t *length);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function starts reading the lines of a file.
+ *
+ * @param reader The line reader.
+ * @param fptr The file pointer, read from its current position.
+ */
+void openLineReader(LineReader_t *reader, FILE *fptr)
+{
+    reader->fptr = fptr;
+    reader->begin = 0;
+    reader->end = 0;
+    reader->end_of_file = 0;
+    reader->skip_rest = 0;
+    reader->buffer_offset = 0;
+    reader->line_offset = 0;
+#if HEX_STATISTICS
+    reader->read_time = 0;
+#endif
+}
+
+/**
+ * @brief This function reads the next line of the file.
+ *
+ * The line is returned without its line feed and is null terminated, the carriage return of a CR LF line terminator
+ * is kept.
+ * It stays valid until the next call of readLine.
+ * A line longer than LINE_READER_BUFFER_SIZE is returned as one line with its first LINE_READER_BUFFER_SIZE
+ * characters, the rest of the line is skipped, so the line numbers stay correct.
+ *
+ * @param reader The line reader.
+ * @param line Pointer to store the pointer to the line.
+ * @param length Pointer to store the number of characters of the line.
+ * @return 1 if a line is read, 0 at the end of the file.
+ */
+int32_t readLine(LineReader_t *reader, int8_t **line, uint32_t *length)
+{
+    int32_t found = 0;              /* 1 when a line is found */
+    int8_t finished = 0;            /* 1 when the end of the file is reached without a line */
+    int8_t *newline = NULL;         /* Pointer to the line feed of the line */
+    uint32_t newline_position = 0;  /* Position of the line feed of the line */
+
+    while (!found && !finished)
+    {
+        newline = (int8_t *)memchr(reader->buffer + reader->begin, '\n', reader->end - reader->begin);
+        /* Skip the characters of a too long line until its line feed */
+        if (reader->skip_rest)
+        {
+            if (newline != NULL)
+            {
+                reader->begin = (uint32_t)(newline - reader->buffer) + 1;
+                reader->skip_rest = 0;
+            }
+            else if (reader->end_of_file)
+            {
+                reader->begin = reader->end;
+                reader->skip_rest = 0;
+            }
+            else
+            {
+                reader->begin = reader->end;
+                fillBuffer(reader);
+            }
+        }
+        /* A complete line is in the buffer */
+        else if (newline != NULL)
+        {
+            newline_position = (uint32_t)(newline - reader->buffer);
+            returnLine(reader, reader->begin, newline_position, line, length);
+            reader->begin = newline_position + 1;
+            found = 1;
+        }
+        /* The last line of the file doesn't have a line feed */
+        else if (reader->end_of_file)
+        {
+            if (reader->begin < reader->end)
+            {
+                returnLine(reader, reader->begin, reader->end, line, length);
+                reader->begin = reader->end;
+                found = 1;
+            }
+            else
+            {
+                /* End of the file, no more lines */
+                finished = 1;
+            }
+        }
+        /* The line fills the whole buffer, return its beginning and skip the rest */
+        else if ((reader->begin == 0) && (reader->end == LINE_READER_BUFFER_SIZE))
+        {
+            returnLine(reader, 0, LINE_READER_BUFFER_SIZE, line, length);
+            reader->begin = LINE_READER_BUFFER_SIZE;
+            reader->skip_rest = 1;
+            found = 1;
+        }
+        else
+        {
+            fillBuffer(reader);
+        }
+    }
+    /* Return 1 if a line is read */
+    return found;
+}
+
+/**
+ * @brief This function reads the next block of the file behind the characters kept in the buffer.
+ *
+ * @param reader The line reader.
+ */
+static void fillBuffer(LineReader_t *reader)
+{
+    size_t count = 0;               /* Number of characters read */
+    uint64_t start = 0;             /* The time of the beginning of the read */
+
+    /* Move the beginning of the current line to the beginning of the buffer */
+    if (reader->begin > 0)
+    {
+        memmove(reader->buffer, reader->buffer + reader->begin, reader->end - reader->begin);
+        reader->buffer_offset += reader->begin;
+        reader->end -= reader->begin;
+        reader->begin = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    start = HEX_STATISTICS_CLOCK();
+    count = fread(reader->buffer + reader->end, 1, LINE_READER_BUFFER_SIZE - reader->end, reader->fptr);
+    HEX_STATISTICS_ELAPSED(reader->read_time, start);
+    if (count == 0)
+    {
+        reader->end_of_file = 1;
+    }
+    else
+    {
+        reader->end += (uint32_t)count;
+    }
+}
+
+/**
+ * @brief This function returns a line of the buffer without its line feed.
+ *
+ * @param reader The line reader.
+ * @param begin Position of the first character of the line.
+ * @param end Position behind the last character of the line, without the line feed.
+ * @param line Pointer to store the pointer to the line.
+ * @param length Pointer to store the number of characters of the line.
+ */
+static void returnLine(LineReader_t *reader, uint32_t begin, uint32_t end, int8_t **line, uint32_t *length)
+{
+    /* Replace the line feed with a null terminator */
+    reader->buffer[end] = '\0';
+    *line = reader->buffer + begin;
+    *length = end - begin;
+    reader->line_offset = reader->buffer_offset + begin;
+} /* EOF */
@@ -0,0 +1,84 @@
+/**
+ * @file line_reader.h
+ * @brief This file contains the prototypes of the line reader functions.
+ *
+ * The line reader reads the lines of a file in large blocks, so a line has no length limit
+ * up to the size of the buffer of the reader, which is much larger than the longest Intel Hex record.
+ * It provides function openLineReader to start reading a file and function readLine to get the next line.
+ * The lines end with LF or CR LF, the last line of the file doesn't need a line terminator.
+ * Only the line feed is removed, the carriage return of a CR LF line terminator is removed by the record parser
+ * (parseRecord), so a line terminator is removed in one place whatever reads the file.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for FILE, fread, ... */
+#include "hex_statistics.h"   /* Include header file of the statistics */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LINE_READER_BUFFER_SIZE (64 * 1024)    /* Size of the block buffer, also the longest line that is kept whole */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of a line reader.
+ *
+ * The buffer has one more character than LINE_READER_BUFFER_SIZE for the null terminator of the last line.
+ */
+typedef struct
+{
+    FILE *fptr;                                     /* The file being read */
+    uint32_t begin;                                 /* Position of the first character not returned yet */
+    uint32_t end;                                   /* Position behind the last character read from the file */
+    int8_t end_of_file;                             /* 1 when the file has no more characters */
+    int8_t skip_rest;                               /* 1 while the rest of a too long line is skipped */
+    uint64_t buffer_offset;                         /* Byte offset in the file of the first character of the buffer */
+    uint64_t line_offset;                           /* Byte offset in the file of the last line returned */
+#if HEX_STATISTICS
+    uint64_t read_time;                             /* Time spent reading the file, in nanoseconds */
+#endif
+    int8_t buffer[LINE_READER_BUFFER_SIZE + 1];     /* The block buffer */
+} LineReader_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function starts reading the lines of a file.
+ *
+ * @param reader The line reader.
+ * @param fptr The file pointer, read from its current position.
+ */
+void openLineReader(LineReader_t *reader, FILE *fptr);
+
+/**
+ * @brief This function reads the next line of the file.
+ *
+ * The line is returned without its line feed and is null terminated, the carriage return of a CR LF line terminator
+ * is kept.
+ * It stays valid until the next call of readLine.
+ * A line longer than LINE_READER_BUFFER_SIZE is returned as one line with its first LINE_READER_BUFFER_SIZE
+ * characters, the rest of the line is skipped, so the line numbers stay correct.
+ *
+ * @param reader The line reader.
+ * @param line Pointer to store the pointer to the line.
+ * @param length Pointer to store the number of characters of the line.
+ * @return 1 if a line is read, 0 at the end of the file.
+ */
+int32_t readLine(LineReader_t *reader, int8_t **line, uint32_t *length);
+
+#endif /* LINE_READER_H */
+
@@ -6,6 +6,68 @@
  * If the Intel Hex file is not valid, it returns an error code.
  * The program will handle any errors that occur during the analysis of the file.
  * If an error is encountered, it prints an error message and the line number where the error occurred.
+ * With option --all-errors, the whole file is checked and every error is printed.
+ * With option --segments, the memory image of the file is built and its segments are printed.
+ * With option --digest, --digest=crc32 or --digest=sha256, the CRC-32 and/or the SHA-256 of each segment and of
+ * the whole memory image are computed while the file is validated and printed with the segments.
+ * With option --overlaps, the data records that overwrite each other are printed, option --gaps=G also prints
+ * the gaps of at least G bytes between the written addresses.
+ * With option --format=json or --format=csv, the valid records are written as JSON lines or CSV.
+ * With option --stdin, the file is read from the standard input and checked block by block while it arrives,
+ * the check stops at the first invalid record.
+ * With option --batch=LIST or --batch-dir=DIR, the files of a list file (one path per line) or the *.hex files
+ * of a directory are checked by a pool of threads, option --threads=T sets the number of threads.
+ * With option --server=SOCKET, the program is a validation server on the Unix domain socket SOCKET: its pool of
+ * --threads=T workers validates, converts and dumps the files of the requests of its clients until it gets
+ * a shutdown request, SIGINT or SIGTERM (see hex_server.h for the requests).
+ * With option --cache=DIR, the results of the checks are kept in the directory DIR and a file that was checked
+ * before isn't checked again (default check, --segments and batches), option --cache-size=M bounds the size
+ * of the directory to M MiB.
+ * With option --index, the address index of the file is written to the file with the extension .hidx added.
+ * With option --lookup=A, the data byte at the hexadecimal absolute address A and its record are printed,
+ * only the record is read from the file with the address index, which is built first if it is out of date.
+ * With option --stats or --stats=json, the statistics of the validation (records of each type, errors of each code,
+ * time spent in I/O, parse and output) are printed to the standard error at exit as a text block or as JSON,
+ * in a build with HEX_STATISTICS set to 1.
+ * With option --bin=OUT, the memory image of the file is written to the binary file OUT, the bytes between the
+ * records get the hexadecimal value of option --fill=XX (default FF) and option --range=A:B only writes the
+ * hexadecimal absolute addresses A to B.
+ * With option --normalize, the file is written again to the standard output as Intel Hex with records of
+ * option --record-size=S data bytes. With option --from-bin=BASE, the file is a binary file and it is written to
+ * the standard output as Intel Hex, its first byte at the hexadecimal absolute address BASE.
+ * With option --merge, all files given are merged in address order and written to the standard output as one
+ * Intel Hex file with a single End-Of-File record, the files aren't merged if they write the same addresses.
+ * With option --diff, the memory images of the two files given are compared and the ranges of addresses that
+ * differ are printed, whatever the records and the address records that write them.
+ * With option --async, the default check reads the file in large blocks with several reads in flight and parses
+ * each block while the next blocks are read, instead of mapping the file into memory, the cache isn't used.
+ * An argument that starts with -- and isn't an option, or an option whose number isn't a whole number in its range,
+ * is printed with the usage on the standard error and nothing is done. The same is done if the options select
+ * more than one mode (only --digest can be given with --segments), if an option isn't used by the mode
+ * (--threads without --batch, --batch-dir or --server, --fill or --range without --bin, --record-size without
+ * --normalize, --from-bin or --merge, --async or --cache with a mode that doesn't use them, --cache-size without
+ * --cache) or if more files are given than the mode uses.
+ *
+ * Exit status:
+ *   0  The file is valid and the mode succeeded: the records, segments, digests or index are printed or written,
+ *      no data records overlap (--overlaps, gaps aren't errors), the converted or merged file is written,
+ *      the address is written by a data record (--lookup), the memory images are the same (--diff),
+ *      all files of the batch are valid, the server ran until it was stopped.
+ *   1  A file isn't valid or can't be read, or the mode failed: data records overlap or cross the end of the 4 GiB
+ *      address space, the files conflict (--merge), the memory images differ (--diff), the address isn't written
+ *      (--lookup), a file of the batch isn't valid, the server can't be started.
+ *   2  An option is unknown, invalid or not used by the mode, the options select more than one mode,
+ *      or the mode isn't given the number of files it uses (--diff compares two files).
+ *
+ * Usage: Check_HEX_file_errors [--all-errors[=N] | --segments | --digest[=D] | --overlaps | --gaps=G | --format=F |
+ *                               --stdin | --batch=LIST | --batch-dir=DIR [--threads=T] | --server=SOCKET [--threads=T] |
+ *                               --index | --lookup=A | --bin=OUT [--fill=XX] [--range=A:B] | --normalize |
+ *                               --from-bin=BASE | --merge | --diff]
+ *                              [--record-size=S] [--cache=DIR [--cache-size=M]] [--stats[=json]] [--async]
+ *                              [file...]
+ * The default file is hex_file.hex, N is the maximum number of errors printed (default 100),
+ * T is the number of threads of a batch or a server (default one per processor), M is 64 by default,
+ * S is 16 by default, D is crc32 or sha256 (default both).
  *
  * @author Viet Ha Nguyen
  * @date 4/26/2024
@@ -16,8 +78,313 @@
  ******************************************************************************/
 #include <stdio.h>      /* Include standard input and output library for printf, scanf, ... */
 #include <stdint.h>     /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdlib.h>     /* For malloc(), free(), strtoul() functions */
 #include <string.h>     /* For NULL character */
+#include <signal.h>     /* For signal() function */
+#include <ctype.h>      /* For isdigit(), isxdigit() functions */
+#include <errno.h>      /* For errno of strtoul() */
 #include "intel_hex_file_analyzer.h"   /* Include header file of lower layer */
+#include "memory_image.h"              /* Include header file of the memory image builder of lower layer */
+#include "address_checker.h"           /* Include header file of the address checker of lower layer */
+#include "batch_validator.h"           /* Include header file of the batch validator of lower layer */
+#include "result_cache.h"              /* Include header file of the result cache of lower layer */
+#include "address_index.h"             /* Include header file of the address index of lower layer */
+#include "hex_converter.h"             /* Include header file of the converter of lower layer */
+#include "hex_merger.h"                /* Include header file of the merger of lower layer */
+#include "image_diff.h"                /* Include header file of the memory image comparison of lower layer */
+#include "image_digest.h"              /* Include header file of the memory image digests of lower layer */
+#include "hex_server.h"                /* Include header file of the validation server of lower layer */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define DEFAULT_HEX_FILE        "hex_file.hex"  /* The file checked when no file is given */
+#define DEFAULT_MAX_ERRORS      100             /* The default maximum number of errors printed with --all-errors */
+#define STREAM_BLOCK_SIZE       4096            /* The number of characters read at once from the standard input with --stdin */
+#define MAX_MERGE_CONFLICTS     100             /* The maximum number of conflicts printed with --merge */
+#define USAGE                   "Usage: Check_HEX_file_errors [--all-errors[=N] | --segments | --digest[=D] | " \
+                                "--overlaps | --gaps=G | --format=F | --stdin | --batch=LIST | --batch-dir=DIR " \
+                                "[--threads=T] | --server=SOCKET [--threads=T] | --index | --lookup=A | --bin=OUT " \
+                                "[--fill=XX] [--range=A:B] | --normalize | --from-bin=BASE | --merge | --diff] " \
+                                "[--record-size=S] [--cache=DIR [--cache-size=M]] [--stats[=json]] [--async] [file...]\n"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function checks the Intel Hex file and prints the information of its records if it is valid.
+ *
+ * @param context The context of the file.
+ * @param cache The result cache, NULL to check the file without a cache.
+ * @param path The path of the Intel Hex file.
+ * @param async_read 1 to validate the file with the asynchronous reader instead of the memory mapping.
+ * @return 1 if the file is valid, 0 otherwise.
+ */
+static int8_t checkFile(HexContext_t *context, ResultCache_t *cache, const char *path, int8_t async_read);
+
+/**
+ * @brief This function checks the whole Intel Hex file and prints all its errors.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param max_errors The maximum number of errors printed, the other errors are only counted.
+ * @return 1 if the file is checked without any error, 0 otherwise.
+ */
+static int8_t checkAllErrors(HexContext_t *context, const char *path, uint32_t max_errors);
+
+/**
+ * @brief This function builds the memory image of the Intel Hex file and prints its segments.
+ *
+ * @param context The context of the file.
+ * @param cache The result cache, NULL to build the memory image without a cache.
+ * @param path The path of the Intel Hex file.
+ * @return 1 if the file is valid and its segments are printed, 0 otherwise.
+ */
+static int8_t printSegments(HexContext_t *context, ResultCache_t *cache, const char *path);
+
+/**
+ * @brief This function prints the segments of a memory image.
+ *
+ * @param segments The segments.
+ * @param segment_count The number of segments.
+ * @param data_size The number of data bytes of all segments.
+ * @param overlap_count The number of segments that overlap the previous segment.
+ */
+static void printSegmentList(const MemorySegment_t segments[], uint32_t segment_count, uint64_t data_size,
+                             uint32_t overlap_count);
+
+/**
+ * @brief This function computes the digests of the memory image of the Intel Hex file and prints them.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param algorithms The digests to compute, IMAGE_DIGEST_CRC32 and/or IMAGE_DIGEST_SHA256.
+ * @return 1 if the file is valid and its digests are printed, 0 otherwise.
+ */
+static int8_t printDigests(HexContext_t *context, const char *path, uint32_t algorithms);
+
+/**
+ * @brief This function prints a SHA-256 digest as hexadecimal characters.
+ *
+ * @param digest The digest.
+ */
+static void printSha256(const uint8_t digest[SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief This function checks the addresses written by the data records and prints the overlaps and gaps.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param gap_threshold The minimum number of bytes of a printed gap, 0 to print no gap.
+ * @return 1 if the file is valid and no data records overlap or cross the end of the 4 GiB address space,
+ *         0 otherwise.
+ */
+static int8_t checkAddresses(HexContext_t *context, const char *path, uint32_t gap_threshold);
+
+/**
+ * @brief This function writes the valid records of the Intel Hex file in a machine-readable format.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param format The format of the records.
+ * @return 1 if the file is valid, 0 otherwise.
+ */
+static int8_t exportFile(HexContext_t *context, const char *path, RecordFormat_t format);
+
+/**
+ * @brief This function checks the Intel Hex file read from the standard input while it arrives.
+ *
+ * @param context The context of the file.
+ * @return 1 if the file is valid, 0 otherwise.
+ */
+static int8_t checkStream(HexContext_t *context);
+
+/**
+ * @brief This function checks the files of a list file or of a directory and prints the result of each file.
+ *
+ * @param context The context that gets the statistics of the batch.
+ * @param list_path The path of the list file, NULL to check a directory.
+ * @param directory The path of the directory, used if list_path is NULL.
+ * @param thread_count The number of threads, 0 to use one thread per processor.
+ * @param cache The result cache, NULL to check every file.
+ * @return 1 if all files of the batch are valid, 0 otherwise.
+ */
+static int8_t checkBatch(HexContext_t *context, const char *list_path, const char *directory, uint32_t thread_count,
+                         ResultCache_t *cache);
+
+/**
+ * @brief This function runs the validation server until it is stopped.
+ *
+ * @param socket_path The path of the Unix domain socket of the server.
+ * @param thread_count The number of worker threads, 0 for one per processor.
+ * @param cache The result cache shared by the workers, NULL to validate every file.
+ * @return 1 if the server has run until it was stopped, 0 if it can't be started.
+ */
+static int8_t runServer(const char *socket_path, uint32_t thread_count, ResultCache_t *cache);
+
+/**
+ * @brief This function stops the running server, it is the handler of SIGINT and SIGTERM.
+ *
+ * @param signal_number The number of the signal.
+ */
+static void stopServer(int signal_number);
+
+/**
+ * @brief This function writes the address index of the Intel Hex file.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @return 1 if the index is written, 0 otherwise.
+ */
+static int8_t writeIndex(HexContext_t *context, const char *path);
+
+/**
+ * @brief This function prints the data byte at an absolute memory address and its record.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param address The absolute memory address.
+ * @return 1 if a data record writes the address, 0 otherwise.
+ */
+static int8_t lookupFileAddress(HexContext_t *context, const char *path, uint32_t address);
+
+/**
+ * @brief This function builds the address index of the Intel Hex file and prints its result.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param index_path The path of the index file.
+ * @return 1 if the index is written, 0 otherwise.
+ */
+static int8_t buildFileIndex(HexContext_t *context, const char *path, const char *index_path);
+
+/**
+ * @brief This function makes the path of the address index of an Intel Hex file.
+ *
+ * @param path The path of the Intel Hex file.
+ * @return The path of the index, to be released with free, NULL if there isn't enough memory.
+ */
+static char *makeIndexPath(const char *path);
+
+/**
+ * @brief This function prints the message of a record error.
+ *
+ * @param error The error code (error codes of checkRecord) and line number of the error.
+ * @return 1 if an error is printed, 0 if the error code is 0.
+ */
+static int8_t printRecordError(const Error_t *error);
+
+/**
+ * @brief This function prints the message of an End-Of-File error.
+ *
+ * @param error The error code (error codes of checkEOF) and line number of the error.
+ * @return 1 if an error is printed, 0 if the error code is 0.
+ */
+static int8_t printEOFError(const Error_t *error);
+
+/**
+ * @brief This function prints the statistics of the context to the standard error.
+ *
+ * @param context The context of the files checked.
+ * @param format The format of the statistics.
+ */
+static void printStatistics(const HexContext_t *context, StatisticsFormat_t format);
+
+/**
+ * @brief This function prints the start address of a valid file, if it has one.
+ *
+ * @param report The report of the validation of the file.
+ */
+static void printStartAddress(const FileReport_t *report);
+
+/**
+ * @brief This function writes the memory image of the Intel Hex file to a binary file.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param binary_path The path of the binary file.
+ * @param options The fill value and the range of the conversion.
+ * @return 1 if the binary file is written, 0 otherwise.
+ */
+static int8_t convertToBinary(HexContext_t *context, const char *path, const char *binary_path,
+                              const BinaryOptions_t *options);
+
+/**
+ * @brief This function writes the Intel Hex file again to the standard output as normalized Intel Hex.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param record_size The number of data bytes of a record.
+ * @return 1 if the file is written, 0 otherwise.
+ */
+static int8_t normalizeFile(HexContext_t *context, const char *path, uint32_t record_size);
+
+/**
+ * @brief This function writes a binary file to the standard output as Intel Hex.
+ *
+ * @param context The context of the file, its writer prints to the standard output.
+ * @param path The path of the binary file.
+ * @param base_address The absolute address of the first byte of the binary file.
+ * @param record_size The number of data bytes of a record.
+ * @return 1 if the Intel Hex file is written, 0 otherwise.
+ */
+static int8_t convertFromBinary(HexContext_t *context, const char *path, uint32_t base_address, uint32_t record_size);
+
+/**
+ * @brief This function merges Intel Hex files and writes the merged file to the standard output.
+ *
+ * @param context The context of the files, its writer prints to the standard output.
+ * @param paths The paths of the Intel Hex files.
+ * @param path_count The number of files.
+ * @param record_size The number of data bytes of a record.
+ * @return 1 if the merged file is written, 0 otherwise.
+ */
+static int8_t mergeFiles(HexContext_t *context, const char *paths[], uint32_t path_count, uint32_t record_size);
+
+/**
+ * @brief This function compares the memory images of two Intel Hex files and prints the ranges that differ.
+ *
+ * @param context The context of the files.
+ * @param first_path The path of the first Intel Hex file.
+ * @param second_path The path of the second Intel Hex file.
+ * @return 1 if both files are valid and their memory images are the same, 0 otherwise.
+ */
+static int8_t diffFiles(HexContext_t *context, const char *first_path, const char *second_path);
+
+/**
+ * @brief This function builds the memory image of an Intel Hex file and prints its error, if any.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param image The memory image to build, it must be initialized with initMemoryImage.
+ * @return 1 if the image is built, 0 otherwise.
+ */
+static int8_t loadMemoryImage(HexContext_t *context, const char *path, MemoryImage_t *image);
+
+/**
+ * @brief This function prints a range of addresses that differs, it is the visitor of the comparison.
+ *
+ * @param visitor_context The number of ranges printed.
+ * @param difference The range that differs.
+ */
+static void printDifference(void *visitor_context, const ImageDifference_t *difference);
+
+/**
+ * @brief This function reads the number of an option.
+ *
+ * @param text The text of the number.
+ * @param base The base of the number, 10 or 16.
+ * @param maximum The largest accepted value.
+ * @param value Pointer to store the number.
+ * @param end Pointer to store the end of the number, NULL if the number must be the whole text.
+ * @return 1 if the text starts with a number not larger than maximum, 0 otherwise.
+ */
+static int8_t readNumber(const char *text, int32_t base, uint32_t maximum, uint32_t *value, char **end);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static HexServer_t *running_server = NULL;     /* The server stopped by stopServer, NULL if none is running */
 
 /*******************************************************************************
  * Code
@@ -30,103 +397,237 @@
  * The program will handle any errors that occur during the analysis of the file.
  * If an error is encountered, it prints an error message and the line number where the error occurred.
  *
- * @return An integer indicating the exit status of the program.
+ * @param argc The number of arguments.
+ * @param argv The arguments: [--all-errors[=N] | --segments | --digest[=D] | --overlaps | --gaps=G | --format=F |
+ *             --stdin | --batch=LIST | --batch-dir=DIR [--threads=T] | --server=SOCKET [--threads=T] |
+ *             --index | --lookup=A | --bin=OUT [--fill=XX] [--range=A:B] | --normalize | --from-bin=BASE | --merge |
+ *             --diff] [--record-size=S] [--cache=DIR [--cache-size=M]] [--stats[=json]] [--async] [file...],
+ *             only --merge and --diff use several files.
+ * @return The exit status: 0 if the file is valid and the mode succeeded, 1 if a file isn't valid or the mode
+ *         failed, 2 if an option is invalid (see the description of the file).
  */
-int32_t main(void)
+int32_t main(int32_t argc, char *argv[])
 {
-    int8_t line[100];            /* Initialize a character array to store each line of the file */
-    int8_t correct_format = 0;   /* Initialize a flag to indicate if the file has correct format */
-    int32_t file_error_code = 0; /* Initialize a variable to store the error code of the file */
-    int32_t EOF_error_code = 0;  /* Initialize a variable to store the error code of the End-Of-File record */
+    int32_t i = 0;                              /* Loop counter */
+    const char *path = DEFAULT_HEX_FILE;        /* The path of the Intel Hex file */
+    int8_t all_errors = 0;                      /* Initialize a flag to indicate if all errors are printed */
+    uint32_t max_errors = DEFAULT_MAX_ERRORS;   /* The maximum number of errors printed */
+    int8_t segments = 0;                        /* Initialize a flag to indicate if the segments are printed */
+    uint32_t digests = 0;                       /* The digests of the memory image printed, 0 for none */
+    int8_t overlaps = 0;                        /* Initialize a flag to indicate if the addresses are checked */
+    uint32_t gap_threshold = 0;                 /* The minimum number of bytes of a printed gap */
+    int8_t export_records = 0;                  /* Initialize a flag to indicate if the records are exported */
+    RecordFormat_t format = RECORD_FORMAT_JSON; /* The format of the exported records */
+    int8_t read_stdin = 0;                      /* Initialize a flag to indicate if the file is read from the standard input */
+    const char *batch_list = NULL;              /* The path of the list file of a batch */
+    const char *batch_directory = NULL;         /* The path of the directory of a batch */
+    uint32_t thread_count = 0;                  /* The number of threads of a batch, 0 for one per processor */
+    const char *server_socket = NULL;           /* The path of the socket of the validation server */
+    const char *cache_directory = NULL;         /* The path of the directory of the result cache */
+    uint64_t cache_size = RESULT_CACHE_DEFAULT_SIZE;    /* The maximum number of bytes of the result cache */
+    ResultCache_t *cache = NULL;                /* Pointer to the result cache, NULL if there is none */
+    int8_t write_index = 0;                     /* Initialize a flag to indicate if the address index is written */
+    int8_t lookup = 0;                          /* Initialize a flag to indicate if an address is looked up */
+    uint32_t lookup_address = 0;                /* The absolute memory address looked up */
+    int8_t statistics = 0;                      /* Initialize a flag to indicate if the statistics are printed */
+    StatisticsFormat_t statistics_format = STATISTICS_FORMAT_TEXT; /* The format of the printed statistics */
+    const char *binary_path = NULL;             /* The path of the binary file written with --bin */
+    int8_t normalize = 0;                       /* Initialize a flag to indicate if the file is normalized */
+    int8_t from_binary = 0;                     /* Initialize a flag to indicate if the file is a binary file */
+    uint32_t base_address = 0;                  /* The absolute address of the first byte of the binary file */
+    uint32_t record_size = HEX_CONVERTER_RECORD_SIZE;   /* The number of data bytes of a written record */
+    char *range_end = NULL;                     /* The end of the first address of --range */
+    uint32_t fill = 0xFF;                       /* The fill value of --fill */
+    uint32_t cache_megabytes = 0;               /* The size of --cache-size in MiB */
+    BinaryOptions_t binary_options = { 0xFF, 0, 0, 0 };  /* The fill value and the range of --bin */
+    int8_t merge = 0;                           /* Initialize a flag to indicate if the files are merged */
+    int8_t diff = 0;                            /* Initialize a flag to indicate if the files are compared */
+    uint32_t file_count = 0;                    /* The number of files given, they are moved to the front of argv */
+    int8_t async_read = 0;                      /* Initialize a flag to indicate if the file is read asynchronously */
+    int8_t valid_option = 1;                    /* Initialize a flag to indicate if the last option is valid */
+    int8_t threads_given = 0;                   /* Initialize a flag to indicate if --threads is given */
+    int8_t fill_given = 0;                      /* Initialize a flag to indicate if --fill is given */
+    int8_t record_size_given = 0;               /* Initialize a flag to indicate if --record-size is given */
+    int8_t cache_size_given = 0;                /* Initialize a flag to indicate if --cache-size is given */
+    int8_t batch = 0;                           /* Initialize a flag to indicate if a batch is checked */
+    int8_t cache_used = 0;                      /* Initialize a flag to indicate if the mode uses the result cache */
+    uint32_t mode_count = 0;                    /* The number of modes selected by the options */
+    const char *option_error = NULL;            /* The message of an option that isn't used by the mode */
+    int32_t exit_code = 0;                      /* The exit status of the program */
 
-    Error_t file_problem;        /* Initialize an error structure to store the error code and line number of the file */
-    Error_t EOF_problem;         /* Initialize an error structure to store the error code and line number of the End-Of-File record */
+    OutputWriter_t output;                      /* Declaring the writer of the text printed by the lower layer */
+    HexContext_t context;                       /* Declaring the context of the file */
+    ResultCache_t result_cache;                 /* Declaring the result cache */
 
-    /* Open the Intel Hex file in read mode */
-    FILE *fptr = fopen("hex_file.hex", "r");
+    openOutputWriter(&output, stdout);
+    initHexContext(&context, &output);
 
-    /* Check if the file is successfully opened */
-    if (fptr == NULL)
-    {
-        printf("Error: Can not open file.\n");
-    }
-    else
+    /* Read the options and the path of the file */
+    for (i = 1; (i < argc) && valid_option; i++)
     {
-        /* Analyze the Intel Hex file and store the error code, the line number where the error occurred
-        in the file_problem */
-        file_error_code = analyzeIntelHexFile(fptr, &file_problem);
-        /* Check the error code of the file */
-        switch (file_error_code)
+        if (strcmp(argv[i], "--all-errors") == 0)
         {
-            case 1:
-            {
-                printf("Error at line %d: There is no ':' character at the beginning of the line.\n", file_problem.error_line);
-                break;
-            }
-            case 2:
-            {
-                printf("Error at line %d: Record format isn't valid.\n", file_problem.error_line);
-                break;
-            }
-            case 3:
-            {
-                printf("Error at line %d: Record type isn't valid.\n", file_problem.error_line);
-                break;
-            }
-            case 4:
+            all_errors = 1;
+        }
+        else if (strncmp(argv[i], "--all-errors=", 13) == 0)
+        {
+            all_errors = 1;
+            valid_option = readNumber(argv[i] + 13, 10, 0xFFFFFFFFU, &max_errors, NULL);
+        }
+        else if (strcmp(argv[i], "--segments") == 0)
+        {
+            segments = 1;
+        }
+        else if (strcmp(argv[i], "--digest") == 0)
+        {
+            digests = IMAGE_DIGEST_CRC32 | IMAGE_DIGEST_SHA256;
+        }
+        else if (strcmp(argv[i], "--digest=crc32") == 0)
+        {
+            digests = IMAGE_DIGEST_CRC32;
+        }
+        else if (strcmp(argv[i], "--digest=sha256") == 0)
+        {
+            digests = IMAGE_DIGEST_SHA256;
+        }
+        else if (strcmp(argv[i], "--overlaps") == 0)
+        {
+            overlaps = 1;
+        }
+        else if (strncmp(argv[i], "--gaps=", 7) == 0)
+        {
+            overlaps = 1;
+            valid_option = readNumber(argv[i] + 7, 10, 0xFFFFFFFFU, &gap_threshold, NULL);
+        }
+        else if (strcmp(argv[i], "--format=json") == 0)
+        {
+            export_records = 1;
+            format = RECORD_FORMAT_JSON;
+        }
+        else if (strcmp(argv[i], "--format=csv") == 0)
+        {
+            export_records = 1;
+            format = RECORD_FORMAT_CSV;
+        }
+        else if (strcmp(argv[i], "--stdin") == 0)
+        {
+            read_stdin = 1;
+        }
+        else if (strncmp(argv[i], "--batch=", 8) == 0)
+        {
+            batch_list = argv[i] + 8;
+        }
+        else if (strncmp(argv[i], "--batch-dir=", 12) == 0)
+        {
+            batch_directory = argv[i] + 12;
+        }
+        else if (strncmp(argv[i], "--server=", 9) == 0)
+        {
+            server_socket = argv[i] + 9;
+        }
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+        {
+            threads_given = 1;
+            valid_option = readNumber(argv[i] + 10, 10, 0xFFFFFFFFU, &thread_count, NULL);
+        }
+        else if (strcmp(argv[i], "--index") == 0)
+        {
+            write_index = 1;
+        }
+        else if (strncmp(argv[i], "--lookup=", 9) == 0)
+        {
+            lookup = 1;
+            valid_option = readNumber(argv[i] + 9, 16, 0xFFFFFFFFU, &lookup_address, NULL);
+        }
+        else if (strncmp(argv[i], "--cache=", 8) == 0)
+        {
+            cache_directory = argv[i] + 8;
+        }
+        else if (strncmp(argv[i], "--cache-size=", 13) == 0)
+        {
+            cache_size_given = 1;
+            valid_option = readNumber(argv[i] + 13, 10, 0xFFFFFFFFU, &cache_megabytes, NULL);
+            cache_size = (uint64_t)cache_megabytes * 1024 * 1024;
+        }
+        else if (strcmp(argv[i], "--stats") == 0)
+        {
+            statistics = 1;
+        }
+        else if (strcmp(argv[i], "--stats=json") == 0)
+        {
+            statistics = 1;
+            statistics_format = STATISTICS_FORMAT_JSON;
+        }
+        else if (strncmp(argv[i], "--bin=", 6) == 0)
+        {
+            binary_path = argv[i] + 6;
+        }
+        else if (strncmp(argv[i], "--fill=", 7) == 0)
+        {
+            fill_given = 1;
+            valid_option = readNumber(argv[i] + 7, 16, 0xFF, &fill, NULL);
+            binary_options.fill = (uint8_t)fill;
+        }
+        else if (strncmp(argv[i], "--range=", 8) == 0)
+        {
+            binary_options.clip = 1;
+            binary_options.last_address = 0xFFFFFFFFU;
+            valid_option = readNumber(argv[i] + 8, 16, 0xFFFFFFFFU, &(binary_options.first_address), &range_end);
+            if (valid_option && (*range_end == ':'))
             {
-                printf("Error at line %d: The number of bytes of data field and record-length field aren't the same.\n", file_problem.error_line);
-                break;
+                valid_option = readNumber(range_end + 1, 16, 0xFFFFFFFFU, &(binary_options.last_address), NULL);
             }
-            case 5:
+            else if (valid_option && (*range_end != '\0'))
             {
-                printf("Error at line %d: Checksum field doesn't match the actual calculation.\n", file_problem.error_line);
-                break;
+                valid_option = 0;
             }
-            /* If the error code is not 1, 2, 3, 4, or 5, set the correct_format flag to 1 */
-            default:
+            else
             {
-                correct_format = 1;
+                /* Do nothing */
             }
         }
-        /* Close the file */
-        fclose(fptr);
-
-        /* If the file has correct format, open the file again and check the End-Of-File record */
-        if (correct_format)
+        else if (strcmp(argv[i], "--normalize") == 0)
+        {
+            normalize = 1;
+        }
+        else if (strncmp(argv[i], "--from-bin=", 11) == 0)
+        {
+            from_binary = 1;
+            valid_option = readNumber(argv[i] + 11, 16, 0xFFFFFFFFU, &base_address, NULL);
+        }
+        else if (strncmp(argv[i], "--record-size=", 14) == 0)
+        {
+            record_size_given = 1;
+            valid_option = readNumber(argv[i] + 14, 10, RECORD_MAX_DATA_BYTES, &record_size, NULL);
+        }
+        else if (strcmp(argv[i], "--merge") == 0)
+        {
+            merge = 1;
+        }
+        else if (strcmp(argv[i], "--diff") == 0)
+        {
+            diff = 1;
+        }
+        else if (strcmp(argv[i], "--async") == 0)
+        {
+            async_read = 1;
+        }
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            /* A mistyped option isn't taken as the path of the file */
+            valid_option = 0;
+        }
+        else
+        {
+            /* The files are kept in the arguments already read, the modes that use one file use the last one */
+            path = argv[i];
+            argv[1 + file_count] = argv[i];
+            file_count += 1;
+        }
+        if (!valid_option)
         {
-            /* Open the Intel Hex file in read mode */
-            fptr = fopen("hex_file.hex", "r");
-            /* Check the End-Of-File record and store the error code, the line number where the error occurred
-            in the EOF_problem */
-            EOF_error_code = checkEOF(fptr, &EOF_problem);
-            /* Check the error code of the End-Of-File record */
-            switch (EOF_error_code)
-            {
-                case 1:
-                {
-                    printf("File error: File is missing End-Of-File record!!!\n");
-                    break;
-                }
-                case 2:
-                {
-                    printf("Error at line %d: End-Of-File record must at the end of file!!!\n", EOF_problem.error_line);
-                    break;
-                }
-                case 3:
-                {
-                    printf("Error at line %d: File mustn't have more than one End-Of-File record!!!\n", EOF_problem.error_line);
-                    break;
-                }
-                /* If the error code is not 1, 2, or 3, print a success message */
-                default:
-                {
-                    printf("\n--> INTEL-HEX FILE HAS CORRECT FORMAT, WITHOUT ANY ERRORS.\n\n");
-                    printf("--> BELOW IS THE INFORMATION OF ALL FILE'S RECORDS . . .\n\n");
-                }
-            }
-            /* Close the file */
-            fclose(fptr);
+            fprintf(stderr, "Unknown or invalid option: %s\n" USAGE, argv[i]);
+            exit_code = 2;
         }
         else
         {
@@ -134,24 +635,1642 @@ int32_t main(void)
         }
     }
 
-    /* If the file has correct format and the End-Of-File record is valid, open the file again and
-    print the entire content (information of each lines as well as records) of the file */
-    if (correct_format && !EOF_error_code)
+    /* Only one mode runs, so the options of two modes and an option the mode doesn't use aren't ignored silently,
+    --digest prints the segments, it can be given with --segments */
+    batch = (batch_list != NULL) || (batch_directory != NULL);
+    mode_count = (uint32_t)all_errors + (uint32_t)(segments || (digests != 0)) + (uint32_t)overlaps +
+                 (uint32_t)export_records + (uint32_t)read_stdin + (uint32_t)batch + (uint32_t)(server_socket != NULL) +
+                 (uint32_t)write_index + (uint32_t)lookup + (uint32_t)(binary_path != NULL) + (uint32_t)normalize +
+                 (uint32_t)from_binary + (uint32_t)merge + (uint32_t)diff;
+    cache_used = ((mode_count == 0) && !async_read) || (segments && (digests == 0)) || batch || (server_socket != NULL);
+    if (exit_code != 0)
     {
-        /* Open the Intel Hex file in read mode */
-        fptr = fopen("hex_file.hex", "r");
-        /* Print the entire content of the file */
-        printIntelHexFile(fptr);
-        /* Close the file */
-        fclose(fptr);
+        /* Do nothing, the invalid option is printed */
+    }
+    else if ((mode_count > 1) || ((batch_list != NULL) && (batch_directory != NULL)))
+    {
+        option_error = "Error: The options select more than one mode.";
+    }
+    else if (threads_given && !batch && (server_socket == NULL))
+    {
+        option_error = "Error: Option --threads is only used with --batch, --batch-dir and --server.";
+    }
+    else if ((fill_given || binary_options.clip) && (binary_path == NULL))
+    {
+        option_error = "Error: Options --fill and --range are only used with --bin.";
+    }
+    else if (record_size_given && !normalize && !from_binary && !merge)
+    {
+        option_error = "Error: Option --record-size is only used with --normalize, --from-bin and --merge.";
+    }
+    else if (async_read && (mode_count > 0))
+    {
+        option_error = "Error: Option --async is only used by the default check.";
+    }
+    else if ((cache_directory != NULL) && !cache_used)
+    {
+        option_error = "Error: Option --cache is only used by the default check without --async, --segments, "
+                       "--batch, --batch-dir and --server.";
+    }
+    else if (cache_size_given && (cache_directory == NULL))
+    {
+        option_error = "Error: Option --cache-size is only used with --cache.";
+    }
+    else if ((read_stdin || batch || (server_socket != NULL)) && (file_count > 0))
+    {
+        option_error = "Error: No file is given with --stdin, --batch, --batch-dir and --server.";
+    }
+    else if (!merge && !diff && (file_count > 1))
+    {
+        option_error = "Error: Only --merge and --diff use several files.";
     }
-    /* If the file doesn't have correct format or the End-Of-File record is not valid, print an error message */
     else
     {
-        printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+        /* Do nothing */
+    }
+    if (option_error != NULL)
+    {
+        fprintf(stderr, "%s\n" USAGE, option_error);
+        exit_code = 2;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* Open the result cache, the files are checked without it if it can't be opened */
+    if ((exit_code == 0) && (cache_directory != NULL))
+    {
+        if (openResultCache(&result_cache, cache_directory, cache_size) == 0)
+        {
+            cache = &result_cache;
+        }
+        else
+        {
+            fprintf(stderr, "Warning: Can not open the cache directory, the files are checked without cache.\n");
+        }
+    }
+    else
+    {
+        /* Do nothing */
     }
-    /* Return 0 to indicate that the program has finished */
-    return 0;
-} /* EOF */
 
+    if (exit_code != 0)
+    {
+        /* Do nothing, nothing is done with an invalid option */
+    }
+    else if (server_socket != NULL)
+    {
+        exit_code = runServer(server_socket, thread_count, cache) ? 0 : 1;
+    }
+    else if (read_stdin)
+    {
+        exit_code = checkStream(&context) ? 0 : 1;
+    }
+    else if ((batch_list != NULL) || (batch_directory != NULL))
+    {
+        exit_code = checkBatch(&context, batch_list, batch_directory, thread_count, cache) ? 0 : 1;
+    }
+    else if (all_errors)
+    {
+        exit_code = checkAllErrors(&context, path, max_errors) ? 0 : 1;
+    }
+    else if (write_index)
+    {
+        exit_code = writeIndex(&context, path) ? 0 : 1;
+    }
+    else if (lookup)
+    {
+        exit_code = lookupFileAddress(&context, path, lookup_address) ? 0 : 1;
+    }
+    else if (binary_path != NULL)
+    {
+        exit_code = convertToBinary(&context, path, binary_path, &binary_options) ? 0 : 1;
+    }
+    else if (normalize)
+    {
+        exit_code = normalizeFile(&context, path, record_size) ? 0 : 1;
+    }
+    else if (from_binary)
+    {
+        exit_code = convertFromBinary(&context, path, base_address, record_size) ? 0 : 1;
+    }
+    else if (merge)
+    {
+        /* Without files the default file is merged alone */
+        exit_code = mergeFiles(&context, (file_count > 0) ? (const char **)(argv + 1) : &path,
+                               (file_count > 0) ? file_count : 1, record_size) ? 0 : 1;
+    }
+    else if (diff)
+    {
+        if (file_count == 2)
+        {
+            exit_code = diffFiles(&context, argv[1], argv[2]) ? 0 : 1;
+        }
+        else
+        {
+            printf("Error: Option --diff compares two files.\n");
+            exit_code = 2;
+        }
+    }
+    else if (digests != 0)
+    {
+        exit_code = printDigests(&context, path, digests) ? 0 : 1;
+    }
+    else if (segments)
+    {
+        exit_code = printSegments(&context, cache, path) ? 0 : 1;
+    }
+    else if (overlaps)
+    {
+        exit_code = checkAddresses(&context, path, gap_threshold) ? 0 : 1;
+    }
+    else if (export_records)
+    {
+        exit_code = exportFile(&context, path, format) ? 0 : 1;
+    }
+    else
+    {
+        exit_code = checkFile(&context, cache, path, async_read) ? 0 : 1;
+    }
+
+    if (statistics && (option_error == NULL) && valid_option)
+    {
+        printStatistics(&context, statistics_format);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (cache != NULL)
+    {
+        closeResultCache(cache);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return exit_code;
+}
+
+/**
+ * @brief This function checks the Intel Hex file and prints the information of its records if it is valid.
+ *
+ * The records and the End-Of-File record are checked in one pass, the information of the records
+ * is printed only if the file is valid. The file is checked in memory, so a file that isn't Intel Hex at all
+ * is rejected by the prefilter, and with a result cache the result of a file checked before is used.
+ * With the asynchronous reader, each block of the file is parsed while the next blocks are read.
+ * If the file can't be mapped into memory or read, it is checked line by line.
+ *
+ * @param context The context of the file.
+ * @param cache The result cache, NULL to check the file without a cache.
+ * @param path The path of the Intel Hex file.
+ * @param async_read 1 to validate the file with the asynchronous reader instead of the memory mapping.
+ * @return 1 if the file is valid, 0 otherwise.
+ */
+static int8_t checkFile(HexContext_t *context, ResultCache_t *cache, const char *path, int8_t async_read)
+{
+    int8_t correct_format = 0;   /* Initialize a flag to indicate if the file has correct format */
+    int8_t EOF_error = 0;        /* Initialize a flag to indicate if the End-Of-File record is not valid */
+    int32_t cached_result = 3;   /* The result of the validation in memory, 3 if the file can't be mapped */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+    CachedResult_t cached;       /* Declaring the result of the file with the result cache */
+
+    /* Open the Intel Hex file in read mode */
+    FILE *fptr = fopen(path, "r");
+
+    /* Check if the file is successfully opened */
+    if (fptr == NULL)
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else
+    {
+        /* Validate the records and the End-Of-File record of the Intel Hex file in one pass and store the error codes,
+        the line numbers where the errors occurred in the file_report */
+        if (async_read)
+        {
+            cached_result = validateIntelHexAsyncFile(context, path, &file_report);
+        }
+        else
+        {
+            cached_result = validateIntelHexFileCached(cache, context, path, 0, &cached);
+            file_report = cached.report;
+            freeCachedResult(&cached);
+        }
+        if (cached_result == 3)
+        {
+            validateIntelHexFile(context, fptr, &file_report);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Check the error code of the file */
+        correct_format = !printRecordError(&(file_report.record_error));
+
+        /* If the file has correct format, check the result of the End-Of-File record */
+        if (correct_format)
+        {
+            EOF_error = printEOFError(&(file_report.eof_error));
+            /* If the End-Of-File record is valid, print a success message */
+            if (!EOF_error)
+            {
+                printf("\n--> INTEL-HEX FILE HAS CORRECT FORMAT, WITHOUT ANY ERRORS.\n\n");
+                printStartAddress(&file_report);
+                printf("--> BELOW IS THE INFORMATION OF ALL FILE'S RECORDS . . .\n\n");
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        /* If the file has correct format and the End-Of-File record is valid, go back to the beginning of the file and
+        print the entire content (information of each lines as well as records) of the file */
+        if (correct_format && !EOF_error)
+        {
+            rewind(fptr);
+            /* Print the entire content of the file */
+            printIntelHexFile(context, fptr);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Close the file */
+        fclose(fptr);
+    }
+
+    /* If the file doesn't have correct format or the End-Of-File record is not valid, print an error message */
+    if (!correct_format || EOF_error)
+    {
+        printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return (correct_format && !EOF_error);
+}
+
+/**
+ * @brief This function checks the whole Intel Hex file and prints all its errors.
+ *
+ * The errors are collected in one pass into an array allocated once with max_errors entries,
+ * so the memory used doesn't depend on the number of errors in the file.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param max_errors The maximum number of errors printed, the other errors are only counted.
+ * @return 1 if the file is checked without any error, 0 otherwise.
+ */
+static int8_t checkAllErrors(HexContext_t *context, const char *path, uint32_t max_errors)
+{
+    uint32_t i = 0;              /* Loop counter */
+    int8_t valid = 0;            /* Initialize a flag to indicate if the file is checked without any error */
+    Error_t error;               /* The error code and line number of an error */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+    ErrorReport_t errors;        /* Initialize the report of all errors of the file */
+
+    /* Open the Intel Hex file in read mode */
+    FILE *fptr = fopen(path, "r");
+
+    errors.capacity = max_errors;
+    errors.entries = (ErrorEntry_t *)malloc(((max_errors > 0) ? max_errors : 1) * sizeof(ErrorEntry_t));
+    /* Check if the file is successfully opened */
+    if ((fptr == NULL) || (errors.entries == NULL))
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else
+    {
+        /* Collect all errors of the file */
+        collectIntelHexFileErrors(context, fptr, &errors, &file_report);
+        for (i = 0; i < errors.count; i++)
+        {
+            error.error_code = errors.entries[i].error_code;
+            error.error_line = errors.entries[i].error_line;
+            /* Print the message of the error and its byte offset */
+            if (errors.entries[i].error_source == HEX_ERROR_SOURCE_RECORD)
+            {
+                printRecordError(&error);
+            }
+            else
+            {
+                printEOFError(&error);
+            }
+            printf("   (byte offset %llu)\n", (unsigned long long)errors.entries[i].error_offset);
+        }
+        /* Print the number of errors */
+        if (errors.total == 0)
+        {
+            printf("\n--> INTEL-HEX FILE HAS CORRECT FORMAT, WITHOUT ANY ERRORS.\n");
+            valid = 1;
+        }
+        else if (errors.total > errors.count)
+        {
+            printf("\n--> %u ERRORS FOUND, %u ERRORS NOT PRINTED.\n", errors.total, errors.total - errors.count);
+        }
+        else
+        {
+            printf("\n--> %u ERRORS FOUND.\n", errors.total);
+        }
+    }
+    /* Close the file */
+    if (fptr != NULL)
+    {
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    free(errors.entries);
+    return valid;
+}
+
+/**
+ * @brief This function builds the memory image of the Intel Hex file and prints its segments.
+ *
+ * The segments are printed in address order with their first and last address and their size.
+ * If the file isn't valid, the error is printed like checkFile does.
+ * With a result cache, the segments of a file checked before are taken from the cache.
+ *
+ * @param context The context of the file.
+ * @param cache The result cache, NULL to build the memory image without a cache.
+ * @param path The path of the Intel Hex file.
+ * @return 1 if the file is valid and its segments are printed, 0 otherwise.
+ */
+static int8_t printSegments(HexContext_t *context, ResultCache_t *cache, const char *path)
+{
+    int32_t result = 0;          /* The result of the building of the memory image */
+    int8_t valid = 1;            /* Initialize a flag to indicate if the segments are printed */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+    MemoryImage_t image;         /* Declaring the memory image of the file */
+    CachedResult_t cached;       /* Declaring the result of the file with the result cache */
+    FILE *fptr = NULL;           /* Declaring a file pointer */
+
+    initMemoryImage(&image);
+    if (cache != NULL)
+    {
+        result = validateIntelHexFileCached(cache, context, path, 1, &cached);
+        file_report = cached.report;
+    }
+    else
+    {
+        /* Open the Intel Hex file in read mode */
+        fptr = fopen(path, "r");
+        result = (fptr == NULL) ? 3 : buildMemoryImage(context, fptr, &image, &file_report);
+    }
+
+    /* Check if the file is successfully opened */
+    if (result == 3)
+    {
+        printf("Error: Can not open file.\n");
+        valid = 0;
+    }
+    else if (result == 4)
+    {
+        printf("Error: Not enough memory for the memory image.\n");
+        valid = 0;
+    }
+    else if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+    {
+        printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+        valid = 0;
+    }
+    else if (cache != NULL)
+    {
+        printSegmentList(cached.segments, cached.segment_count, cached.data_size, cached.overlap_count);
+    }
+    else
+    {
+        printSegmentList(image.segments, image.segment_count, image.data_size, image.overlap_count);
+    }
+
+    if (cache != NULL)
+    {
+        freeCachedResult(&cached);
+    }
+    else if (fptr != NULL)
+    {
+        /* Close the file */
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    freeMemoryImage(&image);
+    return valid;
+}
+
+/**
+ * @brief This function prints the segments of a memory image.
+ *
+ * Each segment is printed with its first and last address and its size, then the totals are printed.
+ * The last address is computed in 64 bits, so a segment that crosses the end of the 4 GiB address space
+ * isn't printed as ending at a low address.
+ *
+ * @param segments The segments.
+ * @param segment_count The number of segments.
+ * @param data_size The number of data bytes of all segments.
+ * @param overlap_count The number of segments that overlap the previous segment.
+ */
+static void printSegmentList(const MemorySegment_t segments[], uint32_t segment_count, uint64_t data_size,
+                             uint32_t overlap_count)
+{
+    uint32_t i = 0;              /* Loop counter */
+
+    /* Print each segment of the memory image */
+    for (i = 0; i < segment_count; i++)
+    {
+        printf("Segment %u: %08X - %08llX (%u bytes)\n", i + 1, segments[i].address,
+               (unsigned long long)segments[i].address + segments[i].size - 1, segments[i].size);
+    }
+    printf("\n--> %u SEGMENTS, %llu BYTES OF DATA, %u OVERLAPPING SEGMENTS.\n", segment_count,
+           (unsigned long long)data_size, overlap_count);
+}
+
+/**
+ * @brief This function computes the digests of the memory image of the Intel Hex file and prints them.
+ *
+ * The digests are computed in the same pass as the validation, the file is only read again if its data records
+ * aren't in address order. Each segment is printed like printSegmentList does, followed by its digests,
+ * then the digests of the whole image are printed.
+ * If the file isn't valid, the error is printed like checkFile does.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param algorithms The digests to compute, IMAGE_DIGEST_CRC32 and/or IMAGE_DIGEST_SHA256.
+ * @return 1 if the file is valid and its digests are printed, 0 otherwise.
+ */
+static int8_t printDigests(HexContext_t *context, const char *path, uint32_t algorithms)
+{
+    int32_t result = 0;          /* The result of the computation of the digests */
+    int8_t valid = 0;            /* Initialize a flag to indicate if the digests are printed */
+    uint32_t i = 0;              /* Loop counter */
+    SegmentDigest_t *segment = NULL;    /* Pointer to the printed segment */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+    ImageDigest_t digest;        /* Declaring the digests of the memory image of the file */
+
+    /* Open the Intel Hex file in read mode */
+    FILE *fptr = fopen(path, "r");
+
+    initImageDigest(&digest, algorithms);
+    result = (fptr == NULL) ? 3 : digestIntelHexFile(context, fptr, &digest, &file_report);
+    if (result == 3)
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else if (result == 4)
+    {
+        printf("Error: Not enough memory for the digests.\n");
+    }
+    else if (result == 5)
+    {
+        printf("Error: Data records overlap, the memory image has no single content.\n");
+    }
+    else if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+    {
+        printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+    }
+    else
+    {
+        valid = 1;
+        /* Print each segment with its digests */
+        for (i = 0; i < digest.segment_count; i++)
+        {
+            segment = &(digest.segments[i]);
+            printf("Segment %u: %08X - %08llX (%u bytes)", i + 1, segment->address,
+                   (unsigned long long)segment->address + segment->size - 1, segment->size);
+            if (algorithms & IMAGE_DIGEST_CRC32)
+            {
+                printf(" CRC32 %08X", segment->crc32);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            if (algorithms & IMAGE_DIGEST_SHA256)
+            {
+                printf(" SHA256 ");
+                printSha256(segment->sha256);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            printf("\n");
+        }
+        printf("\n--> %u SEGMENTS, %llu BYTES OF DATA.\n", digest.segment_count,
+               (unsigned long long)digest.data_size);
+        if (algorithms & IMAGE_DIGEST_CRC32)
+        {
+            printf("--> IMAGE CRC32: %08X\n", digest.crc32);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (algorithms & IMAGE_DIGEST_SHA256)
+        {
+            printf("--> IMAGE SHA256: ");
+            printSha256(digest.sha256);
+            printf("\n");
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    /* Close the file */
+    if (fptr != NULL)
+    {
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    freeImageDigest(&digest);
+    return valid;
+}
+
+/**
+ * @brief This function prints a SHA-256 digest as hexadecimal characters.
+ *
+ * @param digest The digest.
+ */
+static void printSha256(const uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    uint32_t i = 0;              /* Loop counter */
+
+    for (i = 0; i < SHA256_DIGEST_SIZE; i++)
+    {
+        printf("%02x", digest[i]);
+    }
+}
+
+/**
+ * @brief This function checks the addresses written by the data records and prints the overlaps and gaps.
+ *
+ * At most DEFAULT_MAX_ERRORS overlaps and gaps are printed, the other ones are only counted.
+ * If the file isn't valid, the error is printed like checkFile does.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param gap_threshold The minimum number of bytes of a printed gap, 0 to print no gap.
+ * @return 1 if the file is valid and no data records overlap or cross the end of the 4 GiB address space,
+ *         0 otherwise.
+ */
+static int8_t checkAddresses(HexContext_t *context, const char *path, uint32_t gap_threshold)
+{
+    uint32_t i = 0;              /* Loop counter */
+    int32_t result = 0;          /* The result of the address check */
+    int8_t valid = 0;            /* Initialize a flag to indicate if the file is valid without overlap */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+    AddressReport_t addresses;   /* Initialize the report of the address check */
+    AddressConflict_t overlaps[DEFAULT_MAX_ERRORS];     /* The overlaps printed */
+    AddressConflict_t gaps[DEFAULT_MAX_ERRORS];         /* The gaps printed */
+
+    /* Open the Intel Hex file in read mode */
+    FILE *fptr = fopen(path, "r");
+
+    addresses.overlaps = overlaps;
+    addresses.overlap_capacity = DEFAULT_MAX_ERRORS;
+    addresses.gaps = gaps;
+    addresses.gap_capacity = DEFAULT_MAX_ERRORS;
+    addresses.gap_threshold = gap_threshold;
+    /* Check if the file is successfully opened */
+    if (fptr == NULL)
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else
+    {
+        result = checkIntelHexAddresses(context, fptr, &addresses, &file_report);
+        if (result == 4)
+        {
+            printf("Error: Not enough memory for the address check.\n");
+        }
+        else if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+        {
+            printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+        }
+        else
+        {
+            /* Print each overlap and each gap */
+            for (i = 0; i < addresses.overlap_count; i++)
+            {
+                printf("Error at line %u: Data record overwrites %u bytes at address %08X written at line %u.\n",
+                       overlaps[i].line, overlaps[i].size, overlaps[i].address, overlaps[i].other_line);
+            }
+            for (i = 0; i < addresses.gap_count; i++)
+            {
+                printf("Gap of %u bytes at address %08X between line %u and line %u.\n",
+                       gaps[i].size, gaps[i].address, gaps[i].other_line, gaps[i].line);
+            }
+            if (addresses.overflow_line != 0)
+            {
+                printf("Error at line %u: Data record crosses the end of the 4 GiB address space.\n",
+                       addresses.overflow_line);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            /* Print the number of overlaps and gaps, the gaps aren't errors */
+            if (addresses.overlap_total == 0)
+            {
+                printf("\n--> NO DATA RECORDS OVERLAP, %u GAPS FOUND.\n", addresses.gap_total);
+                valid = (addresses.overflow_line == 0);
+            }
+            else
+            {
+                printf("\n--> %u OVERLAPS FOUND, %u GAPS FOUND.\n", addresses.overlap_total, addresses.gap_total);
+            }
+        }
+        /* Close the file */
+        fclose(fptr);
+    }
+    return valid;
+}
+
+/**
+ * @brief This function writes the valid records of the Intel Hex file in a machine-readable format.
+ *
+ * The records are written to the standard output, one line for each record. If the file isn't valid,
+ * the error is printed to the standard error behind the records.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param format The format of the records.
+ * @return 1 if the file is valid, 0 otherwise.
+ */
+static int8_t exportFile(HexContext_t *context, const char *path, RecordFormat_t format)
+{
+    int8_t valid = 0;            /* Initialize a flag to indicate if the file is valid */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+
+    /* Open the Intel Hex file in read mode */
+    FILE *fptr = fopen(path, "r");
+
+    /* Check if the file is successfully opened */
+    if (fptr == NULL)
+    {
+        fprintf(stderr, "Error: Can not open file.\n");
+    }
+    else
+    {
+        /* Write the records and print the error of the file, if any */
+        if (exportIntelHexFile(context, fptr, format, &file_report) == 1)
+        {
+            fprintf(stderr, "Error at line %d: Record isn't valid (error code %d).\n",
+                    file_report.record_error.error_line, file_report.record_error.error_code);
+        }
+        else if (file_report.eof_error.error_code != 0)
+        {
+            fprintf(stderr, "Error at line %d: End-Of-File record isn't valid (error code %d).\n",
+                    file_report.eof_error.error_line, file_report.eof_error.error_code);
+        }
+        else
+        {
+            valid = 1;
+        }
+        /* Close the file */
+        fclose(fptr);
+    }
+    return valid;
+}
+
+/**
+ * @brief This function checks the Intel Hex file read from the standard input while it arrives.
+ *
+ * The blocks read from the standard input are validated at once, a record split between two blocks is
+ * checked when its end arrives. The reading stops at the first invalid record, so a bad transfer is aborted
+ * without waiting for the end of the file. The messages are the same as the messages of checkFile,
+ * the information of the records isn't printed because the file isn't stored.
+ *
+ * @param context The context of the file.
+ * @return 1 if the file is valid, 0 otherwise.
+ */
+static int8_t checkStream(HexContext_t *context)
+{
+    int8_t block[STREAM_BLOCK_SIZE];    /* The characters read from the standard input */
+    size_t count = 0;                   /* The number of characters of the block */
+    int32_t result = 0;                 /* The result of the validation of the blocks */
+    int8_t valid = 0;                   /* Initialize a flag to indicate if the file is valid */
+    uint64_t start = HEX_STATISTICS_CLOCK();    /* The time of the beginning of a read */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+    HexStream_t stream;          /* Declaring the state of the validation of the blocks */
+
+    openIntelHexStream(context, &stream, NULL, NULL);
+    count = fread(block, 1, sizeof(block), stdin);
+    HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+    /* Validate each block until the end of the standard input or the first invalid record */
+    while ((count > 0) && (result != 1))
+    {
+        result = feedIntelHexStream(context, &stream, block, count);
+        if (result != 1)
+        {
+            start = HEX_STATISTICS_CLOCK();
+            count = fread(block, 1, sizeof(block), stdin);
+            HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    finishIntelHexStream(context, &stream, &file_report);
+
+    /* Print the error of the file or a success message */
+    if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+    {
+        printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+    }
+    else
+    {
+        printf("\n--> INTEL-HEX FILE HAS CORRECT FORMAT, WITHOUT ANY ERRORS.\n");
+        valid = 1;
+    }
+    return valid;
+}
+
+/**
+ * @brief This function checks the files of a list file or of a directory and prints the result of each file.
+ *
+ * The files are validated by a pool of threads, then one line is printed for each file in the order of the list:
+ * the path of the file and its first error, or OK. The statistics of the batch are printed at the end.
+ *
+ * @param context The context that gets the statistics of the batch.
+ * @param list_path The path of the list file, NULL to check a directory.
+ * @param directory The path of the directory, used if list_path is NULL.
+ * @param thread_count The number of threads, 0 to use one thread per processor.
+ * @param cache The result cache, NULL to check every file.
+ * @return 1 if all files of the batch are valid, 0 otherwise.
+ */
+static int8_t checkBatch(HexContext_t *context, const char *list_path, const char *directory, uint32_t thread_count,
+                         ResultCache_t *cache)
+{
+    int32_t status = 0;                 /* The status of the building of the list */
+    uint32_t i = 0;                     /* Loop counter */
+    int8_t valid = 0;                   /* Initialize a flag to indicate if all files are valid */
+    const BatchEntry_t *entry = NULL;   /* Pointer to the current file */
+
+    BatchList_t list;                   /* Declaring the list of files */
+    BatchSummary_t summary;             /* Declaring the statistics of the batch */
+
+    initBatchList(&list);
+    if (list_path != NULL)
+    {
+        status = readBatchListFile(&list, list_path);
+    }
+    else
+    {
+        status = addBatchDirectory(&list, directory);
+    }
+
+    if (status == 3)
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else if (status == 4)
+    {
+        printf("Error: Not enough memory for the list of files.\n");
+    }
+    else
+    {
+        validateIntelHexBatch(&list, thread_count, cache, &summary);
+#if HEX_STATISTICS
+        mergeHexStatistics(&(context->statistics), &(summary.statistics));
+#else
+        (void)context;
+#endif
+
+        /* Print the result of each file */
+        for (i = 0; i < list.count; i++)
+        {
+            entry = &(list.entries[i]);
+            printf("%s: ", entry->path);
+            if (entry->result == 3)
+            {
+                printf("Error: Can not open file.\n");
+            }
+            else if (printRecordError(&(entry->report.record_error)) || printEOFError(&(entry->report.eof_error)))
+            {
+                /* Do nothing */
+            }
+            else
+            {
+                printf("OK\n");
+            }
+        }
+
+        /* Print the statistics of the batch */
+        printf("\n--> %u FILES CHECKED, %u VALID, %u WITH RECORD ERRORS, %u WITH END-OF-FILE ERRORS, %u NOT OPENED.\n",
+               summary.file_count, summary.valid_count, summary.record_error_count, summary.eof_error_count,
+               summary.open_error_count);
+        printf("--> %llu BYTES, %llu LINES IN %.3f SECONDS WITH %u THREADS, %u RESULTS FROM THE CACHE.\n",
+               (unsigned long long)summary.byte_count, (unsigned long long)summary.line_count,
+               summary.elapsed_seconds, summary.thread_count, summary.cached_count);
+        valid = (summary.valid_count == summary.file_count);
+    }
+    freeBatchList(&list);
+    return valid;
+}
+
+/**
+ * @brief This function runs the validation server until it is stopped.
+ *
+ * The server is stopped by a shutdown request or by SIGINT and SIGTERM, the requests in progress are answered first.
+ *
+ * @param socket_path The path of the Unix domain socket of the server.
+ * @param thread_count The number of worker threads, 0 for one per processor.
+ * @param cache The result cache shared by the workers, NULL to validate every file.
+ * @return 1 if the server has run until it was stopped, 0 if it can't be started.
+ */
+static int8_t runServer(const char *socket_path, uint32_t thread_count, ResultCache_t *cache)
+{
+    int32_t status = 0;                 /* The status of the opening of the server */
+    int8_t started = 0;                 /* Initialize a flag to indicate if the server has run */
+    /* The server has the latency windows of the metrics, it is allocated instead of being on the stack */
+    HexServer_t *server = (HexServer_t *)malloc(sizeof(HexServer_t));
+
+    if (server == NULL)
+    {
+        printf("Error: Not enough memory for the server.\n");
+    }
+    else
+    {
+        status = openHexServer(server, socket_path, thread_count, cache);
+        if (status == 3)
+        {
+            printf("Error: Can not create the socket of the server (or a file that isn't a socket is at its path).\n");
+        }
+        else if (status == 4)
+        {
+            printf("Error: Can not start the workers of the server.\n");
+        }
+        else
+        {
+            printf("--> SERVER LISTENING ON %s WITH %u THREADS.\n", socket_path, server->thread_count);
+            fflush(stdout);
+            running_server = server;
+            signal(SIGINT, stopServer);
+            signal(SIGTERM, stopServer);
+            runHexServer(server);
+            signal(SIGINT, SIG_DFL);
+            signal(SIGTERM, SIG_DFL);
+            running_server = NULL;
+            closeHexServer(server);
+            printf("--> SERVER STOPPED.\n");
+            started = 1;
+        }
+        free(server);
+    }
+    return started;
+}
+
+/**
+ * @brief This function stops the running server, it is the handler of SIGINT and SIGTERM.
+ *
+ * @param signal_number The number of the signal.
+ */
+static void stopServer(int signal_number)
+{
+    (void)signal_number;
+    if (running_server != NULL)
+    {
+        stopHexServer(running_server);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function writes the address index of the Intel Hex file.
+ *
+ * The index is written to the path of the file with the extension ADDRESS_INDEX_EXTENSION added.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @return 1 if the index is written, 0 otherwise.
+ */
+static int8_t writeIndex(HexContext_t *context, const char *path)
+{
+    int8_t written = 0;                         /* Initialize a flag to indicate if the index is written */
+    char *index_path = makeIndexPath(path);     /* The path of the index file */
+
+    if (index_path == NULL)
+    {
+        printf("Error: Not enough memory for the address index.\n");
+    }
+    else
+    {
+        written = buildFileIndex(context, path, index_path);
+        free(index_path);
+    }
+    return written;
+}
+
+/**
+ * @brief This function prints the data byte at an absolute memory address and its record.
+ *
+ * The address index of the file is used, it is built first if it is missing or out of date.
+ * The information of the record is printed like checkFile does.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param address The absolute memory address.
+ * @return 1 if a data record writes the address, 0 otherwise.
+ */
+static int8_t lookupFileAddress(HexContext_t *context, const char *path, uint32_t address)
+{
+    int32_t result = 0;                         /* The result of the opening of the index */
+    char *index_path = makeIndexPath(path);     /* The path of the index file */
+
+    AddressIndex_t index;                       /* Declaring the address index of the file */
+    AddressLookup_t lookup;                     /* Declaring the result of the lookup */
+
+    if (index_path == NULL)
+    {
+        printf("Error: Not enough memory for the address index.\n");
+        result = 4;
+    }
+    else
+    {
+        result = openAddressIndex(&index, path, index_path);
+        /* Build the index if it can't be used, then open it again */
+        if ((result == 1) && buildFileIndex(context, path, index_path))
+        {
+            result = openAddressIndex(&index, path, index_path);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        free(index_path);
+    }
+
+    if (result == 3)
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else if (result == 0)
+    {
+        result = lookupAddress(context, &index, address, &lookup);
+        if (result == 0)
+        {
+            printf("Address %08X: %02X (line %u, byte offset %llu)\n\n", address, lookup.value,
+                   lookup.entry.line_number, (unsigned long long)lookup.entry.offset);
+            writeRecordInfo(context, lookup.line, lookup.length, (int32_t)lookup.entry.line_number);
+            flushOutputWriter(context->output);
+        }
+        else if (result == 1)
+        {
+            printf("Address %08X: no data record writes this address.\n", address);
+        }
+        else
+        {
+            printf("Error: The record of address %08X can not be read, the address index is out of date.\n", address);
+        }
+        closeAddressIndex(&index);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return (result == 0);
+}
+
+/**
+ * @brief This function builds the address index of the Intel Hex file and prints its result.
+ *
+ * If the file isn't valid, the error is printed like checkFile does.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param index_path The path of the index file.
+ * @return 1 if the index is written, 0 otherwise.
+ */
+static int8_t buildFileIndex(HexContext_t *context, const char *path, const char *index_path)
+{
+    int32_t result = 0;          /* The result of the building of the index */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+
+    result = buildAddressIndex(context, path, index_path, &file_report);
+    if (result == 3)
+    {
+        printf("Error: Can not open file.\n");
+    }
+    else if (result == 4)
+    {
+        printf("Error: Not enough memory for the address index.\n");
+    }
+    else if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+    {
+        printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+    }
+    else
+    {
+        printf("--> ADDRESS INDEX WRITTEN TO %s.\n", index_path);
+    }
+    return (result == 0);
+}
+
+/**
+ * @brief This function makes the path of the address index of an Intel Hex file.
+ *
+ * @param path The path of the Intel Hex file.
+ * @return The path of the index, to be released with free, NULL if there isn't enough memory.
+ */
+static char *makeIndexPath(const char *path)
+{
+    size_t length = strlen(path);       /* The number of characters of the path */
+    char *index_path = (char *)malloc(length + sizeof(ADDRESS_INDEX_EXTENSION));   /* The path of the index */
+
+    if (index_path != NULL)
+    {
+        memcpy(index_path, path, length);
+        memcpy(index_path + length, ADDRESS_INDEX_EXTENSION, sizeof(ADDRESS_INDEX_EXTENSION));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return index_path;
+}
+
+/**
+ * @brief This function prints the message of a record error.
+ *
+ * @param error The error code (error codes of checkRecord) and line number of the error.
+ * @return 1 if an error is printed, 0 if the error code is 0.
+ */
+static int8_t printRecordError(const Error_t *error)
+{
+    int8_t printed = 1;          /* Initialize a flag to indicate if an error is printed */
+
+    /* Check the error code of the record */
+    switch (error->error_code)
+    {
+        case 1:
+        {
+            printf("Error at line %d: There is no ':' character at the beginning of the line.\n", error->error_line);
+            break;
+        }
+        case 2:
+        {
+            printf("Error at line %d: Record format isn't valid.\n", error->error_line);
+            break;
+        }
+        case 3:
+        {
+            printf("Error at line %d: Record type isn't valid.\n", error->error_line);
+            break;
+        }
+        case 4:
+        {
+            printf("Error at line %d: The number of bytes of data field and record-length field aren't the same.\n", error->error_line);
+            break;
+        }
+        case 5:
+        {
+            printf("Error at line %d: Checksum field doesn't match the actual calculation.\n", error->error_line);
+            break;
+        }
+        case 6:
+        {
+            printf("Error at line %d: Record-length field isn't valid for the record type.\n", error->error_line);
+            break;
+        }
+        /* If the error code is not 1, 2, 3, 4, 5, or 6, nothing is printed */
+        default:
+        {
+            printed = 0;
+        }
+    }
+    return printed;
+}
+
+/**
+ * @brief This function prints the message of an End-Of-File error.
+ *
+ * @param error The error code (error codes of checkEOF) and line number of the error.
+ * @return 1 if an error is printed, 0 if the error code is 0.
+ */
+static int8_t printEOFError(const Error_t *error)
+{
+    int8_t printed = 1;          /* Initialize a flag to indicate if an error is printed */
+
+    /* Check the error code of the End-Of-File record */
+    switch (error->error_code)
+    {
+        case 1:
+        {
+            printf("File error: File is missing End-Of-File record!!!\n");
+            break;
+        }
+        case 2:
+        {
+            printf("Error at line %d: End-Of-File record must at the end of file!!!\n", error->error_line);
+            break;
+        }
+        case 3:
+        {
+            printf("Error at line %d: File mustn't have more than one End-Of-File record!!!\n", error->error_line);
+            break;
+        }
+        /* If the error code is not 1, 2, or 3, nothing is printed */
+        default:
+        {
+            printed = 0;
+        }
+    }
+    return printed;
+}
+
+/**
+ * @brief This function prints the statistics of the context to the standard error.
+ *
+ * The statistics are only collected in a build with HEX_STATISTICS set to 1, otherwise a warning is printed.
+ *
+ * @param context The context of the files checked.
+ * @param format The format of the statistics.
+ */
+static void printStatistics(const HexContext_t *context, StatisticsFormat_t format)
+{
+#if HEX_STATISTICS
+    OutputWriter_t output;          /* Declaring the writer of the statistics */
+
+    openOutputWriter(&output, stderr);
+    writeHexStatistics(&output, &(context->statistics), format);
+    flushOutputWriter(&output);
+#else
+    (void)context;
+    (void)format;
+    fprintf(stderr, "Warning: The statistics aren't part of this build, build it with HEX_STATISTICS=1.\n");
+#endif
+}
+
+/**
+ * @brief This function prints the start address of a valid file, if it has one.
+ *
+ * The start address of a start segment address record (03) is printed as CS:IP, the one of a start linear address
+ * record (05) as EIP.
+ *
+ * @param report The report of the validation of the file.
+ */
+static void printStartAddress(const FileReport_t *report)
+{
+    if (report->start_record_type == 0x03)
+    {
+        printf("--> START ADDRESS (CS:IP): %04X:%04X.\n\n", report->start_address >> 16, report->start_address & 0xFFFF);
+    }
+    else if (report->start_record_type == 0x05)
+    {
+        printf("--> START ADDRESS (EIP): %08X.\n\n", report->start_address);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function writes the memory image of the Intel Hex file to a binary file.
+ *
+ * The binary file is only kept if the file is valid, the error is printed like checkFile does otherwise.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param binary_path The path of the binary file.
+ * @param options The fill value and the range of the conversion.
+ * @return 1 if the binary file is written, 0 otherwise.
+ */
+static int8_t convertToBinary(HexContext_t *context, const char *path, const char *binary_path,
+                              const BinaryOptions_t *options)
+{
+    int32_t result = 3;          /* The result of the conversion, 3 if the binary file can't be opened */
+    uint64_t size = 0;           /* The number of bytes of the binary file */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+
+    /* Open the binary file in update mode, the blocks written are read back when a record changes them again */
+    FILE *output = fopen(binary_path, "w+b");
+
+    if (output == NULL)
+    {
+        printf("Error: Can not open the binary file.\n");
+    }
+    else
+    {
+        result = convertIntelHexToBinary(context, path, output, options, &file_report, &size);
+        fclose(output);
+        if (result == 3)
+        {
+            printf("Error: Can not open file or write the binary file.\n");
+        }
+        else if (result == 4)
+        {
+            printf("Error: Not enough memory for the binary file.\n");
+        }
+        else if (result == 5)
+        {
+            printf("Error: A data record crosses the end of the 4 GiB address space.\n");
+        }
+        else if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+        {
+            printf("\n--> STOP CHECKING THE FILE BECAUSE FILE'S FORMAT IS NOT VALID . . . \n");
+        }
+        else
+        {
+            printf("--> BINARY FILE WRITTEN TO %s (%llu BYTES).\n", binary_path, (unsigned long long)size);
+        }
+        /* The binary file of an invalid file is removed */
+        if (result != 0)
+        {
+            remove(binary_path);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    return (result == 0);
+}
+
+/**
+ * @brief This function writes the Intel Hex file again to the standard output as normalized Intel Hex.
+ *
+ * Nothing is written if the file isn't valid, the error is printed to the standard error like exportFile does.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param record_size The number of data bytes of a record.
+ * @return 1 if the file is written, 0 otherwise.
+ */
+static int8_t normalizeFile(HexContext_t *context, const char *path, uint32_t record_size)
+{
+    int32_t result = 0;          /* The result of the conversion */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+
+    result = normalizeIntelHexFile(context, path, context->output, record_size, &file_report);
+    if (result == 3)
+    {
+        fprintf(stderr, "Error: Can not open file.\n");
+    }
+    else if (result == 1)
+    {
+        fprintf(stderr, "Error at line %d: Record isn't valid (error code %d).\n",
+                file_report.record_error.error_line, file_report.record_error.error_code);
+    }
+    else if (result == 2)
+    {
+        fprintf(stderr, "Error at line %d: End-Of-File record isn't valid (error code %d).\n",
+                file_report.eof_error.error_line, file_report.eof_error.error_code);
+    }
+    else if (result == 5)
+    {
+        fprintf(stderr, "Error: A data record crosses the end of the 4 GiB address space.\n");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return (result == 0);
+}
+
+/**
+ * @brief This function writes a binary file to the standard output as Intel Hex.
+ *
+ * @param context The context of the file, its writer prints to the standard output.
+ * @param path The path of the binary file.
+ * @param base_address The absolute address of the first byte of the binary file.
+ * @param record_size The number of data bytes of a record.
+ * @return 1 if the Intel Hex file is written, 0 otherwise.
+ */
+static int8_t convertFromBinary(HexContext_t *context, const char *path, uint32_t base_address, uint32_t record_size)
+{
+    int32_t result = 3;          /* The result of the conversion, 3 if the binary file can't be opened */
+
+    /* Open the binary file in binary read mode */
+    FILE *input = fopen(path, "rb");
+
+    if (input == NULL)
+    {
+        fprintf(stderr, "Error: Can not open file.\n");
+    }
+    else
+    {
+        result = convertBinaryToIntelHex(input, context->output, base_address, record_size);
+        if (result != 0)
+        {
+            fprintf(stderr, "Error: Can not read the binary file or it doesn't fit in the 4 GiB address space.\n");
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        fclose(input);
+    }
+    return (result == 0);
+}
+
+/**
+ * @brief This function merges Intel Hex files and writes the merged file to the standard output.
+ *
+ * Nothing is written if a file isn't valid or if two segments write the same addresses,
+ * the errors and the conflicts are printed to the standard error.
+ *
+ * @param context The context of the files, its writer prints to the standard output.
+ * @param paths The paths of the Intel Hex files.
+ * @param path_count The number of files.
+ * @param record_size The number of data bytes of a record.
+ * @return 1 if the merged file is written, 0 otherwise.
+ */
+static int8_t mergeFiles(HexContext_t *context, const char *paths[], uint32_t path_count, uint32_t record_size)
+{
+    int32_t result = 0;                             /* The result of the validation of the files */
+    uint32_t i = 0;                                 /* Loop counter */
+    uint64_t conflict_count = 0;                    /* The number of conflicts of the files */
+    const MergeInput_t *input = NULL;               /* Pointer to the current input file */
+    const MergeConflict_t *conflict = NULL;         /* Pointer to the current conflict */
+
+    HexMerger_t merger;                             /* Declaring the state of the merge */
+    MergeConflict_t conflicts[MAX_MERGE_CONFLICTS]; /* Declaring the conflicts printed */
+
+    result = openHexMerger(&merger, context, paths, path_count);
+    /* Print the error of each file that isn't valid */
+    for (i = 0; i < merger.input_count; i++)
+    {
+        input = &(merger.inputs[i]);
+        if (input->result == 3)
+        {
+            fprintf(stderr, "%s: Error: Can not open file.\n", input->path);
+        }
+        else if (input->result == 4)
+        {
+            fprintf(stderr, "%s: Error: Not enough memory for the segments of the file.\n", input->path);
+        }
+        else if (input->result == 1)
+        {
+            fprintf(stderr, "%s: Error at line %d: Record isn't valid (error code %d).\n", input->path,
+                    input->report.record_error.error_line, input->report.record_error.error_code);
+        }
+        else if (input->result == 2)
+        {
+            fprintf(stderr, "%s: Error at line %d: End-Of-File record isn't valid (error code %d).\n", input->path,
+                    input->report.eof_error.error_line, input->report.eof_error.error_code);
+        }
+        else if (input->result == 5)
+        {
+            fprintf(stderr, "%s: Error at line %u: Data record crosses the end of the 4 GiB address space.\n",
+                    input->path, input->overflow_line);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    /* The files are only merged if they are all valid and don't write the same addresses */
+    if ((result == 4) && (merger.input_count == 0))
+    {
+        fprintf(stderr, "Error: Not enough memory for the files.\n");
+    }
+    else if (result != 0)
+    {
+        fprintf(stderr, "\n--> THE FILES ARE NOT MERGED BECAUSE A FILE IS NOT VALID . . . \n");
+    }
+    else
+    {
+        conflict_count = findMergeConflicts(&merger, conflicts, MAX_MERGE_CONFLICTS);
+        for (i = 0; (i < conflict_count) && (i < MAX_MERGE_CONFLICTS); i++)
+        {
+            conflict = &(conflicts[i]);
+            fprintf(stderr, "Conflict: 0x%08X to 0x%08X written by %s (line %u) and %s (line %u).\n",
+                    conflict->address, (uint32_t)(conflict->address + conflict->size - 1),
+                    merger.inputs[conflict->first_input].path, conflict->first_line,
+                    merger.inputs[conflict->second_input].path, conflict->second_line);
+        }
+        if (conflict_count > 0)
+        {
+            fprintf(stderr, "\n--> %llu CONFLICTS, THE FILES ARE NOT MERGED . . . \n", (unsigned long long)conflict_count);
+        }
+        else
+        {
+            writeMergedIntelHex(&merger, context, context->output, record_size);
+        }
+    }
+    closeHexMerger(&merger);
+    return ((result == 0) && (conflict_count == 0));
+}
+
+/**
+ * @brief This function compares the memory images of two Intel Hex files and prints the ranges that differ.
+ *
+ * At most DEFAULT_MAX_ERRORS ranges are printed, the other ones are only counted. If a file isn't valid,
+ * the error is printed like checkFile does.
+ *
+ * @param context The context of the files.
+ * @param first_path The path of the first Intel Hex file.
+ * @param second_path The path of the second Intel Hex file.
+ * @return 1 if both files are valid and their memory images are the same, 0 otherwise.
+ */
+static int8_t diffFiles(HexContext_t *context, const char *first_path, const char *second_path)
+{
+    int32_t result = 1;             /* The result of the comparison, 1 if a file isn't valid */
+    uint64_t printed = 0;           /* The number of ranges printed */
+
+    MemoryImage_t first;            /* Declaring the memory image of the first file */
+    MemoryImage_t second;           /* Declaring the memory image of the second file */
+    ImageDiffSummary_t summary;     /* Declaring the result of the comparison */
+
+    initMemoryImage(&first);
+    initMemoryImage(&second);
+    if (loadMemoryImage(context, first_path, &first) && loadMemoryImage(context, second_path, &second))
+    {
+        result = compareMemoryImages(&first, &second, printDifference, &printed, &summary);
+        if (result == 5)
+        {
+            printf("Error: A file has overlapping segments, the value of their addresses isn't unique (see --overlaps).\n");
+        }
+        else if (result == 0)
+        {
+            printf("--> THE MEMORY IMAGES ARE THE SAME, %llu BYTES OF DATA.\n", (unsigned long long)summary.equal_bytes);
+        }
+        else
+        {
+            printf("\n--> %llu RANGES DIFFER: %llu BYTES CHANGED, %llu ONLY IN %s, %llu ONLY IN %s, %llu THE SAME.\n",
+                   (unsigned long long)summary.range_count, (unsigned long long)summary.changed_bytes,
+                   (unsigned long long)summary.first_only_bytes, first_path,
+                   (unsigned long long)summary.second_only_bytes, second_path,
+                   (unsigned long long)summary.equal_bytes);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    freeMemoryImage(&first);
+    freeMemoryImage(&second);
+    return (result == 0);
+}
+
+/**
+ * @brief This function builds the memory image of an Intel Hex file and prints its error, if any.
+ *
+ * The error is printed behind the path of the file, like checkFile does.
+ *
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param image The memory image to build, it must be initialized with initMemoryImage.
+ * @return 1 if the image is built, 0 otherwise.
+ */
+static int8_t loadMemoryImage(HexContext_t *context, const char *path, MemoryImage_t *image)
+{
+    int32_t result = 0;          /* The result of the building of the memory image */
+
+    FileReport_t file_report;    /* Initialize a report structure to store the result of the validation of the file */
+
+    /* Open the Intel Hex file in read mode */
+    FILE *fptr = fopen(path, "r");
+
+    if (fptr == NULL)
+    {
+        printf("%s: Error: Can not open file.\n", path);
+        result = 3;
+    }
+    else
+    {
+        result = buildMemoryImage(context, fptr, image, &file_report);
+        if (result == 4)
+        {
+            printf("%s: Error: Not enough memory for the memory image.\n", path);
+        }
+        else if (result != 0)
+        {
+            printf("%s: ", path);
+            if (printRecordError(&(file_report.record_error)) || printEOFError(&(file_report.eof_error)))
+            {
+                /* Do nothing */
+            }
+            else
+            {
+                printf("Error: File isn't valid.\n");
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Close the file */
+        fclose(fptr);
+    }
+    return (result == 0);
+}
+
+/**
+ * @brief This function prints a range of addresses that differs, it is the visitor of the comparison.
+ *
+ * The range is printed with its first and last address and its size, like the segments of printSegmentList.
+ *
+ * @param visitor_context The number of ranges printed.
+ * @param difference The range that differs.
+ */
+static void printDifference(void *visitor_context, const ImageDifference_t *difference)
+{
+    uint64_t *printed = (uint64_t *)visitor_context;    /* The number of ranges printed */
+
+    if (*printed < DEFAULT_MAX_ERRORS)
+    {
+        if (difference->kind == DIFFERENCE_CHANGED)
+        {
+            printf("Changed:        ");
+        }
+        else if (difference->kind == DIFFERENCE_FIRST_ONLY)
+        {
+            printf("Only in first:  ");
+        }
+        else
+        {
+            printf("Only in second: ");
+        }
+        printf("%08X - %08X (%llu bytes)\n", difference->address, (uint32_t)(difference->address + difference->size - 1),
+               (unsigned long long)difference->size);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    *printed += 1;
+}
+
+/**
+ * @brief This function reads the number of an option.
+ *
+ * strtoul alone takes an empty text as 0, skips spaces and a sign and stops at the first wrong character,
+ * so the first character must be a digit and the end is checked, "--threads=4x" isn't taken as 4 threads.
+ *
+ * @param text The text of the number.
+ * @param base The base of the number, 10 or 16.
+ * @param maximum The largest accepted value.
+ * @param value Pointer to store the number.
+ * @param end Pointer to store the end of the number, NULL if the number must be the whole text.
+ * @return 1 if the text starts with a number not larger than maximum, 0 otherwise.
+ */
+static int8_t readNumber(const char *text, int32_t base, uint32_t maximum, uint32_t *value, char **end)
+{
+    int8_t valid = 0;                   /* Initialize the result */
+    unsigned long number = 0;           /* The number read */
+    char *number_end = NULL;            /* The end of the number */
+
+    if ((base == 16) ? isxdigit((unsigned char)text[0]) : isdigit((unsigned char)text[0]))
+    {
+        errno = 0;
+        number = strtoul(text, &number_end, (int)base);
+        valid = (errno == 0) && (number <= maximum) && ((end != NULL) || (*number_end == '\0'));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (valid)
+    {
+        *value = (uint32_t)number;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (end != NULL)
+    {
+        *end = number_end;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return valid;
+} /* EOF */
 
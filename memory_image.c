@@ -0,0 +1,515 @@
+/**
+ * @file memory_image.c
+ * @brief This file contains the implementation of the memory image builder functions.
+ *
+ * The memory image builder resolves all data records of a valid Intel Hex file into a sparse memory image.
+ * The records are given by the single-pass validation of the Intel Hex file analyzer, each data record
+ * extends the last segment or starts a new one. The segments are sorted and coalesced at the end
+ * only if the records aren't in address order.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "memory_image.h"    /* Include header file of this function file */
+#include <stdlib.h>          /* For malloc(), realloc(), free(), qsort() functions */
+#include <string.h>          /* For memcpy() function */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MEMORY_IMAGE_MIN_SEGMENTS   64            /* The number of segments of the first allocation */
+#define MEMORY_IMAGE_MIN_DATA       (64 * 1024)   /* The number of bytes of the first allocation of the data pool */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of the building of a memory image.
+ */
+typedef struct
+{
+    MemoryImage_t *image;       /* The memory image being built */
+    int8_t sorted;              /* 1 while the segments are sorted by address and don't overlap */
+    int8_t out_of_memory;       /* 1 if an allocation failed */
+} ImageBuilder_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief This function starts the building of a memory image.
+ *
+ * @param builder The state of the building.
+ * @param image The memory image to build.
+ */
+static void startImageBuilder(ImageBuilder_t *builder, MemoryImage_t *image);
+
+/**
+ * @brief This function adds the data of a valid record to the memory image, it is the visitor of the validation.
+ *
+ * @param context The state of the building.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void addRecord(void *context, const IntelHexRecord_t *record, uint32_t absolute_address, uint32_t line_number);
+
+/**
+ * @brief This function makes sure the data pool of the memory image can hold more bytes.
+ *
+ * @param image The memory image.
+ * @param byte_count The number of bytes to add to the data pool.
+ * @return 1 if the data pool is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveData(MemoryImage_t *image, uint32_t byte_count);
+
+/**
+ * @brief This function makes sure the memory image can hold one more segment.
+ *
+ * @param image The memory image.
+ * @return 1 if the array of segments is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveSegment(MemoryImage_t *image);
+
+/**
+ * @brief This function compares two segments by address, then by position in the file.
+ *
+ * @param first The first segment.
+ * @param second The second segment.
+ * @return A negative value, 0 or a positive value if the first segment is before, same as or after the second one.
+ */
+static int compareSegments(const void *first, const void *second);
+
+/**
+ * @brief This function sorts the segments by address and coalesces the adjacent segments.
+ *
+ * The data pool is rebuilt in the order of the sorted segments, so adjacent segments are also adjacent in the pool.
+ *
+ * @param image The memory image.
+ * @return 1 if the segments are sorted, 0 if there isn't enough memory.
+ */
+static int8_t sortSegments(MemoryImage_t *image);
+
+/**
+ * @brief This function finishes the building of a memory image.
+ *
+ * @param builder The state of the building.
+ * @param result The result of the validation of the file.
+ * @return The result of the building (same values as buildMemoryImage).
+ */
+static int32_t finishImageBuilder(ImageBuilder_t *builder, int32_t result);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function initializes an empty memory image.
+ *
+ * @param image The memory image to initialize.
+ */
+void initMemoryImage(MemoryImage_t *image)
+{
+    image->segments = NULL;
+    image->segment_count = 0;
+    image->segment_capacity = 0;
+    image->data = NULL;
+    image->data_size = 0;
+    image->data_capacity = 0;
+    image->overlap_count = 0;
+}
+
+/**
+ * @brief This function validates the Intel Hex file and builds its memory image in a single pass.
+ *
+ * The absolute address of each data record is resolved with the extended segment (02) and extended linear (04)
+ * address records. A data record that starts at the end of the previous segment extends it, so the arrays
+ * of the image only grow geometrically and no memory is allocated for each record.
+ * The segments are sorted by address at the end, this only costs time if the records aren't in address order.
+ * The image is only complete if the function returns 0, it must be released with freeMemoryImage.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param image The memory image to build, it must be initialized with initMemoryImage.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the image is built, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the image.
+ */
+int32_t buildMemoryImage(HexContext_t *context, FILE *fptr, MemoryImage_t *image, FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    ImageBuilder_t builder;         /* Declaring the state of the building */
+
+    startImageBuilder(&builder, image);
+    /* Validate the file and add each valid record to the image */
+    result = visitIntelHexFile(context, fptr, addRecord, &builder, report);
+    /* Return the result of the building */
+    return finishImageBuilder(&builder, result);
+}
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and builds its memory image in a single pass.
+ *
+ * The function does the same as buildMemoryImage on a file stored in memory (a buffer or a memory-mapped file).
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param image The memory image to build, it must be initialized with initMemoryImage.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the image is built, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the image.
+ */
+int32_t buildMemoryImageFromBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, MemoryImage_t *image,
+                                   FileReport_t *report)
+{
+    int32_t result = 0;             /* Initialize the result of the validation */
+
+    ImageBuilder_t builder;         /* Declaring the state of the building */
+
+    startImageBuilder(&builder, image);
+    /* Validate the file and add each valid record to the image */
+    result = visitIntelHexBuffer(context, buffer, size, addRecord, &builder, report);
+    /* Return the result of the building */
+    return finishImageBuilder(&builder, result);
+}
+
+/**
+ * @brief This function releases the memory of a memory image and makes it empty.
+ *
+ * @param image The memory image to release.
+ */
+void freeMemoryImage(MemoryImage_t *image)
+{
+    free(image->segments);
+    free(image->data);
+    initMemoryImage(image);
+}
+
+/**
+ * @brief This function starts the building of a memory image.
+ *
+ * @param builder The state of the building.
+ * @param image The memory image to build.
+ */
+static void startImageBuilder(ImageBuilder_t *builder, MemoryImage_t *image)
+{
+    /* The image is built again from an empty image, the allocated memory is reused */
+    image->segment_count = 0;
+    image->data_size = 0;
+    image->overlap_count = 0;
+    builder->image = image;
+    builder->sorted = 1;
+    builder->out_of_memory = 0;
+}
+
+/**
+ * @brief This function adds the data of a valid record to the memory image, it is the visitor of the validation.
+ *
+ * A data record that starts at the end of the last segment extends it, any other data record starts a new segment.
+ *
+ * @param context The state of the building.
+ * @param record The valid record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param line_number The line number of the record.
+ */
+static void addRecord(void *context, const IntelHexRecord_t *record, uint32_t absolute_address, uint32_t line_number)
+{
+    ImageBuilder_t *builder = (ImageBuilder_t *)context;    /* The state of the building */
+    MemoryImage_t *image = builder->image;                  /* The memory image being built */
+    MemorySegment_t *last = NULL;                           /* The last segment of the image */
+    uint64_t last_end = 0;                                  /* The address after the last segment */
+
+    (void)line_number;
+    /* Only data records with data bytes are added */
+    if ((record->record_type == 0x00) && (record->byte_count > 0) && !builder->out_of_memory)
+    {
+        if (image->segment_count > 0)
+        {
+            last = &(image->segments[image->segment_count - 1]);
+            last_end = (uint64_t)last->address + last->size;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        if (!reserveData(image, record->byte_count))
+        {
+            builder->out_of_memory = 1;
+        }
+        /* Check if the record extends the last segment */
+        else if ((last != NULL) && (last_end == absolute_address) &&
+                 ((uint64_t)last->size + record->byte_count <= 0xFFFFFFFFU))
+        {
+            last->size += record->byte_count;
+        }
+        else if (!reserveSegment(image))
+        {
+            builder->out_of_memory = 1;
+        }
+        /* Start a new segment */
+        else
+        {
+            /* If the record is before the end of the last segment, the segments must be sorted at the end */
+            if ((last != NULL) && (absolute_address < last_end))
+            {
+                builder->sorted = 0;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            image->segments[image->segment_count].address = absolute_address;
+            image->segments[image->segment_count].size = record->byte_count;
+            image->segments[image->segment_count].data_offset = image->data_size;
+            image->segment_count += 1;
+        }
+
+        /* Copy the data of the record to the data pool */
+        if (!builder->out_of_memory)
+        {
+            memcpy(image->data + image->data_size, record->data, record->byte_count);
+            image->data_size += record->byte_count;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function makes sure the data pool of the memory image can hold more bytes.
+ *
+ * The capacity of the data pool is doubled, so adding n bytes costs O(n) time in total.
+ *
+ * @param image The memory image.
+ * @param byte_count The number of bytes to add to the data pool.
+ * @return 1 if the data pool is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveData(MemoryImage_t *image, uint32_t byte_count)
+{
+    int8_t reserved = 1;                            /* Initialize the result */
+    uint64_t capacity = image->data_capacity;       /* The new capacity of the data pool */
+    uint8_t *data = NULL;                           /* The new data pool */
+
+    if (image->data_size + byte_count > image->data_capacity)
+    {
+        if (capacity < MEMORY_IMAGE_MIN_DATA)
+        {
+            capacity = MEMORY_IMAGE_MIN_DATA;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        while (image->data_size + byte_count > capacity)
+        {
+            capacity *= 2;
+        }
+        data = (uint8_t *)(((size_t)capacity == capacity) ? realloc(image->data, (size_t)capacity) : NULL);
+        if (data == NULL)
+        {
+            reserved = 0;
+        }
+        else
+        {
+            image->data = data;
+            image->data_capacity = capacity;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return reserved;
+}
+
+/**
+ * @brief This function makes sure the memory image can hold one more segment.
+ *
+ * The capacity of the array of segments is doubled, so adding n segments costs O(n) time in total.
+ *
+ * @param image The memory image.
+ * @return 1 if the array of segments is large enough, 0 if there isn't enough memory.
+ */
+static int8_t reserveSegment(MemoryImage_t *image)
+{
+    int8_t reserved = 1;                            /* Initialize the result */
+    uint64_t capacity = image->segment_capacity;    /* The new capacity of the array of segments */
+    MemorySegment_t *segments = NULL;               /* The new array of segments */
+
+    if (image->segment_count == image->segment_capacity)
+    {
+        capacity = (capacity < MEMORY_IMAGE_MIN_SEGMENTS) ? MEMORY_IMAGE_MIN_SEGMENTS : capacity * 2;
+        if (capacity > 0xFFFFFFFFU)
+        {
+            capacity = 0xFFFFFFFFU;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (capacity > image->segment_count)
+        {
+            segments = (MemorySegment_t *)realloc(image->segments, (size_t)capacity * sizeof(MemorySegment_t));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (segments == NULL)
+        {
+            reserved = 0;
+        }
+        else
+        {
+            image->segments = segments;
+            image->segment_capacity = (uint32_t)capacity;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return reserved;
+}
+
+/**
+ * @brief This function compares two segments by address, then by position in the file.
+ *
+ * The data offset of a segment grows with its position in the file, so the sort keeps overlapping
+ * segments in the order of the file.
+ *
+ * @param first The first segment.
+ * @param second The second segment.
+ * @return A negative value, 0 or a positive value if the first segment is before, same as or after the second one.
+ */
+static int compareSegments(const void *first, const void *second)
+{
+    const MemorySegment_t *a = (const MemorySegment_t *)first;      /* The first segment */
+    const MemorySegment_t *b = (const MemorySegment_t *)second;     /* The second segment */
+    int result = 0;                                                 /* Initialize the result of the comparison */
+
+    if (a->address != b->address)
+    {
+        result = (a->address < b->address) ? -1 : 1;
+    }
+    else if (a->data_offset != b->data_offset)
+    {
+        result = (a->data_offset < b->data_offset) ? -1 : 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+}
+
+/**
+ * @brief This function sorts the segments by address and coalesces the adjacent segments.
+ *
+ * The data pool is rebuilt in the order of the sorted segments, so adjacent segments are also adjacent in the pool.
+ * A segment that starts before the end of a previous segment overlaps it, it is kept and counted.
+ *
+ * @param image The memory image.
+ * @return 1 if the segments are sorted, 0 if there isn't enough memory.
+ */
+static int8_t sortSegments(MemoryImage_t *image)
+{
+    int8_t sorted = 1;                  /* Initialize the result */
+    uint32_t i = 0;                     /* Loop counter */
+    uint32_t count = 0;                 /* The number of segments after the coalescing */
+    uint64_t offset = 0;                /* The offset of the next segment in the new data pool */
+    uint64_t last_end = 0;              /* The address after the last kept segment */
+    uint64_t highest_end = 0;           /* The highest address after all kept segments */
+    uint8_t *data = NULL;               /* The new data pool */
+
+    qsort(image->segments, image->segment_count, sizeof(MemorySegment_t), compareSegments);
+    data = (uint8_t *)malloc((image->data_size > 0) ? (size_t)image->data_size : 1);
+    if (data == NULL)
+    {
+        sorted = 0;
+    }
+    else
+    {
+        for (i = 0; i < image->segment_count; i++)
+        {
+            /* Copy the data of the segment to the new data pool */
+            memcpy(data + offset, image->data + image->segments[i].data_offset, image->segments[i].size);
+            image->segments[i].data_offset = offset;
+            offset += image->segments[i].size;
+
+            /* Coalesce the segment with the last kept segment if they are adjacent */
+            if ((count > 0) && (image->segments[i].address == last_end) &&
+                ((uint64_t)image->segments[count - 1].size + image->segments[i].size <= 0xFFFFFFFFU))
+            {
+                image->segments[count - 1].size += image->segments[i].size;
+            }
+            else
+            {
+                /* Count the segment if it overlaps a kept segment */
+                if ((count > 0) && (image->segments[i].address < highest_end))
+                {
+                    image->overlap_count += 1;
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+                image->segments[count] = image->segments[i];
+                count += 1;
+            }
+            last_end = (uint64_t)image->segments[count - 1].address + image->segments[count - 1].size;
+            if (last_end > highest_end)
+            {
+                highest_end = last_end;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        image->segment_count = count;
+        /* Replace the data pool */
+        free(image->data);
+        image->data = data;
+        image->data_capacity = (image->data_size > 0) ? image->data_size : 1;
+    }
+    return sorted;
+}
+
+/**
+ * @brief This function finishes the building of a memory image.
+ *
+ * @param builder The state of the building.
+ * @param result The result of the validation of the file.
+ * @return The result of the building (same values as buildMemoryImage).
+ */
+static int32_t finishImageBuilder(ImageBuilder_t *builder, int32_t result)
+{
+    /* An allocation failure is reported before the result of the validation */
+    if (builder->out_of_memory)
+    {
+        result = 4;
+    }
+    /* Sort the segments only if the records aren't in address order */
+    else if (!builder->sorted && !sortSegments(builder->image))
+    {
+        result = 4;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return result;
+} /* EOF */
+
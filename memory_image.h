@@ -0,0 +1,110 @@
+/**
+ * @file memory_image.h
+ * @brief This file contains the prototypes of the memory image builder functions.
+ *
+ * The memory image builder resolves all data records of a valid Intel Hex file into a sparse memory image.
+ * The image is a list of contiguous segments sorted by address, the data of adjacent records is coalesced
+ * into one segment and all data bytes are stored in one pool, so a flasher can use the image directly.
+ * Functions buildMemoryImage and buildMemoryImageFromBuffer build the image in a single pass over the file.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef MEMORY_IMAGE_H
+#define MEMORY_IMAGE_H
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold one contiguous segment of a memory image.
+ *
+ * The data of the segment is stored at data_offset in the data pool of the image.
+ */
+typedef struct
+{
+    uint32_t address;       /* The absolute memory address of the first byte of the segment */
+    uint32_t size;          /* The number of bytes of the segment */
+    uint64_t data_offset;   /* The offset of the first byte of the segment in the data pool */
+} MemorySegment_t;
+
+/**
+ * @brief Structure to hold a sparse memory image.
+ *
+ * The segments are sorted by address. Segments that overlap each other aren't merged, they are kept
+ * in the order of the file and counted in overlap_count.
+ */
+typedef struct
+{
+    MemorySegment_t *segments;  /* The segments of the image */
+    uint32_t segment_count;     /* The number of segments */
+    uint32_t segment_capacity;  /* The number of segments that fit in the allocated array */
+    uint8_t *data;              /* The data pool holding the bytes of all segments */
+    uint64_t data_size;         /* The number of bytes in the data pool */
+    uint64_t data_capacity;     /* The number of bytes that fit in the allocated data pool */
+    uint32_t overlap_count;     /* The number of segments that overlap the previous segment */
+} MemoryImage_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function initializes an empty memory image.
+ *
+ * @param image The memory image to initialize.
+ */
+void initMemoryImage(MemoryImage_t *image);
+
+/**
+ * @brief This function validates the Intel Hex file and builds its memory image in a single pass.
+ *
+ * The absolute address of each data record is resolved with the extended segment (02) and extended linear (04)
+ * address records. A data record that starts at the end of the previous segment extends it, so the arrays
+ * of the image only grow geometrically and no memory is allocated for each record.
+ * The segments are sorted by address at the end, this only costs time if the records aren't in address order.
+ * The image is only complete if the function returns 0, it must be released with freeMemoryImage.
+ *
+ * @param context The context of the file.
+ * @param fptr The file pointer to the Intel Hex file.
+ * @param image The memory image to build, it must be initialized with initMemoryImage.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the image is built, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the image.
+ */
+int32_t buildMemoryImage(HexContext_t *context, FILE *fptr, MemoryImage_t *image, FileReport_t *report);
+
+/**
+ * @brief This function validates an Intel Hex file stored in memory and builds its memory image in a single pass.
+ *
+ * The function does the same as buildMemoryImage on a file stored in memory (a buffer or a memory-mapped file).
+ *
+ * @param context The context of the file.
+ * @param buffer The content of the Intel Hex file.
+ * @param size The number of characters in the buffer.
+ * @param image The memory image to build, it must be initialized with initMemoryImage.
+ * @param report The report structure to store the result of the validation.
+ * @return 0 if the image is built, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         4 if there isn't enough memory for the image.
+ */
+int32_t buildMemoryImageFromBuffer(HexContext_t *context, const int8_t buffer[], uint64_t size, MemoryImage_t *image,
+                                   FileReport_t *report);
+
+/**
+ * @brief This function releases the memory of a memory image and makes it empty.
+ *
+ * @param image The memory image to release.
+ */
+void freeMemoryImage(MemoryImage_t *image);
+
+#endif /* MEMORY_IMAGE_H */
+
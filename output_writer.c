@@ -0,0 +1,200 @@
+/**
+ * @file output_writer.c
+ * @brief This file contains the implementation of the output writer functions.
+ *
+ * The output writer collects the text in a buffer and writes it with one fwrite call when the buffer is full
+ * or when it is flushed. Numbers are formatted with lookup tables instead of printf.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "output_writer.h"   /* Include header file of this function file */
+#include <string.h>          /* For memcpy(), strlen() functions */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define OUTPUT_WRITER_NUMBER_SIZE 24    /* Enough characters for the longest decimal or hexadecimal number */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const int8_t hex_digits[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function starts writing text to a stream.
+ *
+ * @param writer The output writer.
+ * @param stream The stream the text is written to.
+ */
+void openOutputWriter(OutputWriter_t *writer, FILE *stream)
+{
+    writer->stream = stream;
+    writer->length = 0;
+}
+
+/**
+ * @brief This function writes characters.
+ *
+ * The characters are copied to the buffer, the buffer is written to the stream each time it is full.
+ *
+ * @param writer The output writer.
+ * @param text The characters to write, they don't need a null terminator.
+ * @param length The number of characters.
+ */
+void writeText(OutputWriter_t *writer, const int8_t text[], uint32_t length)
+{
+    uint32_t copied = 0;            /* The number of characters copied at once */
+
+    while (length > 0)
+    {
+        /* Write the buffer to the stream if it is full */
+        if (writer->length == OUTPUT_WRITER_BUFFER_SIZE)
+        {
+            flushOutputWriter(writer);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        copied = OUTPUT_WRITER_BUFFER_SIZE - writer->length;
+        if (copied > length)
+        {
+            copied = length;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        memcpy(writer->buffer + writer->length, text, copied);
+        writer->length += copied;
+        text += copied;
+        length -= copied;
+    }
+}
+
+/**
+ * @brief This function writes a null-terminated string.
+ *
+ * @param writer The output writer.
+ * @param text The string to write.
+ */
+void writeString(OutputWriter_t *writer, const char *text)
+{
+    writeText(writer, (const int8_t *)text, (uint32_t)strlen(text));
+}
+
+/**
+ * @brief This function writes a signed decimal number, like printf with %d.
+ *
+ * @param writer The output writer.
+ * @param value The number to write.
+ */
+void writeDecimal(OutputWriter_t *writer, int64_t value)
+{
+    int8_t text[OUTPUT_WRITER_NUMBER_SIZE];         /* The characters of the number, written from the end */
+    uint32_t begin = OUTPUT_WRITER_NUMBER_SIZE;     /* Position of the first character of the number */
+    uint64_t magnitude = (value < 0) ? (0 - (uint64_t)value) : (uint64_t)value;   /* The absolute value of the number */
+
+    do
+    {
+        begin -= 1;
+        text[begin] = (int8_t)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0)
+    {
+        begin -= 1;
+        text[begin] = '-';
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    writeText(writer, text + begin, OUTPUT_WRITER_NUMBER_SIZE - begin);
+}
+
+/**
+ * @brief This function writes an upper-case hexadecimal number with at least a number of digits, like printf with %0NX.
+ *
+ * @param writer The output writer.
+ * @param value The number to write.
+ * @param digits The minimum number of digits, the number is padded with zeros.
+ */
+void writeHex(OutputWriter_t *writer, uint32_t value, uint32_t digits)
+{
+    int8_t text[OUTPUT_WRITER_NUMBER_SIZE];         /* The characters of the number, written from the end */
+    uint32_t begin = OUTPUT_WRITER_NUMBER_SIZE;     /* Position of the first character of the number */
+
+    if (digits > 8)
+    {
+        digits = 8;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    do
+    {
+        begin -= 1;
+        text[begin] = hex_digits[value & 0x0F];
+        value >>= 4;
+    } while ((value > 0) || (OUTPUT_WRITER_NUMBER_SIZE - begin < digits));
+    writeText(writer, text + begin, OUTPUT_WRITER_NUMBER_SIZE - begin);
+}
+
+/**
+ * @brief This function writes bytes as upper-case hexadecimal digits, two digits for each byte.
+ *
+ * @param writer The output writer.
+ * @param data The bytes to write.
+ * @param byte_count The number of bytes.
+ */
+void writeHexBytes(OutputWriter_t *writer, const uint8_t data[], uint32_t byte_count)
+{
+    uint32_t i = 0;                 /* Loop counter */
+
+    for (i = 0; i < byte_count; i++)
+    {
+        /* Write the buffer to the stream if there is no room for two characters */
+        if (writer->length + 2 > OUTPUT_WRITER_BUFFER_SIZE)
+        {
+            flushOutputWriter(writer);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        writer->buffer[writer->length] = hex_digits[data[i] >> 4];
+        writer->buffer[writer->length + 1] = hex_digits[data[i] & 0x0F];
+        writer->length += 2;
+    }
+}
+
+/**
+ * @brief This function writes the text of the buffer to the stream.
+ *
+ * It must be called after the last write, the buffer is also written when it is full.
+ *
+ * @param writer The output writer.
+ */
+void flushOutputWriter(OutputWriter_t *writer)
+{
+    if (writer->length > 0)
+    {
+        fwrite(writer->buffer, 1, writer->length, writer->stream);
+        writer->length = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+} /* EOF */
+
@@ -0,0 +1,107 @@
+/**
+ * @file output_writer.h
+ * @brief This file contains the prototypes of the output writer functions.
+ *
+ * The output writer collects the text printed by the upper layers in a large buffer and writes it
+ * to the output stream in big blocks, so printing a large file doesn't call printf for each field.
+ * It provides functions to write text, decimal numbers and hexadecimal numbers with a formatter
+ * that gives the same characters as printf with %d, %0NX and %02X.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for FILE, fwrite, ... */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define OUTPUT_WRITER_BUFFER_SIZE (64 * 1024)   /* Size of the buffer, the text is written to the stream in blocks of this size */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the state of an output writer.
+ */
+typedef struct
+{
+    FILE *stream;                                   /* The stream the text is written to */
+    uint32_t length;                                /* The number of characters in the buffer */
+    int8_t buffer[OUTPUT_WRITER_BUFFER_SIZE];       /* The buffer of the text not written yet */
+} OutputWriter_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function starts writing text to a stream.
+ *
+ * @param writer The output writer.
+ * @param stream The stream the text is written to.
+ */
+void openOutputWriter(OutputWriter_t *writer, FILE *stream);
+
+/**
+ * @brief This function writes characters.
+ *
+ * @param writer The output writer.
+ * @param text The characters to write, they don't need a null terminator.
+ * @param length The number of characters.
+ */
+void writeText(OutputWriter_t *writer, const int8_t text[], uint32_t length);
+
+/**
+ * @brief This function writes a null-terminated string.
+ *
+ * @param writer The output writer.
+ * @param text The string to write.
+ */
+void writeString(OutputWriter_t *writer, const char *text);
+
+/**
+ * @brief This function writes a signed decimal number, like printf with %d.
+ *
+ * @param writer The output writer.
+ * @param value The number to write.
+ */
+void writeDecimal(OutputWriter_t *writer, int64_t value);
+
+/**
+ * @brief This function writes an upper-case hexadecimal number with at least a number of digits, like printf with %0NX.
+ *
+ * @param writer The output writer.
+ * @param value The number to write.
+ * @param digits The minimum number of digits, the number is padded with zeros.
+ */
+void writeHex(OutputWriter_t *writer, uint32_t value, uint32_t digits);
+
+/**
+ * @brief This function writes bytes as upper-case hexadecimal digits, two digits for each byte.
+ *
+ * @param writer The output writer.
+ * @param data The bytes to write.
+ * @param byte_count The number of bytes.
+ */
+void writeHexBytes(OutputWriter_t *writer, const uint8_t data[], uint32_t byte_count);
+
+/**
+ * @brief This function writes the text of the buffer to the stream.
+ *
+ * It must be called after the last write, the buffer is also written when it is full.
+ *
+ * @param writer The output writer.
+ */
+void flushOutputWriter(OutputWriter_t *writer);
+
+#endif /* OUTPUT_WRITER_H */
+
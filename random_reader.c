@@ -0,0 +1,218 @@
+/**
+ * @file random_reader.c
+ * @brief This file contains the implementation of the random reader functions.
+ *
+ * The reads don't use a file position, several reads of the same open file never disturb each other.
+ * A read is repeated until all bytes are read, because pread may return fewer bytes than asked.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "random_reader.h"      /* Include header file of this function file */
+#include <stddef.h>             /* For NULL */
+
+#if defined(_WIN32)
+#include <windows.h>            /* For CreateFile(), ReadFile(), GetFileTime() functions */
+#else
+#include <fcntl.h>              /* For open() function */
+#include <sys/stat.h>           /* For fstat() function */
+#include <unistd.h>             /* For pread(), close() functions */
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#if defined(_WIN32)
+/**
+ * @brief This function opens a file for random reads.
+ *
+ * The size and the modification time of the file are stored in the reader.
+ *
+ * @param reader The structure to store the open file.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened.
+ */
+int32_t openRandomReader(RandomReader_t *reader, const char *path)
+{
+    int32_t error_code = 0;                 /* Error code, initialized to 0 */
+    HANDLE file_handle = INVALID_HANDLE_VALUE;  /* Handle of the opened file */
+    LARGE_INTEGER file_size;                /* Size of the file */
+    FILETIME write_time;                    /* Time of the last modification of the file */
+
+    reader->handle = NULL;
+    reader->descriptor = -1;
+    reader->size = 0;
+    reader->time = 0;
+
+    /* Open the file with a hint for random access */
+    file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if ((file_handle == INVALID_HANDLE_VALUE) || !GetFileSizeEx(file_handle, &file_size) ||
+        !GetFileTime(file_handle, NULL, NULL, &write_time))
+    {
+        error_code = 1;
+        if (file_handle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file_handle);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        reader->handle = (void *)file_handle;
+        reader->size = (uint64_t)file_size.QuadPart;
+        reader->time = ((uint64_t)write_time.dwHighDateTime << 32) | write_time.dwLowDateTime;
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function reads bytes at an offset of the file.
+ *
+ * @param reader The open file.
+ * @param offset The byte offset of the first byte to read.
+ * @param buffer The buffer to store the bytes.
+ * @param size The number of bytes to read.
+ * @return The number of bytes read, less than size at the end of the file or if the read fails.
+ */
+uint32_t readFileAt(RandomReader_t *reader, uint64_t offset, int8_t buffer[], uint32_t size)
+{
+    uint32_t total = 0;             /* The number of bytes read */
+    DWORD count = 1;                /* The number of bytes of one read */
+    OVERLAPPED position;            /* The offset of one read */
+
+    while ((total < size) && (count > 0))
+    {
+        /* The offset is given with each read, the file position isn't used */
+        ZeroMemory(&position, sizeof(OVERLAPPED));
+        position.Offset = (DWORD)((offset + total) & 0xFFFFFFFFU);
+        position.OffsetHigh = (DWORD)((offset + total) >> 32);
+        if (!ReadFile((HANDLE)reader->handle, buffer + total, size - total, &count, &position))
+        {
+            count = 0;
+        }
+        else
+        {
+            total += count;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief This function closes a file open for random reads.
+ *
+ * @param reader The open file.
+ */
+void closeRandomReader(RandomReader_t *reader)
+{
+    if (reader->handle != NULL)
+    {
+        CloseHandle((HANDLE)reader->handle);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    reader->handle = NULL;
+}
+#else
+/**
+ * @brief This function opens a file for random reads.
+ *
+ * The size and the modification time of the file are stored in the reader.
+ *
+ * @param reader The structure to store the open file.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened.
+ */
+int32_t openRandomReader(RandomReader_t *reader, const char *path)
+{
+    int32_t error_code = 0;     /* Error code, initialized to 0 */
+    struct stat file_status;    /* Status of the file, to get its size and modification time */
+
+    reader->handle = NULL;
+    reader->size = 0;
+    reader->time = 0;
+
+    reader->descriptor = open(path, O_RDONLY);
+    if ((reader->descriptor < 0) || (fstat(reader->descriptor, &file_status) != 0))
+    {
+        error_code = 1;
+        if (reader->descriptor >= 0)
+        {
+            close(reader->descriptor);
+            reader->descriptor = -1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        reader->size = (uint64_t)file_status.st_size;
+        /* The nanoseconds are kept, a file rewritten within the same second must get another time */
+#if defined(__APPLE__)
+        reader->time = ((uint64_t)file_status.st_mtime * 1000000000ULL) + (uint64_t)file_status.st_mtimespec.tv_nsec;
+#else
+        reader->time = ((uint64_t)file_status.st_mtime * 1000000000ULL) + (uint64_t)file_status.st_mtim.tv_nsec;
+#endif
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function reads bytes at an offset of the file.
+ *
+ * @param reader The open file.
+ * @param offset The byte offset of the first byte to read.
+ * @param buffer The buffer to store the bytes.
+ * @param size The number of bytes to read.
+ * @return The number of bytes read, less than size at the end of the file or if the read fails.
+ */
+uint32_t readFileAt(RandomReader_t *reader, uint64_t offset, int8_t buffer[], uint32_t size)
+{
+    uint32_t total = 0;             /* The number of bytes read */
+    ssize_t count = 1;              /* The number of bytes of one read */
+
+    while ((total < size) && (count > 0))
+    {
+        count = pread(reader->descriptor, buffer + total, size - total, (off_t)(offset + total));
+        if (count > 0)
+        {
+            total += (uint32_t)count;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief This function closes a file open for random reads.
+ *
+ * @param reader The open file.
+ */
+void closeRandomReader(RandomReader_t *reader)
+{
+    if (reader->descriptor >= 0)
+    {
+        close(reader->descriptor);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    reader->descriptor = -1;
+}
+#endif /* EOF */
@@ -0,0 +1,70 @@
+/**
+ * @file random_reader.h
+ * @brief This file contains the prototypes of the random reader functions.
+ *
+ * The random reader reads bytes at any offset of a file without changing a file position, like pread,
+ * so a few bytes of a large file can be read without reading the bytes in front of them.
+ * It uses pread on POSIX systems and ReadFile with an offset on Windows.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef RANDOM_READER_H
+#define RANDOM_READER_H
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold a file open for random reads.
+ */
+typedef struct
+{
+    void *handle;           /* The file handle of the operating system (Windows only) */
+    int32_t descriptor;     /* The file descriptor (POSIX only) */
+    uint64_t size;          /* The number of bytes of the file */
+    uint64_t time;          /* The time of the last modification of the file, in nanoseconds (POSIX) or in units
+                               of 100 ns (Windows FILETIME), so a file rewritten in the same second gets another time */
+} RandomReader_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function opens a file for random reads.
+ *
+ * The size and the modification time of the file are stored in the reader.
+ *
+ * @param reader The structure to store the open file.
+ * @param path The path of the file.
+ * @return 0 if the file is open, 1 if the file can't be opened.
+ */
+int32_t openRandomReader(RandomReader_t *reader, const char *path);
+
+/**
+ * @brief This function reads bytes at an offset of the file.
+ *
+ * @param reader The open file.
+ * @param offset The byte offset of the first byte to read.
+ * @param buffer The buffer to store the bytes.
+ * @param size The number of bytes to read.
+ * @return The number of bytes read, less than size at the end of the file or if the read fails.
+ */
+uint32_t readFileAt(RandomReader_t *reader, uint64_t offset, int8_t buffer[], uint32_t size);
+
+/**
+ * @brief This function closes a file open for random reads.
+ *
+ * @param reader The open file.
+ */
+void closeRandomReader(RandomReader_t *reader);
+
+#endif /* RANDOM_READER_H */
@@ -5,7 +5,12 @@
  * The record handler is responsible for processing the Intel Hex records.
  * It provides function checkRecord to check the validity of the record and returns error code to upper layer (HAL layer),
  * extracts the data, and stores it in the appropriate format.
- * The record handler also provides function displayRecordInfo to print the contents of a record.
+ * The record handler also provides function displayRecordInfo to print the contents of a record,
+ * the text is formatted by the output writer, and function writeRecordLine to write a record as JSON or CSV.
+ * All the state of the file is kept in the context given by the caller.
+ * A record stream checks the End-Of-File records of a file given to the record parser character by character.
+ * A freestanding build (HEX_FREESTANDING) leaves out every function that writes text, the other functions
+ * only use the hexadecimal decoder and the fields of the context, the record parser and the record stream.
  *
  * @author Viet Ha Nguyen
  * @date 4/26/2024
@@ -14,111 +19,339 @@
  * Include
  ******************************************************************************/
 #include "record_handler.h"      /* Include header file of this function file */
+#include "hex_decoder.h"         /* Include header file of the hexadecimal decoder */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define RECORD_HEADER_CHARS 9       /* Number of characters of the start code, byte count, address and record type */
+#define RECORD_TYPE_COUNT   6       /* Number of entries of the record type table, the record types 00 to 05 */
+#define RECORD_ANY_LENGTH   (-1)    /* The byte count of a record type that can have any number of data bytes */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief The kinds of records, a kind selects how a record is displayed and stored in the context.
+ */
+typedef enum
+{
+    RECORD_KIND_INVALID = 0,        /* The record type isn't supported */
+    RECORD_KIND_DATA,               /* Data record (00) */
+    RECORD_KIND_EOF,                /* End-Of-File record (01) */
+    RECORD_KIND_ADDRESS,            /* Extended segment (02) or extended linear (04) address record */
+    RECORD_KIND_START               /* Start segment (03) or start linear (05) address record */
+} RecordKind_t;
+
+/**
+ * @brief Structure to hold the rules of one record type.
+ */
+typedef struct
+{
+    RecordKind_t kind;              /* The kind of the record, RECORD_KIND_INVALID if the type isn't supported */
+    int32_t byte_count;             /* The byte count required for the record type, or RECORD_ANY_LENGTH */
+    uint32_t address_shift;         /* The shift of the address given by an extended address record */
+    const char *name;               /* The name of the record type written by writeRecordInfo */
+} RecordType_t;
+
+/* The names of the record types are only used by writeRecordInfo, a freestanding build doesn't keep them */
+#if !HEX_FREESTANDING
+#define RECORD_TYPE_NAME(name)  (name)
+#else
+#define RECORD_TYPE_NAME(name)  NULL
+#endif
+
+/* The context and the record stream of a freestanding build must fit in its RAM budget */
+#if HEX_FREESTANDING
+typedef char RecordStreamBudget_t[((sizeof(HexContext_t) + sizeof(RecordStream_t)) <= HEX_FREESTANDING_RAM_BUDGET) ? 1 : -1];
+#endif
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
+#if !HEX_FREESTANDING
 /**
- * @brief This function prints the fields of a record.
+ * @brief This function writes the fields of a record.
  *
- * The function prints the record-length field, address field, HEX record type, data field,
+ * The function writes the record-length field, address field, HEX record type, data field,
  * and checksum field of the record.
  *
- * @param record The record structure to be printed.
+ * @param output The writer of the fields.
+ * @param record The record structure to be written.
+ */
+static void writeRecordFields(OutputWriter_t *output, const IntelHexRecord_t *record);
+
+#if HEX_SEGMENT_RECORDS || HEX_LINEAR_RECORDS
+/**
+ * @brief This function writes the address from the data record's address field and the absolute memory address.
+ *
+ * @param output The writer of the addresses.
+ * @param base_address The address of the last data record.
+ * @param abs_address The absolute memory address.
+ */
+static void writeAbsoluteAddress(OutputWriter_t *output, int32_t base_address, int32_t abs_address);
+
+/**
+ * @brief This function writes the start address of a start segment (03) or start linear (05) address record.
+ *
+ * @param output The writer of the start address.
+ * @param record The start address record.
+ */
+static void writeStartAddress(OutputWriter_t *output, const IntelHexRecord_t *record);
+#endif
+#endif
+
+/**
+ * @brief This function checks the record type and the byte count of a record with the record type table.
+ *
+ * @param record_type The record type.
+ * @param byte_count The byte count of the record.
+ * @return 0 if the record type and the byte count are valid, 3 if the record type isn't valid,
+ *         6 if the byte count isn't valid for the record type.
  */
-static void printRecord(IntelHexRecord_t record);
+static int32_t checkRecordType(uint32_t record_type, uint32_t byte_count);
+
+/**
+ * @brief This function stores the result of the check of a record in the context.
+ *
+ * An error is stored with the current line number of the context, a valid extended segment (02) or
+ * extended linear (04) address record updates the base address of the context.
+ *
+ * @param context The context of the file.
+ * @param error_code The error code of the record, 0 if the record is valid.
+ * @param record The record.
+ */
+static void storeRecordResult(HexContext_t *context, int32_t error_code, const IntelHexRecord_t *record);
+
+/**
+ * @brief This function updates a record stream with the result of a character.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @param record_result The result of the record parser for the character.
+ */
+static void acceptStreamRecord(const HexContext_t *context, RecordStream_t *stream, int32_t record_result);
+
+/**
+ * @brief This function starts a new line in the record parser.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ */
+static void startRecordLine(HexContext_t *context, RecordParser_t *parser);
+
+/**
+ * @brief This function checks one character of the current line, the line terminator isn't part of the line.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @param character The character.
+ * @return The error code if an error is found in the character, RECORD_PENDING otherwise.
+ */
+static int32_t parseRecordCharacter(HexContext_t *context, RecordParser_t *parser, int8_t character);
+
+/**
+ * @brief This function ends the current line of the record parser and checks the length and the checksum.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @return 0 if the record is valid, the error code if an error is found at the end of the line,
+ *         RECORD_PENDING if the error of the line is already returned.
+ */
+static int32_t endRecordLine(HexContext_t *context, RecordParser_t *parser);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/* The rules of the record types indexed by the record type, the record types that aren't part of
+the dialect of the build are left out so their code is removed by the compiler */
+static const RecordType_t record_types[RECORD_TYPE_COUNT] =
+{
+    { RECORD_KIND_DATA, RECORD_ANY_LENGTH, 0, RECORD_TYPE_NAME("DATA RECORD") },             /* 00 */
+    { RECORD_KIND_EOF, 0, 0, RECORD_TYPE_NAME("END-OF-FILE RECORD") },                       /* 01 */
+#if HEX_SEGMENT_RECORDS
+    { RECORD_KIND_ADDRESS, 2, 4, RECORD_TYPE_NAME("EXTENDED SEGMENT ADDRESS RECORD") },      /* 02 */
+    { RECORD_KIND_START, 4, 0, RECORD_TYPE_NAME("START SEGMENT ADDRESS RECORD") },           /* 03 */
+#else
+    { RECORD_KIND_INVALID, RECORD_ANY_LENGTH, 0, NULL },                                     /* 02 */
+    { RECORD_KIND_INVALID, RECORD_ANY_LENGTH, 0, NULL },                                     /* 03 */
+#endif
+#if HEX_LINEAR_RECORDS
+    { RECORD_KIND_ADDRESS, 2, 16, RECORD_TYPE_NAME("EXTENDED LINEAR ADDRESS RECORD") },      /* 04 */
+    { RECORD_KIND_START, 4, 0, RECORD_TYPE_NAME("START LINEAR ADDRESS RECORD") }             /* 05 */
+#else
+    { RECORD_KIND_INVALID, RECORD_ANY_LENGTH, 0, NULL },                                     /* 04 */
+    { RECORD_KIND_INVALID, RECORD_ANY_LENGTH, 0, NULL }                                      /* 05 */
+#endif
+};
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
+/**
+ * @brief This function initializes a context for a new file.
+ *
+ * The statistics of the context, in a build with HEX_STATISTICS, are cleared.
+ *
+ * @param context The context to initialize.
+ * @param output The writer of the printed text, NULL if nothing is printed with the context
+ *               (always NULL in a freestanding build).
+ */
+#if !HEX_FREESTANDING
+void initHexContext(HexContext_t *context, OutputWriter_t *output)
+{
+    context->output = output;
+#else
+void initHexContext(HexContext_t *context, void *output)
+{
+    (void)output;
+#endif
+#if HEX_STATISTICS
+    clearHexStatistics(&(context->statistics));
+#endif
+    resetHexContext(context);
+}
+
+/**
+ * @brief This function resets the state of a context to process a new file, the output writer and
+ *        the statistics are kept.
+ *
+ * @param context The context to reset.
+ */
+void resetHexContext(HexContext_t *context)
+{
+    context->base_address = 0;
+    context->display_base_address = 0;
+    context->line_number = 0;
+    context->line_offset = 0;
+    context->error.error_code = 0;
+    context->error.error_line = 0;
+}
+
 /**
  * @brief This function checks the validity of the Intel Hex record.
  *
- * The function first checks if the record starts with a colon.
- * It then checks if the byte count, address, and record type has correct syntax.
- * The function also checks if the record type is valid (00, 01, 02, 04, or 05).
- * If all checks pass, the function calculates the checksum of the record and compares it
- * with the checksum in the record.
- * If the checksums match, the function returns 0, indicating that the record syntax is valid.
- * If any of the checks fail, the function returns an error code that indicate the type of error.
+ * The function parses the record by using parseRecord function, only the result of the check
+ * is returned to the caller. The line counter of the context is incremented before the check.
  *
+ * @param context The context of the file.
  * @param line An Intel-Hex-File's line that contain the record's information.
  * @return An error code indicating the result of the check.
  */
-int32_t checkRecord(int8_t line[])
+int32_t checkRecord(HexContext_t *context, int8_t line[])
 {
-    int8_t byte_count_str[3];           /* The byte count in the record as a string */
-    int8_t address_str[5];              /* The address in the record as a string */
-    int8_t record_type_str[3];          /* The record type in the record as a string */
-    int32_t i = 0;                      /* Loop counter */
     int32_t error_code = 0;             /* Error code, initialized to 0 */
-    int32_t data_byte = 0;              /* The number of data bytes in the record */
-    int32_t checksum_record = 0;        /* The checksum in the record */
-    int32_t calculated_checksum = 0;    /* The calculated checksum in reality based on other fields */
+    uint32_t length = 0;                /* The number of characters of the line */
 
     IntelHexRecord_t record;            /* Declaring an Intel Hex record */
 
+    context->line_number += 1;
+#if !HEX_FREESTANDING
+    length = (uint32_t)strlen((const char *)line);
+#else
+    /* Count the characters without strlen of the C library */
+    while (line[length] != '\0')
+    {
+        length += 1;
+    }
+#endif
+    /* Parse and check the record */
+    error_code = parseRecord(context, line, length, &record);
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function parses and checks the Intel Hex record.
+ *
+ * The function decodes the whole record in one pass with the hexadecimal decoder, the line terminator
+ * (LF or CR LF) isn't part of the record.
+ * The function first checks if the record starts with a colon.
+ * It then checks if the byte count, address, and record type are hexadecimal digits.
+ * The function also checks the record type and the byte count with the record type table, the record type
+ * must be one of the dialect of the build and the byte count must be the one of the record type.
+ * It then checks if the number of data bytes matches the byte count and if the data and checksum fields
+ * are hexadecimal digits (a character that isn't a hexadecimal digit is reported before a wrong length).
+ * The data and checksum fields are decoded and added together by decodeHexData in one call, the record
+ * is valid if the sum of all its bytes is 0 modulo 256.
+ * If the checksums match, the function returns 0 and the record structure holds all fields of the record.
+ * If any of the checks fail, the function returns an error code that indicate the type of error.
+ * The error is stored in the context with the current line number of the context, a valid extended segment (02)
+ * or extended linear (04) address record sets the base address of the context.
+ *
+ * @param context The context of the file.
+ * @param line An Intel-Hex-File's line that contain the record's information, it doesn't need a null terminator.
+ * @param length The number of characters of the line, with or without the line terminator.
+ * @param record The record structure to store the fields of the record.
+ * @return An error code indicating the result of the check.
+ */
+int32_t parseRecord(HexContext_t *context, const int8_t line[], uint32_t length, IntelHexRecord_t *record)
+{
+    int32_t error_code = 0;             /* Error code, initialized to 0 */
+    uint32_t address_high = 0;          /* The high byte of the address */
+    uint32_t address_low = 0;           /* The low byte of the address */
+    uint32_t data_sum = 0;              /* The sum of the data bytes and the checksum */
+
+    /* Remove the line terminator from the length of the record */
+    if ((length > 0) && (line[length - 1] == '\n'))
+    {
+        length -= 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if ((length > 0) && (line[length - 1] == '\r'))
+    {
+        length -= 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
     /* Check if the record starts with a colon */
-    if (line[0] != ':')
+    if ((length == 0) || (line[0] != ':'))
     {
         /* If not then set error code to 1 */
         error_code = 1;
     }
-    /* Parse the byte count, address, and record type from the record */
-    else if (sscanf(line, ":%2s%4s%2s", byte_count_str, address_str, record_type_str) != 3)
+    /* Decode the byte count, address, and record type from the record */
+    else if ((length < RECORD_HEADER_CHARS) || !decodeHexByte(line + 1, &(record->byte_count)) ||
+             !decodeHexByte(line + 3, &address_high) || !decodeHexByte(line + 5, &address_low) ||
+             !decodeHexByte(line + 7, &(record->record_type)))
     {
         /* If not then set error code to 2 */
         error_code = 2;
     }
-    /* Check if the record type is valid */
-    else if ((strcmp(record_type_str, "00") != 0) && (strcmp(record_type_str, "01") != 0) && (strcmp(record_type_str, "02") != 0) &&
-             (strcmp(record_type_str, "04") != 0) && (strcmp(record_type_str, "05") != 0))
-    {
-        /* If not then set error code to 3 */
-        error_code = 3;
-    }
     else
     {
-        /* Convert the byte count from a string to a hexidecimal integer */
-        sscanf(byte_count_str, "%X", &(record.byte_count));
-        /* Convert the address from a string to a hexidecimal integer */
-        sscanf(address_str, "%X", &record.address);
-        /* Convert the record type from a string to a hexidecimal integer */
-        sscanf(record_type_str, "%X", &(record.record_type));
-
-        /* Calculate the number of data bytes in the record */
-        data_byte = (strlen(line) - 11 ) / 2;
+        record->address = (address_high << 8) | address_low;
 
+        /* Check if the record type and the byte count are valid, if not then set error code to 3 or 6 */
+        error_code = checkRecordType(record->record_type, record->byte_count);
+        if (error_code != 0)
+        {
+            /* Do nothing */
+        }
         /* Check if the number of data bytes in the record matches the byte count */
-        if (data_byte != record.byte_count)
+        else if (length != RECORD_HEADER_CHARS + (record->byte_count * 2) + 2)
         {
-            /* If not then set error code to 4 */
-            error_code = 4;
+            /* If the rest of the record has a character that isn't a hexadecimal digit then set error code to 2,
+            if not then set error code to 4 */
+            error_code = isHexText(line + RECORD_HEADER_CHARS, length - RECORD_HEADER_CHARS) ? 4 : 2;
         }
         else
         {
-            /* Allocate memory for the record.data */
-            record.data = (uint8_t *)malloc(record.byte_count * sizeof(uint8_t));
-            /* Parse the data from the record */
-            for (i = 0; i < record.byte_count; i++)
-            {
-                sscanf(line + 9 + (i * 2), "%02X", &(record.data[i]));
-            }
-
-            /* Parse the checksum from the record */
-            sscanf(line + strlen(line) - 3, "%02X", &checksum_record);
-
-            /* Calculate checksum in reality based on other record's fields */
-            calculated_checksum = record.byte_count + (record.address >> 8) + (record.address & 0xFF) + record.record_type;
-            /* Add the data to the checksum */
-            for (i = 0; i < record.byte_count; i++)
+            /* Decode the data and checksum fields from the record and add them to the sum of the other fields,
+            the checksum is decoded behind the data */
+            if (!decodeHexData(line + RECORD_HEADER_CHARS, record->byte_count + 1, record->data, &data_sum))
             {
-                calculated_checksum += record.data[i];
+                /* If a character isn't a hexadecimal digit then set error code to 2 */
+                error_code = 2;
             }
-            /* Take the two's complement of the checksum */
-            calculated_checksum = (~calculated_checksum + 1) & 0xFF;
-            /* Check if the calculated checksum matches the checksum in the record */
-            if (calculated_checksum != checksum_record)
+            /* The sum of all bytes of the record including the checksum must be 0 (two's complement of the checksum) */
+            else if (((record->byte_count + address_high + address_low + record->record_type + data_sum) & 0xFF) != 0)
             {
                 /* If not then set error code to 5 */
                 error_code = 5;
@@ -126,117 +359,821 @@ int32_t checkRecord(int8_t line[])
             else
             {
                 /* Set the checksum in the record */
-                record.checksum = checksum_record;
+                record->checksum = record->data[record->byte_count];
             }
-            free(record.data);
         }
     }
+
+    /* Store the error or the base address in the context */
+    storeRecordResult(context, error_code, record);
     /* Return the error code */
     return error_code;
 }
 
+/**
+ * @brief This function starts a record parser on a new file.
+ *
+ * @param parser The record parser.
+ */
+void initRecordParser(RecordParser_t *parser)
+{
+    /* The fields are cleared one by one, so a freestanding build doesn't need memset */
+    parser->record.byte_count = 0;
+    parser->record.address = 0;
+    parser->record.record_type = 0;
+    parser->record.checksum = 0;
+    parser->length = 0;
+    parser->high_digit = 0;
+    parser->sum = 0;
+    parser->error_code = 0;
+    parser->line_started = 0;
+    parser->pending_cr = 0;
+}
+
+/**
+ * @brief This function gives the next character of the file to the record parser.
+ *
+ * The record is checked with the same rules and in the same order as parseRecord: an error found in the start code,
+ * byte count, address or record type, or a character that isn't a hexadecimal digit, is returned at once,
+ * the length and the checksum are checked at the line feed. The rest of an invalid line is skipped.
+ * The line counter of the context is incremented by the first character of each line, an error is stored
+ * in the context with its line number and the base address of the context is updated like parseRecord does.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @param character The next character of the file.
+ * @return 0 if a valid record is complete, the error code (same error codes as checkRecord) when an error is found,
+ *         RECORD_PENDING otherwise.
+ */
+int32_t pushRecordCharacter(HexContext_t *context, RecordParser_t *parser, int8_t character)
+{
+    int32_t result = RECORD_PENDING;    /* Initialize the result of the character */
+
+    /* The first character of a line starts a new record */
+    if (!parser->line_started)
+    {
+        startRecordLine(context, parser);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* A carriage return that isn't followed by a line feed is a character of the line */
+    if (parser->pending_cr && (character != '\n'))
+    {
+        result = parseRecordCharacter(context, parser, '\r');
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    parser->pending_cr = 0;
+
+    if (character == '\n')
+    {
+        result = endRecordLine(context, parser);
+    }
+    /* Wait for the next character to know if the carriage return is the line terminator */
+    else if (character == '\r')
+    {
+        parser->pending_cr = 1;
+    }
+    else if (result == RECORD_PENDING)
+    {
+        result = parseRecordCharacter(context, parser, character);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the character */
+    return result;
+}
+
+/**
+ * @brief This function ends the last line of the file if it doesn't have a line terminator.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @return The same results as pushRecordCharacter for the end of the line, RECORD_PENDING if there is no last line.
+ */
+int32_t finishRecordParser(HexContext_t *context, RecordParser_t *parser)
+{
+    int32_t result = RECORD_PENDING;    /* Initialize the result of the last line */
+
+    /* A carriage return at the end of the file is the line terminator of the last line */
+    parser->pending_cr = 0;
+    if (parser->line_started)
+    {
+        result = endRecordLine(context, parser);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the last line */
+    return result;
+}
+
+/**
+ * @brief This function starts a record stream on a new file.
+ *
+ * @param stream The record stream.
+ */
+void initRecordStream(RecordStream_t *stream)
+{
+    initRecordParser(&(stream->parser));
+    stream->found_EOF = 0;
+    stream->last_line = 0;
+    stream->record_error.error_code = 0;
+    stream->record_error.error_line = 0;
+    stream->eof_error.error_code = 0;
+    stream->eof_error.error_line = 0;
+}
+
+/**
+ * @brief This function gives the next character of the file to the record stream.
+ *
+ * The character is checked by the record parser of the stream. An invalid record is reported as soon as its error
+ * is found and the characters behind it are ignored, so the transfer of the file can be aborted.
+ * A second End-Of-File record is also reported at once, the End-Of-File error is then sure (error code 3 of
+ * checkEOF) but the following records are still checked.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @param character The next character of the file.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t pushRecordStreamCharacter(HexContext_t *context, RecordStream_t *stream, int8_t character)
+{
+    /* The characters behind an invalid record are ignored */
+    if (stream->record_error.error_code == 0)
+    {
+        acceptStreamRecord(context, stream, pushRecordCharacter(context, &(stream->parser), character));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return getRecordStreamResult(stream);
+}
+
+/**
+ * @brief This function gives a whole line of the file to the record stream.
+ *
+ * The line is parsed in place by parseRecord and counted like its characters would be by pushRecordStreamCharacter,
+ * so a line that is complete in a block doesn't go through the record parser character by character.
+ * The record parser of the stream must not have a line started.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @param line The line, without its line feed.
+ * @param length The number of characters of the line.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t pushRecordStreamLine(HexContext_t *context, RecordStream_t *stream, const int8_t line[], uint32_t length)
+{
+    /* The lines behind an invalid record are ignored */
+    if (stream->record_error.error_code == 0)
+    {
+        context->line_number += 1;
+        acceptStreamRecord(context, stream, parseRecord(context, line, length, &(stream->parser.record)));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return getRecordStreamResult(stream);
+}
+
+/**
+ * @brief This function ends the file of the record stream and checks the End-Of-File records.
+ *
+ * The last line is checked even if it doesn't have a line terminator. The End-Of-File records are checked with
+ * the rules and error codes of checkEOF only if all records are valid: the file must have exactly one End-Of-File
+ * record and it must be the last record. The errors are stored in the stream.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t finishRecordStream(HexContext_t *context, RecordStream_t *stream)
+{
+    if (stream->record_error.error_code == 0)
+    {
+        acceptStreamRecord(context, stream, finishRecordParser(context, &(stream->parser)));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* The End-Of-File records are only checked if all records are valid */
+    if (stream->record_error.error_code != 0)
+    {
+        /* Do nothing */
+    }
+    /* If the End-Of-File record is not found, set the error code to 1 */
+    else if (stream->found_EOF == 0)
+    {
+        stream->eof_error.error_code = 1;
+    }
+    /* If the End-Of-File record is found only once, it must be the last record of the file */
+    else if (stream->found_EOF == 1)
+    {
+        stream->eof_error.error_code = (stream->eof_error.error_line != stream->last_line) ? 2 : 0;
+    }
+    /* If the End-Of-File record is found more than once, set the error code to 3 */
+    else
+    {
+        stream->eof_error.error_code = 3;
+    }
+    /* Return the result of the file */
+    return getRecordStreamResult(stream);
+}
+
+/**
+ * @brief This function returns the result of the characters given to a record stream.
+ *
+ * @param stream The record stream.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t getRecordStreamResult(const RecordStream_t *stream)
+{
+    int32_t result = 0;             /* Initialize the result of the stream */
+
+    if (stream->record_error.error_code != 0)
+    {
+        result = 1;
+    }
+    else if ((stream->found_EOF > 1) || (stream->eof_error.error_code != 0))
+    {
+        result = 2;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the stream */
+    return result;
+}
+
+#if !HEX_FREESTANDING
 /**
  * @brief This function displays the entire information of the record.
  *
  * The function parses the line to extract the byte count, address, record type, data, and checksum of the record.
  * It then checks the record type and prints the appropriate absolute memory address.
+ * The text is written to the output writer of the context, which is flushed.
  *
+ * @param context The context of the file.
  * @param line The line that contain the record.
  * @param record_number The number of the record of Intel HEX file.
  */
-void displayRecordInfo(int8_t line[], int32_t record_number)
+void displayRecordInfo(HexContext_t *context, int8_t line[], int32_t record_number)
+{
+    /* Write the information of the record */
+    writeRecordInfo(context, line, (uint32_t)strlen((const char *)line), record_number);
+    flushOutputWriter(context->output);
+}
+
+/**
+ * @brief This function writes the entire information of the record.
+ *
+ * The function writes the same text as displayRecordInfo to the output writer of the context, without flushing it.
+ * The address of the last data record is kept in the context.
+ *
+ * @param context The context of the file.
+ * @param line The line that contain the record, it doesn't need a null terminator.
+ * @param length The number of characters of the line, with or without the line terminator.
+ * @param record_number The number of the record of Intel HEX file.
+ */
+void writeRecordInfo(HexContext_t *context, const int8_t line[], uint32_t length, int32_t record_number)
 {
-    int32_t i = 0;                      /* Initialize the counter variable */
+#if HEX_SEGMENT_RECORDS || HEX_LINEAR_RECORDS
     int32_t abs_address = 0;            /* Initialize the absolute address variable */
-    static int32_t base_address = 0;    /* Initialize the base address variable */
+#endif
+    const RecordType_t *type = NULL;    /* The rules of the record type */
 
-    IntelHexRecord_t record;            /* Declaring an Intel Hex record */
+    OutputWriter_t *output = context->output;   /* The writer of the information */
+    int32_t *base_address = &(context->display_base_address);   /* The address of the last data record */
 
-    /* Allocate memory for the data in the record */
-    record.data = (uint8_t *)malloc(record.byte_count * sizeof(uint8_t));
+    IntelHexRecord_t record;            /* Declaring an Intel Hex record */
 
-    /* Parse the byte count, address, and record type from the line */
-    sscanf(line, ":%02X%04X%02X", &(record.byte_count), &(record.address), &(record.record_type));
-    /* Parse the checksum from the line */
-    sscanf(line + strlen(line) - 3, "%02X", &(record.checksum));
-    /* Parse the data from the line */
-    for (i = 0; i < record.byte_count; i++)
+    /* Write the record number */
+    writeString(output, "*** INFORMATION OF RECORD ");
+    writeDecimal(output, record_number);
+    /* Parse all fields of the record from the line, an invalid record can't be displayed */
+    if (parseRecord(context, line, length, &record) != 0)
     {
-        sscanf(line + 9 + (i * 2), "%02X", &(record.data[i]));
+        writeString(output, ": INVALID RECORD ***\n\n");
     }
-    /* Check if the record type is a data record */
-    if (record.record_type == 0x00)
+    else
     {
-        /* Print the record number and type */
-        printf("*** INFORMATION OF RECORD %d: DATA RECORD ***\n\n", record_number);
-        /* Print the details of the record's fields */
-        printRecord(record);
-        /* Set the base address to the address in the record */
-        base_address = record.address;
+        /* Write the record type, a valid record type is always in the table */
+        type = &(record_types[record.record_type]);
+        writeString(output, ": ");
+        writeString(output, type->name);
+        writeString(output, " ***\n\n");
+        /* Write the rest of the record with the handler of its kind */
+        switch (type->kind)
+        {
+            case RECORD_KIND_DATA:
+            {
+                /* Write the details of the record's fields */
+                writeRecordFields(output, &record);
+                /* Set the base address to the address in the record */
+                *base_address = record.address;
+                break;
+            }
+#if HEX_SEGMENT_RECORDS || HEX_LINEAR_RECORDS
+            case RECORD_KIND_ADDRESS:
+            {
+                /* Write the details of the record's fields */
+                writeRecordFields(output, &record);
+                /* Calculate the absolute address, the address field of the record is shifted by its record type */
+                abs_address = *base_address +
+                              ((((uint32_t)record.data[0] << 8) | record.data[1]) << type->address_shift);
+                /* Write the address from the data record's address field and the absolute memory address */
+                writeAbsoluteAddress(output, *base_address, abs_address);
+                break;
+            }
+            case RECORD_KIND_START:
+            {
+                /* Write the details of the record's fields and the start address */
+                writeRecordFields(output, &record);
+                writeStartAddress(output, &record);
+                break;
+            }
+#endif
+            /* Only the record type is written for an End-Of-File record */
+            default:
+            {
+                /* Do nothing */
+            }
+        }
     }
-    /* Check if the record type is an extended segment address record */
-    else if (record.record_type == 0x02)
+}
+
+/**
+ * @brief This function writes a valid record as one line of a machine-readable format.
+ *
+ * The line has the line number, record type, absolute memory address and data field of the record,
+ * as a JSON object (JSON lines) or as comma-separated values.
+ *
+ * @param context The context of the file, the line is written to its output writer.
+ * @param record The valid record.
+ * @param line_number The line number of the record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param format The format of the line.
+ */
+void writeRecordLine(HexContext_t *context, const IntelHexRecord_t *record, uint32_t line_number,
+                     uint32_t absolute_address, RecordFormat_t format)
+{
+    OutputWriter_t *output = context->output;   /* The writer of the line */
+
+    if (format == RECORD_FORMAT_JSON)
     {
-        /* Print the record number and type */
-        printf("*** INFORMATION OF RECORD %d: EXTENDED SEGMENT ADDRESS RECORD ***\n\n", record_number);
-        /* Print the details of the record's fields */
-        printRecord(record);
-        /* Calculate the absolute address */
-        abs_address = base_address + (record.data[0] * 0x1000) + (record.data[1] * 0x10);
-        /* Print the address from the data record's address field */
-        printf("-> Address from the data record's address field: %04X\n", base_address);
-        /* Print the absolute memory address */
-        printf("-> Absolute memory address: %08X\n", abs_address);
+        writeString(output, "{\"line\":");
+        writeDecimal(output, line_number);
+        writeString(output, ",\"type\":");
+        writeDecimal(output, record->record_type);
+        writeString(output, ",\"address\":");
+        writeDecimal(output, absolute_address);
+        writeString(output, ",\"data\":\"");
+        writeHexBytes(output, record->data, record->byte_count);
+        writeString(output, "\"}\n");
     }
-    /* Check if the record type is an extended linear address record */
-    else if (record.record_type == 0x04)
+    else
+    {
+        writeDecimal(output, line_number);
+        writeString(output, ",");
+        writeDecimal(output, record->record_type);
+        writeString(output, ",");
+        writeDecimal(output, absolute_address);
+        writeString(output, ",");
+        writeHexBytes(output, record->data, record->byte_count);
+        writeString(output, "\n");
+    }
+}
+
+/**
+ * @brief This function writes the header of a machine-readable format.
+ *
+ * Comma-separated values start with the names of the columns, JSON lines have no header.
+ *
+ * @param context The context of the file, the header is written to its output writer.
+ * @param format The format of the lines.
+ */
+void writeRecordHeader(HexContext_t *context, RecordFormat_t format)
+{
+    if (format == RECORD_FORMAT_CSV)
     {
-        /* Print the record number and type */
-        printf("*** INFORMATION OF RECORD %d: EXTENDED LINEAR ADDRESS RECORD ***\n\n", record_number);
-        /* Print the details of the record's fields */
-        printRecord(record);
-        /* Calculate the absolute address */
-        abs_address = base_address + (record.data[0] * 0x1000000) + (record.data[1] * 0x10000);
-        /* Print the address from the data record's address field */
-        printf("-> Address from the data record's address field: %04X\n", base_address);
-        /* Print the absolute memory address */
-        printf("-> Absolute memory address: %08X\n", abs_address);
+        writeString(context->output, "line,type,address,data\n");
     }
-    /* If record is an EOF */
     else
     {
-        /* Print the record number and type */
-        printf("*** INFORMATION OF RECORD %d: END-OF-FILE RECORD ***\n\n", record_number);
+        /* Do nothing */
     }
-    free(record.data);
 }
 
 /**
- * @brief This function prints the fields of a record.
+ * @brief This function writes the fields of a record.
  *
- * The function prints the record-length field, address field, HEX record type, data field,
+ * The function writes the record-length field, address field, HEX record type, data field,
  * and checksum field of the record.
  *
- * @param record The record structure to be printed.
+ * @param output The writer of the fields.
+ * @param record The record structure to be written.
+ */
+static void writeRecordFields(OutputWriter_t *output, const IntelHexRecord_t *record)
+{
+    /* Write the record-length field */
+    writeString(output, "Record-length field: ");
+    writeHex(output, record->byte_count, 2);
+    writeString(output, " <=> ");
+    writeDecimal(output, record->byte_count);
+    writeString(output, " bytes of data\n");
+    /* Write the address field */
+    writeString(output, "Address field: ");
+    writeHex(output, record->address, 4);
+    /* Write the HEX record type */
+    writeString(output, "\nHEX record type: ");
+    writeHex(output, record->record_type, 2);
+    /* Write the data field */
+    writeString(output, "\nData field: ");
+    writeHexBytes(output, record->data, record->byte_count);
+    /* Write the checksum field */
+    writeString(output, "\nChecksum field: ");
+    writeHex(output, record->checksum, 2);
+    writeString(output, "\n");
+}
+
+#if HEX_SEGMENT_RECORDS || HEX_LINEAR_RECORDS
+/**
+ * @brief This function writes the address from the data record's address field and the absolute memory address.
+ *
+ * @param output The writer of the addresses.
+ * @param base_address The address of the last data record.
+ * @param abs_address The absolute memory address.
+ */
+static void writeAbsoluteAddress(OutputWriter_t *output, int32_t base_address, int32_t abs_address)
+{
+    /* Write the address from the data record's address field */
+    writeString(output, "-> Address from the data record's address field: ");
+    writeHex(output, (uint32_t)base_address, 4);
+    /* Write the absolute memory address */
+    writeString(output, "\n-> Absolute memory address: ");
+    writeHex(output, (uint32_t)abs_address, 8);
+    writeString(output, "\n");
+}
+
+/**
+ * @brief This function writes the start address of a start segment (03) or start linear (05) address record.
+ *
+ * A start segment address is the CS:IP pair of the 80x86 processors, a start linear address is the 32-bit EIP.
+ *
+ * @param output The writer of the start address.
+ * @param record The start address record.
  */
-static void printRecord(IntelHexRecord_t record)
+static void writeStartAddress(OutputWriter_t *output, const IntelHexRecord_t *record)
 {
-    int32_t i = 0;          /* Initialize the counter variable */
+    uint32_t high = (record->data[0] << 8) | record->data[1];   /* The code segment or the upper 16 bits of EIP */
+    uint32_t low = (record->data[2] << 8) | record->data[3];    /* The instruction pointer or the lower 16 bits of EIP */
 
-    /* Print the record-length field */
-    printf("Record-length field: %02X <=> %d bytes of data\n", record.byte_count, record.byte_count);
-    /* Print the address field */
-    printf("Address field: %04X\n", record.address);
-    /* Print the HEX record type */
-    printf("HEX record type: %02X\n", record.record_type);
-    /* Print the data field */
-    printf("Data field: ");
-    /* Print the data in the data field */
-    for (i = 0; i < record.byte_count; i++)
+    if (record->record_type == 0x03)
     {
-        printf("%02X", record.data[i]);
+        writeString(output, "-> Start address (CS:IP): ");
+        writeHex(output, high, 4);
+        writeString(output, ":");
+        writeHex(output, low, 4);
     }
-    /* Print the checksum field */
-    printf("\nChecksum field: %02X\n", record.checksum);
-} /* EOF */
+    else
+    {
+        writeString(output, "-> Start address (EIP): ");
+        writeHex(output, (high << 16) | low, 8);
+    }
+    writeString(output, "\n");
+}
+#endif
 
+#endif
+
+/**
+ * @brief This function checks the record type and the byte count of a record with the record type table.
+ *
+ * A record type is valid if it has an entry in the table, the byte count is valid if the entry of
+ * the record type has no required byte count or if it is the required byte count.
+ *
+ * @param record_type The record type.
+ * @param byte_count The byte count of the record.
+ * @return 0 if the record type and the byte count are valid, 3 if the record type isn't valid,
+ *         6 if the byte count isn't valid for the record type.
+ */
+static int32_t checkRecordType(uint32_t record_type, uint32_t byte_count)
+{
+    int32_t error_code = 0;             /* Error code, initialized to 0 */
+
+    /* Check if the record type is supported */
+    if ((record_type >= RECORD_TYPE_COUNT) || (record_types[record_type].kind == RECORD_KIND_INVALID))
+    {
+        error_code = 3;
+    }
+    /* Check if the byte count is the one of the record type */
+    else if ((record_types[record_type].byte_count != RECORD_ANY_LENGTH) &&
+             ((uint32_t)record_types[record_type].byte_count != byte_count))
+    {
+        error_code = 6;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the error code */
+    return error_code;
+}
+
+/**
+ * @brief This function stores the result of the check of a record in the context.
+ *
+ * An error is stored with the current line number of the context, a valid extended segment (02) or
+ * extended linear (04) address record updates the base address of the context.
+ * In a build with HEX_STATISTICS, the record is counted in the statistics of the context.
+ *
+ * @param context The context of the file.
+ * @param error_code The error code of the record, 0 if the record is valid.
+ * @param record The record.
+ */
+static void storeRecordResult(HexContext_t *context, int32_t error_code, const IntelHexRecord_t *record)
+{
+#if !HEX_STATISTICS && !HEX_SEGMENT_RECORDS && !HEX_LINEAR_RECORDS
+    /* Only the statistics and the address records use the record */
+    (void)record;
+#endif
+#if HEX_STATISTICS
+    /* Count the invalid record by its error code (1 to 6), or the valid record by its record type and its data bytes */
+    if (error_code != 0)
+    {
+        context->statistics.error_count[error_code] += 1;
+    }
+    else
+    {
+        context->statistics.record_count[record->record_type] += 1;
+        context->statistics.decoded_byte_count += record->byte_count;
+    }
+#endif
+
+    /* Store the error in the context */
+    if (error_code != 0)
+    {
+        context->error.error_code = error_code;
+        context->error.error_line = context->line_number;
+    }
+#if HEX_SEGMENT_RECORDS || HEX_LINEAR_RECORDS
+    /* An extended segment address record gives the bits 4 to 19 of the base address and an extended linear
+    address record gives the bits 16 to 31, the record type of a valid record is always in the table */
+    else if (record_types[record->record_type].kind == RECORD_KIND_ADDRESS)
+    {
+        context->base_address = (((uint32_t)record->data[0] << 8) | record->data[1]) <<
+                                record_types[record->record_type].address_shift;
+    }
+#endif
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function starts a new line in the record parser.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ */
+static void startRecordLine(HexContext_t *context, RecordParser_t *parser)
+{
+    context->line_number += 1;
+    parser->record.byte_count = 0;
+    parser->record.address = 0;
+    parser->record.record_type = 0;
+    parser->length = 0;
+    parser->high_digit = 0;
+    parser->sum = 0;
+    parser->error_code = 0;
+    parser->line_started = 1;
+}
+
+/**
+ * @brief This function checks one character of the current line, the line terminator isn't part of the line.
+ *
+ * The characters are checked in the order of parseRecord: the start code, then the hexadecimal digits of
+ * the byte count, address and record type, then the record type, then the hexadecimal digits of the data
+ * and checksum fields. Each byte is added to the sum of the record when its second digit is received.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @param character The character.
+ * @return The error code if an error is found in the character, RECORD_PENDING otherwise.
+ */
+static int32_t parseRecordCharacter(HexContext_t *context, RecordParser_t *parser, int8_t character)
+{
+    int32_t result = RECORD_PENDING;    /* Initialize the result of the character */
+    uint32_t digit = 0;                 /* The value of the hexadecimal digit */
+    uint32_t value = 0;                 /* The value of the byte completed by the character */
+    uint32_t byte_index = 0;            /* The index of the byte in the record, 0 is the byte count */
+
+    /* Skip the rest of an invalid line */
+    if (parser->error_code != 0)
+    {
+        /* Do nothing */
+    }
+    /* Check if the record starts with a colon */
+    else if (parser->length == 0)
+    {
+        if (character != ':')
+        {
+            /* If not then set error code to 1 */
+            result = 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    /* A character that isn't a hexadecimal digit sets error code to 2, whatever the length of the line */
+    else if (!decodeHexDigit(character, &digit))
+    {
+        result = 2;
+    }
+    /* Keep the first digit of the byte */
+    else if ((parser->length & 1) != 0)
+    {
+        parser->high_digit = digit;
+    }
+    else
+    {
+        value = (parser->high_digit << 4) | digit;
+        byte_index = (parser->length - 1) / 2;
+        parser->sum += value;
+        if (byte_index == 0)
+        {
+            parser->record.byte_count = value;
+        }
+        else if (byte_index == 1)
+        {
+            parser->record.address = value << 8;
+        }
+        else if (byte_index == 2)
+        {
+            parser->record.address |= value;
+        }
+        /* Check if the record type and the byte count are valid, if not then set error code to 3 or 6 */
+        else if (byte_index == 3)
+        {
+            parser->record.record_type = value;
+            result = checkRecordType(value, parser->record.byte_count);
+            if (result == 0)
+            {
+                result = RECORD_PENDING;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        /* Store the data and checksum bytes, the checksum is stored behind the data */
+        else if (byte_index - 4 <= RECORD_MAX_DATA_BYTES)
+        {
+            parser->record.data[byte_index - 4] = (uint8_t)value;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    /* Store the error in the context */
+    if (result != RECORD_PENDING)
+    {
+        parser->error_code = result;
+        storeRecordResult(context, result, &(parser->record));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Count the character, a line that long can't be a valid record */
+    if (parser->length < UINT32_MAX)
+    {
+        parser->length += 1;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the character */
+    return result;
+}
+
+/**
+ * @brief This function ends the current line of the record parser and checks the length and the checksum.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @return 0 if the record is valid, the error code if an error is found at the end of the line,
+ *         RECORD_PENDING if the error of the line is already returned.
+ */
+static int32_t endRecordLine(HexContext_t *context, RecordParser_t *parser)
+{
+    int32_t result = RECORD_PENDING;    /* Initialize the result of the line */
+
+    parser->line_started = 0;
+    /* The error of the line is already returned */
+    if (parser->error_code != 0)
+    {
+        /* Do nothing */
+    }
+    /* An empty line doesn't start with a colon */
+    else if (parser->length == 0)
+    {
+        result = 1;
+    }
+    /* The byte count, address, and record type aren't complete */
+    else if (parser->length < RECORD_HEADER_CHARS)
+    {
+        result = 2;
+    }
+    /* Check if the number of data bytes in the record matches the byte count, all characters are hexadecimal digits */
+    else if (parser->length != RECORD_HEADER_CHARS + (parser->record.byte_count * 2) + 2)
+    {
+        result = 4;
+    }
+    /* The sum of all bytes of the record including the checksum must be 0 (two's complement of the checksum) */
+    else if ((parser->sum & 0xFF) != 0)
+    {
+        result = 5;
+    }
+    else
+    {
+        /* Set the checksum in the record */
+        parser->record.checksum = parser->record.data[parser->record.byte_count];
+        result = 0;
+    }
+
+    /* Store the error or the base address in the context */
+    if (result != RECORD_PENDING)
+    {
+        parser->error_code = result;
+        storeRecordResult(context, result, &(parser->record));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    /* Return the result of the line */
+    return result;
+}
+
+/**
+ * @brief This function updates a record stream with the result of a character.
+ *
+ * The first invalid record is stored in the stream, the End-Of-File records are counted and the line
+ * of the first one is stored.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @param record_result The result of the record parser for the character.
+ */
+static void acceptStreamRecord(const HexContext_t *context, RecordStream_t *stream, int32_t record_result)
+{
+    if (record_result == RECORD_PENDING)
+    {
+        /* Do nothing */
+    }
+    /* Store the error and the line number of the invalid record */
+    else if (record_result != 0)
+    {
+        stream->record_error.error_code = (uint32_t)record_result;
+        stream->record_error.error_line = context->line_number;
+    }
+    else
+    {
+        stream->last_line = context->line_number;
+        /* If the End-Of-File record is found for the first time, store the line number */
+        if (stream->parser.record.record_type == 0x01)
+        {
+            if (stream->found_EOF == 0)
+            {
+                stream->eof_error.error_line = context->line_number;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            stream->found_EOF += 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+} /* EOF */
@@ -5,15 +5,36 @@
  * The record handler is responsible for processing the Intel Hex records.
  * It provides function checkRecord to check the validity of the record and returns error code
  * to upper layer (HAL layer), extracts the data, and stores it in the appropriate format.
- * The record handler also provides function displayRecordInfo to print the contents of a record.
+ * A record parser (RecordParser_t) does the same checks on a record received character by character.
+ * The record handler also provides function displayRecordInfo to print the contents of a record,
+ * function writeRecordInfo to write the same text without flushing the output and function writeRecordLine
+ * to write a record as one line of JSON or CSV.
+ * Every function takes a context (HexContext_t) that holds all the state of the file being processed,
+ * so there is no shared state and independent files can be processed at the same time in different threads.
+ * A record stream (RecordStream_t) adds the End-Of-File checks of a whole file to the record parser, with the same
+ * error codes as checkEOF, so a file received character by character is validated like validateIntelHexBuffer does.
+ * The push-parser API of the analyzer (openIntelHexStream, feedIntelHexStream, finishIntelHexStream) is built
+ * on the record stream, so there is one End-Of-File check for the target and the host.
+ * In a build with HEX_FREESTANDING set to 1, for example in a bootloader that validates a file received over
+ * a serial line, only the checks, the record parser and the record stream are built: no C library, no heap and
+ * no output, the context and the record stream fit in HEX_FREESTANDING_RAM_BUDGET bytes together and each
+ * character given to pushRecordStreamCharacter costs the same few table lookups and comparisons.
  *
  * @author Viet Ha Nguyen
  * @date 4/26/2024
  */
+#ifndef HEX_FREESTANDING
+#define HEX_FREESTANDING 0  /* 1 to build only the checks and the record parser, without the C library */
+#endif
+
 #include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stddef.h>   /* For NULL, also available in a freestanding build */
+#if !HEX_FREESTANDING
 #include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
-#include <stdlib.h>   /* For malloc(), free() functions*/
 #include <string.h>   /* For strcpy(), strcmp() functions*/
+#include "output_writer.h"   /* Include header file of the output writer */
+#include "hex_statistics.h"  /* Include header file of the statistics */
+#endif
 
 /*******************************************************************************
  * Header guards
@@ -21,52 +42,340 @@
 #ifndef RECORD_HANDLER_H
 #define RECORD_HANDLER_H
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define RECORD_MAX_DATA_BYTES 255   /* The byte count field has 2 hexadecimal digits, so a record has at most 255 data bytes */
+#define RECORD_PENDING        (-1)  /* Result of the record parser while the record isn't complete and has no error */
+#define HEX_FREESTANDING_RAM_BUDGET 1024    /* Bytes of RAM of a context and a record stream in a freestanding build */
+
+#if HEX_FREESTANDING && defined(HEX_STATISTICS) && HEX_STATISTICS
+#error "The statistics use the C library, they can't be collected in a freestanding build"
+#endif
+
+/* The dialects of Intel Hex, the record types of a build are chosen with HEX_DIALECT (e.g. -DHEX_DIALECT=HEX_DIALECT_I8HEX) */
+#define HEX_DIALECT_ALL       0     /* All record types of Intel Hex (00 to 05) */
+#define HEX_DIALECT_I8HEX     1     /* Data and End-Of-File records (00, 01), 16-bit addresses */
+#define HEX_DIALECT_I16HEX    2     /* I8HEX and the extended segment and start segment address records (02, 03), 20-bit addresses */
+#define HEX_DIALECT_I32HEX    3     /* I8HEX and the extended linear and start linear address records (04, 05), 32-bit addresses */
+
+#ifndef HEX_DIALECT
+#define HEX_DIALECT HEX_DIALECT_ALL
+#endif
+
+#if (HEX_DIALECT == HEX_DIALECT_ALL) || (HEX_DIALECT == HEX_DIALECT_I16HEX)
+#define HEX_SEGMENT_RECORDS   1     /* The extended segment (02) and start segment (03) address records are supported */
+#else
+#define HEX_SEGMENT_RECORDS   0
+#endif
+
+#if (HEX_DIALECT == HEX_DIALECT_ALL) || (HEX_DIALECT == HEX_DIALECT_I32HEX)
+#define HEX_LINEAR_RECORDS    1     /* The extended linear (04) and start linear (05) address records are supported */
+#else
+#define HEX_LINEAR_RECORDS    0
+#endif
+
 /*******************************************************************************
  * Declarations
  ******************************************************************************/
+/**
+ * @brief Structure to hold the error code and line number of an error.
+ */
+typedef struct
+{
+    uint32_t error_code;
+    uint32_t error_line;
+} Error_t;
+
+/**
+ * @brief Structure to hold the state of the processing of one Intel Hex file.
+ *
+ * A context is used by one thread at a time, each file processed at the same time needs its own context.
+ * The output writer is given by the caller and can be shared by several contexts used by the same thread.
+ */
+typedef struct
+{
+    uint32_t base_address;          /* Base address of the last extended segment (02) or extended linear (04) address record */
+    int32_t display_base_address;   /* Address of the last data record, used in the text of displayRecordInfo */
+    uint32_t line_number;           /* Number of lines processed, the line number of the current record */
+    uint64_t line_offset;           /* Byte offset of the current line, kept by the single-pass validations */
+    Error_t error;                  /* Error code and line number of the last error found */
+#if !HEX_FREESTANDING
+    OutputWriter_t *output;         /* The writer of the printed text */
+#endif
+#if HEX_STATISTICS
+    HexStatistics_t statistics;     /* The counters of all files processed with the context, kept between files */
+#endif
+} HexContext_t;
+
 /**
  * @brief Structure to hold the information of an Intel Hex Record.
  *
  * The structure contains the byte count, address, record type, data, and checksum of the record.
+ * The data field is stored inside the structure, so parsing a record never allocates memory.
+ * It has one more byte than the largest data field because the checksum is decoded behind the data.
  */
 typedef struct
 {
     uint32_t byte_count;
     uint32_t address;
     uint32_t record_type;
-    uint8_t *data;
+    uint8_t data[RECORD_MAX_DATA_BYTES + 1];
     uint32_t checksum;
 } IntelHexRecord_t;
 
+/**
+ * @brief Structure to hold the state of the record parser between two characters.
+ *
+ * The record parser checks a record character by character, so a record can be split between several
+ * blocks of data. Only the current record is kept, never the characters of the line.
+ */
+typedef struct
+{
+    IntelHexRecord_t record;        /* The fields of the current record */
+    uint32_t length;                /* Number of characters of the current line, without the line terminator */
+    uint32_t high_digit;            /* Value of the first hexadecimal digit of the current byte */
+    uint32_t sum;                   /* Sum of all bytes of the current record */
+    int32_t error_code;             /* Error code of the current line, 0 while no error is found */
+    int8_t line_started;            /* 1 if a character of the current line is received */
+    int8_t pending_cr;              /* 1 if the last character is a carriage return, it may be the line terminator */
+} RecordParser_t;
+
+/**
+ * @brief Structure to hold the state of the validation of a file received character by character.
+ *
+ * The record stream checks the records with a record parser and counts the End-Of-File records, so the
+ * End-Of-File record is checked without the analyzer and without the C library.
+ */
+typedef struct
+{
+    RecordParser_t parser;          /* The state of the current record */
+    uint32_t found_EOF;             /* Number of End-Of-File records found */
+    uint32_t last_line;             /* Line number of the last record checked */
+    Error_t record_error;           /* Error code and line number of the invalid record, error code 0 if there is none */
+    Error_t eof_error;              /* Error code of the End-Of-File check (error codes of checkEOF) and line number
+                                       of the first End-Of-File record */
+} RecordStream_t;
+
+#if !HEX_FREESTANDING
+/**
+ * @brief The machine-readable formats of writeRecordLine.
+ */
+typedef enum
+{
+    RECORD_FORMAT_JSON = 0,     /* One JSON object for each record (JSON lines) */
+    RECORD_FORMAT_CSV           /* Comma-separated values with a header line */
+} RecordFormat_t;
+#endif
+
 /*******************************************************************************
  * Prototype
  ******************************************************************************/
+/**
+ * @brief This function initializes a context for a new file.
+ *
+ * The statistics of the context, in a build with HEX_STATISTICS, are cleared.
+ *
+ * @param context The context to initialize.
+ * @param output The writer of the printed text, NULL if nothing is printed with the context
+ *               (always NULL in a freestanding build).
+ */
+#if !HEX_FREESTANDING
+void initHexContext(HexContext_t *context, OutputWriter_t *output);
+#else
+void initHexContext(HexContext_t *context, void *output);
+#endif
+
+/**
+ * @brief This function resets the state of a context to process a new file, the output writer and
+ *        the statistics are kept.
+ *
+ * @param context The context to reset.
+ */
+void resetHexContext(HexContext_t *context);
+
 /**
  * @brief This function checks the validity of the Intel Hex record.
  *
  * The function first checks if the record starts with a colon.
  * It then checks if the byte count, address, and record type has correct syntax.
- * The function also checks if the record type is valid (00, 01, 02, 04, or 05).
+ * The function also checks if the record type is valid (00 to 05, only the record types of
+ * the dialect HEX_DIALECT of the build) and if the byte count is valid for the record type
+ * (0 for an End-Of-File record, 2 for an extended address record, 4 for a start address record).
  * If all checks pass, the function calculates the checksum of the record and compares it
  * with the checksum in the record.
  * If the checksums match, the function returns 0, indicating that the record syntax is valid.
  * If any of the checks fail, the function returns an error code that indicate the type of error.
+ * The line counter of the context is incremented, an error is stored in the context with its line number.
  *
+ * @param context The context of the file.
  * @param line An Intel-Hex-File's line that contain the record's information.
  * @return An error code indicating the result of the check.
  */
-int32_t checkRecord(int8_t line[]);
+int32_t checkRecord(HexContext_t *context, int8_t line[]);
+
+/**
+ * @brief This function parses and checks the Intel Hex record.
+ *
+ * The function performs the same checks as checkRecord function and, if the record is valid,
+ * stores all fields of the record in the record structure so the caller doesn't have to parse the line again.
+ * The record is decoded in one pass with the hexadecimal decoder, the line terminator (LF or CR LF) isn't part of the record.
+ *
+ * The line is parsed in place, it doesn't need a null terminator so records can be parsed directly
+ * inside a memory-mapped file.
+ * The base address of the context is updated by a valid extended segment (02) or extended linear (04)
+ * address record, an error is stored in the context with the current line number of the context.
+ *
+ * @param context The context of the file.
+ * @param line An Intel-Hex-File's line that contain the record's information.
+ * @param length The number of characters of the line, with or without the line terminator.
+ * @param record The record structure to store the fields of the record.
+ * @return An error code indicating the result of the check (same error codes as checkRecord).
+ */
+int32_t parseRecord(HexContext_t *context, const int8_t line[], uint32_t length, IntelHexRecord_t *record);
 
+/**
+ * @brief This function starts a record parser on a new file.
+ *
+ * @param parser The record parser.
+ */
+void initRecordParser(RecordParser_t *parser);
+
+/**
+ * @brief This function gives the next character of the file to the record parser.
+ *
+ * The record is checked with the same rules and in the same order as parseRecord: an error found in the start code,
+ * byte count, address or record type, or a character that isn't a hexadecimal digit, is returned at once,
+ * the length and the checksum are checked at the line feed. The rest of an invalid line is skipped.
+ * The line counter of the context is incremented by the first character of each line, an error is stored
+ * in the context with its line number and the base address of the context is updated like parseRecord does.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @param character The next character of the file.
+ * @return 0 if a valid record is complete, the error code (same error codes as checkRecord) when an error is found,
+ *         RECORD_PENDING otherwise.
+ */
+int32_t pushRecordCharacter(HexContext_t *context, RecordParser_t *parser, int8_t character);
+
+/**
+ * @brief This function ends the last line of the file if it doesn't have a line terminator.
+ *
+ * @param context The context of the file.
+ * @param parser The record parser.
+ * @return The same results as pushRecordCharacter for the end of the line, RECORD_PENDING if there is no last line.
+ */
+int32_t finishRecordParser(HexContext_t *context, RecordParser_t *parser);
+
+/**
+ * @brief This function starts a record stream on a new file.
+ *
+ * @param stream The record stream.
+ */
+void initRecordStream(RecordStream_t *stream);
+
+/**
+ * @brief This function gives the next character of the file to the record stream.
+ *
+ * The character is checked by the record parser of the stream. An invalid record is reported as soon as its error
+ * is found and the characters behind it are ignored, so the transfer of the file can be aborted.
+ * A second End-Of-File record is also reported at once, the End-Of-File error is then sure (error code 3 of
+ * checkEOF) but the following records are still checked.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @param character The next character of the file.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t pushRecordStreamCharacter(HexContext_t *context, RecordStream_t *stream, int8_t character);
+
+/**
+ * @brief This function gives a whole line of the file to the record stream.
+ *
+ * The line is parsed in place by parseRecord and counted like its characters would be by pushRecordStreamCharacter,
+ * so a line that is complete in a block doesn't go through the record parser character by character.
+ * The record parser of the stream must not have a line started.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @param line The line, without its line feed.
+ * @param length The number of characters of the line.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t pushRecordStreamLine(HexContext_t *context, RecordStream_t *stream, const int8_t line[], uint32_t length);
+
+/**
+ * @brief This function ends the file of the record stream and checks the End-Of-File records.
+ *
+ * The last line is checked even if it doesn't have a line terminator. The End-Of-File records are checked with
+ * the rules and error codes of checkEOF only if all records are valid: the file must have exactly one End-Of-File
+ * record and it must be the last record. The errors are stored in the stream.
+ *
+ * @param context The context of the file.
+ * @param stream The record stream.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t finishRecordStream(HexContext_t *context, RecordStream_t *stream);
+
+/**
+ * @brief This function returns the result of the characters given to a record stream.
+ *
+ * @param stream The record stream.
+ * @return 0 if no error is found yet, 1 if a record is invalid, 2 if the End-Of-File record isn't valid.
+ */
+int32_t getRecordStreamResult(const RecordStream_t *stream);
+
+#if !HEX_FREESTANDING
 /**
  * @brief This function displays the entire information of the record.
  *
  * The function parses the line to extract the byte count, address, record type, data, and checksum of the record.
  * It then checks the record type and prints the appropriate absolute memory address.
+ * The text is written to the output writer of the context, which is flushed.
  *
+ * @param context The context of the file.
  * @param line The line that contain the record.
  * @param record_number The number of the record of Intel HEX file.
  */
-void displayRecordInfo(int8_t line[], int32_t record_number);
+void displayRecordInfo(HexContext_t *context, int8_t line[], int32_t record_number);
+
+/**
+ * @brief This function writes the entire information of the record.
+ *
+ * The function writes the same text as displayRecordInfo to the output writer of the context, without flushing it.
+ *
+ * @param context The context of the file.
+ * @param line The line that contain the record, it doesn't need a null terminator.
+ * @param length The number of characters of the line, with or without the line terminator.
+ * @param record_number The number of the record of Intel HEX file.
+ */
+void writeRecordInfo(HexContext_t *context, const int8_t line[], uint32_t length, int32_t record_number);
+
+/**
+ * @brief This function writes a valid record as one line of a machine-readable format.
+ *
+ * The line has the line number, record type, absolute memory address and data field of the record,
+ * as a JSON object (JSON lines) or as comma-separated values.
+ *
+ * @param context The context of the file, the line is written to its output writer.
+ * @param record The valid record.
+ * @param line_number The line number of the record.
+ * @param absolute_address The absolute memory address of the first data byte of the record.
+ * @param format The format of the line.
+ */
+void writeRecordLine(HexContext_t *context, const IntelHexRecord_t *record, uint32_t line_number,
+                     uint32_t absolute_address, RecordFormat_t format);
+
+/**
+ * @brief This function writes the header of a machine-readable format.
+ *
+ * Comma-separated values start with the names of the columns, JSON lines have no header.
+ *
+ * @param context The context of the file, the header is written to its output writer.
+ * @param format The format of the lines.
+ */
+void writeRecordHeader(HexContext_t *context, RecordFormat_t format);
+#endif
 
 #endif /* RECORD_HANDLER_H */
 
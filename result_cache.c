@@ -0,0 +1,855 @@
+/**
+ * @file result_cache.c
+ * @brief This file contains the implementation of the result cache functions.
+ *
+ * Each result is one file of the cache directory, its name is the key in hexadecimal with the extension .ihc.
+ * The file has a header with the key, the size of the Intel Hex file, the rules of the validation and the
+ * report, then the segments of the memory image if they are known. A result is used only if its whole header
+ * matches the file, so a damaged or foreign file of the directory is ignored.
+ * The time of the last use of a result is the modification time of its file, it is updated at each hit.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include "result_cache.h"      /* Include header file of this function file */
+#include "record_handler.h"    /* Include header file of the record handler of lower layer */
+#include "file_mapper.h"       /* Include header file of the file mapper of lower layer */
+#include "content_hash.h"      /* Include header file of the content hash of lower layer */
+#include <stdlib.h>            /* For malloc(), realloc(), free(), qsort() functions */
+#include <string.h>            /* For memcpy(), memset(), strlen(), strcmp() functions */
+#include <sys/stat.h>          /* For stat(), mkdir() functions */
+#if defined(_WIN32)
+#include <windows.h>           /* For CreateDirectoryA(), FindFirstFileA(), MoveFileExA() functions */
+#include <sys/utime.h>         /* For _utime() function */
+#else
+#include <dirent.h>            /* For opendir(), readdir() functions */
+#include <unistd.h>            /* For getpid() function */
+#include <utime.h>             /* For utime() function */
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define RESULT_CACHE_MAGIC          0x43584849U     /* "IHXC" in little-endian order, the first bytes of a result */
+#define RESULT_CACHE_NO_SEGMENTS    0xFFFFFFFFU     /* The number of segments of a result without segments */
+#define RESULT_CACHE_EXTENSION      ".ihc"          /* The extension of the results */
+#define RESULT_CACHE_NAME_SIZE      21              /* The characters of the name of a result: 16 digits, extension, null */
+#define RESULT_CACHE_MIN_FILES      64              /* The number of files of the first allocation of a trim */
+/* The size a full cache is trimmed to while it is open, 3/4 of its maximum size so the directory isn't
+   listed again at the next store */
+#define RESULT_CACHE_TRIM_SIZE(max_size)    ((max_size) - ((max_size) / 4))
+/* The rules of the validation of this build: the version and the dialect, a file can get another result in a build
+   of another dialect */
+#define RESULT_CACHE_RULES          ((HEX_VALIDATOR_VERSION << 8) | HEX_DIALECT)
+#if defined(_WIN32)
+#define RESULT_CACHE_SEPARATOR      '\\'            /* The separator of the directories of a path */
+#else
+#define RESULT_CACHE_SEPARATOR      '/'             /* The separator of the directories of a path */
+#endif
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold the header of a result file.
+ */
+typedef struct
+{
+    uint32_t magic;                 /* RESULT_CACHE_MAGIC */
+    uint32_t header_size;           /* The size of this structure, it differs if the file is from another build */
+    uint32_t rules;                 /* RESULT_CACHE_RULES of the validation */
+    int32_t result;                 /* The result of the validation */
+    uint64_t key;                   /* The key of the Intel Hex file */
+    uint64_t size;                  /* The number of bytes of the Intel Hex file */
+    uint32_t segment_count;         /* The number of segments behind the header, RESULT_CACHE_NO_SEGMENTS if unknown */
+    uint32_t overlap_count;         /* The number of segments that overlap the previous segment */
+    uint64_t data_size;             /* The number of data bytes of all segments */
+    FileReport_t report;            /* The report of the validation */
+} CacheHeader_t;
+
+/**
+ * @brief Structure to hold one result file found by a trim of the cache directory.
+ */
+typedef struct
+{
+    char *path;                     /* The path of the result file */
+    uint64_t size;                  /* The number of bytes of the result file */
+    uint64_t time;                  /* The time of the last use of the result */
+} CacheFile_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static char *joinPath(const char *directory, const char *name);
+static void formatEntryName(char name[], uint64_t key);
+static int8_t hasCacheExtension(const char *name);
+static void storeContextResult(HexContext_t *context, const FileReport_t *report);
+static uint64_t trimResultCache(ResultCache_t *cache, uint64_t target_size);
+static int32_t addCacheFile(CacheFile_t **files, uint32_t *count, uint32_t *capacity, char *path,
+                            uint64_t size, uint64_t time);
+static int compareCacheFiles(const void *first, const void *second);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/**
+ * @brief This function opens a result cache, the cache directory is created if it doesn't exist.
+ *
+ * The results already in the directory are counted in total_size, the results used least recently are removed
+ * if they are larger than the maximum size.
+ *
+ * @param cache The cache to open.
+ * @param directory The path of the cache directory.
+ * @param max_size The maximum number of bytes of all results of the directory.
+ * @return 0 if the cache is open, 3 if the directory can't be created, 4 if there isn't enough memory.
+ */
+int32_t openResultCache(ResultCache_t *cache, const char *directory, uint64_t max_size)
+{
+    int32_t status = 0;                     /* Initialize the status of the function */
+    size_t length = strlen(directory);      /* The number of characters of the path of the directory */
+#if defined(_WIN32)
+    DWORD attributes = 0;                   /* The attributes of the directory */
+#else
+    struct stat information;                /* The information of the directory */
+#endif
+
+    cache->directory = (char *)malloc(length + 1);
+    cache->max_size = max_size;
+    cache->total_size = 0;
+    cache->trimming = 0;
+    cache->hit_count = 0;
+    cache->miss_count = 0;
+    cache->store_count = 0;
+    cache->temporary_count = 0;
+    if (cache->directory == NULL)
+    {
+        status = 4;
+    }
+    else
+    {
+        memcpy(cache->directory, directory, length + 1);
+        /* Create the directory, it is fine if it already exists */
+#if defined(_WIN32)
+        CreateDirectoryA(directory, NULL);
+        attributes = GetFileAttributesA(directory);
+        if ((attributes == INVALID_FILE_ATTRIBUTES) || ((attributes & FILE_ATTRIBUTE_DIRECTORY) == 0))
+#else
+        mkdir(directory, 0777);
+        if ((stat(directory, &information) != 0) || !S_ISDIR(information.st_mode))
+#endif
+        {
+            free(cache->directory);
+            cache->directory = NULL;
+            status = 3;
+        }
+        else
+        {
+            pthread_mutex_init(&(cache->lock), NULL);
+            cache->total_size = trimResultCache(cache, max_size);
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief This function computes the key of the result of a file.
+ *
+ * @param buffer The content of the file.
+ * @param size The number of bytes of the file.
+ * @return The xxHash of the content seeded with the version and the dialect of the validation.
+ */
+uint64_t computeCacheKey(const int8_t buffer[], uint64_t size)
+{
+    return hashContent(buffer, size, RESULT_CACHE_RULES);
+}
+
+/**
+ * @brief This function looks up the result of a file in the cache.
+ *
+ * A result found in the cache becomes the result used most recently, the modification time of its file
+ * is set to the current time.
+ *
+ * @param cache The cache.
+ * @param key The key of the file.
+ * @param size The number of bytes of the file.
+ * @param with_segments 1 if the segments of a valid file are needed, a result without segments isn't used then.
+ * @param result The structure to store the result, it must be released with freeCachedResult.
+ * @return 1 if the result is found, 0 otherwise.
+ */
+int32_t lookupResultCache(ResultCache_t *cache, uint64_t key, uint64_t size, int8_t with_segments,
+                          CachedResult_t *result)
+{
+    int32_t found = 0;                      /* Initialize a flag to indicate if the result is found */
+    int8_t has_segments = 0;                /* Initialize a flag to indicate if the result has segments */
+    char name[RESULT_CACHE_NAME_SIZE];      /* The name of the result file */
+    char *path = NULL;                      /* The path of the result file */
+    FILE *fptr = NULL;                      /* The result file */
+    MemorySegment_t *segments = NULL;       /* The segments of the result */
+    CacheHeader_t header;                   /* Declaring the header of the result file */
+
+    formatEntryName(name, key);
+    path = joinPath(cache->directory, name);
+    if (path != NULL)
+    {
+        fptr = fopen(path, "rb");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (fptr != NULL)
+    {
+        /* Use the result only if the header matches the file */
+        if ((fread(&header, sizeof(CacheHeader_t), 1, fptr) == 1) && (header.magic == RESULT_CACHE_MAGIC) &&
+            (header.header_size == sizeof(CacheHeader_t)) && (header.rules == RESULT_CACHE_RULES) &&
+            (header.key == key) && (header.size == size))
+        {
+            /* Read the segments, if there are any */
+            if ((header.segment_count != RESULT_CACHE_NO_SEGMENTS) && (header.segment_count > 0))
+            {
+                segments = (MemorySegment_t *)malloc((size_t)header.segment_count * sizeof(MemorySegment_t));
+                has_segments = (segments != NULL) &&
+                               (fread(segments, sizeof(MemorySegment_t), header.segment_count, fptr) ==
+                                header.segment_count);
+            }
+            else
+            {
+                has_segments = (header.segment_count == 0);
+            }
+            found = !with_segments || (header.result != 0) || has_segments;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        fclose(fptr);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (found)
+    {
+        result->result = header.result;
+        result->size = header.size;
+        result->report = header.report;
+        result->cached = 1;
+        result->has_segments = has_segments;
+        result->segments = has_segments ? segments : NULL;
+        result->segment_count = has_segments ? header.segment_count : 0;
+        result->overlap_count = header.overlap_count;
+        result->data_size = header.data_size;
+        if (!has_segments)
+        {
+            free(segments);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        /* Make the result the one used most recently */
+#if defined(_WIN32)
+        _utime(path, NULL);
+#else
+        utime(path, NULL);
+#endif
+    }
+    else
+    {
+        free(segments);
+    }
+    free(path);
+
+    pthread_mutex_lock(&(cache->lock));
+    if (found)
+    {
+        cache->hit_count += 1;
+    }
+    else
+    {
+        cache->miss_count += 1;
+    }
+    pthread_mutex_unlock(&(cache->lock));
+    return found;
+}
+
+/**
+ * @brief This function stores the result of a file in the cache.
+ *
+ * The result is written to a temporary file which is renamed to the name of the result, so another thread
+ * or process never reads a result that is only partly written. A result that can't be written is not stored,
+ * the cache is only an optimization.
+ * The size of the result is added to total_size, a result that replaces another one is counted twice until
+ * the next trim, so total_size is never smaller than the directory. When total_size passes the maximum size,
+ * one thread trims the directory to RESULT_CACHE_TRIM_SIZE while the other threads go on storing.
+ *
+ * @param cache The cache.
+ * @param key The key of the file.
+ * @param result The result of the file, its segments are stored if has_segments is 1.
+ */
+void storeResultCache(ResultCache_t *cache, uint64_t key, const CachedResult_t *result)
+{
+    int8_t written = 0;                     /* Initialize a flag to indicate if the result is written */
+    int8_t trim = 0;                        /* Initialize a flag to indicate if this thread trims the cache */
+    uint32_t number = 0;                    /* The number of the temporary file */
+    uint64_t stored_size = 0;               /* The number of bytes of the result file */
+    uint64_t counted_size = 0;              /* The total size when the trim starts */
+    uint64_t remaining_size = 0;            /* The number of bytes of the results kept by the trim */
+    char name[RESULT_CACHE_NAME_SIZE];      /* The name of the result file */
+    char *path = NULL;                      /* The path of the result file */
+    char *temporary = NULL;                 /* The path of the temporary file */
+    size_t length = 0;                      /* The number of characters of the path of the result file */
+    FILE *fptr = NULL;                      /* The temporary file */
+    CacheHeader_t header;                   /* Declaring the header of the result file */
+
+    /* All bytes of the header are set, so the same result always gives the same file */
+    memset(&header, 0, sizeof(CacheHeader_t));
+    header.magic = RESULT_CACHE_MAGIC;
+    header.header_size = sizeof(CacheHeader_t);
+    header.rules = RESULT_CACHE_RULES;
+    header.result = result->result;
+    header.key = key;
+    header.size = result->size;
+    header.segment_count = result->has_segments ? result->segment_count : RESULT_CACHE_NO_SEGMENTS;
+    header.overlap_count = result->overlap_count;
+    header.data_size = result->data_size;
+    header.report = result->report;
+    stored_size = sizeof(CacheHeader_t) +
+                  (result->has_segments ? ((uint64_t)result->segment_count * sizeof(MemorySegment_t)) : 0);
+
+    pthread_mutex_lock(&(cache->lock));
+    number = cache->temporary_count;
+    cache->temporary_count += 1;
+    pthread_mutex_unlock(&(cache->lock));
+
+    formatEntryName(name, key);
+    path = joinPath(cache->directory, name);
+    if (path != NULL)
+    {
+        length = strlen(path);
+        temporary = (char *)malloc(length + 32);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (temporary != NULL)
+    {
+        /* The name of the temporary file is unique for each process and each store */
+#if defined(_WIN32)
+        snprintf(temporary, length + 32, "%s.%lu.%u.tmp", path, (unsigned long)GetCurrentProcessId(), number);
+#else
+        snprintf(temporary, length + 32, "%s.%lu.%u.tmp", path, (unsigned long)getpid(), number);
+#endif
+        fptr = fopen(temporary, "wb");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (fptr != NULL)
+    {
+        written = (fwrite(&header, sizeof(CacheHeader_t), 1, fptr) == 1);
+        if (written && result->has_segments && (result->segment_count > 0))
+        {
+            written = (fwrite(result->segments, sizeof(MemorySegment_t), result->segment_count, fptr) ==
+                       result->segment_count);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        written = (fclose(fptr) == 0) && written;
+
+        /* Replace the result file by the temporary file */
+#if defined(_WIN32)
+        written = written && MoveFileExA(temporary, path, MOVEFILE_REPLACE_EXISTING);
+#else
+        written = written && (rename(temporary, path) == 0);
+#endif
+        if (!written)
+        {
+            remove(temporary);
+        }
+        else
+        {
+            pthread_mutex_lock(&(cache->lock));
+            cache->store_count += 1;
+            cache->total_size += stored_size;
+            trim = (cache->total_size > cache->max_size) && !cache->trimming;
+            if (trim)
+            {
+                cache->trimming = 1;
+                counted_size = cache->total_size;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            pthread_mutex_unlock(&(cache->lock));
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    free(temporary);
+    free(path);
+
+    if (trim)
+    {
+        remaining_size = trimResultCache(cache, RESULT_CACHE_TRIM_SIZE(cache->max_size));
+        /* The results stored by the other threads during the trim are still counted */
+        pthread_mutex_lock(&(cache->lock));
+        cache->total_size = remaining_size + (cache->total_size - counted_size);
+        cache->trimming = 0;
+        pthread_mutex_unlock(&(cache->lock));
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function validates an Intel Hex file, the result is looked up in the cache first.
+ *
+ * The file is mapped into memory and its key is computed. If the cache has no result for the key, the file is
+ * validated with validateIntelHexBuffer, or with buildMemoryImageFromBuffer if the segments are needed,
+ * and the result is stored in the cache. The context gets the same line count and error in both cases.
+ * If the segments aren't needed, a file rejected by prefilterIntelHexBuffer isn't hashed nor looked up.
+ *
+ * @param cache The cache, NULL to validate the file without a cache.
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param with_segments 1 to get the segments of the memory image of a valid file.
+ * @param result The structure to store the result, it must be released with freeCachedResult.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if the file can't be opened, 4 if there isn't enough memory for the segments.
+ */
+int32_t validateIntelHexFileCached(ResultCache_t *cache, HexContext_t *context, const char *path,
+                                   int8_t with_segments, CachedResult_t *result)
+{
+    int8_t found = 0;               /* Initialize a flag to indicate if the result is found in the cache */
+    int8_t rejected = 0;            /* Initialize a flag to indicate if the file is rejected by the prefilter */
+    uint64_t key = 0;               /* The key of the file */
+    uint64_t start = HEX_STATISTICS_CLOCK();     /* The time of the beginning of the mapping */
+    MappedFile_t file;              /* Declaring the mapping of the file */
+    MemoryImage_t image;            /* Declaring the memory image of the file */
+
+    memset(result, 0, sizeof(CachedResult_t));
+    if (mapFile(path, &file) != 0)
+    {
+        result->result = 3;
+    }
+    else
+    {
+        HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+        /* A file that isn't Intel Hex at all is rejected before the whole file is hashed */
+        if (!with_segments)
+        {
+            result->size = file.size;
+            rejected = prefilterIntelHexBuffer(context, file.data, file.size, HEX_PREFILTER_SIZE, &(result->report));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        if (rejected)
+        {
+            result->result = 1;
+        }
+        else if (cache != NULL)
+        {
+            key = computeCacheKey(file.data, file.size);
+            found = lookupResultCache(cache, key, file.size, with_segments, result);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        if (rejected)
+        {
+            /* Do nothing */
+        }
+        else if (found)
+        {
+            resetHexContext(context);
+            storeContextResult(context, &(result->report));
+        }
+        else if (with_segments)
+        {
+            /* Build the memory image and keep its segments */
+            result->size = file.size;
+            initMemoryImage(&image);
+            result->result = buildMemoryImageFromBuffer(context, file.data, file.size, &image, &(result->report));
+            if ((result->result != 4) && (image.segment_count > 0))
+            {
+                result->segments = (MemorySegment_t *)malloc((size_t)image.segment_count * sizeof(MemorySegment_t));
+                if (result->segments != NULL)
+                {
+                    memcpy(result->segments, image.segments, (size_t)image.segment_count * sizeof(MemorySegment_t));
+                }
+                else
+                {
+                    result->result = 4;
+                }
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            result->has_segments = (result->result != 4);
+            result->segment_count = result->has_segments ? image.segment_count : 0;
+            result->overlap_count = image.overlap_count;
+            result->data_size = image.data_size;
+            freeMemoryImage(&image);
+        }
+        else
+        {
+            result->size = file.size;
+            result->result = validateIntelHexBuffer(context, file.data, file.size, &(result->report));
+        }
+
+        /* Store the result of the validation, a failed allocation isn't a result of the file */
+        if ((cache != NULL) && !found && !rejected && (result->result != 4))
+        {
+            storeResultCache(cache, key, result);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        start = HEX_STATISTICS_CLOCK();
+        unmapFile(&file);
+        HEX_STATISTICS_ELAPSED(context->statistics.io_time, start);
+    }
+    return result->result;
+}
+
+/**
+ * @brief This function releases the segments of a result.
+ *
+ * @param result The result to release.
+ */
+void freeCachedResult(CachedResult_t *result)
+{
+    free(result->segments);
+    result->segments = NULL;
+    result->segment_count = 0;
+    result->has_segments = 0;
+}
+
+/**
+ * @brief This function closes a result cache.
+ *
+ * If results have been stored, the results used least recently are removed until the size of the directory
+ * is at most the maximum size of the cache.
+ *
+ * @param cache The cache to close.
+ */
+void closeResultCache(ResultCache_t *cache)
+{
+    if (cache->directory != NULL)
+    {
+        if (cache->store_count > 0)
+        {
+            trimResultCache(cache, cache->max_size);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        pthread_mutex_destroy(&(cache->lock));
+        free(cache->directory);
+        cache->directory = NULL;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function makes the path of a file of a directory.
+ *
+ * @param directory The path of the directory.
+ * @param name The name of the file.
+ * @return The path, to be released with free, NULL if there isn't enough memory.
+ */
+static char *joinPath(const char *directory, const char *name)
+{
+    size_t directory_length = strlen(directory);    /* The number of characters of the path of the directory */
+    size_t name_length = strlen(name);              /* The number of characters of the name of the file */
+    char *path = (char *)malloc(directory_length + name_length + 2);   /* The path of the file */
+
+    if (path != NULL)
+    {
+        memcpy(path, directory, directory_length);
+        path[directory_length] = RESULT_CACHE_SEPARATOR;
+        memcpy(path + directory_length + 1, name, name_length + 1);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return path;
+}
+
+/**
+ * @brief This function makes the name of the result file of a key.
+ *
+ * @param name The RESULT_CACHE_NAME_SIZE characters of the name.
+ * @param key The key.
+ */
+static void formatEntryName(char name[], uint64_t key)
+{
+    const char *digits = "0123456789abcdef";   /* The hexadecimal digits */
+    uint32_t i = 0;                             /* Loop counter */
+
+    for (i = 0; i < 16; i++)
+    {
+        name[i] = digits[(key >> (60 - (i * 4))) & 0x0F];
+    }
+    memcpy(name + 16, RESULT_CACHE_EXTENSION, sizeof(RESULT_CACHE_EXTENSION));
+}
+
+/**
+ * @brief This function checks if the name of a file ends with the extension of the results.
+ *
+ * @param name The name of the file.
+ * @return 1 if the name ends with RESULT_CACHE_EXTENSION, 0 otherwise.
+ */
+static int8_t hasCacheExtension(const char *name)
+{
+    size_t length = strlen(name);   /* The number of characters of the name */
+
+    return (length > 4) && (strcmp(name + length - 4, RESULT_CACHE_EXTENSION) == 0);
+}
+
+/**
+ * @brief This function stores the result found in the cache in the context of the file.
+ *
+ * The context gets what a validation would give it: the number of lines of the file and the first error.
+ *
+ * @param context The context of the file.
+ * @param report The report of the file.
+ */
+static void storeContextResult(HexContext_t *context, const FileReport_t *report)
+{
+    context->line_number = report->line_count;
+    if (report->record_error.error_code != 0)
+    {
+        context->error = report->record_error;
+    }
+    else if (report->eof_error.error_code != 0)
+    {
+        context->error = report->eof_error;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+ * @brief This function removes the results used least recently until the size of the directory is small enough.
+ *
+ * Nothing is removed if the results aren't larger than the maximum size of the cache.
+ * Other files of the directory are kept and aren't counted.
+ *
+ * @param cache The cache.
+ * @param target_size The number of bytes the results are trimmed to, at most the maximum size of the cache.
+ * @return The number of bytes of the results kept.
+ */
+static uint64_t trimResultCache(ResultCache_t *cache, uint64_t target_size)
+{
+    int32_t status = 0;                     /* Initialize the status of the listing of the directory */
+    uint32_t i = 0;                         /* Loop counter */
+    uint32_t count = 0;                     /* The number of result files */
+    uint32_t capacity = 0;                  /* The number of allocated result files */
+    uint64_t total = 0;                     /* The number of bytes of all result files */
+    char *path = NULL;                      /* The path of the current file */
+    CacheFile_t *files = NULL;              /* The result files */
+#if defined(_WIN32)
+    char *pattern = joinPath(cache->directory, "*" RESULT_CACHE_EXTENSION);    /* The search pattern of the results */
+    HANDLE find = INVALID_HANDLE_VALUE;     /* The handle of the search */
+    WIN32_FIND_DATAA data;                  /* The information of the current file */
+
+    if (pattern != NULL)
+    {
+        find = FindFirstFileA(pattern, &data);
+        free(pattern);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    if (find != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            /* The pattern also matches longer extensions, the extension is checked again */
+            if (hasCacheExtension(data.cFileName))
+            {
+                path = joinPath(cache->directory, data.cFileName);
+                status = addCacheFile(&files, &count, &capacity, path,
+                                      ((uint64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow,
+                                      ((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) |
+                                      data.ftLastWriteTime.dwLowDateTime);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        } while ((status == 0) && FindNextFileA(find, &data));
+        FindClose(find);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+#else
+    DIR *handle = opendir(cache->directory);   /* The handle of the directory */
+    struct dirent *entry = NULL;            /* The current file of the directory */
+    struct stat information;                /* The information of the current file */
+
+    if (handle != NULL)
+    {
+        entry = readdir(handle);
+        while ((status == 0) && (entry != NULL))
+        {
+            if (hasCacheExtension(entry->d_name))
+            {
+                path = joinPath(cache->directory, entry->d_name);
+                if ((path != NULL) && (stat(path, &information) == 0) && S_ISREG(information.st_mode))
+                {
+                    status = addCacheFile(&files, &count, &capacity, path, (uint64_t)information.st_size,
+                                          (uint64_t)information.st_mtime);
+                }
+                else
+                {
+                    free(path);
+                }
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            entry = readdir(handle);
+        }
+        closedir(handle);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+#endif
+
+    /* Remove the oldest results while the directory is too large */
+    for (i = 0; i < count; i++)
+    {
+        total += files[i].size;
+    }
+    if (total > cache->max_size)
+    {
+        qsort(files, count, sizeof(CacheFile_t), compareCacheFiles);
+        for (i = 0; (i < count) && (total > target_size); i++)
+        {
+            if (remove(files[i].path) == 0)
+            {
+                total -= files[i].size;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        free(files[i].path);
+    }
+    free(files);
+    return total;
+}
+
+/**
+ * @brief This function adds one result file to the files found by a trim.
+ *
+ * @param files The array of the files, it grows geometrically.
+ * @param count The number of files.
+ * @param capacity The number of allocated files.
+ * @param path The path of the file, it is owned by the array, NULL if it couldn't be allocated.
+ * @param size The number of bytes of the file.
+ * @param time The time of the last use of the result.
+ * @return 0 if the file is added, 4 if there isn't enough memory.
+ */
+static int32_t addCacheFile(CacheFile_t **files, uint32_t *count, uint32_t *capacity, char *path,
+                            uint64_t size, uint64_t time)
+{
+    int32_t status = (path != NULL) ? 0 : 4;    /* Initialize the status of the function */
+    uint32_t new_capacity = 0;              /* The new number of allocated files */
+    CacheFile_t *new_files = NULL;          /* Pointer to the new array */
+
+    if ((status == 0) && (*count == *capacity))
+    {
+        new_capacity = (*capacity == 0) ? RESULT_CACHE_MIN_FILES : *capacity * 2;
+        new_files = (CacheFile_t *)realloc(*files, (size_t)new_capacity * sizeof(CacheFile_t));
+        if (new_files != NULL)
+        {
+            *files = new_files;
+            *capacity = new_capacity;
+        }
+        else
+        {
+            status = 4;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (status == 0)
+    {
+        (*files)[*count].path = path;
+        (*files)[*count].size = size;
+        (*files)[*count].time = time;
+        *count += 1;
+    }
+    else
+    {
+        free(path);
+    }
+    return status;
+}
+
+/**
+ * @brief This function compares two result files by the time of their last use for qsort.
+ *
+ * @param first The first file.
+ * @param second The second file.
+ * @return -1 if the first file is used less recently, 1 if it is used more recently, 0 otherwise.
+ */
+static int compareCacheFiles(const void *first, const void *second)
+{
+    uint64_t first_time = ((const CacheFile_t *)first)->time;     /* The time of the first file */
+    uint64_t second_time = ((const CacheFile_t *)second)->time;   /* The time of the second file */
+
+    return (first_time < second_time) ? -1 : ((first_time > second_time) ? 1 : 0);
+} /* EOF */
@@ -0,0 +1,165 @@
+/**
+ * @file result_cache.h
+ * @brief This file contains the prototypes of the result cache functions.
+ *
+ * The result cache keeps the result of the validation of a file in a cache directory, so a file that is
+ * byte-identical to a file validated before isn't validated again. The key of a result is the 64-bit xxHash
+ * of the content of the file, seeded with HEX_VALIDATOR_VERSION and HEX_DIALECT so the results of another version
+ * of the validation or of a build of another dialect are never used, and the size of the file.
+ * A result stores the report of the validation and, if it is asked for, the segments of the memory image of the file.
+ * Function validateIntelHexFileCached looks up the result of a file before validating it and stores it after.
+ * The total size of the cache directory is bounded, the results used least recently are removed first.
+ *
+ * @author Viet Ha Nguyen
+ * @date 10/14/2026
+ */
+/*******************************************************************************
+ * Include
+ ******************************************************************************/
+#include <stdint.h>   /* Include standard integer types library for fixed-width integers like int8_t, uint64_t, etc. */
+#include <stdio.h>    /* Include standard input and output library for printf, scanf, ... */
+#include <pthread.h>  /* For pthread_mutex_t type */
+#include "intel_hex_file_analyzer.h"   /* Include header file of the Intel Hex file analyzer */
+#include "memory_image.h"              /* Include header file of the memory image builder */
+
+/*******************************************************************************
+ * Header guards
+ ******************************************************************************/
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define RESULT_CACHE_DEFAULT_SIZE   (64ULL * 1024 * 1024)   /* The default bound of the size of the cache directory */
+
+/*******************************************************************************
+ * Declarations
+ ******************************************************************************/
+/**
+ * @brief Structure to hold an open result cache.
+ *
+ * The cache can be used by several threads at the same time, a result is written to a temporary file
+ * and renamed, so a result is never read while it is written.
+ */
+typedef struct
+{
+    char *directory;                /* The path of the cache directory */
+    uint64_t max_size;              /* The maximum number of bytes of all results of the directory */
+    uint64_t total_size;            /* The number of bytes of the results, counted at the opening and at each store */
+    int8_t trimming;                /* 1 while a thread removes the results used least recently */
+    uint32_t hit_count;             /* The number of results found */
+    uint32_t miss_count;            /* The number of results not found */
+    uint32_t store_count;           /* The number of results stored */
+    uint32_t temporary_count;       /* The number of temporary files created, it makes their names unique */
+    pthread_mutex_t lock;           /* The mutex protecting the counters */
+} ResultCache_t;
+
+/**
+ * @brief Structure to hold the result of the validation of a file, validated or found in the cache.
+ *
+ * The segments are only meaningful if has_segments is 1, they are the segments of the memory image
+ * without the data bytes.
+ */
+typedef struct
+{
+    int32_t result;                 /* 0 if the file is valid, 1 record error, 2 End-Of-File error, 3 can't open, 4 out of memory */
+    uint64_t size;                  /* The number of bytes of the file */
+    FileReport_t report;            /* The report of the validation */
+    int8_t cached;                  /* 1 if the result is found in the cache */
+    int8_t has_segments;            /* 1 if the segments of the memory image are known */
+    MemorySegment_t *segments;      /* The segments of the memory image */
+    uint32_t segment_count;         /* The number of segments */
+    uint32_t overlap_count;         /* The number of segments that overlap the previous segment */
+    uint64_t data_size;             /* The number of data bytes of all segments */
+} CachedResult_t;
+
+/*******************************************************************************
+ * Prototype
+ ******************************************************************************/
+/**
+ * @brief This function opens a result cache, the cache directory is created if it doesn't exist.
+ *
+ * The results of the directory are counted, and the results used least recently are removed if they are
+ * larger than the maximum size.
+ *
+ * @param cache The cache to open.
+ * @param directory The path of the cache directory.
+ * @param max_size The maximum number of bytes of all results of the directory.
+ * @return 0 if the cache is open, 3 if the directory can't be created, 4 if there isn't enough memory.
+ */
+int32_t openResultCache(ResultCache_t *cache, const char *directory, uint64_t max_size);
+
+/**
+ * @brief This function computes the key of the result of a file.
+ *
+ * @param buffer The content of the file.
+ * @param size The number of bytes of the file.
+ * @return The xxHash of the content seeded with the version and the dialect of the validation.
+ */
+uint64_t computeCacheKey(const int8_t buffer[], uint64_t size);
+
+/**
+ * @brief This function looks up the result of a file in the cache.
+ *
+ * A result found in the cache becomes the result used most recently.
+ *
+ * @param cache The cache.
+ * @param key The key of the file.
+ * @param size The number of bytes of the file.
+ * @param with_segments 1 if the segments of a valid file are needed, a result without segments isn't used then.
+ * @param result The structure to store the result, it must be released with freeCachedResult.
+ * @return 1 if the result is found, 0 otherwise.
+ */
+int32_t lookupResultCache(ResultCache_t *cache, uint64_t key, uint64_t size, int8_t with_segments,
+                          CachedResult_t *result);
+
+/**
+ * @brief This function stores the result of a file in the cache.
+ *
+ * A result that can't be written is not stored, the cache is only an optimization.
+ * When the results get larger than the maximum size, the results used least recently are removed at once,
+ * so the directory of a server or of a long batch stays bounded while the cache is open.
+ *
+ * @param cache The cache.
+ * @param key The key of the file.
+ * @param result The result of the file, its segments are stored if has_segments is 1.
+ */
+void storeResultCache(ResultCache_t *cache, uint64_t key, const CachedResult_t *result);
+
+/**
+ * @brief This function validates an Intel Hex file, the result is looked up in the cache first.
+ *
+ * The file is mapped into memory and its key is computed. If the cache has no result for the key, the file is
+ * validated with validateIntelHexBuffer, or with buildMemoryImageFromBuffer if the segments are needed,
+ * and the result is stored in the cache. The context gets the same line count and error in both cases.
+ *
+ * @param cache The cache, NULL to validate the file without a cache.
+ * @param context The context of the file.
+ * @param path The path of the Intel Hex file.
+ * @param with_segments 1 to get the segments of the memory image of a valid file.
+ * @param result The structure to store the result, it must be released with freeCachedResult.
+ * @return 0 if the file is valid, 1 if a record is invalid, 2 if the End-Of-File record isn't valid,
+ *         3 if the file can't be opened, 4 if there isn't enough memory for the segments.
+ */
+int32_t validateIntelHexFileCached(ResultCache_t *cache, HexContext_t *context, const char *path,
+                                   int8_t with_segments, CachedResult_t *result);
+
+/**
+ * @brief This function releases the segments of a result.
+ *
+ * @param result The result to release.
+ */
+void freeCachedResult(CachedResult_t *result);
+
+/**
+ * @brief This function closes a result cache.
+ *
+ * If results have been stored, the results used least recently are removed until the size of the directory
+ * is at most the maximum size of the cache.
+ *
+ * @param cache The cache to close.
+ */
+void closeResultCache(ResultCache_t *cache);
+
+#endif /* RESULT_CACHE_H */